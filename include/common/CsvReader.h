@@ -0,0 +1,53 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace minidb {
+
+/**
+ * 流式 CSV 读取：按块（默认 1MB）读文件，逐条返回记录的字段，内存占用与文件大小无关
+ * 支持 RFC 4180 引号（字段内可含逗号、换行，"" 表示一个引号），行尾为 \n 或 \r\n，空行跳过。
+ * 返回的字段视图指向内部缓冲区，在下一次 next() 前有效。
+ */
+class CsvReader {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+    // 文件不存在时抛出 FileNotFoundException
+    explicit CsvReader(const std::string& path, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    CsvReader(const CsvReader&) = delete;
+    CsvReader& operator=(const CsvReader&) = delete;
+
+    // 读取下一条记录，文件结束时返回 false；引号不闭合等格式错误抛出 DatabaseException
+    bool next(std::vector<std::string_view>& fields);
+
+    // 最近一条记录在文件中的起始行号（从 1 开始），用于报错
+    size_t lineNumber() const { return recordLine_; }
+
+private:
+    std::ifstream file_;
+    std::string path_;
+    size_t chunkSize_;
+    std::string buffer_;        // 未消费的数据从 pos_ 开始
+    size_t pos_ = 0;
+    bool eof_ = false;
+    size_t line_ = 1;           // pos_ 处的行号
+    size_t recordLine_ = 0;
+
+    // 读入下一块数据（先丢弃已消费的部分），没有更多数据时返回 false
+    bool fill();
+    // 从 pos_ 起找记录结尾（引号外的换行），找不到时返回 npos；newlines 为记录内的换行数
+    size_t findRecordEnd(size_t& newlines) const;
+    // 把 [begin, end) 拆成字段，带引号的字段就地去掉转义
+    void splitFields(size_t begin, size_t end, std::vector<std::string_view>& fields);
+};
+
+} // namespace minidb
+
+#endif // CSV_READER_H
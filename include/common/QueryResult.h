@@ -1,90 +1,94 @@
 #ifndef QUERY_RESULT_H
 #define QUERY_RESULT_H
 
-#include <vector>
-#include <string>
+#include "Tuple.h"
+#include "Types.h"
+#include "Value.h"
+
+#include <cstdint>
 #include <optional>
-#include <sstream>
-#include <iostream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace minidb {
 
+/**
+ * 查询结果（列式）：每列一个带类型的缓冲区
+ * INTEGER/BOOLEAN 存为连续的 int32_t 数组，VARCHAR 的字节连续追加到该列的字符串区，按偏移数组定位，
+ * 单元格不单独分配字符串。只有 getRow()/getValue()/print()/toJsonString()/toCsvString() 这些展示接口才转换为文本。
+ */
 class QueryResult {
 public:
     using Row = std::vector<std::string>;
 
     QueryResult() = default;
 
-    void setColumnNames(const std::vector<std::string>& names) {
-        columnNames_ = names;
-    }
+    // 设置输出列（名称和类型），清空已有的行
+    void setColumns(const std::vector<std::string>& names, const std::vector<TypeId>& types);
+    // 只设置列名时各列按 VARCHAR 保存
+    void setColumnNames(const std::vector<std::string>& names);
 
     const std::vector<std::string>& getColumnNames() const {
         return columnNames_;
     }
 
-    // 添加一行结果
-    void addRow(const Row& row) {
-        results_.push_back(row);
-    }
+    TypeId getColumnType(size_t col) const { return columns_.at(col).type; }
 
-    // 获取指定行
-    const Row& getRow(size_t index) const {
-        if (index < results_.size()) {
-            return results_[index];
-        }
-        throw std::out_of_range("Row index out of range");
-    }
+    // 追加一个单元格：同一行的各列依次追加，所有列追加完后行数才增加
+    void appendInt(size_t col, int32_t value);
+    void appendString(size_t col, std::string_view value);
+    void appendNull(size_t col);
+    void appendValue(size_t col, const Value& value);
+    // 追加一行（值按位置对应输出列）
+    void appendTuple(const Tuple& tuple);
+    // 添加一行文本结果
+    void addRow(const Row& row);
 
     // 行数/列数
-    size_t rowCount() const { return results_.size(); }
-    size_t columnCount() const { return results_.empty() ? 0 : results_[0].size(); }
-
-    // 获取具体单元格
-    std::optional<std::string> getValue(size_t row, size_t col) const {
-        if (row < results_.size() && col < results_[row].size()) {
-            return results_[row][col];
-        }
-        return std::nullopt;
-    }
+    size_t rowCount() const { return columns_.empty() ? 0 : columns_[0].size(); }
+    size_t columnCount() const { return columns_.size(); }
+
+    // 按类型读取单元格，不转换为文本；getString 返回的视图在追加新行前有效
+    bool isNull(size_t row, size_t col) const;
+    int32_t getInt(size_t row, size_t col) const;
+    std::string_view getString(size_t row, size_t col) const;
+
+    // 获取指定行（转换为文本）
+    Row getRow(size_t index) const;
+
+    // 获取具体单元格（转换为文本）
+    std::optional<std::string> getValue(size_t row, size_t col) const;
 
     // 打印（调试使用）
-    void print() const {
-        if (results_.empty()) {
-            std::cout << "(empty)" << std::endl;
-            return;
-        }
-        for (const auto& row : results_) {
-            for (size_t i = 0; i < row.size(); ++i) {
-                std::cout << row[i] << (i + 1 < row.size() ? "\t" : "\n");
-            }
-        }
-    }
+    void print() const;
+    void print(std::ostream& out) const;
 
-    // 转成 JSON 字符串
-    std::string toJsonString() const {
-        std::ostringstream json;
-        json << "[\n";
-        for (size_t i = 0; i < results_.size(); ++i) {
-            json << "  { ";
-            const auto& row = results_[i];
-            for (size_t j = 0; j < row.size(); ++j) {
-                json << "\"" << j << "\": \"" << row[j] << "\"";
-                if (j < row.size() - 1) json << ", ";
-            }
-            json << " }";
-            if (i < results_.size() - 1) json << ",";
-            json << "\n";
-        }
-        json << "]";
-        return json.str();
-    }
+    // 转成 JSON 字符串（对象数组，键为列名），格式见 ResultWriter
+    std::string toJsonString() const;
+    // 转成 CSV 字符串（首行为列名）
+    std::string toCsvString() const;
 
 private:
+    struct ColumnBuffer {
+        TypeId type = TypeId::VARCHAR;
+        std::vector<int32_t> ints;          // INTEGER/BOOLEAN 的值（BOOLEAN 取 0/1）
+        std::string bytes;                  // VARCHAR 的字节
+        std::vector<uint32_t> offsets{0};   // VARCHAR：第 r 个值为 bytes[offsets[r], offsets[r+1])
+        std::vector<bool> nulls;
+
+        size_t size() const { return nulls.size(); }
+    };
+
     std::vector<std::string> columnNames_;
-    std::vector<Row> results_; // 二维数组存所有行列
+    std::vector<ColumnBuffer> columns_;
+
+    const ColumnBuffer& cell(size_t row, size_t col) const;
+    // 单元格的文本形式追加到 out（VARCHAR 原样，NULL 为 "NULL"）
+    void appendText(size_t row, size_t col, std::string& out) const;
 };
 
 } // namespace minidb
 
-#endif // QUERY_RESULT_H
\ No newline at end of file
+#endif // QUERY_RESULT_H
@@ -0,0 +1,106 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include "QueryResult.h"
+#include "Tuple.h"
+#include "Value.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace minidb {
+
+/**
+ * 可复用的输出缓冲区：格式化结果直接追加到一块连续内存，容量只增不减
+ * 绑定文件描述符时，累积超过 flushThreshold 字节就写出并清空，内存占用与导出的行数无关；
+ * 未绑定（fd < 0）时全部保留在内存中，由 str() 取出。
+ */
+class OutputBuffer {
+public:
+    static constexpr size_t DEFAULT_FLUSH_THRESHOLD = 64 * 1024;
+
+    explicit OutputBuffer(int fd = -1, size_t flushThreshold = DEFAULT_FLUSH_THRESHOLD);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void append(std::string_view bytes) {
+        buffer_.append(bytes);
+        maybeFlush();
+    }
+    void append(char c) {
+        buffer_.push_back(c);
+        maybeFlush();
+    }
+    // 用 std::to_chars 格式化整数，不经过流或临时字符串
+    void appendInt(int64_t value);
+
+    // 把缓冲的字节写到文件描述符（未绑定时什么也不做），写失败时抛出 DiskException
+    void flush();
+
+    const std::string& str() const { return buffer_; }
+    void clear() { buffer_.clear(); }
+    // 已写到文件描述符的字节数
+    size_t bytesFlushed() const { return flushed_; }
+
+private:
+    int fd_;
+    size_t flushThreshold_;
+    std::string buffer_;
+    size_t flushed_ = 0;
+
+    void maybeFlush() {
+        if (fd_ >= 0 && buffer_.size() >= flushThreshold_) flush();
+    }
+};
+
+/**
+ * 流式结果序列化：按 begin() / writeRow()... / end() 的顺序逐行写出，不缓存整个结果集
+ * JSON 输出对象数组，键为真实列名；整数/布尔值不加引号，NULL 为 null，字符串按 JSON 规则转义。
+ * CSV 首行为列名，字段含逗号、引号或换行时加引号并把引号写两次（RFC 4180），NULL 为空字段、空字符串为 ""。
+ */
+class ResultWriter {
+public:
+    enum class Format { JSON, CSV };
+
+    ResultWriter(OutputBuffer& out, Format format) : out_(out), format_(format) {}
+
+    // 写出表头（JSON 为 "["，CSV 为列名行）；列名只转义一次
+    void begin(const std::vector<std::string>& columnNames);
+    // 写出一行：Tuple 来自结果游标，QueryResult 的行直接读取列缓冲区
+    void writeRow(const Tuple& tuple);
+    void writeRow(const QueryResult& result, size_t row);
+    // 写出结果集的全部行（含 begin/end）
+    void writeAll(const QueryResult& result);
+    // 写出结尾并 flush
+    void end();
+
+    size_t rowsWritten() const { return rows_; }
+
+private:
+    OutputBuffer& out_;
+    Format format_;
+    std::vector<std::string> keys_;     // JSON：预先转义好的 "列名":；CSV：不使用
+    size_t rows_ = 0;
+    size_t column_ = 0;
+
+    void beginRow();
+    void endRow();
+    void separator();
+    void writeNull();
+    void writeInt(int32_t value);
+    void writeBool(bool value);
+    void writeString(std::string_view value);
+};
+
+// 追加 JSON 字符串字面量（含两侧引号），转义引号、反斜杠和控制字符
+void appendJsonString(OutputBuffer& out, std::string_view value);
+// 追加 CSV 字段，必要时加引号（空字符串总是写成 ""）
+void appendCsvField(OutputBuffer& out, std::string_view value);
+
+} // namespace minidb
+
+#endif // RESULT_WRITER_H
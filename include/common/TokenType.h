@@ -13,7 +13,8 @@ enum class TokenType {
     OPERATOR = 4,     // 运算符，种别码 4
     DELIMITER = 5,    // 界符，种别码 5
     ERROR = 6,        // 错误 Token，用于识别失败的情况
-    EOF_TOKEN = 7     // 文件结束 Token，标识 SQL 字符串处理完毕
+    EOF_TOKEN = 7,    // 文件结束 Token，标识 SQL 字符串处理完毕
+    PARAMETER = 8     // 参数占位符 ?（预编译语句），可出现在常量的位置
 };
 
 #endif //MINIDB_TOKENTYPE_H
\ No newline at end of file
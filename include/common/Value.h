@@ -4,6 +4,7 @@
 #include "Exception.h"
 #include <variant>
 #include <string>
+#include <string_view>
 #include <ostream>
 
 namespace minidb {
@@ -29,6 +30,8 @@ namespace minidb {
         int32_t getAsInt() const;
         bool getAsBool() const;
         std::string getAsString() const;
+        // 不拷贝地读取 VARCHAR，视图在值被修改或销毁前有效
+        std::string_view getStringView() const;
 
         // 比较操作
         bool equals(const Value& other) const;
@@ -10,6 +10,7 @@
 #include "../common/Token.h"
 #include <vector>
 #include <optional>
+#include <string>
 using namespace std;
 
 //AST节点基类（所有的父类）
@@ -43,6 +44,70 @@ struct Condition {
 
 };
 
+//预编译语句的参数占位符 ?：在AST和执行计划中写作 "?1"、"?2"…（按出现顺序从1编号），执行前替换为绑定的值
+inline string parameterMarker(size_t index) {
+    return "?" + to_string(index);
+}
+
+//常量文本是参数占位符时返回其编号，否则返回0
+inline size_t parameterIndex(const string& text) {
+    if (text.size() < 2 || text[0] != '?') return 0;
+    size_t index = 0;
+    for (size_t i = 1; i < text.size(); ++i) {
+        if (text[i] < '0' || text[i] > '9') return 0;
+        index = index * 10 + static_cast<size_t>(text[i] - '0');
+    }
+    return index;
+}
+
+//表达式节点（用于WHERE子句，如 "age + 1 > 20 AND NOT name = 'Bob'"）
+struct Expr;
+using ExprPtr = shared_ptr<Expr>;
+
+struct Expr {
+    enum class Kind { Column, Literal, Unary, Binary };
+
+    Kind kind;
+    string value;   //列名 / 常量文本 / 运算符（"AND"、"OR"、"NOT"、"="、"+" 等）
+    string type;    //表达式类型（"INT"、"STRING"、"BOOLEAN"），由语义分析填写
+    ExprPtr left;   //一元运算的操作数 / 二元运算的左操作数
+    ExprPtr right;  //二元运算的右操作数
+
+    static ExprPtr column(string name) {
+        return make_shared<Expr>(Expr{Kind::Column, std::move(name), "", nullptr, nullptr});
+    }
+    static ExprPtr literal(string text) {
+        return make_shared<Expr>(Expr{Kind::Literal, std::move(text), "", nullptr, nullptr});
+    }
+    static ExprPtr unary(string op, ExprPtr operand) {
+        return make_shared<Expr>(Expr{Kind::Unary, std::move(op), "", std::move(operand), nullptr});
+    }
+    static ExprPtr binary(string op, ExprPtr lhs, ExprPtr rhs) {
+        return make_shared<Expr>(Expr{Kind::Binary, std::move(op), "", std::move(lhs), std::move(rhs)});
+    }
+};
+
+//JOIN子句（如 "JOIN customers ON orders.customer_id = customers.id"）
+struct JoinClause {
+    string tableName;   //被连接的表名
+    ExprPtr on;         //连接条件（列 = 列，可用 AND 连接多个）
+};
+
+//SELECT列表中的聚合函数调用（如 COUNT(*)、SUM(amount)）
+struct AggregateCall {
+    string func;        //函数名（COUNT/SUM/MIN/MAX/AVG，大写）
+    string column;      //参数列名，COUNT(*) 为 "*"
+
+    //在查询列和结果中的名字（如 "SUM(amount)"）
+    string name() const { return func + "(" + column + ")"; }
+};
+
+//ORDER BY中的一个排序列
+struct OrderByItem {
+    string column;      //排序列名
+    bool ascending = true;  //ASC（默认）或 DESC
+};
+
 //CREATE TABLE语句的AST节点
 class CreateTableAST : public ASTNode {
 public:
@@ -54,21 +119,46 @@ public:
 class InsertAST : public ASTNode {
 public:
     string tableName;               //表名（如 "Students"）
-    vector<string> values;          //插入的值列表（如 ["Alice", "20"]）
+    vector<vector<string>> rows;    //插入的各行值列表（如 [["'Alice'", "20"], ["'Bob'", "21"]]）
 };
 
 //SELECT语句的AST节点
 class SelectAST : public ASTNode {
 public:
     vector<string> columns;         //查询的列（如 ["name", "age"] 或 ["*"]）
+    string tableName;               //表名（如 "Students"），有JOIN时为最左边的表
+    vector<JoinClause> joins;       //按出现顺序的JOIN子句（无JOIN时为空）
+    optional<Condition> condition;  //WHERE 条件（仅当整个WHERE是单个 "列 运算符 常量" 比较时存在）
+    ExprPtr where;                  //完整的WHERE表达式树（无WHERE时为空）
+    vector<AggregateCall> aggregates; //查询列中的聚合函数（columns 中对应位置为其 name()）
+    vector<string> groupBy;         //GROUP BY 列（无分组时为空）
+    vector<OrderByItem> orderBy;    //ORDER BY 列（按优先级排列，无排序时为空）
+    optional<size_t> limit;         //LIMIT 行数（无LIMIT时为空）
+    size_t offset = 0;              //OFFSET 跳过的行数
+};
+
+//CREATE INDEX语句的AST节点
+class CreateIndexAST : public ASTNode {
+public:
+    string indexName;               //索引名（如 "idx_age"）
     string tableName;               //表名（如 "Students"）
-    optional<Condition> condition;  //WHERE 条件（可选，用 optional 表示可能不存在）
+    vector<string> columns;         //索引列（如 ["age"]，组合索引按顺序列出）
+    bool isUnique = false;          //是否为 UNIQUE 索引
 };
 
 //DELETE语句的AST节点
 class DeleteAST : public ASTNode {
 public:
     std::string tableName;               //表名（如 "Students"）
-    std::optional<Condition> condition;  //WHERE 条件（可选，用 optional 表示可能不存在）
+    std::optional<Condition> condition;  //WHERE 条件（仅当整个WHERE是单个 "列 运算符 常量" 比较时存在）
+    ExprPtr where;                       //完整的WHERE表达式树（无WHERE时为空）
+};
+
+//COPY语句的AST节点：从CSV文件批量导入
+class CopyAST : public ASTNode {
+public:
+    string tableName;               //表名
+    string filePath;                //CSV文件路径（不含引号）
+    bool header = false;            //首行是否为列名（HEADER选项）
 };
 #endif //MINIDB_AST_H
\ No newline at end of file
@@ -23,7 +23,11 @@ private:
     size_t tokenPos;//当前Token在tokens中的位置
 
     //预测分析表：key为"非终结符|当前Token值"，value为产生式（字符串列表）
-    unordered_map<string, vector<string>> predictTable;
+    //文法固定不变，所有Parser共享一份，只在第一次构造时初始化
+    static unordered_map<string, vector<string>> predictTable;
+
+    //已解析的参数占位符 ? 个数
+    size_t parameterCount = 0;
 
     ASTNodePtr generateAST() {
         // 根据当前解析状态生成 AST
@@ -62,6 +66,9 @@ private:
     //解析CREATE TABLE语句
     unique_ptr<CreateTableAST> parseCreateTable();
 
+    //解析CREATE INDEX语句
+    unique_ptr<CreateIndexAST> parseCreateIndex();
+
     //解析列列表（如"name STRING, age INT"）
     vector<Column> parseColumnList();
     bool isNonTerminal(const string& symbol);
@@ -88,20 +95,54 @@ private:
     //解析值列表的递归部分（处理逗号分隔的后续值）
     void parseValueListPrime();
 
+    //解析COPY语句（如"COPY students FROM 'students.csv' HEADER;"）
+    unique_ptr<CopyAST> parseCopy();
+
     //解析SELECT语句
     unique_ptr<SelectAST> parseSelect();
 
     //解析DELETE语句
     unique_ptr<DeleteAST> parseDelete();
 
-    //解析查询列列表（如"name, age"或"*"）
-    vector<string> parseSelectColumns();
+    //解析查询列列表（如"name, age"、"*"或"age, COUNT(*)"），聚合函数另外记入aggregates
+    vector<string> parseSelectColumns(vector<AggregateCall>& aggregates);
+
+    //解析聚合函数调用（如"SUM(amount)"、"COUNT(*)"）
+    AggregateCall parseAggregate();
 
     //解析查询列列表的递归部分（处理逗号分隔的后续列）
     void parseSelectColumnsPrime();
 
-    //解析WHERE子句（可选，如"WHERE age > 20"）
-    optional<Condition> parseWhereClause();
+    //解析JOIN列表（可选，如"JOIN customers ON orders.customer_id = customers.id"）
+    vector<JoinClause> parseJoinList();
+
+    //解析WHERE子句（可选，如"WHERE age > 20 AND name = 'Bob'"），无WHERE时返回空
+    ExprPtr parseWhereClause();
+
+    //解析GROUP BY子句（可选，如"GROUP BY city, age"），无GROUP BY时返回空
+    vector<string> parseGroupByClause();
+
+    //解析ORDER BY子句（可选，如"ORDER BY age DESC, name"），无ORDER BY时返回空
+    vector<OrderByItem> parseOrderByClause();
+
+    //解析LIMIT子句（可选，如"LIMIT 10 OFFSET 20"），返回是否存在LIMIT
+    bool parseLimitClause(size_t& limit, size_t& offset);
+
+    //表达式解析（按优先级由低到高：OR < AND < NOT < 比较 < 加减 < 基本项）
+    ExprPtr parseExpression();
+    ExprPtr parseOrExpr();
+    ExprPtr parseAndExpr();
+    ExprPtr parseNotExpr();
+    ExprPtr parseComparison();
+    ExprPtr parseAdditive();
+    ExprPtr parsePrimary();
+
+    //当前Token是否为指定关键字/运算符
+    bool atKeyword(const string& keyword) const;
+    bool atOperator(const string& op) const;
+
+    //为当前的参数占位符分配编号，返回其在AST中的写法（"?1"、"?2"…）
+    string nextParameter();
 
     // 新增：存储匹配到的Token值
     std::string matchedValue;
@@ -115,6 +156,9 @@ public:
 
     //核心方法：执行语法分析，返回AST根节点
     unique_ptr<ASTNode> parse();
+
+    //语句中参数占位符 ? 的个数（parse之后有效）
+    size_t getParameterCount() const { return parameterCount; }
 };
 
 void printAST(ASTNode* ast);
@@ -6,18 +6,223 @@
 #define MINIDB_PLANNODE_H
 
 #include <json.hpp>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace minidb {
 
+    enum class PlanNodeType {
+        CreateTable, CreateIndex, Insert, Copy, Delete, Update,
+        SeqScan, IndexScan, Filter, Project, Limit, Sort, Aggregate, Join
+    };
+
+    // 计划节点类型名（与 JSON 计划中的 "type" 一致）
+    const char* planNodeTypeName(PlanNodeType type);
+
+    // 简单条件 "列 运算符 常量"，常量保留原始文本，执行时按列类型转换
+    struct PlanCondition {
+        std::string column;
+        std::string op;
+        std::string value;
+    };
+
+    // 表达式树（由 AST 表达式转换而来）
+    struct PlanExpr;
+    using PlanExprPtr = std::shared_ptr<const PlanExpr>;
+
+    struct PlanExpr {
+        enum class Kind { Column, Literal, Unary, Binary };
+
+        Kind kind;
+        std::string value;  // 列名 / 常量文本 / 运算符
+        std::string type;   // 常量的类型（"INT"、"BOOLEAN"、"STRING"），由语义分析确定
+        PlanExprPtr left;   // 一元运算的操作数 / 二元运算的左操作数
+        PlanExprPtr right;  // 二元运算的右操作数
+    };
 
-    //逻辑执行计划节点基类
+    //逻辑执行计划节点基类：执行引擎按 type 直接绑定到具体节点，JSON 只用于 EXPLAIN
     struct PlanNode {
+        explicit PlanNode(PlanNodeType nodeType) : type(nodeType) {}
         virtual ~PlanNode() = default;
+
+        // 转换为 JSON 形式（EXPLAIN 输出）
         virtual nlohmann::json toJson() const = 0;
+
+        const PlanNodeType type;
+    };
+
+    using PlanNodePtr = std::unique_ptr<PlanNode>;
+
+    struct CreateTablePlan : PlanNode {
+        struct ColumnDef {
+            std::string name;
+            std::string type;   // "INT" / "VARCHAR" 等，不区分大小写
+        };
+
+        CreateTablePlan() : PlanNode(PlanNodeType::CreateTable) {}
+        nlohmann::json toJson() const override;
+
+        std::string tableName;
+        std::vector<ColumnDef> columns;
     };
 
+    struct CreateIndexPlan : PlanNode {
+        CreateIndexPlan() : PlanNode(PlanNodeType::CreateIndex) {}
+        nlohmann::json toJson() const override;
+
+        std::string indexName;
+        std::string tableName;
+        std::vector<std::string> columns;
+        bool unique = false;
+    };
+
+    struct InsertPlan : PlanNode {
+        InsertPlan() : PlanNode(PlanNodeType::Insert) {}
+        nlohmann::json toJson() const override;
+
+        std::string tableName;
+        std::vector<std::vector<std::string>> rows;    // 每行按表列顺序的常量文本
+    };
+
+    // COPY：从 CSV 文件批量导入，字段按表列顺序
+    struct CopyPlan : PlanNode {
+        CopyPlan() : PlanNode(PlanNodeType::Copy) {}
+        nlohmann::json toJson() const override;
+
+        std::string tableName;
+        std::string filePath;
+        bool header = false;    // 首行为列名，导入时跳过
+    };
+
+    // DELETE：删除 input 产出的行（input 为目标表上的扫描 + 过滤）
+    struct DeletePlan : PlanNode {
+        DeletePlan() : PlanNode(PlanNodeType::Delete) {}
+        nlohmann::json toJson() const override;
+
+        std::string tableName;
+        PlanNodePtr input;
+    };
+
+    // UPDATE：把 input 产出的行中的列改为给定常量
+    struct UpdatePlan : PlanNode {
+        struct Assignment {
+            std::string column;
+            std::string value;
+        };
+
+        UpdatePlan() : PlanNode(PlanNodeType::Update) {}
+        nlohmann::json toJson() const override;
+
+        std::string tableName;
+        std::vector<Assignment> updates;
+        PlanNodePtr input;
+    };
+
+    struct SeqScanPlan : PlanNode {
+        SeqScanPlan() : PlanNode(PlanNodeType::SeqScan) {}
+        nlohmann::json toJson() const override;
+
+        std::string tableName;
+    };
+
+    // 按索引首列的条件扫描，输出按该列有序
+    // 索引扫描：索引前导列上的等值前缀，加上紧随其后一列上的可选区间
+    struct IndexScanPlan : PlanNode {
+        IndexScanPlan() : PlanNode(PlanNodeType::IndexScan) {}
+        nlohmann::json toJson() const override;
+
+        std::string tableName;
+        std::string indexName;
+        std::vector<PlanCondition> prefix;  // 按索引列顺序，第 i 项为第 i 列的 "=" 条件
+        std::vector<PlanCondition> range;   // 第 prefix.size() 列上的下界/上界（> >= < <=），至多各一个
+    };
+
+    // 过滤：简单条件（可下推到扫描）或表达式树，二者取其一
+    struct FilterPlan : PlanNode {
+        FilterPlan() : PlanNode(PlanNodeType::Filter) {}
+        nlohmann::json toJson() const override;
+
+        PlanCondition condition;
+        PlanExprPtr expr;       // 非空时使用表达式，忽略 condition
+        PlanNodePtr input;
+    };
+
+    struct ProjectPlan : PlanNode {
+        ProjectPlan() : PlanNode(PlanNodeType::Project) {}
+        nlohmann::json toJson() const override;
+
+        std::vector<std::string> columns;   // ["*"] 或为空表示全部列
+        PlanNodePtr input;
+    };
+
+    struct LimitPlan : PlanNode {
+        LimitPlan() : PlanNode(PlanNodeType::Limit) {}
+        nlohmann::json toJson() const override;
+
+        size_t limit = 0;
+        size_t offset = 0;
+        PlanNodePtr input;
+    };
+
+    struct SortPlan : PlanNode {
+        struct Key {
+            std::string column;
+            bool ascending = true;
+        };
+
+        SortPlan() : PlanNode(PlanNodeType::Sort) {}
+        nlohmann::json toJson() const override;
+
+        std::vector<Key> keys;
+        PlanNodePtr input;
+    };
+
+    struct AggregatePlan : PlanNode {
+        struct Call {
+            std::string func;       // COUNT/SUM/MIN/MAX/AVG
+            std::string column;     // 参数列名，COUNT(*) 为 "*"
+        };
+
+        AggregatePlan() : PlanNode(PlanNodeType::Aggregate) {}
+        nlohmann::json toJson() const override;
+
+        std::vector<std::string> groupBy;
+        std::vector<Call> aggregates;
+        PlanNodePtr input;
+    };
+
+    /**
+     * 连接：leftKeys[i] = rightKeys[i]，键写作 "表.列"
+     * leftTable/rightTable 非空时该侧输入为单表，输出列加上表名限定
+     * indexNestedLoop 没有 right，用 indexName 上的索引逐行查右表（indexKey 为该索引对应的连接键下标）
+     */
+    struct JoinPlan : PlanNode {
+        enum class Algorithm { Hash, Merge, IndexNestedLoop };
+
+        JoinPlan() : PlanNode(PlanNodeType::Join) {}
+        nlohmann::json toJson() const override;
+
+        Algorithm algorithm = Algorithm::Hash;
+        std::string leftTable;
+        std::string rightTable;
+        std::vector<std::string> leftKeys;
+        std::vector<std::string> rightKeys;
+        std::string indexName;
+        size_t indexKey = 0;
+        PlanNodePtr left;
+        PlanNodePtr right;
+    };
+
+    /**
+     * 由 JSON 计划构造计划树，供直接提交 JSON 计划的调用方使用
+     * 兼容旧式计划：{"type":"Select"} 视为 SeqScan（带 condition 时其上加 Filter），
+     * 单行 Insert 写作 "values"（多行为 "rows"），
+     * 没有 input 的 Delete/Update 以整表扫描（带 condition 时加 Filter）为输入
+     */
+    PlanNodePtr planFromJson(const nlohmann::json& plan);
+
 } // namespace minidb
 
 #endif // MINIDB_PLANNODE_H
@@ -0,0 +1,75 @@
+//
+// PreparedStatement.h
+// 预编译语句：SQL 只编译一次，每次执行只绑定 ? 参数的值
+//
+
+#ifndef MINIDB_PREPAREDSTATEMENT_H
+#define MINIDB_PREPAREDSTATEMENT_H
+
+#include "compiler/PlanNode.h"
+#include "common/Value.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace minidb {
+
+    class SQLCompiler;
+
+    // 计划缓存中的一项：编译好的计划（参数处仍是占位符，创建后不再修改）
+    struct CachedPlan {
+        std::string sql;                                // 规范化后的 SQL 文本（缓存键）
+        PlanNodePtr plan;
+        size_t parameterCount = 0;
+        uint64_t catalogVersion = 0;                    // 编译时的目录版本
+    };
+
+    /**
+     * 预编译语句，由 SQLCompiler::prepare 创建，参数按 ? 的出现顺序从 1 编号
+     * 相同 SQL 的语句共享缓存中的同一个计划，但各自持有一份副本并把绑定的值写入副本，
+     * 因此多个语句可以交替绑定和执行。plan() 返回的计划在本语句下一次 plan() 调用前有效，
+     * 目录变化（建表/建索引等）后自动重新编译；语句不能比创建它的 SQLCompiler 活得更久。
+     */
+    class PreparedStatement {
+    public:
+        PreparedStatement() = default;
+
+        size_t parameterCount() const { return bindings_.size(); }
+        const std::string& sql() const;
+
+        // 绑定第 index 个参数（从 1 开始）；不支持 NULL
+        PreparedStatement& bind(size_t index, const Value& value);
+        // 按顺序绑定全部参数，个数必须与 parameterCount() 一致
+        PreparedStatement& bind(const std::vector<Value>& values);
+        void clearBindings();
+
+        // 返回绑定了参数的计划，交给 ExecutionEngine 执行；有参数未绑定时抛出异常
+        const PlanNode& plan();
+
+    private:
+        friend class SQLCompiler;
+
+        PreparedStatement(SQLCompiler* compiler, std::shared_ptr<CachedPlan> cached);
+
+        SQLCompiler* compiler_ = nullptr;
+        std::shared_ptr<CachedPlan> cached_;
+        PlanNodePtr plan_;                                   // 本语句的计划副本，首次 plan() 时创建
+        std::vector<std::vector<std::string*>> slots_;       // slots_[i]：副本中第 i+1 个参数的常量文本
+        std::vector<std::optional<std::string>> bindings_;  // 已转换为常量文本的参数值
+    };
+
+    // 找出计划中所有参数占位符的位置，slots[i] 对应第 i+1 个参数；有参数不在计划中时抛出异常
+    std::vector<std::vector<std::string*>> collectParameterSlots(PlanNode& plan, size_t parameterCount);
+
+    /**
+     * 解析 EXECUTE 的参数列表（如 "1, 'Bob', true"）
+     * 带引号的为字符串，true/false 为布尔值，其余按整数解析
+     */
+    std::vector<Value> parseParameterValues(const std::string& text);
+
+} // namespace minidb
+
+#endif // MINIDB_PREPAREDSTATEMENT_H
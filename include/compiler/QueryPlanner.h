@@ -9,6 +9,7 @@
 
 
 #include "AST.h"
+#include "PlanNode.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -17,35 +18,70 @@
 
 namespace minidb {
 
+    class CatalogManager;
 
-    //执行计划生成器：将 AST 转换为逻辑执行计划（JSON 格式）
+    //执行计划生成器：将 AST 转换为逻辑执行计划（带类型的计划树）
     class QueryPlanner {
     public:
 
         //构造函数
         QueryPlanner() = default;
 
+        //带目录的构造函数：可根据已有索引为 WHERE 条件选择 IndexScan
+        explicit QueryPlanner(const CatalogManager* catalog) : catalog_(catalog) {}
+
         /**
          * 生成执行计划
          * @param ast AST 根节点
-         * @return JSON 格式的执行计划
+         * @return 计划树，由执行引擎直接执行
          */
+        PlanNodePtr buildPlan(ASTNode* ast);
+
+        //生成 JSON 格式的执行计划（EXPLAIN 输出），等价于 buildPlan(ast)->toJson()
         nlohmann::json generatePlan(ASTNode* ast);
 
     private:
+        const CatalogManager* catalog_ = nullptr;  // 为空时只生成顺序扫描计划
 
         //处理 CREATE TABLE 语句
-        nlohmann::json handleCreateTable(CreateTableAST* ast);
+        PlanNodePtr handleCreateTable(CreateTableAST* ast);
+
+        //处理 CREATE INDEX 语句
+        PlanNodePtr handleCreateIndex(CreateIndexAST* ast);
 
         //处理 INSERT 语句
-        nlohmann::json handleInsert(InsertAST* ast);
+        PlanNodePtr handleInsert(InsertAST* ast);
 
 
         //处理 SELECT 语句
-        nlohmann::json handleSelect(SelectAST* ast);
+        PlanNodePtr handleSelect(SelectAST* ast);
 
         //处理 DELETE 语句
-        nlohmann::json handleDelete(DeleteAST* ast);
+        PlanNodePtr handleDelete(DeleteAST* ast);
+
+        //处理 COPY 语句
+        PlanNodePtr handleCopy(CopyAST* ast);
+
+        //为单表的合取条件选择最长等值前缀（加下一列区间）的索引扫描，用到的条件从 conds 中移除；
+        //没有可用索引时返回空
+        PlanNodePtr chooseIndexScan(const std::string& tableName, std::vector<Condition>& conds) const;
+
+        /**
+         * 生成 WHERE 子句对应的扫描与过滤子计划
+         * 表达式按 AND 拆成合取项："列 运算符 常量" 形式的合取项生成 Filter{condition}（可下推到扫描中，
+         * useIndex 时构成索引等值前缀或区间的几项可改走 IndexScan），其余合取项生成 Filter{expr}，放在简单条件之上。
+         */
+        PlanNodePtr planWhere(const std::string& tableName, const std::optional<Condition>& condition,
+                                 const ExprPtr& where, bool useIndex) const;
+
+        /**
+         * 生成 JOIN 查询的左深连接树（不含 Project）
+         * 只引用一张表的 WHERE 合取项下推到该表的扫描；ON 中两侧列的等值比较作为连接键，
+         * 其余 ON/WHERE 合取项生成连接之上的 Filter{expr}。列名须已由语义分析改写为 "表.列"。
+         * 连接算法：单键且两侧输入都已按连接键有序（索引扫描）时用 merge，右表在某个连接键上
+         * 有索引时用 indexNestedLoop（不扫描右表），否则用 hash。
+         */
+        PlanNodePtr planJoin(SelectAST* ast) const;
     };
 
 } // namespace minidb
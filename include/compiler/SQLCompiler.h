@@ -9,18 +9,52 @@
 #include "compiler/Parser.h"
 #include "compiler/SemanticAnalyzer.h"
 #include "compiler/QueryPlanner.h"
+#include "compiler/PreparedStatement.h"
 #include "compiler/AST.h"
 #include "engine/catalog/catalog_manager.h"
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 namespace minidb
 {
     class SQLCompiler {
     public:
+        static constexpr size_t DEFAULT_PLAN_CACHE_CAPACITY = 256;
+
         explicit SQLCompiler(CatalogManager& catalog);
+        // 编译为计划树，由执行引擎直接执行（语句中不能有 ? 参数）
+        PlanNodePtr compilePlan(const std::string& sql);
+        // 编译为 JSON 计划（EXPLAIN 输出），附带 "astType"
         nlohmann::json compile(const std::string& sql);
 
+        /**
+         * 预编译 SELECT/INSERT/DELETE 语句，? 为参数占位符
+         * 计划按规范化的 SQL 文本缓存，目录版本变化后失效；缓存命中时不再做词法/语法/语义分析和计划生成
+         */
+        PreparedStatement prepare(const std::string& sql);
+
+        // 计划缓存的键：引号外的连续空白压缩为一个空格，去掉首尾空白，统一以一个分号结尾
+        static std::string normalizeSql(const std::string& sql);
+
+        size_t planCacheSize() const { return planCache.size(); }
+        void setPlanCacheCapacity(size_t capacity);
+        void clearPlanCache() { planCache.clear(); }
+        uint64_t catalogVersion() const { return catalogManager.get_version(); }
+
     private:
+        friend class PreparedStatement;
+
         CatalogManager& catalogManager;
+        // 规范化 SQL -> 编译好的计划
+        std::unordered_map<std::string, std::shared_ptr<CachedPlan>> planCache;
+        size_t planCacheCapacity = DEFAULT_PLAN_CACHE_CAPACITY;
+
+        // 词法 + 语法分析，parameterCount 返回 ? 的个数
+        ASTNodePtr parse(const std::string& sql, size_t& parameterCount);
+        // 取缓存的计划，没有或已失效时重新编译并放入缓存
+        std::shared_ptr<CachedPlan> lookupPlan(const std::string& normalizedSql);
     };
 }
 
@@ -18,6 +18,12 @@ public:
 };
 
 
+//ʽпõıJOINѯ FROMJOIN ĳ˳У
+struct TableScope {
+    std::string name;
+    const Schema* schema;
+};
+
 //࣬﷨ɵAST
 class SemanticAnalyzer {
 public:
@@ -35,6 +41,9 @@ private:
     //CREATE TABLE
     void analyzeCreateTable(CreateTableAST* ast);
 
+    //CREATE INDEX
+    void analyzeCreateIndex(CreateIndexAST* ast);
+
     //INSERT
     void analyzeInsert(InsertAST* ast);
 
@@ -44,9 +53,36 @@ private:
     //DELETE
     void analyzeDelete(DeleteAST* ast);
 
+    //COPY䣨ļִʱ飩
+    void analyzeCopy(CopyAST* ast);
+
     //WHEREʽ
     void analyzeCondition(const Condition& cond, const Schema& schema, const std::string& table_name);
 
+    //JOINѯѯСONWHEREвӵı
+    void analyzeJoinSelect(SelectAST* ast);
+
+    //ۺϺGROUP BYӾ
+    void analyzeAggregates(SelectAST* ast, const std::vector<TableScope>& tables);
+
+    //ORDER BYӾ
+    void analyzeOrderBy(SelectAST* ast, const std::vector<TableScope>& tables);
+
+    //WHEREʽҪΪ
+    void analyzeWhere(const ExprPtr& where, const std::vector<TableScope>& tables);
+
+    //ݹʽдڵͣرʽͣ"INT""STRING""BOOLEAN"
+    std::string analyzeExpression(const ExprPtr& expr, const std::vector<TableScope>& tables);
+
+    /**
+     * ã֧ "."Լֻһɼгֵ ""
+     * жɼʱдΪ "."ڼƻɰ
+     */
+    const MyColumn& resolveColumn(std::string& name, const std::vector<TableScope>& tables);
+
+    //һͽͣ޷תʱ
+    void coerceLiteral(const ExprPtr& expr, const std::string& type);
+
     //ǷϷ
     bool isValidOperator(const std::string& op);
 
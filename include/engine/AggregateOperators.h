@@ -0,0 +1,139 @@
+#ifndef MINIDB_AGGREGATE_OPERATORS_H
+#define MINIDB_AGGREGATE_OPERATORS_H
+
+#include "common/Tuple.h"
+#include "engine/Operators.h"
+#include "engine/SpillFile.h"
+#include "storage/BufferManager.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace minidb {
+
+    enum class AggregateType { COUNT, SUM, MIN, MAX, AVG };
+
+    // 聚合项：column 为 NO_COLUMN 时表示 COUNT(*)
+    struct AggregateSpec {
+        static constexpr size_t NO_COLUMN = std::numeric_limits<size_t>::max();
+
+        AggregateType type;
+        size_t column = NO_COLUMN;
+        std::string name;   // 输出列名
+    };
+
+    // 解析聚合函数名（COUNT/SUM/MIN/MAX/AVG，不区分大小写）
+    AggregateType parseAggregateType(const std::string &func);
+
+    /**
+     * 分组用的开放寻址哈希表：槽位数为 2 的幂，线性探测，槽位只保存键的哈希值和组号
+     * 分组键是单个 INTEGER/BOOLEAN 列时按 int64 直接比较（NULL 用 INT64_MIN 表示），
+     * 否则按 KeyCodec 编码后的字节串比较。组号按新建顺序从 0 连续分配。
+     */
+    class GroupHashTable {
+    public:
+        static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+        // 清空分组并按分组列类型选择键的表示方式
+        void reset(const std::vector<TypeId> &keyTypes);
+        /**
+         * 查找元组所属的分组，不存在且 insert 为 true 时新建
+         * @param hash 输出分组键的哈希值（高位可用于溢出分区）
+         * @return 组号；不存在且不允许新建时返回 NONE
+         */
+        uint32_t find(const Tuple &tuple, const std::vector<size_t> &columns, bool insert, uint64_t &hash);
+
+        size_t size() const { return groupCount_; }
+        // 槽位和分组键占用的内存估算（字节）
+        size_t memoryUsage() const;
+
+    private:
+        bool integerKeys_ = false;
+        std::vector<uint64_t> slotHashes_;
+        std::vector<uint32_t> slotGroups_;      // NONE 表示空槽
+        std::vector<int64_t> intKeys_;          // 按组号保存的整数键（integerKeys_ 时使用）
+        std::vector<std::string> encodedKeys_;  // 按组号保存的编码键（其他情况使用）
+        size_t encodedBytes_ = 0;
+        size_t groupCount_ = 0;
+        uint64_t mask_ = 0;
+        std::string scratch_;
+
+        bool keyEquals(uint32_t group, int64_t intKey) const;
+        void grow();
+    };
+
+    /**
+     * 哈希聚合：阻塞算子，按分组列分组后计算聚合项
+     * 输出列依次为分组列和聚合列；没有分组列时总是输出一行。
+     * NULL 不参与 SUM/MIN/MAX/AVG/COUNT(col)，全为 NULL 时结果为 NULL；AVG 取整数平均（向零截断）。
+     * 分组状态的估算内存超过 memoryBudget 后不再新建分组：已有分组的行继续在内存中累加，
+     * 其余行按分组键哈希的高位写入 PARTITION_COUNT 个分区，输出内存中的分组后再逐个分区聚合。
+     */
+    class AggregateOperator : public Operator {
+    public:
+        static constexpr size_t PARTITION_BITS = 4;
+        static constexpr size_t PARTITION_COUNT = size_t{1} << PARTITION_BITS;
+
+        /**
+         * @param bufferManager 溢出分区使用的缓冲池，为空时不溢出
+         */
+        AggregateOperator(OperatorPtr child, std::vector<size_t> groupColumns, std::vector<AggregateSpec> aggregates,
+                          std::shared_ptr<storage::BufferManager> bufferManager = nullptr,
+                          size_t memoryBudget = DEFAULT_OPERATOR_MEMORY_BUDGET);
+
+        // 单个聚合项的累加状态：COUNT 只用 count，SUM/AVG 用 sum 和 count，MIN/MAX 用 extreme
+        struct AggState {
+            int64_t count = 0;
+            int64_t sum = 0;
+            Value extreme;
+        };
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+        // 最近一次 open() 是否有分组写入了溢出分区
+        bool spilled() const { return spilled_; }
+
+        /**
+         * 部分聚合：与 next() 输出相同的分组，但给出分组列值和未转换的累加状态（SUM 保持 64 位），
+         * 供并行聚合合并各线程的结果
+         */
+        bool nextGroup(Tuple &keys, std::vector<AggState> &states);
+        // 清空分组，之后用 mergeGroup() 合并部分结果并用 next() 输出（不读取子算子，不溢出）
+        void beginMerge();
+        // 合并一个部分分组，keys 依次为各分组列的值
+        void mergeGroup(const Tuple &keys, const std::vector<AggState> &states);
+
+    private:
+        OperatorPtr child_;
+        std::vector<size_t> groupColumns_;
+        std::vector<AggregateSpec> aggregates_;
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        size_t memoryBudget_;
+
+        GroupHashTable table_;
+        std::vector<Value> groupKeys_;      // 每组 groupColumns_.size() 个分组列值，按组号连续存放
+        std::vector<AggState> states_;      // 每组 aggregates_.size() 个累加状态，按组号连续存放
+        size_t groupBytes_ = 0;
+        size_t cursor_ = 0;
+
+        bool spilled_ = false;
+        std::vector<std::unique_ptr<SpillFile>> partitions_;
+        size_t partition_ = 0;
+
+        void resetGroups();
+        // 把一行累加到所属分组；allowSpill 时超出预算的新分组写入溢出分区
+        void consume(const Tuple &tuple, bool allowSpill);
+        void accumulate(AggState *states, const Tuple &tuple);
+        // 取下一个待输出的分组号，内存中的分组输出完后逐个聚合溢出分区
+        bool advance(size_t &group);
+        Tuple result(size_t group) const;
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_AGGREGATE_OPERATORS_H
@@ -2,15 +2,32 @@
 
 #include "engine/catalog/catalog_manager.h"
 #include "../include/storage/BufferManager.h"
+#include "../include/storage/Pager.h"
+#include "../include/storage/TablePageDirectory.h"
+#include "engine/bPlusTree/bplus_tree_index.h"
+#include "engine/AggregateOperators.h"
+#include "engine/JoinOperators.h"
+#include "engine/SortOperators.h"
+#include "engine/Operators.h"
+#include "engine/ParallelOperators.h"
+#include "engine/ResultCursor.h"
+#include "engine/TaskScheduler.h"
+#include "engine/VectorizedOperators.h"
 #include "../include/json.hpp"
+#include "compiler/PlanNode.h"
 #include "common/QueryResult.h"
+#include "common/ResultWriter.h"
 #include "common/Value.h"
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <functional>
+#include <thread>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <set>
 
 namespace minidb {
 
@@ -18,38 +35,144 @@ namespace minidb {
     public:
         ExecutionEngine(std::shared_ptr<CatalogManager> catalog,
                         std::shared_ptr<storage::BufferManager> bufferManager)
-            : catalog_(std::move(catalog)), bufferManager_(std::move(bufferManager)) {}
+            : catalog_(std::move(catalog)), bufferManager_(std::move(bufferManager)),
+              pager_(std::make_shared<storage::Pager>(bufferManager_->getDiskManager(), bufferManager_)) {}
 
         // SQL执行接口
-        QueryResult executeCreateTable(const nlohmann::json &plan);
-        QueryResult executeInsert(const nlohmann::json &plan);
-        QueryResult executeSelect(const nlohmann::json &plan);
-
-
-        QueryResult executeProject(const nlohmann::json &plan); // 新增
-        QueryResult executeDelete(const nlohmann::json &plan);
-        QueryResult executeUpdate(const nlohmann::json &plan);
-
-        // 执行入口
+        QueryResult executeCreateTable(const CreateTablePlan &plan);
+        QueryResult executeInsert(const InsertPlan &plan);
+        /**
+         * COPY 批量导入：按块读取 CSV，逐行直接编码到表尾数据页，写满后追加新页
+         * 整个导入过程只持有当前尾页，不再逐行查找空位；结果为一列 rows（导入的行数）
+         * 出错时已导入的行保留，报错信息带 CSV 行号
+         */
+        QueryResult executeCopy(const CopyPlan &plan);
+        QueryResult executeCreateIndex(const CreateIndexPlan &plan);
+        QueryResult executeDelete(const DeletePlan &plan);
+        QueryResult executeUpdate(const UpdatePlan &plan);
+
+        /**
+         * 执行入口：按节点类型直接绑定到执行函数/算子，不经过 JSON
+         * JSON 重载供直接提交 JSON 计划的调用方使用，先由 planFromJson 转换为计划树
+         */
+        QueryResult executePlan(const PlanNode &plan);
         QueryResult executePlan(const nlohmann::json &plan);
 
+        // 计划是否为查询（产出行的计划，而不是 DDL/DML）
+        static bool isQuery(const PlanNode &plan);
+        static bool isQuery(const nlohmann::json &plan);
+        /**
+         * 为查询计划打开结果游标：调用方逐行/逐批拉取带类型的元组，行随算子产出而交付
+         * 能批量执行的计划使用批量算子，否则使用逐行算子树
+         */
+        ResultCursor openCursor(const PlanNode &plan);
+        ResultCursor openCursor(const nlohmann::json &plan);
+        /**
+         * 执行查询并把结果按 JSON/CSV 流式写入 out，边拉取边序列化，不物化结果集
+         * @return 写出的行数
+         */
+        size_t exportQuery(const PlanNode &plan, OutputBuffer &out, ResultWriter::Format format);
+        size_t exportQuery(const nlohmann::json &plan, OutputBuffer &out, ResultWriter::Format format);
+
+        // 把查询计划（SeqScan/IndexScan/Filter/Project/Limit/Sort/Aggregate/Join）组装为算子树
+        OperatorPtr buildOperator(const PlanNode &plan);
+        OperatorPtr buildOperator(const nlohmann::json &plan);
+        /**
+         * 把 [Project] -> Filter* -> SeqScan 形式的计划组装为批量算子树，扫描只解码被引用的列
+         * 计划中含有其他节点时返回 nullptr，由调用方回退到逐行算子
+         * 表足够大且并行度大于 1 时返回按 morsel 并行执行的扫描
+         */
+        VectorOperatorPtr buildVectorOperator(const PlanNode &plan);
+        VectorOperatorPtr buildVectorOperator(const nlohmann::json &plan);
+
+        // 是否优先使用批量执行（默认开启）
+        void setVectorized(bool enabled) { vectorized_ = enabled; }
+        bool isVectorized() const { return vectorized_; }
+
+        // 单个阻塞算子（哈希连接、哈希聚合、排序）可用的内存，超出时溢出到临时页
+        void setOperatorMemoryBudget(size_t bytes) { operatorMemoryBudget_ = bytes; }
+        size_t getOperatorMemoryBudget() const { return operatorMemoryBudget_; }
+
+        // 大表扫描、聚合同时使用的线程数（含调用线程，默认为硬件线程数），1 表示不并行
+        void setParallelism(size_t threads);
+        size_t getParallelism() const { return parallelism_; }
+
     private:
         std::shared_ptr<CatalogManager> catalog_;
         std::shared_ptr<storage::BufferManager> bufferManager_;
+        // 索引页通过 Pager 分配/回收
+        std::shared_ptr<storage::Pager> pager_;
+        // 已打开的索引：索引名 -> B+树（元数据由目录持有）
+        std::unordered_map<std::string, std::unique_ptr<engine::BPlusTreeIndex>> indexes_;
+        // 已打开的数据页目录：表ID -> 目录（目录首页记在 TableInfo 中）
+        std::unordered_map<uint32_t, std::unique_ptr<storage::TablePageDirectory>> directories_;
+        bool vectorized_ = true;
+        size_t operatorMemoryBudget_ = DEFAULT_OPERATOR_MEMORY_BUDGET;
+        size_t parallelism_ = std::max(1u, std::thread::hardware_concurrency());
+        // 首次并行执行时创建 parallelism_ - 1 个工作线程
+        std::unique_ptr<TaskScheduler> scheduler_;
 
         void handleError(const std::string &message) const {
             throw std::runtime_error(message);
         }
 
-        // 内部工具函数：按页扫描表
-        void scanTablePages(const TableInfo *table_info,
-                            const std::function<void(storage::Page *, RID &)> &callback);
-
-        // 内部工具函数：表空间扩展
-        PageID appendNewPageToTable(TableInfo *table_info);
-
-
-        void scanSinglePage(PageID pid, const Schema &schema, QueryResult &result);
+        // 内部工具函数：表空间扩展，在已持有的末页之后链接一个新数据页并登记到目录
+        PageID appendNewPageToTable(storage::TablePageDirectory &directory, storage::WritePageGuard &last_page);
+        // 把记录写到目录中第一个放得下的数据页，都放不下时追加新页，返回新 RID
+        RID relocateRecord(storage::TablePageDirectory &directory, const char *record, uint16_t size);
+        // 打开表已有的数据页目录，没有目录时返回 nullptr（不建立）
+        storage::TablePageDirectory *findPageDirectory(const TableInfo *table);
+        // 打开表的数据页目录，没有目录的表沿页链建立一次；只在建表和 DML 中调用
+        storage::TablePageDirectory &pageDirectory(const TableInfo *table);
+        // 读路径用：按页链顺序给出全部数据页，有目录时取自目录，否则沿页链读取
+        std::vector<PageID> tablePages(const TableInfo *table);
+        // 写入前检查唯一索引，已存在相同键时抛出异常；updating 为本批被更新记录的 RID，
+        // 它们的旧条目会在写入前删除，不算冲突（批内新键之间的冲突由调用方检查）
+        void checkUniqueIndexes(const std::vector<catalog::IndexMeta *> &indexes, const Schema &schema,
+                                const Tuple &tuple, const std::set<RID> *updating = nullptr);
+
+        // [Project] -> Filter* -> SeqScan 链拆出的扫描信息
+        struct ScanChain {
+            const TableInfo *table = nullptr;
+            std::vector<std::string> projection;                // 为空表示全部列
+            std::vector<const PlanCondition *> conditions;      // 由内向外
+        };
+        bool matchScanChain(const PlanNode &plan, ScanChain &chain) const;
+        // 扫描需要解码的表列下标，为空表示全部列
+        std::vector<size_t> scanColumns(const ScanChain &chain) const;
+        // 条件下推、列裁剪后的逐行扫描（有投影时在上面加 Project）
+        OperatorPtr buildScanOperator(const ScanChain &chain);
+        // 表值得并行扫描时返回 true，并按页链顺序给出全部数据页
+        bool parallelPages(const TableInfo *table, std::vector<PageID> &pages);
+        TaskScheduler &scheduler();
+        // 为扫描链生成按页组装批量流水线的函数（条件、投影预先解析，不引用计划树）
+        MorselPipelineFactory makeMorselFactory(const ScanChain &chain);
+
+        // 按 algorithm 组装哈希/归并/索引嵌套循环连接
+        OperatorPtr buildJoinOperator(const JoinPlan &plan);
+        // 子计划所扫描的表的数据页总数，用于选择建表侧
+        size_t estimatePages(const PlanNode &plan);
+        // limit 为上层 LIMIT 需要的行数，没有时为 NO_LIMIT
+        OperatorPtr buildSortOperator(const SortPlan &plan, OperatorPtr child, size_t limit);
+
+        // 从游标拉取全部行，按列类型写入列式结果集
+        QueryResult collectResult(ResultCursor &cursor);
+        // 把简单条件编译为谓词，字面量按输入列类型预先转换
+        FilterOperator::Predicate makePredicate(const Operator &input, const PlanCondition &condition);
+        /**
+         * 把计划中的表达式树编译为闭包
+         * 列位置、常量和运算符在编译时确定，AND/OR 短路求值，NULL 参与算术时结果为 NULL
+         */
+        TupleExpression compileExpression(const Operator &input, const PlanExpr &expr);
+        // UPDATE/DELETE 的目标行（input 子计划产出的带 RID 的完整元组）
+        std::vector<Tuple> collectTargets(const PlanNode &input);
+
+        // 索引维护工具函数
+        engine::BPlusTreeIndex &openIndex(catalog::IndexMeta *meta);
+        std::vector<Value> extractIndexKey(const catalog::IndexMeta &meta, const Schema &schema,
+                                           const Tuple &tuple) const;
+        void insertIndexEntries(const TableInfo *table_info, const Tuple &tuple);
+        void deleteIndexEntries(const TableInfo *table_info, const Tuple &tuple);
 
     };
 
@@ -0,0 +1,173 @@
+#ifndef MINIDB_JOIN_OPERATORS_H
+#define MINIDB_JOIN_OPERATORS_H
+
+#include "common/Tuple.h"
+#include "engine/Operators.h"
+#include "engine/SpillFile.h"
+#include "storage/BufferManager.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace minidb {
+
+    // 按键列计算哈希值，任一键为 NULL 时返回 false（NULL 不与任何值相等）
+    bool hashKeys(const Tuple &tuple, const std::vector<size_t> &keys, uint64_t &hash);
+
+    /**
+     * 连接用的开放寻址哈希表：槽位数为 2 的幂，线性探测
+     * 每个槽位只保存键的哈希值和链头行号，同一哈希值的行通过 next_ 数组串成链，
+     * 不为每个键单独分配节点；链内按建表时的行顺序排列。
+     */
+    class JoinHashTable {
+    public:
+        static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+        // 用给定的行建表，键含 NULL 的行不入表
+        void build(std::vector<Tuple> rows, std::vector<size_t> keys);
+        // 与 probe 的键相等的第一行 / 下一行，没有时返回 NONE
+        uint32_t findFirst(const Tuple &probe, const std::vector<size_t> &probeKeys, uint64_t hash) const;
+        uint32_t findNext(uint32_t row, const Tuple &probe, const std::vector<size_t> &probeKeys) const;
+
+        const Tuple &row(uint32_t index) const { return rows_[index]; }
+        bool empty() const { return rows_.empty(); }
+        void clear();
+
+    private:
+        std::vector<Tuple> rows_;
+        std::vector<size_t> keys_;
+        std::vector<uint64_t> slotHashes_;
+        std::vector<uint32_t> slotHeads_;   // NONE 表示空槽
+        std::vector<uint32_t> next_;
+        uint64_t mask_ = 0;
+
+        bool keysEqual(uint32_t row, const Tuple &probe, const std::vector<size_t> &probeKeys) const;
+    };
+
+    /**
+     * 哈希等值连接（内连接）：用一侧输入（应为较小的一侧）建哈希表，另一侧逐条探测
+     * 建表侧的估算内存超过 memoryBudget 时改为 grace 分区连接：两侧按键哈希的高位分成
+     * PARTITION_COUNT 个分区写入临时页，再逐个分区建表、探测，同一时刻只有一个分区在内存中。
+     * 输出列依次为左输入的列和右输入的列，与建表侧无关。
+     */
+    class HashJoinOperator : public Operator {
+    public:
+        static constexpr size_t PARTITION_BITS = 4;
+        static constexpr size_t PARTITION_COUNT = size_t{1} << PARTITION_BITS;
+
+        /**
+         * @param leftKeys/rightKeys 两侧连接键的列位置，按位置一一对应
+         * @param buildLeft 为 true 时用左输入建表
+         * @param leftQualifier/rightQualifier 非空时该侧输出列名加上 "表." 前缀
+         */
+        HashJoinOperator(OperatorPtr left, OperatorPtr right, std::vector<size_t> leftKeys,
+                         std::vector<size_t> rightKeys, bool buildLeft,
+                         std::shared_ptr<storage::BufferManager> bufferManager,
+                         size_t memoryBudget = DEFAULT_OPERATOR_MEMORY_BUDGET,
+                         const std::string &leftQualifier = "", const std::string &rightQualifier = "");
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+        // 最近一次 open() 是否改走了分区溢出
+        bool spilled() const { return spilled_; }
+
+    private:
+        OperatorPtr build_;
+        OperatorPtr probe_;
+        std::vector<size_t> buildKeys_;
+        std::vector<size_t> probeKeys_;
+        bool buildLeft_;
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        size_t memoryBudget_;
+
+        JoinHashTable table_;
+        Tuple probeTuple_;
+        uint32_t match_ = JoinHashTable::NONE;
+
+        bool spilled_ = false;
+        std::vector<std::unique_ptr<SpillFile>> buildPartitions_;
+        std::vector<std::unique_ptr<SpillFile>> probePartitions_;
+        size_t partition_ = 0;
+
+        // 取下一条探测元组（溢出时按分区顺序读临时页）
+        bool nextProbe();
+        // 把第 p 个建表分区读入内存建表
+        void loadPartition(size_t p);
+        void spill(std::vector<Tuple> &buffered);
+    };
+
+    /**
+     * 归并连接（内连接）：两侧输入须已按连接键升序（如索引扫描的输出），各自只顺序读一遍
+     * 右侧键相同的一组行缓存在内存中，与左侧键相同的每一行依次组合；输入乱序时抛出异常。
+     */
+    class MergeJoinOperator : public Operator {
+    public:
+        MergeJoinOperator(OperatorPtr left, OperatorPtr right, std::vector<size_t> leftKeys,
+                          std::vector<size_t> rightKeys, const std::string &leftQualifier = "",
+                          const std::string &rightQualifier = "");
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+    private:
+        OperatorPtr left_;
+        OperatorPtr right_;
+        std::vector<size_t> leftKeys_;
+        std::vector<size_t> rightKeys_;
+
+        Tuple leftRow_;
+        Tuple rightRow_;
+        bool hasLeft_ = false;
+        bool hasRight_ = false;
+        std::vector<Tuple> group_;      // 右侧当前键相同的一组行
+        size_t groupPos_ = 0;
+        bool inGroup_ = false;
+
+        // 读取下一条键不为 NULL 的行，并检查键是否有序
+        bool advance(Operator &input, const std::vector<size_t> &keys, Tuple &row);
+    };
+
+    /**
+     * 索引嵌套循环连接（内连接）：逐条读取外侧（左）输入，用连接键查内表（右）的 B+ 树索引，
+     * 按 RID 回表读取匹配行，内表不做全表扫描，适合外侧行少、连接选择性高的查询
+     */
+    class IndexNestedLoopJoinOperator : public Operator {
+    public:
+        /**
+         * @param indexKey 索引列对应第几个连接键；其余连接键在回表后比较
+         */
+        IndexNestedLoopJoinOperator(OperatorPtr outer, std::shared_ptr<storage::BufferManager> bufferManager,
+                                    const TableInfo *inner, const engine::BPlusTreeIndex *index,
+                                    std::vector<size_t> outerKeys, std::vector<size_t> innerKeys, size_t indexKey,
+                                    const std::string &outerQualifier = "", const std::string &innerQualifier = "");
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+    private:
+        OperatorPtr outer_;
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        const TableInfo *inner_;
+        const engine::BPlusTreeIndex *index_;
+        std::vector<size_t> outerKeys_;
+        std::vector<size_t> innerKeys_;
+        size_t indexKey_;
+
+        Tuple outerRow_;
+        std::vector<RID> matches_;      // 当前外侧行在索引中命中的 RID
+        size_t matchPos_ = 0;
+
+        // 用当前外侧行的键查索引
+        void probe();
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_JOIN_OPERATORS_H
@@ -5,10 +5,197 @@
 #ifndef MINIDB_OPERATORS_H
 #define MINIDB_OPERATORS_H
 
+#include "common/Tuple.h"
+#include "common/Value.h"
+#include "engine/catalog/table_info.h"
+#include "engine/bPlusTree/bplus_tree_index.h"
+#include "storage/BufferManager.h"
+#include "storage/PageGuard.h"
 
-class Operators
-{
-};
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
+namespace minidb {
 
-#endif //MINIDB_OPERATORS_H
\ No newline at end of file
+    /**
+     * 火山模型（Volcano）算子基类
+     * 调用顺序：open() → 反复 next() 直到返回 false → close()
+     * 每次 next() 只产出一条元组，上层按需拉取，非阻塞算子之间不做整表物化。
+     */
+    class Operator {
+    public:
+        virtual ~Operator() = default;
+
+        virtual void open() = 0;
+        // 取下一条元组，没有更多元组时返回 false
+        virtual bool next(Tuple &tuple) = 0;
+        virtual void close() = 0;
+
+        // 输出列的名称和类型（与 next() 产出的元组按位置对应）
+        const std::vector<std::string> &getColumnNames() const { return columnNames_; }
+        const std::vector<TypeId> &getColumnTypes() const { return columnTypes_; }
+        // 按列名查找输出列位置（未限定的列名可匹配唯一的 "表.列"），不存在或有歧义时抛出异常
+        size_t getColumnIndex(const std::string &name) const;
+
+    protected:
+        std::vector<std::string> columnNames_;
+        std::vector<TypeId> columnTypes_;
+    };
+
+    using OperatorPtr = std::unique_ptr<Operator>;
+
+    // 阻塞算子（哈希连接、哈希聚合、排序）默认可用的内存，超出后溢出到临时页
+    constexpr size_t DEFAULT_OPERATOR_MEMORY_BUDGET = 4 * 1024 * 1024;
+
+    // 比较运算符：构建算子时从字符串解析一次，逐行求值时不再比较字符串
+    enum class CompareOp { EQ, NE, LT, LE, GT, GE };
+
+    /**
+     * 编译后的记录谓词：直接在定长记录字节上比较一列与常量
+     * 列偏移、类型和常量在编译时固定，求值时不构造 Value，也不做运算符分派。
+     */
+    using RecordPredicate = std::function<bool(const char *record)>;
+
+    /**
+     * 顺序扫描：沿表的页链逐页遍历，只 pin 当前页
+     * 下推的条件在页内记录上直接求值，不满足的记录不解码；通过的记录只解码 columns 指定的列。
+     */
+    class SeqScanOperator : public Operator {
+    public:
+        /**
+         * @param columns 需要输出的表列下标（按输出顺序），为空表示全部列
+         * @param predicates 下推的条件（AND 关系）
+         */
+        SeqScanOperator(std::shared_ptr<storage::BufferManager> bufferManager, const TableInfo *tableInfo,
+                        std::vector<size_t> columns = {}, std::vector<RecordPredicate> predicates = {});
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+    private:
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        const TableInfo *tableInfo_;
+        std::vector<size_t> columns_;       // 输出的表列下标，为空表示全部列（走整行解码）
+        std::vector<RecordPredicate> predicates_;
+        storage::ReadPageGuard page_;
+        PageID pageId_ = INVALID_PAGE_ID;
+        uint16_t slot_ = 0;
+    };
+
+    // 索引扫描：前导列等值前缀加下一列区间，按 RID 回表读取记录
+    class IndexScanOperator : public Operator {
+    public:
+        /**
+         * @param prefix 前导列的等值键（已转换为列类型）
+         * @param lower/upper prefix 之后下一列的区间端点，无界表示不限
+         */
+        IndexScanOperator(std::shared_ptr<storage::BufferManager> bufferManager, const TableInfo *tableInfo,
+                          const engine::BPlusTreeIndex *index, std::vector<Value> prefix,
+                          engine::KeyBound lower, engine::KeyBound upper);
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+    private:
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        const TableInfo *tableInfo_;
+        const engine::BPlusTreeIndex *index_;
+        std::vector<Value> prefix_;
+        engine::KeyBound lower_;
+        engine::KeyBound upper_;
+        engine::IndexIterator iterator_;
+    };
+
+    // 过滤：只向上传递满足谓词的元组
+    class FilterOperator : public Operator {
+    public:
+        using Predicate = std::function<bool(const Tuple &)>;
+
+        FilterOperator(OperatorPtr child, Predicate predicate);
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+    private:
+        OperatorPtr child_;
+        Predicate predicate_;
+    };
+
+    // 逐元组求值的表达式（WHERE 中布尔/算术表达式的编译结果）
+    using TupleExpression = std::function<Value(const Tuple &)>;
+
+    // 投影：按列名选取输出列（输出列名与请求的列名一致），"*" 表示全部列
+    class ProjectOperator : public Operator {
+    public:
+        ProjectOperator(OperatorPtr child, const std::vector<std::string> &columns);
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+    private:
+        OperatorPtr child_;
+        std::vector<size_t> positions_;
+    };
+
+    /**
+     * 限制：跳过 offset 条后最多输出 limit 条
+     * 达到上限（或子算子耗尽）时立即关闭子算子，不再拉取，扫描 pin 住的页随之释放；LIMIT 0 不打开子算子。
+     */
+    class LimitOperator : public Operator {
+    public:
+        LimitOperator(OperatorPtr child, size_t limit, size_t offset = 0);
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+    private:
+        OperatorPtr child_;
+        size_t limit_;
+        size_t offset_;
+        size_t skipped_ = 0;
+        size_t produced_ = 0;
+        bool childOpen_ = false;
+
+        void closeChild();
+    };
+
+    // ==== 记录/字面量工具函数 ====
+
+    // 按列的偏移量从定长记录中解码一列（整表读写用 TableInfo::get_codec()）
+    Value decodeColumn(const char *record, const MyColumn &column);
+    // 解析比较运算符（兼容早期计划中的 EQUALS/LESS_THAN 等名称）
+    CompareOp parseCompareOp(const std::string &op);
+    // 把 field op literal 编译为记录谓词，literal 须已转换为列类型
+    RecordPredicate compilePredicate(const RowCodec::Field &field, CompareOp op, const Value &literal);
+    RecordPredicate compilePredicate(const MyColumn &column, CompareOp op, const Value &literal);
+    // 把 SQL 字面量（可能带引号）转换为指定类型的值
+    Value parseLiteral(const std::string &text, TypeId type);
+    // 按运算符比较两个同类型的值，NULL 参与比较时结果为 false
+    bool compareValues(const Value &lhs, CompareOp op, const Value &rhs);
+    bool compareValues(const Value &lhs, const std::string &op, const Value &rhs);
+    // 条件结果是否为真（NULL 视为不满足）
+    inline bool isTrue(const Value &value) { return !value.isNull() && value.getAsBool(); }
+    // 结果集中的显示形式（字符串不带引号）
+    std::string valueToString(const Value &value);
+    // 64 位整数混合（MurmurHash3 fmix64），让低位用于定位哈希槽位、高位用于溢出分区
+    inline uint64_t mixHash(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+} // namespace minidb
+
+#endif //MINIDB_OPERATORS_H
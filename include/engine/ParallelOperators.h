@@ -0,0 +1,158 @@
+#ifndef MINIDB_PARALLEL_OPERATORS_H
+#define MINIDB_PARALLEL_OPERATORS_H
+
+#include "engine/AggregateOperators.h"
+#include "engine/Operators.h"
+#include "engine/TaskScheduler.h"
+#include "engine/VectorizedOperators.h"
+#include "storage/BufferManager.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace minidb {
+
+    // 每个 morsel 包含的数据页数
+    constexpr size_t MORSEL_PAGES = 32;
+    // 表的数据页少于此数时不值得并行，仍走串行扫描
+    constexpr size_t PARALLEL_SCAN_MIN_PAGES = 2 * MORSEL_PAGES;
+
+    // 为一组数据页组装扫描流水线（扫描 + 下推的过滤 + 投影），各工作线程分别调用
+    using MorselPipelineFactory = std::function<VectorOperatorPtr(std::vector<PageID> pages)>;
+
+    // 按 MORSEL_PAGES 切分好的页范围，工作线程用原子下标逐个领取
+    class MorselQueue {
+    public:
+        MorselQueue(const std::vector<PageID> &pages, size_t morselPages);
+
+        size_t size() const { return morsels_.size(); }
+        // 领取下一个 morsel，全部领完时返回 false
+        bool pop(size_t &index);
+        const std::vector<PageID> &morsel(size_t index) const { return morsels_[index]; }
+
+    private:
+        std::vector<std::vector<PageID>> morsels_;
+        std::atomic<size_t> next_{0};
+    };
+
+    /**
+     * 并行批量扫描：把表的数据页切成 morsel，提交给工作线程在线程内执行扫描、过滤和投影
+     * 结果批次按 morsel 顺序边完成边输出，行序与串行扫描相同；
+     * 已提交但未输出的 morsel 最多 2 * workers 个，输出一个才提交下一个，内存占用与表大小无关。
+     * 等待的 morsel 还没有工作线程领取时，由调用 nextBatch() 的线程自己执行。
+     */
+    class ParallelScanOperator : public VectorOperator {
+    public:
+        /**
+         * @param pages 表的全部数据页（按页链顺序）
+         * @param workers 同时执行的工作任务数
+         */
+        ParallelScanOperator(TaskScheduler &scheduler, size_t workers, std::vector<PageID> pages,
+                             MorselPipelineFactory factory, size_t morselPages = MORSEL_PAGES);
+        ~ParallelScanOperator() override;
+
+        void open() override;
+        bool nextBatch(DataChunk &chunk) override;
+        // 取消尚未开始的 morsel，并等待已提交的任务全部结束
+        void close() override;
+
+    private:
+        enum class MorselState { Pending, Running, Ready };
+
+        TaskScheduler &scheduler_;
+        size_t workers_;
+        size_t window_;
+        std::vector<PageID> pages_;
+        MorselPipelineFactory factory_;
+        size_t morselPages_;
+
+        std::unique_ptr<MorselQueue> queue_;
+        // 以下状态由 mutex_ 保护，工作任务与输出线程共享
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::vector<MorselState> states_;
+        std::vector<std::vector<DataChunk>> results_;   // 每个 morsel 产出的批次，输出后即释放
+        std::exception_ptr error_;
+        size_t outstanding_ = 0;                        // 已提交未结束的任务数
+        bool cancelled_ = false;
+
+        size_t submitted_ = 0;                          // 下一个要提交的 morsel
+        size_t morsel_ = 0;                             // 正在输出的 morsel
+        size_t batch_ = 0;
+
+        // 把窗口内尚未提交的 morsel 提交给调度器
+        void fillWindow();
+        // 执行一个 morsel（已被其他线程领取或已取消时直接返回）
+        void runMorsel(size_t index);
+    };
+
+    /**
+     * 并行哈希聚合：每个工作任务领取 morsel，在线程内扫描、过滤后用自己的 AggregateOperator 做部分聚合，
+     * 最后把各线程的部分结果按分组键再聚合一次。
+     * 部分结果以未转换的累加状态合并（SUM、AVG 的和保持 64 位），合并完才转换为输出值；
+     * 输出列与 AggregateOperator 相同，有分组时输出顺序不保证与串行一致。
+     * 每个部分聚合的内存预算为 memoryBudget / workers，超出时各自溢出到临时页；
+     * 各线程缓存的部分结果按分组键哈希分成 PARTITION_COUNT 个分区，同样超出预算时写入临时页，
+     * 此时逐个分区合并输出（分区内不再溢出），与串行聚合溢出后的处理一致。
+     */
+    class ParallelAggregateOperator : public Operator {
+    public:
+        /**
+         * @param groupColumns、aggregates 中的列下标对应流水线的输出列
+         */
+        ParallelAggregateOperator(TaskScheduler &scheduler, size_t workers, std::vector<PageID> pages,
+                                  MorselPipelineFactory factory, std::vector<size_t> groupColumns,
+                                  std::vector<AggregateSpec> aggregates,
+                                  std::shared_ptr<storage::BufferManager> bufferManager = nullptr,
+                                  size_t memoryBudget = DEFAULT_OPERATOR_MEMORY_BUDGET,
+                                  size_t morselPages = MORSEL_PAGES);
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+        // 最近一次 open() 是否有部分聚合或部分结果写入了临时页
+        bool spilled() const { return spilled_; }
+
+    private:
+        static constexpr size_t PARTITION_COUNT = AggregateOperator::PARTITION_COUNT;
+
+        // 一个工作任务的部分结果：编码后的分组记录按分区存放，溢出后改写到各分区的临时页
+        struct PartialBuffer {
+            std::vector<std::vector<std::string>> memory;
+            std::vector<std::unique_ptr<SpillFile>> files;     // 为空表示未溢出
+            size_t bytes = 0;
+        };
+
+        TaskScheduler &scheduler_;
+        size_t workers_;
+        std::vector<PageID> pages_;
+        MorselPipelineFactory factory_;
+        std::vector<size_t> groupColumns_;
+        std::vector<AggregateSpec> aggregates_;
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        size_t memoryBudget_;
+        size_t morselPages_;
+
+        std::vector<std::string> inputNames_;
+        std::vector<TypeId> inputTypes_;
+        std::vector<PartialBuffer> partials_;
+        bool spilled_ = false;
+        size_t partition_ = 0;                          // 下一个待合并的分区
+        std::unique_ptr<AggregateOperator> final_;     // 合并部分结果的聚合
+
+        // 把一个部分分组放入所属分区，超出 budget 时把该任务的缓存全部写入临时页
+        void addPartial(PartialBuffer &buffer, const Tuple &keys,
+                        const std::vector<AggregateOperator::AggState> &states, size_t budget);
+        // 把下一个分区（未溢出时为全部分区）的部分结果合并到 final_，没有剩余分区时返回 false
+        bool mergeNext();
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_PARALLEL_OPERATORS_H
@@ -0,0 +1,70 @@
+#ifndef MINIDB_RESULT_CURSOR_H
+#define MINIDB_RESULT_CURSOR_H
+
+#include "common/QueryResult.h"
+#include "common/Tuple.h"
+#include "engine/Operators.h"
+#include "engine/VectorizedOperators.h"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace minidb {
+
+    /**
+     * 查询结果游标：持有已打开的算子树，调用方按需拉取行，算子每产出一行就能交付一行
+     * 行以带类型的 Tuple 返回，不转换为字符串；游标只缓存当前批次（批量执行时为一个 DataChunk），
+     * 内存占用与结果集大小无关。读完最后一行或调用 close() 时立即关闭算子树、释放其 pin 住的页。
+     */
+    class ResultCursor {
+    public:
+        // 打开逐行算子树
+        explicit ResultCursor(OperatorPtr root);
+        // 打开批量算子树
+        explicit ResultCursor(VectorOperatorPtr root);
+        ~ResultCursor();
+
+        ResultCursor(ResultCursor &&other) noexcept;
+        ResultCursor &operator=(ResultCursor &&other) noexcept;
+        ResultCursor(const ResultCursor &) = delete;
+        ResultCursor &operator=(const ResultCursor &) = delete;
+
+        const std::vector<std::string> &getColumnNames() const { return columnNames_; }
+        const std::vector<TypeId> &getColumnTypes() const { return columnTypes_; }
+
+        // 取下一行，没有更多行时返回 false（并关闭算子树）
+        bool next(Tuple &tuple);
+        /**
+         * 取至多 maxRows 行追加到 rows（不清空 rows 原有内容）
+         * @return 本次取到的行数，为 0 表示已读完
+         */
+        size_t nextBatch(std::vector<Tuple> &rows, size_t maxRows);
+        /**
+         * 取至多 maxRows 行直接追加到列式结果（result 的列须与游标一致）
+         * 批量执行时从列向量逐列拷贝，不经过 Tuple/Value
+         * @return 本次取到的行数，为 0 表示已读完
+         */
+        size_t fetchInto(QueryResult &result, size_t maxRows = std::numeric_limits<size_t>::max());
+        // 提前结束：关闭算子树，之后 next() 总是返回 false
+        void close();
+
+        bool isOpen() const { return open_; }
+        // 已交付的行数
+        size_t rowsProduced() const { return produced_; }
+
+    private:
+        OperatorPtr root_;
+        VectorOperatorPtr vectorRoot_;
+        std::vector<std::string> columnNames_;
+        std::vector<TypeId> columnTypes_;
+        bool open_ = false;
+        size_t produced_ = 0;
+
+        DataChunk chunk_;
+        size_t chunkPos_ = 0;   // chunk_ 中下一个待交付的有效行
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_RESULT_CURSOR_H
@@ -0,0 +1,86 @@
+#ifndef MINIDB_ROWCODEC_H
+#define MINIDB_ROWCODEC_H
+
+#include "common/Tuple.h"
+#include "common/Value.h"
+#include "engine/catalog/schema.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace minidb {
+
+    /**
+     * 定长记录的行编解码器，每个 Schema 编译一次（TableInfo 持有）
+     * 各列的偏移、宽度、类型在构造时放进连续的 Field 数组，偏移以 MyColumn::offset 为准；
+     * 每列的解码/编码例程在构造时按类型选定（模板实例化），逐列解码只是一次间接调用，不再按类型 switch。
+     * 全部为 INTEGER 列的表使用整行解码例程，连续读出各列。
+     */
+    class RowCodec {
+    public:
+        struct Field {
+            uint32_t offset = 0;
+            uint32_t width = 0;
+            TypeId type = TypeId::INVALID;
+            Value (*decode)(const char *record, const Field &field) = nullptr;
+            // NULL 写为零值（定长记录没有 NULL 位图）
+            void (*encode)(char *record, const Field &field, const Value &value) = nullptr;
+        };
+
+        explicit RowCodec(const Schema &schema);
+
+        // 单独一列的字段描述（供只有 MyColumn 的调用方使用）
+        static Field fieldOf(const MyColumn &column);
+
+        size_t columnCount() const { return fields_.size(); }
+        uint32_t rowSize() const { return rowSize_; }
+        const Field &field(size_t column) const { return fields_[column]; }
+
+        // 按已知类型直接读写一列，不检查类型
+        int32_t readInt(const char *record, size_t column) const {
+            int32_t v;
+            std::memcpy(&v, record + fields_[column].offset, sizeof(int32_t));
+            return v;
+        }
+        bool readBool(const char *record, size_t column) const { return record[fields_[column].offset] != 0; }
+        // 定长存储，去掉填充的 '\0'
+        std::string_view readString(const char *record, size_t column) const {
+            const Field &f = fields_[column];
+            return std::string_view(record + f.offset, strnlen(record + f.offset, f.width));
+        }
+        void writeInt(char *record, size_t column, int32_t value) const {
+            std::memcpy(record + fields_[column].offset, &value, sizeof(int32_t));
+        }
+        void writeBool(char *record, size_t column, bool value) const {
+            std::memcpy(record + fields_[column].offset, &value, sizeof(bool));
+        }
+        // 超长截断，不足补 '\0'
+        void writeString(char *record, size_t column, std::string_view value) const;
+
+        Value decodeValue(const char *record, size_t column) const {
+            const Field &f = fields_[column];
+            return f.decode(record, f);
+        }
+        void encodeValue(char *record, size_t column, const Value &value) const {
+            const Field &f = fields_[column];
+            f.encode(record, f, value);
+        }
+
+        // 解码整条记录
+        Tuple decode(const char *record, const RID &rid = RID{}) const;
+        // 只解码 columns 中的列，按给定顺序
+        Tuple decode(const char *record, const std::vector<size_t> &columns, const RID &rid) const;
+        // 按列顺序编码 values，record 须有 rowSize() 字节
+        void encode(const std::vector<Value> &values, char *record) const;
+
+    private:
+        std::vector<Field> fields_;
+        uint32_t rowSize_ = 0;
+        bool allIntegers_ = false;
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_ROWCODEC_H
@@ -0,0 +1,99 @@
+#ifndef MINIDB_SORT_OPERATORS_H
+#define MINIDB_SORT_OPERATORS_H
+
+#include "common/Tuple.h"
+#include "engine/Operators.h"
+#include "engine/SpillFile.h"
+#include "storage/BufferManager.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace minidb {
+
+    // 排序键：输出列位置 + 升降序
+    struct SortKey {
+        size_t column;
+        bool ascending = true;
+    };
+
+    /**
+     * 外部归并排序：阻塞算子
+     * 每行编码为 "可比较字节串键 + 序列化元组" 追加到内存区，键按 KeyCodec 编码（降序列逐字节取反）
+     * 并以输入序号结尾，排序时只做 memcmp，相同键保持输入顺序。内存区超过 memoryBudget 时
+     * 排好序作为一个有序段写入临时页，最后用败者树对所有有序段做 k 路归并。
+     * 升序时 NULL 排在最前、降序时排在最后。
+     * 给定 limit（ORDER BY ... LIMIT）时只用大小为 limit 的堆保留前 limit 行，不做全排序。
+     */
+    class SortOperator : public Operator {
+    public:
+        static constexpr size_t NO_LIMIT = std::numeric_limits<size_t>::max();
+
+        /**
+         * @param bufferManager 溢出有序段使用的缓冲池，为空时全部在内存中排序
+         * @param limit 只需要输出的前 limit 行（含 OFFSET 跳过的行）
+         */
+        SortOperator(OperatorPtr child, std::vector<SortKey> keys,
+                     std::shared_ptr<storage::BufferManager> bufferManager = nullptr,
+                     size_t memoryBudget = DEFAULT_OPERATOR_MEMORY_BUDGET, size_t limit = NO_LIMIT);
+
+        void open() override;
+        bool next(Tuple &tuple) override;
+        void close() override;
+
+        // 最近一次 open() 写入临时页的有序段数（0 表示全部在内存中排序）
+        size_t runCount() const { return runs_.size(); }
+        // 最近一次 open() 是否只用堆求了前 limit 行
+        bool usedTopN() const { return topN_; }
+
+    private:
+        // 内存区中一条记录的位置；prefix 是键的前 8 字节（大端），多数比较只看它
+        struct SortEntry {
+            uint64_t prefix;
+            uint32_t offset;
+            uint32_t keyLength;
+            uint32_t length;
+        };
+
+        OperatorPtr child_;
+        std::vector<SortKey> keys_;
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        size_t memoryBudget_;
+        size_t limit_;
+
+        std::string arena_;
+        std::vector<SortEntry> entries_;
+        std::vector<std::string> heap_;     // top-N 的候选记录，堆顶为当前最大的键
+        size_t heapBytes_ = 0;
+        bool topN_ = false;
+        uint64_t sequence_ = 0;
+        std::string record_;
+
+        std::vector<std::unique_ptr<SpillFile>> runs_;
+        std::vector<std::string_view> heads_;   // 每个有序段的当前记录
+        std::vector<bool> exhausted_;
+        std::vector<size_t> tree_;              // tree_[0] 为胜者，其余为各内部结点的败者
+        size_t cursor_ = 0;
+        size_t produced_ = 0;
+
+        // 编码一行：2 字节键长 + 键 + 序列化元组
+        void encodeRecord(const Tuple &tuple, std::string &out);
+        void addEntry(std::string_view record);
+        void sortEntries();
+        void spillRun();
+        void pushTopN();
+
+        // 败者树：叶子 i 对应有序段 i，已读完的段视为无穷大
+        size_t buildTree(size_t node);
+        void replay(size_t run);
+        bool runLess(size_t a, size_t b) const;
+        void advanceRun(size_t run);
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_SORT_OPERATORS_H
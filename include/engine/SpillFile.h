@@ -0,0 +1,69 @@
+#ifndef MINIDB_SPILL_FILE_H
+#define MINIDB_SPILL_FILE_H
+
+#include "common/Tuple.h"
+#include "storage/BufferManager.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace minidb {
+
+    /**
+     * 元组序列化格式（临时页和排序内存区共用）：每个值依次为 1 字节类型 + 值
+     * INTEGER 4 字节，BOOLEAN 1 字节，VARCHAR 为 2 字节长度 + 内容，NULL 没有值部分
+     */
+    void serializeTuple(const Tuple &tuple, std::string &out);
+    Tuple deserializeTuple(const char *data, size_t size);
+
+    /**
+     * 临时溢出文件：阻塞算子内存不足时，把元组顺序写入数据库文件中的临时页，之后按写入顺序读回
+     * 写入时先在内存中凑满一页再落盘，读取时一次只 pin 一页，不会长期占用缓冲池；
+     * 对象析构时归还全部临时页。
+     */
+    class SpillFile {
+    public:
+        explicit SpillFile(std::shared_ptr<storage::BufferManager> bufferManager);
+        ~SpillFile();
+
+        SpillFile(const SpillFile &) = delete;
+        SpillFile &operator=(const SpillFile &) = delete;
+
+        // 追加一条元组（只保存值，不保存 RID）
+        void append(const Tuple &tuple);
+        // 追加一条任意格式的记录（须能放入一页）
+        void appendRecord(std::string_view record);
+        // 把尚未落盘的记录写入临时页，并把读取位置重置到开头
+        void rewind();
+        // 按写入顺序读取下一条元组，读完时返回 false
+        bool next(Tuple &tuple);
+        // 按写入顺序读取下一条记录，返回的视图在下一次读取前有效
+        bool nextRecord(std::string_view &record);
+
+        size_t size() const { return recordCount_; }
+        size_t pageCount() const { return pages_.size(); }
+
+    private:
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        std::vector<PageID> pages_;
+
+        // 写缓冲：尚未落盘的记录（依次拼接）及各自长度
+        std::string staged_;
+        std::vector<uint16_t> stagedSizes_;
+        size_t recordCount_ = 0;
+
+        // 读取状态：当前页全部记录的拷贝及各自长度
+        size_t readPage_ = 0;
+        std::string readBuffer_;
+        std::vector<uint16_t> readSizes_;
+        size_t readPos_ = 0;
+        size_t readOffset_ = 0;
+
+        void flush();
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_SPILL_FILE_H
@@ -0,0 +1,59 @@
+#ifndef MINIDB_TASK_SCHEDULER_H
+#define MINIDB_TASK_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace minidb {
+
+    /**
+     * 工作窃取线程池：每个工作线程有自己的任务队列，从队尾取自己的任务，
+     * 自己的队列为空时从其他线程的队头窃取。
+     * run() 提交一批任务后，调用线程也参与执行，直到这一批全部完成，因此可以嵌套调用，线程数为 0 时退化为串行。
+     */
+    class TaskScheduler {
+    public:
+        using Task = std::function<void()>;
+
+        explicit TaskScheduler(size_t workers);
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler &) = delete;
+        TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+        size_t workerCount() const { return threads_.size(); }
+
+        // 执行一批任务并等待全部完成；任务抛出的第一个异常在这里重新抛出（其余任务仍会执行完）
+        void run(std::vector<Task> tasks);
+        // 提交单个任务后立即返回，不等待完成；任务需自行处理异常。没有工作线程时在调用线程直接执行
+        void submit(Task task);
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::atomic<size_t> queued_{0};
+        std::atomic<size_t> nextQueue_{0};
+        bool stop_ = false;
+
+        // 先取 self 队列的队尾，再依次窃取其他队列的队头；self 超出范围（调用线程）时只窃取
+        bool pop(size_t self, Task &task);
+        void workerLoop(size_t self);
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_TASK_SCHEDULER_H
@@ -0,0 +1,134 @@
+#ifndef MINIDB_VECTORIZED_OPERATORS_H
+#define MINIDB_VECTORIZED_OPERATORS_H
+
+#include "common/Value.h"
+#include "engine/Operators.h"
+#include "engine/catalog/table_info.h"
+#include "storage/BufferManager.h"
+#include "storage/PageGuard.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace minidb {
+
+    // 每批最多处理的行数
+    constexpr size_t VECTOR_SIZE = 1024;
+
+    /**
+     * 列向量：INTEGER/BOOLEAN 以连续的 int32_t 数组保存（BOOLEAN 取 0/1），
+     * VARCHAR 保存为字符串数组。数组容量固定为 VECTOR_SIZE，批间复用不重新分配。
+     */
+    struct ColumnVector {
+        TypeId type = TypeId::INVALID;
+        std::vector<int32_t> ints;
+        std::vector<std::string> strings;
+
+        void reset(TypeId columnType);
+        Value getValue(size_t row) const;
+    };
+
+    /**
+     * 一批行数据（列式）
+     * 过滤不移动列数据，只改写选择向量 selection：hasSelection 为 false 时 [0, size) 全部有效，
+     * 否则只有 selection 前 selectedCount 个下标对应的行有效。
+     */
+    struct DataChunk {
+        std::vector<ColumnVector> columns;
+        size_t size = 0;
+        std::vector<uint16_t> selection;
+        size_t selectedCount = 0;
+        bool hasSelection = false;
+
+        size_t activeCount() const { return hasSelection ? selectedCount : size; }
+        size_t rowAt(size_t i) const { return hasSelection ? selection[i] : i; }
+        void reset(const std::vector<TypeId> &types);
+    };
+
+    // 批量算子基类：与 Operator 相同的 open/next/close 协议，但每次产出一批行
+    class VectorOperator {
+    public:
+        virtual ~VectorOperator() = default;
+
+        virtual void open() = 0;
+        // 取下一批（activeCount() 可能为 0），没有更多数据时返回 false
+        virtual bool nextBatch(DataChunk &chunk) = 0;
+        virtual void close() = 0;
+
+        const std::vector<std::string> &getColumnNames() const { return columnNames_; }
+        const std::vector<TypeId> &getColumnTypes() const { return columnTypes_; }
+        size_t getColumnIndex(const std::string &name) const;
+
+    protected:
+        std::vector<std::string> columnNames_;
+        std::vector<TypeId> columnTypes_;
+    };
+
+    using VectorOperatorPtr = std::unique_ptr<VectorOperator>;
+
+    // 批量顺序扫描：直接从页内记录解码所需列，跳过未引用的列
+    class VectorSeqScanOperator : public VectorOperator {
+    public:
+        /**
+         * @param columns 需要输出的表列下标（按输出顺序），为空表示全部列
+         */
+        VectorSeqScanOperator(std::shared_ptr<storage::BufferManager> bufferManager, const TableInfo *tableInfo,
+                              std::vector<size_t> columns = {});
+        // 只扫描 pages 中的数据页（按给定顺序），不沿页链走；并行扫描的一个 morsel
+        VectorSeqScanOperator(std::shared_ptr<storage::BufferManager> bufferManager, const TableInfo *tableInfo,
+                              std::vector<size_t> columns, std::vector<PageID> pages);
+
+        void open() override;
+        bool nextBatch(DataChunk &chunk) override;
+        void close() override;
+
+    private:
+        std::shared_ptr<storage::BufferManager> bufferManager_;
+        const TableInfo *tableInfo_;
+        std::vector<RowCodec::Field> fields_;     // 输出列的偏移、宽度、类型，取自表的 RowCodec
+        bool usePages_ = false;
+        std::vector<PageID> pages_;
+        size_t pagePos_ = 0;
+        storage::ReadPageGuard page_;
+        PageID pageId_ = INVALID_PAGE_ID;
+        uint16_t slot_ = 0;
+
+        // 当前页读完后的下一页
+        PageID nextPageId() const;
+    };
+
+    // 批量过滤：列与常量比较，在 int32_t 数组上用无分支循环生成选择向量
+    class VectorFilterOperator : public VectorOperator {
+    public:
+        VectorFilterOperator(VectorOperatorPtr child, size_t column, CompareOp op, Value literal);
+
+        void open() override;
+        bool nextBatch(DataChunk &chunk) override;
+        void close() override;
+
+    private:
+        VectorOperatorPtr child_;
+        size_t column_;
+        CompareOp op_;
+        Value literal_;
+    };
+
+    // 批量投影：按下标重排/裁剪列向量，只交换向量，同一列被重复引用时才拷贝
+    class VectorProjectOperator : public VectorOperator {
+    public:
+        VectorProjectOperator(VectorOperatorPtr child, const std::vector<std::string> &columns);
+
+        void open() override;
+        bool nextBatch(DataChunk &chunk) override;
+        void close() override;
+
+    private:
+        VectorOperatorPtr child_;
+        std::vector<size_t> positions_;
+        DataChunk input_;
+    };
+
+} // namespace minidb
+
+#endif // MINIDB_VECTORIZED_OPERATORS_H
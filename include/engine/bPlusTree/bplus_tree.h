@@ -4,14 +4,15 @@
 #include "common/Value.h"
 #include "common/Types.h"
 #include "storage/Pager.h"
+#include "storage/PageGuard.h"
+#include "engine/bPlusTree/bplus_tree_page.h"
+#include "engine/bPlusTree/index_iterator.h"
 #include <memory>
 #include <vector>
 
 namespace minidb {
 namespace engine {
 
-class BPlusTreePage; // 前向声明
-
 // B+树节点常量定义
 // constexpr int LEAF_NODE_MAX_KEYS = 32;      // 叶子节点最大键数
 // constexpr int INTERNAL_NODE_MAX_KEYS = 32;  // 内部节点最大键数
@@ -23,9 +24,14 @@ class BPlusTreePage; // 前向声明
 
 class BPlusTree {
 public:
+    /**
+     * @param leaf_max_size / internal_max_size 节点最大键数，0 表示按页面容量
+     */
     BPlusTree(std::shared_ptr<storage::Pager> pager,
               PageID root_page_id,
-              TypeId key_type);
+              TypeId key_type,
+              uint16_t leaf_max_size = LEAF_NODE_MAX_KEYS,
+              uint16_t internal_max_size = INTERNAL_NODE_MAX_KEYS);
 
     // 基本操作
     bool insert(const Value& key, const RID& rid);
@@ -33,7 +39,18 @@ public:
     std::vector<RID> range_search(const Value& begin, const Value& end) const;
     bool remove(const Value& key);
 
+    /**
+     * 区间扫描：返回流式迭代器，任意时刻只 pin 一个叶子页
+     * @param lower/upper 区间端点，可为无界、开或闭
+     */
+    IndexIterator scan(const KeyBound& lower, const KeyBound& upper,
+                       ScanDirection direction = ScanDirection::FORWARD) const;
+    IndexIterator begin(ScanDirection direction = ScanDirection::FORWARD) const {
+        return scan(KeyBound::unbounded(), KeyBound::unbounded(), direction);
+    }
+
     // 树信息
+    bool is_empty() const { return root_page_id_ == INVALID_PAGE_ID; }
     uint32_t get_height() const;
     uint32_t get_node_count() const;
     PageID get_root_page_id() const { return root_page_id_; }
@@ -42,9 +59,38 @@ public:
     void print_tree() const;
 
 private:
+    // 持有页面守卫的节点视图：守卫析构时自动 unpin
+    struct ReadNode {
+        storage::ReadPageGuard guard;
+        BPlusTreePage page;
+
+        explicit ReadNode(storage::ReadPageGuard&& g)
+            : guard(std::move(g)), page(guard.getPage()) {}
+        const BPlusTreePage* operator->() const { return &page; }
+    };
+
+    struct WriteNode {
+        storage::WritePageGuard guard;
+        BPlusTreePage page;
+
+        explicit WriteNode(storage::WritePageGuard&& g)
+            : guard(std::move(g)), page(guard.getPage()) {}
+        BPlusTreePage* operator->() { return &page; }
+        PageID page_id() const { return guard.getPageId(); }
+    };
+
+    // 子节点分裂后需要上推给父节点的信息
+    struct SplitResult {
+        bool split = false;
+        Value key;
+        PageID right_page_id = INVALID_PAGE_ID;
+    };
+
     std::shared_ptr<storage::Pager> pager_;
     PageID root_page_id_;
     TypeId key_type_;
+    uint16_t leaf_max_size_;
+    uint16_t internal_max_size_;
     mutable uint32_t node_count_ = 0;
 
     /**
@@ -59,34 +105,50 @@ private:
     void validate_key_type(const Value& key) const;
 
     // 页面管理
-    std::unique_ptr<BPlusTreePage> get_node(PageID page_id) const;
-    void release_node(PageID page_id, bool is_dirty) const;
+    ReadNode read_node(PageID page_id) const;
+    WriteNode write_node(PageID page_id);
+
+    // 内部节点中 key 应进入的子节点下标
+    static int child_index_for(const BPlusTreePage& node, const Value& key);
 
     // 搜索方法
     PageID find_leaf_page(const Value& key) const;
     PageID find_first_leaf_page() const;
+    PageID find_last_leaf_page() const;
 
     // 插入相关
     bool insert_recursive(PageID current_page_id, const Value& key,
-                         const RID& rid, Value* promoted_key,
-                         PageID* new_child_page_id, bool* need_split);
-    bool split_leaf_node(PageID leaf_page_id, const Value& new_key, const RID& new_rid,
-                        Value* promoted_key, PageID* new_page_id);
-    bool split_internal_node(PageID internal_page_id, const Value& new_key, PageID new_child_id,
-                           Value* promoted_key, PageID* new_page_id);
-    bool create_new_root(PageID left_child_id, const Value& key, PageID right_child_id);
-
-    // 删除相关
-    bool remove_recursive(PageID current_page_id, const Value& key, bool* need_merge);
-    bool remove_from_leaf(PageID leaf_page_id, const Value& key);
-    bool handle_underflow(PageID parent_page_id, PageID page_id, int index);
-
-    // 节点创建
-    PageID create_new_leaf_node();
-    PageID create_new_internal_node();
+                          const RID& rid, SplitResult* result);
+    void split_leaf_node(WriteNode& leaf, const Value& new_key, const RID& new_rid,
+                         SplitResult* result);
+    void split_internal_node(WriteNode& internal, const Value& new_key, PageID new_child_id,
+                             SplitResult* result);
+    /**
+     * 按字节选择分裂点：返回左侧条目数
+     * @param promoted 上推到父节点、不留在任一侧的条目数（内部节点为 1）
+     */
+    static int choose_split_point(const std::vector<size_t>& sizes, size_t max_count, size_t promoted);
+    // VARCHAR 叶子分裂时的后缀截断分隔键
+    static Value shortest_separator(const Value& left_max, const Value& right_min);
+    void create_new_root(PageID left_child_id, const Value& key, PageID right_child_id);
+
+    // 删除相关：下溢由父节点在子节点删除返回后处理
+    bool remove_recursive(PageID current_page_id, const Value& key);
+    void handle_underflow(WriteNode& parent, int child_index);
+    void rebalance_leaves(WriteNode& parent, int separator_index, WriteNode& left, WriteNode& right);
+    void rebalance_internals(WriteNode& parent, int separator_index, WriteNode& left, WriteNode& right);
+    // 根为空叶子或只剩一个子节点的内部节点时降低树高
+    void collapse_root();
+    // 释放节点页面，交还给磁盘空闲链表复用
+    void free_node(WriteNode&& node);
+    static bool separator_fits(const BPlusTreePage& parent, int index, const Value& key);
+
+    // 节点创建（返回已初始化并持有写守卫的新节点）
+    WriteNode create_new_leaf_node();
+    WriteNode create_new_internal_node();
 };
 
 } // namespace engine
 } // namespace minidb
 
-#endif // MINIDB_BPLUS_TREE_H
\ No newline at end of file
+#endif // MINIDB_BPLUS_TREE_H
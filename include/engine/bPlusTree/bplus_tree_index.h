@@ -0,0 +1,66 @@
+#ifndef MINIDB_BPLUS_TREE_INDEX_H
+#define MINIDB_BPLUS_TREE_INDEX_H
+
+#include "engine/bPlusTree/bplus_tree.h"
+#include "engine/bPlusTree/index_iterator.h"
+#include "engine/bPlusTree/key_codec.h"
+#include "engine/catalog/index_meta.h"
+#include "storage/Pager.h"
+#include <memory>
+#include <vector>
+
+namespace minidb {
+namespace engine {
+
+/**
+ * 基于 B+ 树的二级索引
+ * 单列唯一索引直接以列值为键；组合索引和非唯一索引使用 KeyCodec 编码的
+ * 字节串作为 VARCHAR 键，非唯一索引再追加 RID 后缀保证键唯一。
+ * 树根变化时同步回 IndexMeta。
+ */
+class BPlusTreeIndex {
+public:
+    /**
+     * @param meta 索引元数据（由调用方持有，生命周期需覆盖本对象）
+     * @param leaf_max_size / internal_max_size 节点最大键数，0 表示按页面容量
+     */
+    BPlusTreeIndex(std::shared_ptr<storage::Pager> pager,
+                   catalog::IndexMeta* meta,
+                   uint16_t leaf_max_size = 0,
+                   uint16_t internal_max_size = 0);
+
+    /**
+     * 插入索引项
+     * @return 唯一索引中键已存在时返回 false
+     */
+    bool insert_entry(const std::vector<Value>& key_values, const RID& rid);
+    bool delete_entry(const std::vector<Value>& key_values, const RID& rid);
+
+    /**
+     * 前缀扫描：eq_prefix 对前几列做等值约束，lower/upper 约束紧随其后的一列
+     * 迭代器的 rid() 即表中记录的位置
+     */
+    IndexIterator scan(const std::vector<Value>& eq_prefix,
+                       const KeyBound& lower = KeyBound::unbounded(),
+                       const KeyBound& upper = KeyBound::unbounded(),
+                       ScanDirection direction = ScanDirection::FORWARD) const;
+
+    bool uses_encoded_keys() const { return encoded_; }
+    const catalog::IndexMeta& get_meta() const { return *meta_; }
+    const BPlusTree& get_tree() const { return tree_; }
+
+private:
+    std::shared_ptr<storage::Pager> pager_;
+    catalog::IndexMeta* meta_;
+    bool encoded_;
+    BPlusTree tree_;
+
+    void check_key_values(const std::vector<Value>& values, size_t expected) const;
+    Value make_tree_key(const std::vector<Value>& key_values, const RID& rid) const;
+    void sync_root();
+};
+
+} // namespace engine
+} // namespace minidb
+
+#endif // MINIDB_BPLUS_TREE_INDEX_H
@@ -5,6 +5,9 @@
 #include "common/Types.h"
 #include "common/Value.h"
 #include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace minidb {
@@ -15,40 +18,78 @@ struct BPlusNodeHeader {
     uint16_t is_leaf;        // 是否是叶子节点 (1/0)
     uint16_t key_count;      // 当前键的数量
     PageID next_page_id;     // 下一个叶子节点的页ID
+    PageID prev_page_id;     // 上一个叶子节点的页ID（反向扫描用）
     TypeId key_type;         // 键的数据类型
     uint16_t key_size;       // 键的固定大小（VARCHAR为0）
-
+    uint16_t max_size;       // 节点允许的最大键数（0表示由页面空间决定）
+    uint16_t prefix_size;    // 叶子节点所有键的公共前缀长度（仅VARCHAR）
+    uint16_t heap_offset;    // 键堆的最低已用偏移，向低地址增长（仅VARCHAR）
 };
 #pragma pack(pop)
 
+// B+树节点可用的数据区大小（物理页去掉 PageHeader）
+constexpr size_t BPLUS_PAGE_DATA_SIZE = PAGE_SIZE - sizeof(storage::PageHeader);
+// VARCHAR 键的最大字节数，保证任一节点至少能放下 4 个键
+constexpr size_t BPLUS_MAX_VARCHAR_KEY_SIZE = (BPLUS_PAGE_DATA_SIZE - sizeof(BPlusNodeHeader)) / 4 - 16;
+
+/**
+ * B+树节点页
+ * 定长键（INTEGER/BOOLEAN）：数据区为交错的 [key][value] 数组。
+ * VARCHAR 键：槽式布局，数据区开头是定长槽数组 [key_off][key_len][value]，
+ * 键字节从数据区末尾向前堆放，O(1) 定位任意键。叶子节点把所有键的公共前缀
+ * 只存一份（放在数据区最末尾），槽中只存后缀；内部节点第 0 个槽只存最左子指针，
+ * 第 i+1 个槽存第 i 个分隔键及其右子指针。
+ */
 class BPlusTreePage {
 public:
     explicit BPlusTreePage(storage::Page* page);
+    // 只读视图：仅读取页头，不做任何修正写回
+    explicit BPlusTreePage(const storage::Page* page);
 
     // 类型检查
     bool is_leaf() const { return header_.is_leaf == 1; }
-    void set_leaf(bool is_leaf) { header_.is_leaf = is_leaf ? 1 : 0; }
+    void set_leaf(bool is_leaf) {
+        header_.is_leaf = is_leaf ? 1 : 0;
+        save_header();
+    }
 
     // 键类型管理 - 新增
     TypeId get_key_type() const { return header_.key_type; }
     void set_key_type(TypeId key_type) {
         header_.key_type = key_type;
         header_.key_size = calculate_key_size(key_type);
+        if (header_.key_count == 0) {
+            reset_key_heap();
+        }
         save_header(); // ✅ 写回
         mark_dirty();
     }
+    bool uses_slotted_layout() const { return header_.key_type == TypeId::VARCHAR; }
+    uint16_t get_prefix_size() const { return header_.prefix_size; }
 
     // 容量管理
     uint16_t get_key_count() const { return header_.key_count; }
     void set_key_count(uint16_t count) {
         header_.key_count = count;
-        mark_dirty();
+        save_header();
     }
 
     PageID get_next_page_id() const { return header_.next_page_id; }
     void set_next_page_id(PageID page_id) {
         header_.next_page_id = page_id;
-        mark_dirty();
+        save_header();
+    }
+
+    PageID get_prev_page_id() const { return header_.prev_page_id; }
+    void set_prev_page_id(PageID page_id) {
+        header_.prev_page_id = page_id;
+        save_header();
+    }
+
+    uint16_t get_max_size() const { return header_.max_size; }
+    void set_max_size(uint16_t max_size) {
+        header_.max_size = max_size;
+        save_header();
     }
 
     // 键操作
@@ -76,6 +117,19 @@ public:
     bool remove_leaf_pair(int index);
     bool remove_internal_pair(int index);
 
+    // 整体重写节点内容（分裂/合并时使用），放不下时抛出异常
+    void assign_leaf_entries(const std::vector<std::pair<Value, RID>>& entries);
+    void assign_internal_entries(const std::vector<Value>& keys, const std::vector<PageID>& children);
+
+    // 判断整组条目能否放入本节点（合并兄弟节点前使用）
+    bool fits_leaf_entries(const std::vector<std::pair<Value, RID>>& entries) const;
+    bool fits_internal_entries(const std::vector<Value>& keys) const;
+
+    // 按字节计算的空间信息：插入 key 是否放得下、一个条目占用的字节数、数据区总字节数
+    bool has_room_for(const Value& key) const;
+    size_t get_entry_size(const Value& key) const;
+    size_t get_data_capacity() const;
+
     // 容量检查
     bool is_full() const;
     bool is_underflow() const;
@@ -119,6 +173,24 @@ private:
     void shift_keys_left(int start_index, int count = 1);
     void shift_values_right(int start_index, int count = 1);
     void shift_values_left(int start_index, int count = 1);
+
+    // VARCHAR 槽式布局辅助方法
+    void reset_key_heap();
+    size_t heap_top() const;
+    size_t slot_size() const { return 2 * sizeof(uint16_t) + get_value_size(); }
+    int slot_count() const { return header_.key_count + (is_leaf() ? 0 : 1); }
+    int key_slot(int index) const { return is_leaf() ? index : index + 1; }
+    char* slot_at(int slot) const { return get_data_start() + slot * slot_size(); }
+    const char* prefix_data() const;
+    std::string slot_key(int slot) const;
+    std::string varchar_key_bytes(const Value& key) const;
+    size_t used_bytes() const;
+    int compare_suffix(std::string_view suffix, int index) const;
+    int find_varchar_key_index(const std::string& key) const;
+    void collect_slots(std::vector<std::string>* keys, std::vector<std::string>* values) const;
+    bool rebuild_slots(const std::vector<std::string>& keys, const std::vector<std::string>& values);
+    bool insert_slot(int slot, const std::string& key, const char* value);
+    void remove_slot(int slot);
 };
 
 } // namespace engine
@@ -0,0 +1,92 @@
+#ifndef MINIDB_INDEX_ITERATOR_H
+#define MINIDB_INDEX_ITERATOR_H
+
+#include "common/Value.h"
+#include "common/Types.h"
+#include "storage/Pager.h"
+#include "storage/PageGuard.h"
+#include "engine/bPlusTree/bplus_tree_page.h"
+#include <memory>
+#include <optional>
+
+namespace minidb {
+namespace engine {
+
+// 扫描方向
+enum class ScanDirection {
+    FORWARD,   // 按键升序
+    BACKWARD   // 按键降序
+};
+
+// 区间端点：无界、闭区间或开区间
+struct KeyBound {
+    std::optional<Value> key;   // 为空表示无界
+    bool inclusive = true;
+
+    static KeyBound unbounded() { return KeyBound{}; }
+    static KeyBound closed(const Value& v) { return KeyBound{v, true}; }
+    static KeyBound open(const Value& v) { return KeyBound{v, false}; }
+
+    bool is_unbounded() const { return !key.has_value(); }
+};
+
+/**
+ * B+树叶子层迭代器
+ * 始终只 pin 当前所在的一个叶子页，沿 next/prev 指针惰性移动，
+ * 越过区间端点或走完叶子链后自动释放页面并变为 end 状态。
+ */
+class IndexIterator {
+public:
+    // 默认构造即 end 迭代器
+    IndexIterator() = default;
+
+    /**
+     * @param leaf_page_id 起始叶子（正向为下界所在叶子，反向为上界所在叶子）
+     */
+    IndexIterator(std::shared_ptr<storage::Pager> pager,
+                  PageID leaf_page_id,
+                  KeyBound lower,
+                  KeyBound upper,
+                  ScanDirection direction);
+
+    IndexIterator(const IndexIterator&) = delete;
+    IndexIterator& operator=(const IndexIterator&) = delete;
+    IndexIterator(IndexIterator&&) noexcept = default;
+    IndexIterator& operator=(IndexIterator&&) noexcept = default;
+
+    bool is_end() const { return !leaf_.has_value(); }
+
+    // 当前条目（调用前需保证 !is_end()）
+    const Value& key() const { return current_key_; }
+    RID rid() const;
+
+    // 向扫描方向前进一条
+    IndexIterator& operator++();
+
+    ScanDirection direction() const { return direction_; }
+
+private:
+    std::shared_ptr<storage::Pager> pager_;
+    storage::ReadPageGuard guard_;
+    std::optional<BPlusTreePage> leaf_;
+    int index_ = 0;
+    Value current_key_;
+
+    KeyBound lower_;
+    KeyBound upper_;
+    ScanDirection direction_ = ScanDirection::FORWARD;
+
+    void load_leaf(PageID page_id);
+    void seek_first();
+    // 把 index_ 调整到有效位置（必要时跨叶子），并检查区间终点
+    void settle();
+    void finish();
+
+    bool before_lower(const Value& key) const;
+    bool after_upper(const Value& key) const;
+};
+
+} // namespace engine
+} // namespace minidb
+
+#endif // MINIDB_INDEX_ITERATOR_H
@@ -0,0 +1,46 @@
+#ifndef MINIDB_KEY_CODEC_H
+#define MINIDB_KEY_CODEC_H
+
+#include "common/Value.h"
+#include "common/Types.h"
+#include <string>
+#include <vector>
+
+namespace minidb {
+namespace engine {
+
+/**
+ * 可比较字节串（memcomparable）键编码
+ * 编码结果按字节序（memcmp）比较的顺序与原值的顺序一致，
+ * 因此组合键、带 RID 后缀的非唯一键都可以作为 VARCHAR 键直接放进 B+ 树。
+ *
+ * 每列格式：1 字节空值标记（0x00 NULL / 0x01 非空）+ 值编码
+ *   BOOLEAN  1 字节
+ *   INTEGER  4 字节大端，符号位取反
+ *   VARCHAR  0x00 转义为 0x00 0xFF，以 0x00 0x00 结尾
+ * 任意前几列的编码恰好是完整编码的字节前缀，便于前缀扫描。
+ */
+class KeyCodec {
+public:
+    static constexpr size_t RID_SUFFIX_SIZE = sizeof(int32_t) * 2;
+
+    static void encode_value(const Value& value, std::string* out);
+    static std::string encode(const std::vector<Value>& values);
+
+    // 非唯一索引以 RID 作为后缀打破重复
+    static void append_rid(const RID& rid, std::string* out);
+    static RID decode_rid_suffix(const std::string& key);
+
+    static std::vector<Value> decode(const std::string& key, const std::vector<TypeId>& types);
+
+    /**
+     * 以 prefix 为前缀的所有串都严格小于返回值
+     * @return 不存在这样的串（prefix 全为 0xFF）时返回空串
+     */
+    static std::string prefix_successor(const std::string& prefix);
+};
+
+} // namespace engine
+} // namespace minidb
+
+#endif // MINIDB_KEY_CODEC_H
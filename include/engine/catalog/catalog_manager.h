@@ -2,11 +2,13 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string>
 #include <vector>
 #include "table_info.h"
+#include "index_meta.h"
 #include "compiler/AST.h"
 
 namespace minidb {
@@ -30,9 +32,26 @@ namespace minidb {
         std::vector<std::string> get_table_names() const;
         uint32_t get_table_count() const { return tables_.size(); }
 
+        // Ŀ¼汾ţÿν/ɾ//ɾһִмƻݴжǷʧЧ
+        uint64_t get_version() const { return version_; }
+
+
+        // ӿ
+        // ڱУȫΨһcreate_index ֻǼԪݣB+ִ湹
+        bool create_index(const std::string& index_name, const std::string& table_name,
+                          const std::vector<std::string>& column_names, bool is_unique);
+        bool drop_index(const std::string& index_name);
+        bool index_exists(const std::string& index_name) const;
+        catalog::IndexMeta* get_index(const std::string& index_name);
+        const catalog::IndexMeta* get_index(const std::string& index_name) const;
+        std::vector<catalog::IndexMeta*> get_table_indexes(const std::string& table_name) const;
+        //  column_name Ϊеѯ滮ѡɨ裩û򷵻nullptr
+        const catalog::IndexMeta* find_index(const std::string& table_name,
+                                             const std::string& column_name) const;
 
         // ASTɽӿ
         bool create_table_from_ast(const CreateTableAST& create_ast);
+        bool create_index_from_ast(const CreateIndexAST& index_ast);
         bool validate_insert_ast(const InsertAST& insert_ast) const;
         bool validate_select_ast(const SelectAST& select_ast) const;
 
@@ -48,6 +67,9 @@ namespace minidb {
     private:
         // Ϣ洢TableInfoӳ
         std::unordered_map<std::string, std::unique_ptr<TableInfo>> tables_;
+        // Ϣ洢IndexMetaӳ
+        std::unordered_map<std::string, std::unique_ptr<catalog::IndexMeta>> indexes_;
+        uint64_t version_ = 0;
 
         TypeId convert_ast_type_to_typeid(const std::string& type_str) const;
 
@@ -3,12 +3,14 @@
 #include "../include/common/Types.h"
 #include "../include/common/Constants.h"
 #include <string>
+#include <vector>
 #include <cstring> // for std::memcpy
 
 namespace minidb {
 namespace catalog {
 
 // 索引元数据类：管理索引名称、表名、列名、键类型和根页面ID
+// 支持多列（组合）索引与非唯一索引，单列构造函数保持唯一索引语义
 class IndexMeta {
 public:
     IndexMeta() = default;
@@ -20,12 +22,35 @@ public:
               TypeId key_type,
               PageID root_page_id = INVALID_PAGE_ID);
 
+    // 组合/非唯一索引构造函数，column_names 与 key_types 一一对应
+    IndexMeta(std::string index_name,
+              std::string table_name,
+              std::vector<std::string> column_names,
+              std::vector<TypeId> key_types,
+              bool is_unique,
+              PageID root_page_id = INVALID_PAGE_ID);
+
     // Getter接口
     const std::string& get_index_name() const { return index_name_; }
     const std::string& get_table_name() const { return table_name_; }
-    const std::string& get_column_name() const { return column_name_; }
-    TypeId get_key_type() const { return key_type_; }
+    // 首列列名/类型（单列索引即索引列本身）
+    const std::string& get_column_name() const;
+    TypeId get_key_type() const;
     PageID get_root_page_id() const { return root_page_id_; }
+
+    const std::vector<std::string>& get_column_names() const { return column_names_; }
+    const std::vector<TypeId>& get_key_types() const { return key_types_; }
+    size_t get_column_count() const { return column_names_.size(); }
+    bool is_unique() const { return is_unique_; }
+    bool is_composite() const { return column_names_.size() > 1; }
+
+    /**
+     * 计算索引可用的最长前缀，QueryPlanner::chooseIndexScan 据此在多个索引间选择，
+     * 并在前缀之后的下一列上取区间
+     * @param equality_columns 谓词中做等值比较的列（顺序无关，可重复）
+     * @return 被等值谓词完整覆盖的索引前导列个数（0 表示前缀不可用）
+     */
+    size_t match_equality_prefix(const std::vector<std::string>& equality_columns) const;
     
     // Setter接口
     void set_root_page_id(PageID page_id) { root_page_id_ = page_id; }
@@ -44,12 +69,17 @@ public:
 private:
     std::string index_name_;
     std::string table_name_; 
-    std::string column_name_;
-    TypeId key_type_{TypeId::INVALID};
+    std::vector<std::string> column_names_;
+    std::vector<TypeId> key_types_;
+    bool is_unique_{true};
     PageID root_page_id_{INVALID_PAGE_ID};
 
+    void validate() const;
+
+public:
     // 序列化字段的固定长度（为了对齐和固定大小）
     static constexpr size_t NAME_LENGTH = 64; // 名称字段的最大长度
+    static constexpr size_t MAX_INDEX_COLUMNS = 4; // 组合索引最多列数
 };
 
 } // namespace catalog
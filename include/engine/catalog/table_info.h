@@ -3,6 +3,8 @@
 #include <string>
 #include <cstdint>
 #include "schema.h"
+#include "common/Constants.h"
+#include "engine/RowCodec.h"
 
 namespace minidb {
 
@@ -28,6 +30,8 @@ namespace minidb {
 
         const std::string& get_table_name() const { return table_name_; }
         const Schema& get_schema() const { return schema_; }
+        // 按本表 Schema 编译的行编解码器，所有读写记录的路径共用
+        const RowCodec& get_codec() const { return codec_; }
         uint32_t get_table_id() const { return table_id_; }
 
         PageID getFirstPageID() const { return first_page_id_; }
@@ -35,6 +39,10 @@ namespace minidb {
         // 设置首数据页ID（用于建表时绑定物理页 或 恢复时还原）
         void setFirstPageID(PageID pid) { first_page_id_ = pid; }
 
+        // 数据页目录的首页ID（INVALID_PAGE_ID 表示尚未建立目录）
+        PageID getDirectoryPageID() const { return directory_page_id_; }
+        void setDirectoryPageID(PageID pid) { directory_page_id_ = pid; }
+
         // 设置表ID（恢复时可用）
         void set_table_id(uint32_t table_id) { table_id_ = table_id; }
 
@@ -49,8 +57,10 @@ namespace minidb {
     private:
         std::string table_name_; // 表名
         Schema schema_;          // 表结构定义
+        RowCodec codec_;         // 由 schema_ 编译，须在其后声明
         uint32_t table_id_;      // 表唯一标识
         PageID first_page_id_;   // 表首数据页ID
+        PageID directory_page_id_ = INVALID_PAGE_ID; // 数据页目录首页ID
     };
 
 } // namespace minidb
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "../../include/common/Exception.h"
 #include "../../include/storage/Page.h"
 #include "../../include/storage/DiskManager.h"
+#include "../../include/storage/PageGuard.h"
 #include <list>
 #include <unordered_map>
 #include <shared_mutex>
@@ -32,9 +33,16 @@ namespace minidb {
             void pinPage(PageID page_id);
             void unpinPage(PageID page_id, bool is_dirty = false);
 
+            // RAII 访问：返回的守卫在析构时自动 unpin（写守卫同时标记脏页）
+            ReadPageGuard fetchPageRead(PageID page_id);
+            WritePageGuard fetchPageWrite(PageID page_id);
+            uint16_t getPinCount(PageID page_id) const;
+
             void flushPage(PageID page_id);
             void flushAllPages();
             void removePage(PageID page_id);
+            // 丢弃页面的缓存帧且不写回（用于即将释放的临时页），页面不在缓冲池时什么也不做
+            void discardPage(PageID page_id);
 
             size_t getHitCount() const { return hit_count_; }
             size_t getMissCount() const { return miss_count_; }
@@ -48,6 +56,8 @@ namespace minidb {
                 return disk_manager_->allocatePage();
             }
 
+            std::shared_ptr<DiskManager> getDiskManager() const { return disk_manager_; }
+
         private:
             std::shared_ptr<DiskManager> disk_manager_;
             size_t pool_size_;
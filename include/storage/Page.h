@@ -15,7 +15,8 @@ enum class PageType {
     DATA_PAGE,    // 数据页（默认类型）
     INDEX_PAGE,   // 索引页
     FREE_PAGE,    // 空闲页
-    META_PAGE     // 元数据页
+    META_PAGE,    // 元数据页
+    DIRECTORY_PAGE // 表的数据页目录
 };
 
 // 页面头部结构体（与 cpp 中 header_ 成员的初始化逻辑匹配）
@@ -33,6 +34,9 @@ struct PageHeader {
 
 class Page {
 public:
+    // 每条记录的槽位元数据（偏移 + 长度）占用的字节数
+    static constexpr uint16_t SLOT_SIZE = 4;
+
     // 1. 构造函数（与 cpp 实现完全匹配）
     Page();                                  // 默认构造：pin_count=0，页头/数据区清零
     explicit Page(PageID page_id);           // 带页ID的构造：指定 page_id，其他同默认构造
@@ -58,6 +62,8 @@ public:
 
     // 3. 记录操作接口（与 cpp 实现的参数、返回值、const 修饰完全匹配）
     bool insertRecord(const char* record_data, uint16_t record_size, RID* rid = nullptr);
+    // 分配一个 record_size 字节的新槽位并返回其页内地址，由调用方直接写入记录；空间不足时返回 nullptr
+    char* reserveRecord(uint16_t record_size, RID* rid = nullptr);
     bool getRecord(const RID& rid, char* buffer, uint16_t* size = nullptr) const;
     bool deleteRecord(const RID& rid);
     bool updateRecord(const RID& rid, const char* new_data, uint16_t new_size, RID* new_rid = nullptr);
@@ -108,6 +114,8 @@ public:
     //     return header_.free_space;
     // }
     bool getSlotInfo(uint16_t slot_num, uint16_t* offset, uint16_t* size) const; // 获取槽位完整信息
+    // 直接返回槽位记录在页内的地址（不拷贝），已删除或越界时返回 nullptr
+    const char* getRecordData(uint16_t slot_num, uint16_t* size = nullptr) const;
 
 private:
     // 7. 私有辅助函数（与 cpp 中槽位操作逻辑匹配，仅内部调用）
@@ -0,0 +1,70 @@
+#ifndef MINIDB_PAGEGUARD_H
+#define MINIDB_PAGEGUARD_H
+
+#include "common/Types.h"
+#include "common/Constants.h"
+#include "storage/Page.h"
+
+namespace minidb {
+    namespace storage {
+
+        class BufferManager;
+
+        /**
+         * 页面守卫基类（RAII）
+         * 持有一次 fetchPage 产生的 pin，析构或 release() 时自动 unpinPage。
+         * 只能移动不能拷贝，保证每个 pin 恰好被释放一次。
+         */
+        class BasicPageGuard {
+        public:
+            BasicPageGuard() = default;
+            BasicPageGuard(BufferManager* buffer_manager, PageID page_id, Page* page);
+            ~BasicPageGuard();
+
+            BasicPageGuard(const BasicPageGuard&) = delete;
+            BasicPageGuard& operator=(const BasicPageGuard&) = delete;
+            BasicPageGuard(BasicPageGuard&& other) noexcept;
+            BasicPageGuard& operator=(BasicPageGuard&& other) noexcept;
+
+            // 提前释放 pin（之后守卫变为空）
+            void release();
+
+            bool isValid() const { return page_ != nullptr; }
+            PageID getPageId() const { return page_id_; }
+
+        protected:
+            BufferManager* buffer_manager_{nullptr};
+            Page* page_{nullptr};
+            PageID page_id_{INVALID_PAGE_ID};
+            bool is_dirty_{false};
+        };
+
+        // 只读页面守卫：释放时不标记脏页
+        class ReadPageGuard : public BasicPageGuard {
+        public:
+            using BasicPageGuard::BasicPageGuard;
+
+            const Page* getPage() const { return page_; }
+            const char* getData() const { return page_->getData(); }
+            const Page* operator->() const { return page_; }
+        };
+
+        // 读写页面守卫：释放时自动把页面标记为脏页
+        class WritePageGuard : public BasicPageGuard {
+        public:
+            WritePageGuard() = default;
+            WritePageGuard(BufferManager* buffer_manager, PageID page_id, Page* page)
+                : BasicPageGuard(buffer_manager, page_id, page) {
+                is_dirty_ = true;
+            }
+
+            Page* getPage() { return page_; }
+            const Page* getPage() const { return page_; }
+            char* getData() { return page_->getData(); }
+            Page* operator->() { return page_; }
+        };
+
+    } // namespace storage
+} // namespace minidb
+
+#endif // MINIDB_PAGEGUARD_H
@@ -24,6 +24,8 @@ namespace minidb {
             Page* getPage(PageID page_id);
             void pinPage(PageID page_id);
             void releasePage(PageID page_id, bool is_dirty = false);
+            ReadPageGuard fetchPageRead(PageID page_id);
+            WritePageGuard fetchPageWrite(PageID page_id);
 
             // 刷写操作
             void flushPage(PageID page_id);
@@ -0,0 +1,75 @@
+#ifndef MINIDB_TABLE_PAGE_DIRECTORY_H
+#define MINIDB_TABLE_PAGE_DIRECTORY_H
+
+#include "../include/storage/BufferManager.h"
+#include "../include/storage/Page.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace minidb {
+    namespace storage {
+
+        /**
+         * 表的数据页目录：按页链顺序登记每个数据页的页号和空闲空间提示
+         * 目录本身存放在一串 DIRECTORY_PAGE 中（页头 slot_count 为条目数，next_free_page 指向下一目录页），
+         * 打开时整体读入内存，之后按下标随机访问、O(1) 找到表尾；空闲空间提示在内存中修改，flush() 时写回。
+         * 数据页之间的页链照常维护，逐页扫描不依赖目录。
+         */
+        class TablePageDirectory {
+        public:
+#pragma pack(push, 1)
+            struct Entry {
+                PageID page_id;
+                uint16_t free_space;
+            };
+#pragma pack(pop)
+            static constexpr size_t ENTRIES_PER_PAGE = (PAGE_SIZE - sizeof(PageHeader)) / sizeof(Entry);
+
+            // 沿 first_page 开始的页链建立目录并写盘（建表时页链只有首页；旧表首次访问时迁移），返回目录首页
+            static PageID create(const std::shared_ptr<BufferManager>& buffer_manager, PageID first_page);
+
+            // 打开已持久化的目录
+            TablePageDirectory(std::shared_ptr<BufferManager> buffer_manager, PageID root_page);
+
+            PageID getRootPageId() const { return directory_pages_.front(); }
+            size_t getPageCount() const { return pages_.size(); }
+            // 全部数据页，按页链顺序
+            const std::vector<PageID>& getPages() const { return pages_; }
+            PageID getLastPage() const { return pages_.back(); }
+            // 目录自身占用的页
+            const std::vector<PageID>& getDirectoryPages() const { return directory_pages_; }
+
+            uint16_t getFreeSpace(PageID page_id) const;
+            /**
+             * 找空闲空间提示放得下 record_size 字节记录（含槽位）的数据页，没有时返回 INVALID_PAGE_ID
+             * 先看表尾页，放不下时从游标处按页链顺序往后找；同一张表的记录定长，游标均摊 O(1) 前进
+             */
+            PageID findPageWithSpace(uint16_t record_size);
+
+            // 登记已链接到表尾的新数据页，目录页写满时分配并链接新的目录页
+            void append(PageID page_id, uint16_t free_space);
+            // 修改数据页的空闲空间提示（只改内存，flush() 时写回）
+            void setFreeSpace(PageID page_id, uint16_t free_space);
+            // 把修改过的条目写回目录页
+            void flush();
+
+        private:
+            std::shared_ptr<BufferManager> buffer_manager_;
+            std::vector<PageID> directory_pages_;
+            std::vector<PageID> pages_;
+            std::vector<uint16_t> free_space_;
+            std::unordered_map<PageID, size_t> positions_;  // 数据页号 -> 条目下标
+            std::vector<bool> dirty_;                       // 按目录页记录是否有未写回的条目
+            // 空闲空间游标：下标小于 cursor_ 的数据页都放不下 cursor_required_ 字节
+            size_t cursor_ = 0;
+            uint32_t cursor_required_ = 0;
+
+            static void initDirectoryPage(Page& page);
+        };
+
+    } // namespace storage
+} // namespace minidb
+
+#endif // MINIDB_TABLE_PAGE_DIRECTORY_H
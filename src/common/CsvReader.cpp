@@ -0,0 +1,115 @@
+#include "../include/common/CsvReader.h"
+#include "common/Exception.h"
+
+#include <cstring>
+
+namespace minidb {
+
+CsvReader::CsvReader(const std::string& path, size_t chunkSize)
+    : file_(path, std::ios::binary), path_(path), chunkSize_(chunkSize == 0 ? DEFAULT_CHUNK_SIZE : chunkSize) {
+    if (!file_) {
+        throw FileNotFoundException(path);
+    }
+}
+
+bool CsvReader::fill() {
+    if (eof_) return false;
+
+    // 丢弃已消费的部分，未完成的记录移到缓冲区开头
+    buffer_.erase(0, pos_);
+    pos_ = 0;
+
+    size_t used = buffer_.size();
+    buffer_.resize(used + chunkSize_);
+    file_.read(buffer_.data() + used, static_cast<std::streamsize>(chunkSize_));
+    if (file_.bad()) {
+        throw IOException("Failed to read " + path_);
+    }
+    size_t got = static_cast<size_t>(file_.gcount());
+    buffer_.resize(used + got);
+    if (got < chunkSize_) eof_ = true;
+    return got > 0;
+}
+
+size_t CsvReader::findRecordEnd(size_t& newlines) const {
+    // 引号成对出现（"" 转义相当于一次闭合加一次打开），引号内的换行属于字段内容
+    bool quoted = false;
+    newlines = 0;
+    for (size_t i = pos_; i < buffer_.size(); ++i) {
+        char c = buffer_[i];
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (c == '\n') {
+            if (!quoted) return i;
+            ++newlines;
+        }
+    }
+    return std::string::npos;
+}
+
+void CsvReader::splitFields(size_t begin, size_t end, std::vector<std::string_view>& fields) {
+    fields.clear();
+    size_t i = begin;
+    while (true) {
+        if (i < end && buffer_[i] == '"') {
+            // 去掉引号后的内容不会比原文长，就地写回
+            size_t start = i;
+            size_t out = i;
+            ++i;
+            while (true) {
+                if (i >= end) {
+                    throw DatabaseException("CSV line " + std::to_string(recordLine_) + ": unterminated quoted field");
+                }
+                char c = buffer_[i++];
+                if (c == '"') {
+                    if (i < end && buffer_[i] == '"') {
+                        ++i;
+                    } else {
+                        break;
+                    }
+                }
+                buffer_[out++] = c;
+            }
+            fields.emplace_back(buffer_.data() + start, out - start);
+            if (i < end && buffer_[i] != ',') {
+                throw DatabaseException("CSV line " + std::to_string(recordLine_) +
+                                        ": unexpected character after quoted field");
+            }
+        } else {
+            const char* comma = static_cast<const char*>(std::memchr(buffer_.data() + i, ',', end - i));
+            size_t stop = comma ? static_cast<size_t>(comma - buffer_.data()) : end;
+            fields.emplace_back(buffer_.data() + i, stop - i);
+            i = stop;
+        }
+        if (i >= end) break;
+        ++i;    // 跳过逗号；行尾的逗号表示最后还有一个空字段
+    }
+}
+
+bool CsvReader::next(std::vector<std::string_view>& fields) {
+    while (true) {
+        size_t newlines = 0;
+        size_t end = findRecordEnd(newlines);
+        if (end == std::string::npos) {
+            // 记录跨越块边界：读入下一块后重新查找
+            if (fill()) continue;
+            if (pos_ >= buffer_.size()) return false;
+            // 最后一条记录没有结尾换行
+            end = buffer_.size();
+        }
+
+        size_t begin = pos_;
+        size_t stop = end;
+        if (stop > begin && buffer_[stop - 1] == '\r') --stop;
+
+        recordLine_ = line_;
+        line_ += newlines + (end < buffer_.size() ? 1 : 0);
+        pos_ = end < buffer_.size() ? end + 1 : end;
+
+        if (stop == begin) continue;    // 空行
+        splitFields(begin, stop, fields);
+        return true;
+    }
+}
+
+} // namespace minidb
@@ -0,0 +1,202 @@
+#include "../include/common/QueryResult.h"
+#include "common/ResultWriter.h"
+
+#include <charconv>
+#include <iostream>
+#include <stdexcept>
+
+namespace minidb {
+
+void QueryResult::setColumns(const std::vector<std::string>& names, const std::vector<TypeId>& types) {
+    if (names.size() != types.size()) {
+        throw std::invalid_argument("Column names and types differ in length");
+    }
+    columnNames_ = names;
+    columns_.assign(names.size(), ColumnBuffer{});
+    for (size_t i = 0; i < types.size(); ++i) {
+        // 整数和布尔值存为 int32_t，其他类型按文本保存
+        bool integral = types[i] == TypeId::INTEGER || types[i] == TypeId::BOOLEAN;
+        columns_[i].type = integral ? types[i] : TypeId::VARCHAR;
+    }
+}
+
+void QueryResult::setColumnNames(const std::vector<std::string>& names) {
+    setColumns(names, std::vector<TypeId>(names.size(), TypeId::VARCHAR));
+}
+
+void QueryResult::appendInt(size_t col, int32_t value) {
+    ColumnBuffer& column = columns_.at(col);
+    if (column.type != TypeId::INTEGER && column.type != TypeId::BOOLEAN) {
+        throw TypeMismatchException("Column " + std::to_string(col) + " does not hold integers");
+    }
+    column.ints.push_back(value);
+    column.nulls.push_back(false);
+}
+
+void QueryResult::appendString(size_t col, std::string_view value) {
+    ColumnBuffer& column = columns_.at(col);
+    if (column.type != TypeId::VARCHAR) {
+        throw TypeMismatchException("Column " + std::to_string(col) + " does not hold strings");
+    }
+    column.bytes.append(value);
+    column.offsets.push_back(static_cast<uint32_t>(column.bytes.size()));
+    column.nulls.push_back(false);
+}
+
+void QueryResult::appendNull(size_t col) {
+    ColumnBuffer& column = columns_.at(col);
+    if (column.type == TypeId::VARCHAR) {
+        column.offsets.push_back(column.offsets.back());
+    } else {
+        column.ints.push_back(0);
+    }
+    column.nulls.push_back(true);
+}
+
+void QueryResult::appendValue(size_t col, const Value& value) {
+    if (value.isNull()) {
+        appendNull(col);
+        return;
+    }
+    TypeId type = columns_.at(col).type;
+    if (type == TypeId::VARCHAR) {
+        // 按文本保存的列（只设置了列名）接受任意类型的值
+        if (value.getType() == TypeId::VARCHAR) {
+            appendString(col, value.getStringView());
+        } else {
+            appendString(col, value.toString());
+        }
+    } else if (value.getType() == TypeId::BOOLEAN) {
+        appendInt(col, value.getAsBool() ? 1 : 0);
+    } else {
+        appendInt(col, value.getAsInt());
+    }
+}
+
+void QueryResult::appendTuple(const Tuple& tuple) {
+    const auto& values = tuple.getValues();
+    if (values.size() != columns_.size()) {
+        throw std::invalid_argument("Row has " + std::to_string(values.size()) + " values, expected " +
+                                    std::to_string(columns_.size()));
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        appendValue(i, values[i]);
+    }
+}
+
+void QueryResult::addRow(const Row& row) {
+    // 没有设置列时按第一行的宽度建立文本列
+    if (columns_.empty() && columnNames_.empty()) {
+        columns_.assign(row.size(), ColumnBuffer{});
+    }
+    if (row.size() != columns_.size()) {
+        throw std::invalid_argument("Row has " + std::to_string(row.size()) + " values, expected " +
+                                    std::to_string(columns_.size()));
+    }
+    for (size_t i = 0; i < row.size(); ++i) {
+        appendString(i, row[i]);
+    }
+}
+
+const QueryResult::ColumnBuffer& QueryResult::cell(size_t row, size_t col) const {
+    if (col >= columns_.size() || row >= columns_[col].size()) {
+        throw std::out_of_range("Cell (" + std::to_string(row) + ", " + std::to_string(col) + ") out of range");
+    }
+    return columns_[col];
+}
+
+bool QueryResult::isNull(size_t row, size_t col) const {
+    return cell(row, col).nulls[row];
+}
+
+int32_t QueryResult::getInt(size_t row, size_t col) const {
+    const ColumnBuffer& column = cell(row, col);
+    if (column.type == TypeId::VARCHAR) {
+        throw TypeMismatchException("Column " + std::to_string(col) + " does not hold integers");
+    }
+    return column.ints[row];
+}
+
+std::string_view QueryResult::getString(size_t row, size_t col) const {
+    const ColumnBuffer& column = cell(row, col);
+    if (column.type != TypeId::VARCHAR) {
+        throw TypeMismatchException("Column " + std::to_string(col) + " does not hold strings");
+    }
+    return std::string_view(column.bytes).substr(column.offsets[row], column.offsets[row + 1] - column.offsets[row]);
+}
+
+void QueryResult::appendText(size_t row, size_t col, std::string& out) const {
+    const ColumnBuffer& column = columns_[col];
+    if (column.nulls[row]) {
+        out += "NULL";
+        return;
+    }
+    switch (column.type) {
+        case TypeId::VARCHAR:
+            out.append(column.bytes, column.offsets[row], column.offsets[row + 1] - column.offsets[row]);
+            break;
+        case TypeId::BOOLEAN:
+            out += column.ints[row] ? "true" : "false";
+            break;
+        default: {
+            char buffer[16];
+            auto end = std::to_chars(buffer, buffer + sizeof(buffer), column.ints[row]).ptr;
+            out.append(buffer, end);
+            break;
+        }
+    }
+}
+
+QueryResult::Row QueryResult::getRow(size_t index) const {
+    if (index >= rowCount()) {
+        throw std::out_of_range("Row index out of range");
+    }
+    Row row(columns_.size());
+    for (size_t col = 0; col < columns_.size(); ++col) {
+        appendText(index, col, row[col]);
+    }
+    return row;
+}
+
+std::optional<std::string> QueryResult::getValue(size_t row, size_t col) const {
+    if (col < columns_.size() && row < columns_[col].size()) {
+        std::string text;
+        appendText(row, col, text);
+        return text;
+    }
+    return std::nullopt;
+}
+
+void QueryResult::print() const {
+    print(std::cout);
+}
+
+void QueryResult::print(std::ostream& out) const {
+    if (rowCount() == 0) {
+        out << "(empty)" << std::endl;
+        return;
+    }
+    std::string line;
+    for (size_t r = 0; r < rowCount(); ++r) {
+        line.clear();
+        for (size_t col = 0; col < columns_.size(); ++col) {
+            appendText(r, col, line);
+            line += col + 1 < columns_.size() ? '\t' : '\n';
+        }
+        out << line;
+    }
+}
+
+std::string QueryResult::toJsonString() const {
+    OutputBuffer out;
+    ResultWriter(out, ResultWriter::Format::JSON).writeAll(*this);
+    return out.str();
+}
+
+std::string QueryResult::toCsvString() const {
+    OutputBuffer out;
+    ResultWriter(out, ResultWriter::Format::CSV).writeAll(*this);
+    return out.str();
+}
+
+} // namespace minidb
@@ -0,0 +1,225 @@
+#include "../include/common/ResultWriter.h"
+#include "common/Exception.h"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace minidb {
+
+// ==================== OutputBuffer ====================
+
+OutputBuffer::OutputBuffer(int fd, size_t flushThreshold) : fd_(fd), flushThreshold_(flushThreshold) {
+    buffer_.reserve(fd_ >= 0 ? flushThreshold_ + 1024 : 0);
+}
+
+OutputBuffer::~OutputBuffer() {
+    // 析构时尽量写出剩余字节并忽略错误，需要知道是否写成功时应显式调用 flush()
+    try {
+        flush();
+    } catch (const std::exception&) {
+    }
+}
+
+void OutputBuffer::appendInt(int64_t value) {
+    char digits[24];
+    auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    buffer_.append(digits, end);
+    maybeFlush();
+}
+
+void OutputBuffer::flush() {
+    if (fd_ < 0) return;
+    size_t written = 0;
+    while (written < buffer_.size()) {
+#ifdef _WIN32
+        int n = ::_write(fd_, buffer_.data() + written, static_cast<unsigned>(buffer_.size() - written));
+#else
+        ssize_t n = ::write(fd_, buffer_.data() + written, buffer_.size() - written);
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw IOException(std::string("Failed to write result: ") + std::strerror(errno));
+        }
+        written += static_cast<size_t>(n);
+    }
+    flushed_ += written;
+    buffer_.clear();
+}
+
+// ==================== 转义 ====================
+
+void appendJsonString(OutputBuffer& out, std::string_view value) {
+    static const char hex[] = "0123456789abcdef";
+    out.append('"');
+    // 连续的无需转义字节一次追加
+    size_t start = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        auto c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.append(value.substr(start, i - start));
+        start = i + 1;
+        switch (c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            case '\b': out.append("\\b"); break;
+            case '\f': out.append("\\f"); break;
+            default: {
+                const char escape[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                out.append(std::string_view(escape, sizeof(escape)));
+                break;
+            }
+        }
+    }
+    out.append(value.substr(start));
+    out.append('"');
+}
+
+void appendCsvField(OutputBuffer& out, std::string_view value) {
+    // 空字符串写成 ""，与表示 NULL 的空字段区分
+    if (!value.empty() && value.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out.append(value);
+        return;
+    }
+    out.append('"');
+    size_t start = 0;
+    for (size_t quote = value.find('"'); quote != std::string_view::npos; quote = value.find('"', start)) {
+        out.append(value.substr(start, quote + 1 - start));
+        out.append('"');
+        start = quote + 1;
+    }
+    out.append(value.substr(start));
+    out.append('"');
+}
+
+// ==================== ResultWriter ====================
+
+void ResultWriter::begin(const std::vector<std::string>& columnNames) {
+    rows_ = 0;
+    keys_.clear();
+    if (format_ == Format::JSON) {
+        // 预先生成每列的 "列名": 前缀，逐行输出时直接拷贝
+        OutputBuffer key;
+        for (const auto& name : columnNames) {
+            key.clear();
+            appendJsonString(key, name);
+            keys_.push_back(key.str() + ":");
+        }
+        out_.append('[');
+        return;
+    }
+
+    for (size_t i = 0; i < columnNames.size(); ++i) {
+        if (i > 0) out_.append(',');
+        appendCsvField(out_, columnNames[i]);
+    }
+    out_.append('\n');
+}
+
+void ResultWriter::beginRow() {
+    column_ = 0;
+    if (format_ == Format::JSON) {
+        out_.append(rows_ == 0 ? "\n  {" : ",\n  {");
+    }
+}
+
+void ResultWriter::endRow() {
+    out_.append(format_ == Format::JSON ? '}' : '\n');
+    ++rows_;
+}
+
+void ResultWriter::separator() {
+    if (format_ == Format::JSON) {
+        if (column_ > 0) out_.append(',');
+        if (column_ < keys_.size()) out_.append(keys_[column_]);
+    } else if (column_ > 0) {
+        out_.append(',');
+    }
+    ++column_;
+}
+
+void ResultWriter::writeNull() {
+    separator();
+    if (format_ == Format::JSON) out_.append("null");
+}
+
+void ResultWriter::writeInt(int32_t value) {
+    separator();
+    out_.appendInt(value);
+}
+
+void ResultWriter::writeBool(bool value) {
+    separator();
+    out_.append(value ? "true" : "false");
+}
+
+void ResultWriter::writeString(std::string_view value) {
+    separator();
+    if (format_ == Format::JSON) {
+        appendJsonString(out_, value);
+    } else {
+        appendCsvField(out_, value);
+    }
+}
+
+void ResultWriter::writeRow(const Tuple& tuple) {
+    beginRow();
+    for (const auto& value : tuple.getValues()) {
+        switch (value.getType()) {
+            case TypeId::INVALID: writeNull(); break;
+            case TypeId::INTEGER: writeInt(value.getAsInt()); break;
+            case TypeId::BOOLEAN: writeBool(value.getAsBool()); break;
+            case TypeId::VARCHAR: writeString(value.getStringView()); break;
+            default: writeString(value.toString()); break;
+        }
+    }
+    endRow();
+}
+
+void ResultWriter::writeRow(const QueryResult& result, size_t row) {
+    beginRow();
+    for (size_t col = 0; col < result.columnCount(); ++col) {
+        if (result.isNull(row, col)) {
+            writeNull();
+            continue;
+        }
+        switch (result.getColumnType(col)) {
+            case TypeId::INTEGER: writeInt(result.getInt(row, col)); break;
+            case TypeId::BOOLEAN: writeBool(result.getInt(row, col) != 0); break;
+            default: writeString(result.getString(row, col)); break;
+        }
+    }
+    endRow();
+}
+
+void ResultWriter::writeAll(const QueryResult& result) {
+    // 没有列名的列（只用 addRow 填充的结果）按位置命名
+    std::vector<std::string> names = result.getColumnNames();
+    for (size_t col = names.size(); col < result.columnCount(); ++col) {
+        names.push_back(std::to_string(col));
+    }
+    begin(names);
+    for (size_t row = 0; row < result.rowCount(); ++row) {
+        writeRow(result, row);
+    }
+    end();
+}
+
+void ResultWriter::end() {
+    if (format_ == Format::JSON) {
+        out_.append(rows_ == 0 ? "]" : "\n]");
+    }
+    out_.flush();
+}
+
+} // namespace minidb
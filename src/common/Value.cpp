@@ -48,6 +48,13 @@ std::string Value::getAsString() const {
     return std::get<std::string>(value_);
 }
 
+std::string_view Value::getStringView() const {
+    if (type_id_ != TypeId::VARCHAR) {
+        throw TypeMismatchException("Expected VARCHAR, got " + std::string(getTypeName(type_id_)));
+    }
+    return std::get<std::string>(value_);
+}
+
 std::string Value::toString() const {
     if (isNull()) return "NULL";
     
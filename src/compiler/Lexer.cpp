@@ -13,7 +13,11 @@ void Lexer::initKeywords() {
     keywords = {
         "SELECT", "FROM", "WHERE", "CREATE", "TABLE",
         "INSERT", "INTO", "VALUES", "INT", "INTEGER",
-        "STRING", "VARCHAR", "FLOAT", "DOUBLE", "DELETE", 
+        "STRING", "VARCHAR", "FLOAT", "DOUBLE", "DELETE",
+        "INDEX", "ON", "UNIQUE", "AND", "OR", "NOT",
+        "JOIN", "INNER", "GROUP", "BY",
+        "COUNT", "SUM", "MIN", "MAX", "AVG", "ORDER", "ASC", "DESC",
+        "LIMIT", "OFFSET", "COPY", "HEADER",
         "int", "integer", "string", "varchar", "float", "double", "delete"
     };
 }
@@ -39,12 +43,15 @@ void Lexer::skipWhitespace() {
 }
 
 // 处理标识符和关键字（以字母或下划线开头，后续可跟字母、数字或下划线）
+// 带表名限定的列名（如 "orders.id"）整体作为一个标识符
 Token Lexer::handleIdentifierOrKeyword() {
     int startColumn = column;  // 记录起始列号（用于错误定位）
     size_t startPos = pos;     // 记录起始位置（用于截取字符串）
 
-    // 遍历字符直到遇到非字母/数字/下划线
-    while (pos < sql.size() && (isalnum(sql[pos]) || sql[pos] == '_')) {
+    // 遍历字符直到遇到非字母/数字/下划线（'.' 后紧跟字母或下划线时视为限定名的一部分）
+    while (pos < sql.size() &&
+           (isalnum(sql[pos]) || sql[pos] == '_' ||
+            (sql[pos] == '.' && pos + 1 < sql.size() && (isalpha(sql[pos + 1]) || sql[pos + 1] == '_')))) {
         pos++;
         column++;
     }
@@ -139,7 +146,7 @@ Token Lexer::handleOperator() {
         op_str += next;
 
         // 明确列出所有双字符运算符，确保覆盖
-        const std::unordered_set<std::string> double_ops = {"==", "!=", ">=", "<="};
+        const std::unordered_set<std::string> double_ops = {"==", "!=", "<>", ">=", "<="};
         if (double_ops.count(op_str)) {
             pos += 2;
             column += 2;
@@ -201,6 +208,11 @@ Token Lexer::nextToken() {
     else if (c == ',' || c == ';' || c == '(' || c == ')' || c == '{' || c == '}') { // 补充 } 界符
         return handleDelimiter();
     }
+    else if (c == '?') {
+        pos++;
+        column++;
+        return Token(TokenType::PARAMETER, "?", line, column - 1);
+    }
     else {
         // 修复：中文→英文错误信息
         pos++;
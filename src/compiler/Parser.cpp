@@ -1,23 +1,31 @@
 /*
  * Parser.cpp - 基于LL(1)文法的SQL语法解析器
  * 支持SQL语句类型：
- * 1. SELECT（带WHERE子句、多列查询、通配符*）
+ * 1. SELECT（带WHERE子句、多列查询、通配符*、聚合函数、GROUP BY、ORDER BY与LIMIT/OFFSET）
  * 2. CREATE TABLE（多列定义，支持STRING/INT类型）
  * 3. INSERT（多值插入，兼容带引号/无引号字符串常量）
  * 4. DELETE（删除语句）
+ * 5. CREATE [UNIQUE] INDEX（单列/组合索引）
  */
 
 #include "../../include/compiler/Parser.h"
 #include "../../include/compiler/AST.h"
 
 #include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
 #include <memory>
+#include <mutex>
 
 using namespace std;
 
+unordered_map<string, vector<string>> Parser::predictTable;
+
+// 预测表只初始化一次
+static once_flag predictTableOnce;
+
 // 将TokenType转换为字符串，用于调试输出
 static std::string tokenTypeToString(TokenType type) {
     switch (type) {
@@ -28,6 +36,7 @@ static std::string tokenTypeToString(TokenType type) {
     case TokenType::DELIMITER: return "DELIMITER";
     case TokenType::ERROR: return "ERROR";
     case TokenType::EOF_TOKEN: return "EOF";
+    case TokenType::PARAMETER: return "PARAMETER";
     default: return "UNKNOWN";
     }
 }
@@ -43,6 +52,31 @@ static std::string tokensToString(const std::vector<Token>& tokens) {
     return result;
 }
 
+// 整个WHERE是单个 "列 运算符 常量" 比较时，转换为简单条件（供索引选择等沿用）
+static optional<Condition> toSimpleCondition(const ExprPtr& where) {
+    static const vector<string> comparisonOps = {"=", "==", "!=", "<>", "<", "<=", ">", ">="};
+    if (!where || where->kind != Expr::Kind::Binary ||
+        find(comparisonOps.begin(), comparisonOps.end(), where->value) == comparisonOps.end()) {
+        return nullopt;
+    }
+    if (where->left->kind != Expr::Kind::Column || where->right->kind != Expr::Kind::Literal) {
+        return nullopt;
+    }
+    return Condition(where->left->value, where->value, where->right->value);
+}
+
+// 表达式树转换为字符串（调试输出用），二元运算加括号以体现结合关系
+static std::string exprToString(const ExprPtr& expr) {
+    switch (expr->kind) {
+    case Expr::Kind::Column: return expr->value;
+    case Expr::Kind::Literal: return expr->value;
+    case Expr::Kind::Unary: return expr->value + " " + exprToString(expr->left);
+    case Expr::Kind::Binary:
+        return "(" + exprToString(expr->left) + " " + expr->value + " " + exprToString(expr->right) + ")";
+    }
+    return "";
+}
+
 // match函数完整实现
 void Parser::match(const string& expectedValue) {
     // 生成当前Token的标识
@@ -57,7 +91,8 @@ void Parser::match(const string& expectedValue) {
         if (expectedValue == "CONSTANT") {
             currentTokenKey = "CONSTANT";
         }
-    } else if (currentToken.type == TokenType::CONSTANT) {
+    } else if (currentToken.type == TokenType::CONSTANT || currentToken.type == TokenType::PARAMETER) {
+        // 参数占位符可出现在任何常量的位置
         currentTokenKey = "CONSTANT";
     } else if (currentToken.type == TokenType::OPERATOR) {
         if (currentToken.value == "*") {
@@ -136,7 +171,7 @@ Parser::Parser(const std::vector<Token>& tokenList)
       currentToken(TokenType::ERROR, "", -1, -1),
       tokenPos(0) {
 
-    initPredictTable();
+    call_once(predictTableOnce, [this] { initPredictTable(); });
     //语法栈初始化：栈底为EOF（结束符），栈顶为开始符号Prog
     symStack.push("EOF");
     symStack.push("Prog");
@@ -159,7 +194,7 @@ Parser::Parser(Lexer& l)
       currentToken(TokenType::ERROR, "", -1, -1),
       tokenPos(0) {
 
-    initPredictTable();
+    call_once(predictTableOnce, [this] { initPredictTable(); });
     //语法栈初始化：栈底为EOF（结束符），栈顶为开始符号Prog
     symStack.push("EOF");
     symStack.push("Prog");
@@ -182,6 +217,7 @@ void Parser::initPredictTable() {
     predictTable["Prog|KEYWORD(CREATE)"] = {"Stmt", "EOF"};
     predictTable["Prog|KEYWORD(INSERT)"] = {"Stmt", "EOF"};
     predictTable["Prog|KEYWORD(DELETE)"] = {"Stmt", "EOF"};
+    predictTable["Prog|KEYWORD(COPY)"] = {"Stmt", "EOF"};
     predictTable["Prog|EOF"] = {}; // 允许空输入
 
     // 2. 语句规则：Stmt → CreateTable | Insert | Select | Delete（分发到具体语句）
@@ -189,6 +225,7 @@ void Parser::initPredictTable() {
     predictTable["Stmt|KEYWORD(INSERT)"] = {"Insert"};
     predictTable["Stmt|KEYWORD(SELECT)"] = {"Select"};
     predictTable["Stmt|KEYWORD(DELETE)"] = {"Delete"};
+    predictTable["Stmt|KEYWORD(COPY)"] = {"Copy"};
 
     // 12. DELETE语句规则：Delete → DELETE FROM 表名 WHERE子句 ;
     predictTable["Delete|KEYWORD(DELETE)"] = {
@@ -201,6 +238,18 @@ void Parser::initPredictTable() {
         LPAREN, "ColumnList", RPAREN, SEMICOLON
     };
 
+    // 3.1 CREATE INDEX语句规则：CreateIndex → CREATE [UNIQUE] INDEX 索引名 ON 表名 ( 索引列 ) ;
+    // CREATE 之后需要再看一个Token才能区分 TABLE/INDEX，由 parseStmt 向前看一个Token完成选择
+    predictTable["CreateIndex|KEYWORD(CREATE)"] = {
+        "KEYWORD(CREATE)", "IndexUnique", "KEYWORD(INDEX)", "IDENTIFIER", "KEYWORD(ON)",
+        "IDENTIFIER", LPAREN, "IndexColumns", RPAREN, SEMICOLON
+    };
+    predictTable["IndexUnique|KEYWORD(UNIQUE)"] = {"KEYWORD(UNIQUE)"};
+    predictTable["IndexUnique|KEYWORD(INDEX)"] = {};
+    predictTable["IndexColumns|IDENTIFIER"] = {"IDENTIFIER", "IndexColumns'"};
+    predictTable["IndexColumns'|,"] = {COMMA, "IDENTIFIER", "IndexColumns'"};
+    predictTable["IndexColumns'|)"] = {};
+
     // 4. 列列表规则（消除左递归）
     predictTable["ColumnList|IDENTIFIER"] = {"Column", "ColumnList'"};  // 初始列（由列名触发）
     predictTable["ColumnList'|,"] = {COMMA, "Column", "ColumnList'"};   // 逗号后接新列
@@ -216,11 +265,21 @@ void Parser::initPredictTable() {
     predictTable["KEYWORD(TYPE)|KEYWORD(FLOAT)"] = {"KEYWORD(FLOAT)"};
     predictTable["KEYWORD(TYPE)|KEYWORD(BOOLEAN)"] = {"KEYWORD(BOOLEAN)"};
 
-    // 6. INSERT语句规则：Insert → INSERT INTO 表名 VALUES ( 值列表 ) ;
+    // 6. INSERT语句规则：Insert → INSERT INTO 表名 VALUES ( 值列表 ) 行列表 ;
     predictTable["Insert|KEYWORD(INSERT)"] = {
         "KEYWORD(INSERT)", "KEYWORD(INTO)", "IDENTIFIER",
-        "KEYWORD(VALUES)", LPAREN, "ValueList", RPAREN, SEMICOLON
+        "KEYWORD(VALUES)", LPAREN, "ValueList", RPAREN, "RowList", SEMICOLON
     };
+    // 多行插入：RowList → , ( 值列表 ) RowList | ε
+    predictTable["RowList|,"] = {COMMA, LPAREN, "ValueList", RPAREN, "RowList"};
+    predictTable["RowList|;"] = {};
+
+    // 6.1 COPY语句规则：Copy → COPY 表名 FROM 文件路径 [HEADER] ;
+    predictTable["Copy|KEYWORD(COPY)"] = {
+        "KEYWORD(COPY)", "IDENTIFIER", "KEYWORD(FROM)", "CONSTANT", "CopyOptions", SEMICOLON
+    };
+    predictTable["CopyOptions|KEYWORD(HEADER)"] = {"KEYWORD(HEADER)"};
+    predictTable["CopyOptions|;"] = {};
 
     // 7. 值列表规则（消除左递归，兼容无引号字符串）
     predictTable["ValueList|CONSTANT"] = {"CONSTANT", "ValueList'"};    // 正常常量（带引号字符串/数字）
@@ -228,25 +287,86 @@ void Parser::initPredictTable() {
     predictTable["ValueList'|,"] = {COMMA, "CONSTANT", "ValueList'"};   // 逗号后接新值
     predictTable["ValueList'|)"] = {};                                 // 右括号结束（空产生式）
 
-    // 8. SELECT语句规则：Select → SELECT 查询列 FROM 表名 WHERE子句 ;
+    // 8. SELECT语句规则：Select → SELECT 查询列 FROM 表名 JOIN列表 WHERE子句 GROUP BY子句 ORDER BY子句 LIMIT子句 ;
     predictTable["Select|KEYWORD(SELECT)"] = {
         "KEYWORD(SELECT)", "SelectColumns", "KEYWORD(FROM)",
-        "IDENTIFIER", "WhereClause", SEMICOLON
+        "IDENTIFIER", "JoinList", "WhereClause", "GroupByClause", "OrderByClause", "LimitClause", SEMICOLON
     };
 
+    // 8.1 JOIN列表规则：JoinList → JoinClause JoinList | ε；JoinClause → [INNER] JOIN 表名 ON Expr
+    predictTable["JoinList|KEYWORD(JOIN)"] = {"JoinClause", "JoinList"};
+    predictTable["JoinList|KEYWORD(INNER)"] = {"JoinClause", "JoinList"};
+    predictTable["JoinList|KEYWORD(WHERE)"] = {};
+    predictTable["JoinList|KEYWORD(GROUP)"] = {};
+    predictTable["JoinList|KEYWORD(ORDER)"] = {};
+    predictTable["JoinList|KEYWORD(LIMIT)"] = {};
+    predictTable["JoinList|;"] = {};
+    predictTable["JoinClause|KEYWORD(INNER)"] = {"KEYWORD(INNER)", "KEYWORD(JOIN)", "IDENTIFIER", "KEYWORD(ON)", "Expr"};
+    predictTable["JoinClause|KEYWORD(JOIN)"] = {"KEYWORD(JOIN)", "IDENTIFIER", "KEYWORD(ON)", "Expr"};
+
     // 9. 查询列列表规则（消除左递归，支持通配符）
     predictTable["SelectColumns|STAR"] = {STAR};                           // 通配符*（查询所有列）
-    predictTable["SelectColumns|IDENTIFIER"] = {"IDENTIFIER", "SelectColumns'"};  // 具体列名
-    predictTable["SelectColumns'|,"] = {COMMA, "IDENTIFIER", "SelectColumns'"};   // 逗号后接新查询列
+    predictTable["SelectColumns|IDENTIFIER"] = {"SelectItem", "SelectColumns'"};  // 具体列名
+    predictTable["SelectColumns'|,"] = {COMMA, "SelectItem", "SelectColumns'"};   // 逗号后接新查询列
+    // 查询项：SelectItem → IDENTIFIER | Aggregate；Aggregate → 函数名 ( * | IDENTIFIER )
+    predictTable["SelectItem|IDENTIFIER"] = {"IDENTIFIER"};
+    for (const char* func : {"COUNT", "SUM", "MIN", "MAX", "AVG"}) {
+        string keyword = string("KEYWORD(") + func + ")";
+        predictTable["SelectColumns|" + keyword] = {"SelectItem", "SelectColumns'"};
+        predictTable["SelectItem|" + keyword] = {"Aggregate"};
+        predictTable["Aggregate|" + keyword] = {keyword, LPAREN, "AggregateArg", RPAREN};
+    }
+    predictTable["AggregateArg|STAR"] = {STAR};
+    predictTable["AggregateArg|IDENTIFIER"] = {"IDENTIFIER"};
     predictTable["SelectColumns'|KEYWORD(FROM)"] = {};                             // 遇到FROM结束
     predictTable["SelectColumns'|;"] = {};                               // 遇到分号结束（无FROM场景）
 
     // 10. WHERE子句规则（可选）
-    predictTable["WhereClause|KEYWORD(WHERE)"] = {"KEYWORD(WHERE)", "Condition"};  // 有WHERE时解析条件
+    predictTable["WhereClause|KEYWORD(WHERE)"] = {"KEYWORD(WHERE)", "Expr"};  // 有WHERE时解析条件表达式
     predictTable["WhereClause|;"] = {};                                 // 无WHERE时直接结束
-
-    // 11. 条件表达式规则：Condition → 列名 运算符 值（IDENTIFIER → 列名，OPERATOR → 运算符，CONSTANT → 值）
-    predictTable["Condition|IDENTIFIER"] = {"IDENTIFIER", "OPERATOR", "CONSTANT"};
+    predictTable["WhereClause|KEYWORD(GROUP)"] = {};                    // 无WHERE，后接GROUP BY
+    predictTable["WhereClause|KEYWORD(ORDER)"] = {};                    // 无WHERE，后接ORDER BY
+    predictTable["WhereClause|KEYWORD(LIMIT)"] = {};                    // 无WHERE，后接LIMIT
+
+    // 10.1 GROUP BY子句规则：GroupByClause → GROUP BY IDENTIFIER GroupByList' | ε
+    predictTable["GroupByClause|KEYWORD(GROUP)"] = {"KEYWORD(GROUP)", "KEYWORD(BY)", "IDENTIFIER", "GroupByList'"};
+    predictTable["GroupByClause|;"] = {};
+    predictTable["GroupByClause|KEYWORD(ORDER)"] = {};
+    predictTable["GroupByClause|KEYWORD(LIMIT)"] = {};
+    predictTable["GroupByList'|,"] = {COMMA, "IDENTIFIER", "GroupByList'"};
+    predictTable["GroupByList'|;"] = {};
+    predictTable["GroupByList'|KEYWORD(ORDER)"] = {};
+    predictTable["GroupByList'|KEYWORD(LIMIT)"] = {};
+
+    // 10.2 ORDER BY子句规则：OrderByClause → ORDER BY OrderItem OrderByList' | ε；OrderItem → IDENTIFIER [ASC|DESC]
+    predictTable["OrderByClause|KEYWORD(ORDER)"] = {"KEYWORD(ORDER)", "KEYWORD(BY)", "OrderItem", "OrderByList'"};
+    predictTable["OrderByClause|;"] = {};
+    predictTable["OrderByClause|KEYWORD(LIMIT)"] = {};
+    predictTable["OrderItem|IDENTIFIER"] = {"IDENTIFIER", "SortOrder"};
+    predictTable["SortOrder|KEYWORD(ASC)"] = {"KEYWORD(ASC)"};
+    predictTable["SortOrder|KEYWORD(DESC)"] = {"KEYWORD(DESC)"};
+    predictTable["SortOrder|,"] = {};
+    predictTable["SortOrder|;"] = {};
+    predictTable["SortOrder|KEYWORD(LIMIT)"] = {};
+    predictTable["OrderByList'|,"] = {COMMA, "OrderItem", "OrderByList'"};
+    predictTable["OrderByList'|;"] = {};
+    predictTable["OrderByList'|KEYWORD(LIMIT)"] = {};
+
+    // 10.3 LIMIT子句规则：LimitClause → LIMIT CONSTANT OffsetClause | ε；OffsetClause → OFFSET CONSTANT | ε
+    predictTable["LimitClause|KEYWORD(LIMIT)"] = {"KEYWORD(LIMIT)", "CONSTANT", "OffsetClause"};
+    predictTable["LimitClause|;"] = {};
+    predictTable["OffsetClause|KEYWORD(OFFSET)"] = {"KEYWORD(OFFSET)", "CONSTANT"};
+    predictTable["OffsetClause|;"] = {};
+
+    // 11. 条件表达式 Expr 由 parseExpression 按优先级递归下降解析：
+    //   Expr       → OrExpr
+    //   OrExpr     → AndExpr { OR AndExpr }
+    //   AndExpr    → NotExpr { AND NotExpr }
+    //   NotExpr    → NOT NotExpr | Comparison
+    //   Comparison → Additive [ 比较运算符 Additive ]
+    //   Additive   → Primary { (+|-) Primary }
+    //   Primary    → IDENTIFIER | CONSTANT | - CONSTANT | ( Expr )
+    // 所有运算符在Token层面都是 OPERATOR，预测表无法区分比较与加减，因此不走预测表
 }
 
 
@@ -262,7 +382,7 @@ void Parser::parseNonTerminal(const string& nonTerminal) {
         currentTokenKey = "KEYWORD(" + keywordValue + ")";
     } else if (currentToken.type == TokenType::IDENTIFIER) {
         currentTokenKey = "IDENTIFIER";
-    } else if (currentToken.type == TokenType::CONSTANT) {
+    } else if (currentToken.type == TokenType::CONSTANT || currentToken.type == TokenType::PARAMETER) {
         currentTokenKey = "CONSTANT";
     } else if (currentToken.type == TokenType::OPERATOR) {
         // 特殊处理通配符*，确保它被正确识别为STAR而不是OPERATOR
@@ -287,7 +407,7 @@ void Parser::parseNonTerminal(const string& nonTerminal) {
                << "（非终结符: " << nonTerminal << ", Token: " << currentToken.value << "）";
         throw runtime_error(errMsg.str());
     }
-    vector<string> production = predictTable[tableKey];
+    const vector<string>& production = predictTable.at(tableKey);
 
     //3. 验证语法栈顶是否为当前非终结符（确保解析逻辑正确性）
     if (symStack.empty() || symStack.top() != nonTerminal) {
@@ -425,15 +545,29 @@ unique_ptr<ASTNode> Parser::parseStmt() {
     parseNonTerminal("Stmt");
     unique_ptr<ASTNode> resultAST;
 
+    // CREATE 后紧跟 INDEX/UNIQUE 时改走 CREATE INDEX 产生式
+    if (!symStack.empty() && symStack.top() == "CreateTable" && tokenPos + 1 < tokens.size()) {
+        string next = tokens[tokenPos + 1].value;
+        transform(next.begin(), next.end(), next.begin(), ::toupper);
+        if (tokens[tokenPos + 1].type == TokenType::KEYWORD && (next == "INDEX" || next == "UNIQUE")) {
+            symStack.pop();
+            symStack.push("CreateIndex");
+        }
+    }
+
     // 根据语法栈顶符号，分发到对应语句的解析函数
     if (!symStack.empty() && symStack.top() == "CreateTable") {
         resultAST = parseCreateTable();
+    } else if (!symStack.empty() && symStack.top() == "CreateIndex") {
+        resultAST = parseCreateIndex();
     } else if (!symStack.empty() && symStack.top() == "Insert") {
         resultAST = parseInsert();
     } else if (!symStack.empty() && symStack.top() == "Select") {
         resultAST = parseSelect();
     } else if (!symStack.empty() && symStack.top() == "Delete") {
         resultAST = parseDelete();
+    } else if (!symStack.empty() && symStack.top() == "Copy") {
+        resultAST = parseCopy();
     } else {
         throw runtime_error("未知语句类型：栈顶为'" + (symStack.empty() ? "空" : symStack.top()) + "'");
     }
@@ -454,8 +588,9 @@ unique_ptr<SelectAST> Parser::parseSelect() {
         symStack.pop();
     }
 
-    //2. 解析查询列列表（如 "name, age" 或 "*"）
-    vector<string> selectCols = parseSelectColumns();
+    //2. 解析查询列列表（如 "name, age"、"*" 或 "age, COUNT(*)"）
+    vector<AggregateCall> aggregates;
+    vector<string> selectCols = parseSelectColumns(aggregates);
 
     //3. 匹配FROM关键字（确保语法结构正确）
     if (symStack.empty() || symStack.top() != "KEYWORD(FROM)") {
@@ -477,10 +612,24 @@ unique_ptr<SelectAST> Parser::parseSelect() {
         symStack.pop();
     }
 
-    //5. 解析WHERE子句（可选，无WHERE时返回空）
-    optional<Condition> condition = parseWhereClause();
+    //5. 解析JOIN子句（可选，可以有多个）
+    vector<JoinClause> joins = parseJoinList();
+
+    //6. 解析WHERE子句（可选，无WHERE时返回空）
+    ExprPtr where = parseWhereClause();
+
+    //7. 解析GROUP BY子句（可选）
+    vector<string> groupBy = parseGroupByClause();
+
+    //8. 解析ORDER BY子句（可选）
+    vector<OrderByItem> orderBy = parseOrderByClause();
 
-    //6. 匹配语句结束分号
+    //9. 解析LIMIT/OFFSET子句（可选）
+    size_t limit = 0;
+    size_t offset = 0;
+    bool hasLimit = parseLimitClause(limit, offset);
+
+    //10. 匹配语句结束分号
     match("SEMICOLON");
     if (!symStack.empty() && symStack.top() == "SEMICOLON") {
         symStack.pop();
@@ -490,14 +639,59 @@ unique_ptr<SelectAST> Parser::parseSelect() {
     auto ast = make_unique<SelectAST>();
     ast->columns = selectCols;
     ast->tableName = tableName;
-    ast->condition = condition;
+    ast->joins = std::move(joins);
+    ast->condition = toSimpleCondition(where);
+    ast->where = where;
+    ast->aggregates = std::move(aggregates);
+    ast->groupBy = std::move(groupBy);
+    ast->orderBy = std::move(orderBy);
+    if (hasLimit) {
+        ast->limit = limit;
+        ast->offset = offset;
+    }
     return ast;
 }
 
+/**
+ * 解析JOIN列表：JoinList → JoinClause JoinList | ε
+ * JoinClause → [INNER] JOIN 表名 ON Expr
+ * @return 按出现顺序的JOIN子句（无JOIN时为空）
+ */
+vector<JoinClause> Parser::parseJoinList() {
+    vector<JoinClause> joins;
+    while (!symStack.empty() && symStack.top() == "JoinList") {
+        parseNonTerminal("JoinList");
+        if (symStack.empty() || symStack.top() != "JoinClause") {
+            break;  // 空产生式：JOIN列表结束
+        }
+        parseNonTerminal("JoinClause");
+
+        if (symStack.top() == "KEYWORD(INNER)") {
+            match("KEYWORD(INNER)");
+            symStack.pop();
+        }
+        match("KEYWORD(JOIN)");
+        symStack.pop();
+
+        JoinClause join;
+        join.tableName = currentToken.value;
+        match("IDENTIFIER");
+        symStack.pop();
+
+        match("KEYWORD(ON)");
+        symStack.pop();
+
+        symStack.pop();  // Expr 由递归下降解析
+        join.on = parseExpression();
+        joins.push_back(std::move(join));
+    }
+    return joins;
+}
+
 /**
  * 解析INSERT语句：生成InsertAST节点
- * 支持：多值插入，兼容带引号/无引号字符串常量
- * @return InsertAST节点（包含目标表名、插入值列表）
+ * 支持：多值插入、多行插入（VALUES (...), (...)），兼容带引号/无引号字符串常量
+ * @return InsertAST节点（包含目标表名、各行插入值列表）
  */
 unique_ptr<InsertAST> Parser::parseInsert() {
     parseNonTerminal("Insert");
@@ -534,7 +728,8 @@ unique_ptr<InsertAST> Parser::parseInsert() {
     }
 
     // 解析插入值列表
-    vector<string> values = parseValueList();
+    vector<vector<string>> rows;
+    rows.push_back(parseValueList());
 
     // 匹配右括号（值列表结束）
     match(RPAREN);
@@ -542,6 +737,21 @@ unique_ptr<InsertAST> Parser::parseInsert() {
         symStack.pop();
     }
 
+    // 逗号后接更多行
+    while (!symStack.empty() && symStack.top() == "RowList") {
+        parseNonTerminal("RowList");
+        if (symStack.empty() || symStack.top() != COMMA) {
+            break;  // 空产生式：行列表结束
+        }
+        match(COMMA);
+        symStack.pop();
+        match(LPAREN);
+        symStack.pop();
+        rows.push_back(parseValueList());
+        match(RPAREN);
+        symStack.pop();
+    }
+
     // 匹配语句结束分号
     match("SEMICOLON");
     if (!symStack.empty() && symStack.top() == "SEMICOLON") {
@@ -551,7 +761,53 @@ unique_ptr<InsertAST> Parser::parseInsert() {
     // 构建InsertAST并返回
     auto ast = make_unique<InsertAST>();
     ast->tableName = tableName;
-    ast->values = values;
+    ast->rows = std::move(rows);
+    return ast;
+}
+
+/**
+ * 解析COPY语句：生成CopyAST节点
+ * COPY 表名 FROM '文件路径' [HEADER]; HEADER 表示首行为列名，导入时跳过
+ * @return CopyAST节点（包含目标表名、文件路径）
+ */
+unique_ptr<CopyAST> Parser::parseCopy() {
+    parseNonTerminal("Copy");
+
+    match("KEYWORD(COPY)");
+    symStack.pop();
+
+    string tableName = currentToken.value;
+    match("IDENTIFIER");
+    symStack.pop();
+
+    match("KEYWORD(FROM)");
+    symStack.pop();
+
+    // 字符串常量由词法分析器去掉了引号
+    if (currentToken.type != TokenType::CONSTANT) {
+        throw runtime_error("COPY 需要文件路径常量，实际为: " + currentToken.value);
+    }
+    string filePath = currentToken.value;
+    match("CONSTANT");
+    symStack.pop();
+
+    parseNonTerminal("CopyOptions");
+    bool header = false;
+    if (!symStack.empty() && symStack.top() == "KEYWORD(HEADER)") {
+        match("KEYWORD(HEADER)");
+        symStack.pop();
+        header = true;
+    }
+
+    match("SEMICOLON");
+    if (!symStack.empty() && symStack.top() == "SEMICOLON") {
+        symStack.pop();
+    }
+
+    auto ast = make_unique<CopyAST>();
+    ast->tableName = tableName;
+    ast->filePath = filePath;
+    ast->header = header;
     return ast;
 }
 
@@ -610,12 +866,77 @@ unique_ptr<CreateTableAST> Parser::parseCreateTable() {
     return ast;
 }
 
+/**
+ * 解析CREATE INDEX语句：生成CreateIndexAST节点
+ * 支持 UNIQUE 修饰和多列组合索引
+ * @return CreateIndexAST节点（包含索引名、表名、索引列）
+ */
+unique_ptr<CreateIndexAST> Parser::parseCreateIndex() {
+    parseNonTerminal("CreateIndex");
+    auto ast = make_unique<CreateIndexAST>();
+
+    // 匹配CREATE关键字
+    match("KEYWORD(CREATE)");
+    symStack.pop();
+
+    // 可选的UNIQUE修饰
+    parseNonTerminal("IndexUnique");
+    if (!symStack.empty() && symStack.top() == "KEYWORD(UNIQUE)") {
+        match("KEYWORD(UNIQUE)");
+        symStack.pop();
+        ast->isUnique = true;
+    }
+
+    // 匹配INDEX关键字和索引名
+    match("KEYWORD(INDEX)");
+    symStack.pop();
+    ast->indexName = currentToken.value;
+    match("IDENTIFIER");
+    symStack.pop();
+
+    // 匹配ON关键字和表名
+    match("KEYWORD(ON)");
+    symStack.pop();
+    ast->tableName = currentToken.value;
+    match("IDENTIFIER");
+    symStack.pop();
+
+    // 解析括号内的索引列列表
+    match(LPAREN);
+    symStack.pop();
+    parseNonTerminal("IndexColumns");
+    while (!symStack.empty() && symStack.top() != RPAREN) {
+        string stackTop = symStack.top();
+        if (stackTop == "IDENTIFIER") {
+            ast->columns.push_back(currentToken.value);
+            match("IDENTIFIER");
+            symStack.pop();
+        } else if (stackTop == COMMA) {
+            match(COMMA);
+            symStack.pop();
+        } else if (stackTop == "IndexColumns'") {
+            parseNonTerminal(stackTop);
+        } else {
+            throw runtime_error("CREATE INDEX语法错误：索引列列表异常，栈顶为'" + stackTop + "'");
+        }
+    }
+    match(RPAREN);
+    symStack.pop();
+
+    // 匹配语句结束分号
+    match("SEMICOLON");
+    if (!symStack.empty() && symStack.top() == "SEMICOLON") {
+        symStack.pop();
+    }
+    return ast;
+}
+
 //列表解析函数
 /**
  * 解析查询列列表（SELECT用）：如 "name, age" 或 "*"
  * @return 查询列名称列表（如 ["name", "age"] 或 ["*"]）
  */
-vector<string> Parser::parseSelectColumns() {
+vector<string> Parser::parseSelectColumns(vector<AggregateCall>& aggregates) {
     parseNonTerminal("SelectColumns");
     vector<string> columns;
     bool parsingComplete = false;
@@ -634,11 +955,19 @@ vector<string> Parser::parseSelectColumns() {
             columns.push_back("*");
             match(STAR);
             symStack.pop();
+        } else if (stackTop == "SelectItem") {
+            // 按当前Token展开为列名或聚合函数
+            parseNonTerminal("SelectItem");
         } else if (stackTop == "IDENTIFIER") {
             // 匹配具体列名（如 "name"、"age"）
             columns.push_back(currentToken.value);
             match("IDENTIFIER");
             symStack.pop();
+        } else if (stackTop == "Aggregate") {
+            // 聚合函数调用，查询列中记为 "FUNC(col)"
+            AggregateCall call = parseAggregate();
+            columns.push_back(call.name());
+            aggregates.push_back(std::move(call));
         } else if (stackTop == "SelectColumns'") {
             // 处理递归部分（逗号分隔的后续列）
             symStack.pop();
@@ -660,6 +989,142 @@ vector<string> Parser::parseSelectColumns() {
     return columns;
 }
 
+/**
+ * 解析聚合函数调用：Aggregate → 函数名 ( * | IDENTIFIER )
+ * @return 函数名（大写）与参数列
+ */
+AggregateCall Parser::parseAggregate() {
+    parseNonTerminal("Aggregate");
+
+    AggregateCall call;
+    call.func = currentToken.value;
+    transform(call.func.begin(), call.func.end(), call.func.begin(), ::toupper);
+    match(symStack.top());
+    symStack.pop();
+
+    match(LPAREN);
+    symStack.pop();
+
+    parseNonTerminal("AggregateArg");
+    if (symStack.top() == STAR) {
+        call.column = "*";
+        match(STAR);
+    } else {
+        call.column = currentToken.value;
+        match("IDENTIFIER");
+    }
+    symStack.pop();
+
+    match(RPAREN);
+    symStack.pop();
+    return call;
+}
+
+/**
+ * 解析GROUP BY子句：GroupByClause → GROUP BY IDENTIFIER GroupByList' | ε
+ * @return 分组列（无GROUP BY时为空）
+ */
+vector<string> Parser::parseGroupByClause() {
+    parseNonTerminal("GroupByClause");
+    vector<string> columns;
+    if (symStack.empty() || symStack.top() != "KEYWORD(GROUP)") {
+        return columns;  // 空产生式
+    }
+    match("KEYWORD(GROUP)");
+    symStack.pop();
+    match("KEYWORD(BY)");
+    symStack.pop();
+
+    while (!symStack.empty()) {
+        const string stackTop = symStack.top();
+        if (stackTop == "IDENTIFIER") {
+            columns.push_back(currentToken.value);
+            match("IDENTIFIER");
+            symStack.pop();
+        } else if (stackTop == "GroupByList'") {
+            parseNonTerminal("GroupByList'");
+        } else if (stackTop == COMMA) {
+            match(COMMA);
+            symStack.pop();
+        } else {
+            break;  // 分组列结束，栈顶为分号
+        }
+    }
+    return columns;
+}
+
+/**
+ * 解析ORDER BY子句：OrderByClause → ORDER BY OrderItem OrderByList' | ε
+ * @return 排序列及升降序（无ORDER BY时为空）
+ */
+vector<OrderByItem> Parser::parseOrderByClause() {
+    parseNonTerminal("OrderByClause");
+    vector<OrderByItem> items;
+    if (symStack.empty() || symStack.top() != "KEYWORD(ORDER)") {
+        return items;  // 空产生式
+    }
+    match("KEYWORD(ORDER)");
+    symStack.pop();
+    match("KEYWORD(BY)");
+    symStack.pop();
+
+    while (!symStack.empty()) {
+        const string stackTop = symStack.top();
+        if (stackTop == "OrderItem" || stackTop == "OrderByList'" || stackTop == "SortOrder") {
+            parseNonTerminal(stackTop);
+        } else if (stackTop == "IDENTIFIER") {
+            items.push_back({currentToken.value, true});
+            match("IDENTIFIER");
+            symStack.pop();
+        } else if (stackTop == "KEYWORD(ASC)" || stackTop == "KEYWORD(DESC)") {
+            items.back().ascending = stackTop == "KEYWORD(ASC)";
+            match(stackTop);
+            symStack.pop();
+        } else if (stackTop == COMMA) {
+            match(COMMA);
+            symStack.pop();
+        } else {
+            break;  // 排序列结束，栈顶为分号
+        }
+    }
+    return items;
+}
+
+/**
+ * 解析LIMIT子句：LimitClause → LIMIT CONSTANT OffsetClause | ε；OffsetClause → OFFSET CONSTANT | ε
+ * @return 是否存在LIMIT；行数须为非负整数
+ */
+bool Parser::parseLimitClause(size_t& limit, size_t& offset) {
+    parseNonTerminal("LimitClause");
+    if (symStack.empty() || symStack.top() != "KEYWORD(LIMIT)") {
+        return false;  // 空产生式
+    }
+
+    // 读取一个非负整数常量
+    auto readCount = [this](const string& clause) {
+        string text = currentToken.value;
+        if (currentToken.type != TokenType::CONSTANT || text.empty() ||
+            !all_of(text.begin(), text.end(), ::isdigit)) {
+            throw runtime_error(clause + " 需要非负整数，实际为 '" + text + "'");
+        }
+        match("CONSTANT");
+        symStack.pop();
+        return static_cast<size_t>(stoull(text));
+    };
+
+    match("KEYWORD(LIMIT)");
+    symStack.pop();
+    limit = readCount("LIMIT");
+
+    parseNonTerminal("OffsetClause");
+    if (!symStack.empty() && symStack.top() == "KEYWORD(OFFSET)") {
+        match("KEYWORD(OFFSET)");
+        symStack.pop();
+        offset = readCount("OFFSET");
+    }
+    return true;
+}
+
 /**
  * 解析值列表（INSERT用）：如 "'Alice', 20"
  * @return 插入值字符串列表（如 ["'Alice'", "20"]）
@@ -671,7 +1136,12 @@ vector<string> Parser::parseValueList() {
     while (!symStack.empty()) {
         string stackTop = symStack.top();
 
-        if (stackTop == "CONSTANT") {
+        if (stackTop == "CONSTANT" && currentToken.type == TokenType::PARAMETER) {
+            values.push_back(nextParameter());
+            match("CONSTANT");
+            symStack.pop();
+        }
+        else if (stackTop == "CONSTANT") {
             // 在match之前先保存当前Token的值，因为match会推进token流
             string value = currentToken.value;
 
@@ -830,7 +1300,7 @@ void Parser::parseSelectColumnsPrime() {
     if (predictTable.find(tableKey) == predictTable.end()) {
         throw runtime_error("无匹配的SelectColumns'产生式：" + tableKey);
     }
-    vector<string> production = predictTable[tableKey];
+    const vector<string>& production = predictTable.at(tableKey);
 
     // 逆序压入产生式符号（栈后进先出）
     for (auto it = production.rbegin(); it != production.rend(); ++it) {
@@ -853,7 +1323,7 @@ void Parser::parseValueListPrime() {
     if (predictTable.find(tableKey) == predictTable.end()) {
         throw runtime_error("无匹配的ValueList'产生式：" + tableKey);
     }
-    vector<string> production = predictTable[tableKey];
+    const vector<string>& production = predictTable.at(tableKey);
 
     // 逆序压入产生式符号（栈后进先出）
     for (auto it = production.rbegin(); it != production.rend(); ++it) {
@@ -876,7 +1346,7 @@ void Parser::parseColumnListPrime() {
     if (predictTable.find(tableKey) == predictTable.end()) {
         throw runtime_error("无匹配的ColumnList'产生式：" + tableKey);
     }
-    vector<string> production = predictTable[tableKey];
+    const vector<string>& production = predictTable.at(tableKey);
 
     // 逆序压入产生式符号（栈后进先出）
     for (auto it = production.rbegin(); it != production.rend(); ++it) {
@@ -887,10 +1357,10 @@ void Parser::parseColumnListPrime() {
 }
 
 /**
- * 解析WHERE子句：WhereClause → WHERE Condition | ε
- * @return 可选的Condition对象（有WHERE时返回条件，否则返回空）
+ * 解析WHERE子句：WhereClause → WHERE Expr | ε
+ * @return WHERE表达式树（无WHERE时返回空）
  */
-optional<Condition> Parser::parseWhereClause() {
+ExprPtr Parser::parseWhereClause() {
     parseNonTerminal("WhereClause");
 
     // 匹配WHERE关键字（若存在）
@@ -899,31 +1369,120 @@ optional<Condition> Parser::parseWhereClause() {
         symStack.pop();
     }
 
-    // 解析条件表达式（Condition → IDENTIFIER OPERATOR CONSTANT）
-    if (!symStack.empty() && symStack.top() == "Condition") {
-        Condition cond;
-        parseNonTerminal("Condition");
-
-        // 1. 匹配条件关联的列名（如 "age"）
-        cond.column = currentToken.value;
-        match("IDENTIFIER");
+    // 解析条件表达式
+    if (!symStack.empty() && symStack.top() == "Expr") {
         symStack.pop();
+        return parseExpression();
+    }
+
+    // 无WHERE子句，返回空
+    return nullptr;
+}
+
+bool Parser::atKeyword(const string& keyword) const {
+    if (currentToken.type != TokenType::KEYWORD) return false;
+    string value = currentToken.value;
+    transform(value.begin(), value.end(), value.begin(), ::toupper);
+    return value == keyword;
+}
+
+bool Parser::atOperator(const string& op) const {
+    return currentToken.type == TokenType::OPERATOR && currentToken.value == op;
+}
+
+string Parser::nextParameter() {
+    return parameterMarker(++parameterCount);
+}
+
+ExprPtr Parser::parseExpression() {
+    return parseOrExpr();
+}
+
+ExprPtr Parser::parseOrExpr() {
+    ExprPtr expr = parseAndExpr();
+    while (atKeyword("OR")) {
+        match("KEYWORD(OR)");
+        expr = Expr::binary("OR", expr, parseAndExpr());
+    }
+    return expr;
+}
+
+ExprPtr Parser::parseAndExpr() {
+    ExprPtr expr = parseNotExpr();
+    while (atKeyword("AND")) {
+        match("KEYWORD(AND)");
+        expr = Expr::binary("AND", expr, parseNotExpr());
+    }
+    return expr;
+}
+
+ExprPtr Parser::parseNotExpr() {
+    if (atKeyword("NOT")) {
+        match("KEYWORD(NOT)");
+        return Expr::unary("NOT", parseNotExpr());
+    }
+    return parseComparison();
+}
 
-        // 2. 匹配比较运算符（如 ">"、"<"）
-        cond.op = currentToken.value;
+ExprPtr Parser::parseComparison() {
+    static const vector<string> comparisonOps = {"=", "==", "!=", "<>", "<", "<=", ">", ">="};
+    ExprPtr lhs = parseAdditive();
+    if (currentToken.type == TokenType::OPERATOR &&
+        find(comparisonOps.begin(), comparisonOps.end(), currentToken.value) != comparisonOps.end()) {
+        string op = currentToken.value;
         match("OPERATOR");
-        symStack.pop();
+        return Expr::binary(op, lhs, parseAdditive());
+    }
+    return lhs;
+}
 
-        // 3. 匹配条件值（如 "20"、"'Alice'"）
-        cond.value = currentToken.value;
-        match("CONSTANT");
-        symStack.pop();
+ExprPtr Parser::parseAdditive() {
+    ExprPtr expr = parsePrimary();
+    while (atOperator("+") || atOperator("-")) {
+        string op = currentToken.value;
+        match("OPERATOR");
+        expr = Expr::binary(op, expr, parsePrimary());
+    }
+    return expr;
+}
 
-        return cond;
+ExprPtr Parser::parsePrimary() {
+    if (currentToken.type == TokenType::IDENTIFIER) {
+        string name = currentToken.value;
+        match("IDENTIFIER");
+        return Expr::column(name);
+    }
+    if (currentToken.type == TokenType::PARAMETER) {
+        match("CONSTANT");
+        return Expr::literal(nextParameter());
+    }
+    if (currentToken.type == TokenType::CONSTANT) {
+        string text = currentToken.value;
+        match("CONSTANT");
+        // 与占位符写法相同的字符串常量加上引号，避免被当作参数（求值时引号会被去掉）
+        if (parameterIndex(text) != 0) {
+            text = "'" + text + "'";
+        }
+        return Expr::literal(text);
+    }
+    // 负数常量：词法分析把 "-5" 切分为运算符和常量
+    if (atOperator("-") && tokenPos + 1 < tokens.size() && tokens[tokenPos + 1].type == TokenType::CONSTANT) {
+        match("OPERATOR");
+        string text = "-" + currentToken.value;
+        match("CONSTANT");
+        return Expr::literal(text);
+    }
+    if (currentToken.type == TokenType::DELIMITER && currentToken.value == "(") {
+        match(LPAREN);
+        ExprPtr expr = parseExpression();
+        match(RPAREN);
+        return expr;
     }
 
-    // 无WHERE子句，返回空
-    return nullopt;
+    stringstream errMsg;
+    errMsg << "语法错误：表达式中出现意外的Token '" << currentToken.value
+           << "'（行: " << currentToken.line << ", 列: " << currentToken.column << "）";
+    throw runtime_error(errMsg.str());
 }
 
 //对外接口
@@ -974,7 +1533,7 @@ unique_ptr<DeleteAST> Parser::parseDelete() {
     }
 
     // 解析WHERE子句（可选，无WHERE时返回空）
-    optional<Condition> condition = parseWhereClause();
+    ExprPtr where = parseWhereClause();
 
     // 匹配语句结束分号
     match("SEMICOLON");
@@ -985,7 +1544,8 @@ unique_ptr<DeleteAST> Parser::parseDelete() {
     //构建DeleteAST并返回
     auto ast = make_unique<DeleteAST>();
     ast->tableName = tableName;
-    ast->condition = condition;
+    ast->condition = toSimpleCondition(where);
+    ast->where = where;
     return ast;
 }
 
@@ -1006,18 +1566,46 @@ void printAST(ASTNode* ast) {
         }
         cout << endl;
         cout << "  目标表: " << selectAst->tableName << endl;
+        for (const auto& join : selectAst->joins) {
+            cout << "  JOIN: " << join.tableName << " ON " << exprToString(join.on) << endl;
+        }
         if (selectAst->condition.has_value()) {
             auto& cond = selectAst->condition.value();
             cout << "  WHERE条件: " << cond.column << " " << cond.op << " " << cond.value << endl;
+        } else if (selectAst->where) {
+            cout << "  WHERE条件: " << exprToString(selectAst->where) << endl;
         } else {
             cout << "  WHERE条件: 无" << endl;
         }
+        if (!selectAst->groupBy.empty()) {
+            cout << "  GROUP BY: ";
+            for (size_t i = 0; i < selectAst->groupBy.size(); ++i) {
+                if (i > 0) cout << ", ";
+                cout << selectAst->groupBy[i];
+            }
+            cout << endl;
+        }
+        if (!selectAst->orderBy.empty()) {
+            cout << "  ORDER BY: ";
+            for (size_t i = 0; i < selectAst->orderBy.size(); ++i) {
+                if (i > 0) cout << ", ";
+                cout << selectAst->orderBy[i].column << (selectAst->orderBy[i].ascending ? " ASC" : " DESC");
+            }
+            cout << endl;
+        }
+        if (selectAst->limit.has_value()) {
+            cout << "  LIMIT: " << selectAst->limit.value() << " OFFSET " << selectAst->offset << endl;
+        }
     } else if (auto insertAst = dynamic_cast<InsertAST*>(ast)) {
         cout << "InsertAST（INSERT语句）:" << endl;
         cout << "  目标表: " << insertAst->tableName << endl;
         cout << "  插入值: " << endl;
-        for (const auto& val : insertAst->values) {
-            cout << "    - " << val << endl;
+        for (const auto& row : insertAst->rows) {
+            cout << "    -";
+            for (const auto& val : row) {
+                cout << " " << val;
+            }
+            cout << endl;
         }
     } else if (auto createAst = dynamic_cast<CreateTableAST*>(ast)) {
         cout << "CreateTableAST（CREATE TABLE语句）:" << endl;
@@ -1026,15 +1614,31 @@ void printAST(ASTNode* ast) {
         for (const auto& col : createAst->columns) {
             cout << "    - 列名: " << col.name << ", 类型: " << col.type << endl;
         }
+    } else if (auto indexAst = dynamic_cast<CreateIndexAST*>(ast)) {
+        cout << "CreateIndexAST（CREATE INDEX语句）:" << endl;
+        cout << "  索引名: " << indexAst->indexName << (indexAst->isUnique ? "（UNIQUE）" : "") << endl;
+        cout << "  目标表: " << indexAst->tableName << endl;
+        cout << "  索引列: ";
+        for (size_t i = 0; i < indexAst->columns.size(); ++i) {
+            if (i > 0) cout << ", ";
+            cout << indexAst->columns[i];
+        }
+        cout << endl;
     } else if (auto deleteAst = dynamic_cast<DeleteAST*>(ast)) {
         cout << "DeleteAST（DELETE语句）:" << endl;
         cout << "  目标表: " << deleteAst->tableName << endl;
         if (deleteAst->condition.has_value()) {
             auto& cond = deleteAst->condition.value();
             cout << "  WHERE条件: " << cond.column << " " << cond.op << " " << cond.value << endl;
+        } else if (deleteAst->where) {
+            cout << "  WHERE条件: " << exprToString(deleteAst->where) << endl;
         } else {
             cout << "  WHERE条件: 无" << endl;
         }
+    } else if (auto copyAst = dynamic_cast<CopyAST*>(ast)) {
+        cout << "CopyAST（COPY语句）:" << endl;
+        cout << "  目标表: " << copyAst->tableName << endl;
+        cout << "  文件: " << copyAst->filePath << (copyAst->header ? "（含表头）" : "") << endl;
     } else {
         cout << "未知AST节点类型" << endl;
     }
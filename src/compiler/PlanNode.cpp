@@ -0,0 +1,366 @@
+//
+// PlanNode.cpp
+// 计划节点与 JSON 之间的转换（EXPLAIN 输出 / 兼容 JSON 计划）
+//
+
+#include "compiler/PlanNode.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace minidb {
+
+namespace {
+
+json conditionToJson(const PlanCondition& cond) {
+    return {{"column", cond.column}, {"op", cond.op}, {"value", cond.value}};
+}
+
+json exprToJson(const PlanExpr& expr) {
+    switch (expr.kind) {
+        case PlanExpr::Kind::Column:
+            return {{"column", expr.value}};
+        case PlanExpr::Kind::Literal:
+            return {{"value", expr.value}, {"type", expr.type}};
+        case PlanExpr::Kind::Unary:
+            return {{"op", expr.value}, {"operand", exprToJson(*expr.left)}};
+        case PlanExpr::Kind::Binary:
+            return {{"op", expr.value}, {"left", exprToJson(*expr.left)}, {"right", exprToJson(*expr.right)}};
+    }
+    return json();
+}
+
+// 常量在 JSON 中可能写成字符串或数字，统一取文本
+std::string textOf(const json& value) {
+    return value.is_string() ? value.get<std::string>() : value.dump();
+}
+
+PlanCondition conditionFromJson(const json& cond) {
+    return PlanCondition{cond.at("column").get<std::string>(), cond.at("op").get<std::string>(),
+                         textOf(cond.at("value"))};
+}
+
+PlanExprPtr exprFromJson(const json& expr) {
+    auto node = std::make_shared<PlanExpr>();
+    if (expr.contains("column")) {
+        node->kind = PlanExpr::Kind::Column;
+        node->value = expr["column"].get<std::string>();
+    } else if (expr.contains("value")) {
+        node->kind = PlanExpr::Kind::Literal;
+        node->value = textOf(expr["value"]);
+        node->type = expr.value("type", std::string());
+    } else if (expr.contains("operand")) {
+        node->kind = PlanExpr::Kind::Unary;
+        node->value = expr.at("op").get<std::string>();
+        node->left = exprFromJson(expr["operand"]);
+    } else {
+        node->kind = PlanExpr::Kind::Binary;
+        node->value = expr.at("op").get<std::string>();
+        node->left = exprFromJson(expr.at("left"));
+        node->right = exprFromJson(expr.at("right"));
+    }
+    return node;
+}
+
+// 整表扫描，带 condition 时其上加 Filter（旧式 Select/Delete/Update 计划）
+PlanNodePtr scanWithCondition(const json& plan) {
+    auto scan = std::make_unique<SeqScanPlan>();
+    scan->tableName = plan.at("tableName").get<std::string>();
+    if (!plan.contains("condition")) return scan;
+
+    auto filter = std::make_unique<FilterPlan>();
+    filter->condition = conditionFromJson(plan["condition"]);
+    filter->input = std::move(scan);
+    return filter;
+}
+
+PlanNodePtr inputFromJson(const json& plan) {
+    if (!plan.contains("input")) {
+        throw std::runtime_error("Plan node '" + plan.value("type", std::string()) + "' requires an input");
+    }
+    return planFromJson(plan["input"]);
+}
+
+const char* algorithmName(JoinPlan::Algorithm algorithm) {
+    switch (algorithm) {
+        case JoinPlan::Algorithm::Merge: return "merge";
+        case JoinPlan::Algorithm::IndexNestedLoop: return "indexNestedLoop";
+        default: return "hash";
+    }
+}
+
+} // namespace
+
+const char* planNodeTypeName(PlanNodeType type) {
+    switch (type) {
+        case PlanNodeType::CreateTable: return "CreateTable";
+        case PlanNodeType::CreateIndex: return "CreateIndex";
+        case PlanNodeType::Insert: return "Insert";
+        case PlanNodeType::Copy: return "Copy";
+        case PlanNodeType::Delete: return "Delete";
+        case PlanNodeType::Update: return "Update";
+        case PlanNodeType::SeqScan: return "SeqScan";
+        case PlanNodeType::IndexScan: return "IndexScan";
+        case PlanNodeType::Filter: return "Filter";
+        case PlanNodeType::Project: return "Project";
+        case PlanNodeType::Limit: return "Limit";
+        case PlanNodeType::Sort: return "Sort";
+        case PlanNodeType::Aggregate: return "Aggregate";
+        case PlanNodeType::Join: return "Join";
+    }
+    return "Unknown";
+}
+
+// ==================== toJson ====================
+
+json CreateTablePlan::toJson() const {
+    json cols = json::array();
+    for (const auto& col : columns) {
+        cols.push_back({{"name", col.name}, {"type", col.type}});
+    }
+    return {{"type", "CreateTable"}, {"tableName", tableName}, {"columns", cols}};
+}
+
+json CreateIndexPlan::toJson() const {
+    return {{"type", "CreateIndex"}, {"indexName", indexName}, {"tableName", tableName},
+            {"columns", columns}, {"unique", unique}};
+}
+
+json InsertPlan::toJson() const {
+    // 单行插入保持旧格式 "values"
+    if (rows.size() == 1) {
+        return {{"type", "Insert"}, {"tableName", tableName}, {"values", rows.front()}};
+    }
+    return {{"type", "Insert"}, {"tableName", tableName}, {"rows", rows}};
+}
+
+json CopyPlan::toJson() const {
+    return {{"type", "Copy"}, {"tableName", tableName}, {"filePath", filePath}, {"header", header}};
+}
+
+json DeletePlan::toJson() const {
+    return {{"type", "Delete"}, {"tableName", tableName}, {"input", input->toJson()}};
+}
+
+json UpdatePlan::toJson() const {
+    json assignments = json::array();
+    for (const auto& update : updates) {
+        assignments.push_back({{"column", update.column}, {"value", update.value}});
+    }
+    return {{"type", "Update"}, {"tableName", tableName}, {"updates", assignments}, {"input", input->toJson()}};
+}
+
+json SeqScanPlan::toJson() const {
+    return {{"type", "SeqScan"}, {"tableName", tableName}};
+}
+
+json IndexScanPlan::toJson() const {
+    json prefixJson = json::array();
+    for (const auto& cond : prefix) prefixJson.push_back(conditionToJson(cond));
+    json rangeJson = json::array();
+    for (const auto& cond : range) rangeJson.push_back(conditionToJson(cond));
+    return {{"type", "IndexScan"}, {"tableName", tableName}, {"indexName", indexName},
+            {"prefix", prefixJson}, {"range", rangeJson}};
+}
+
+json FilterPlan::toJson() const {
+    json plan = {{"type", "Filter"}, {"input", input->toJson()}};
+    if (expr) {
+        plan["expr"] = exprToJson(*expr);
+    } else {
+        plan["condition"] = conditionToJson(condition);
+    }
+    return plan;
+}
+
+json ProjectPlan::toJson() const {
+    return {{"type", "Project"}, {"columns", columns}, {"input", input->toJson()}};
+}
+
+json LimitPlan::toJson() const {
+    return {{"type", "Limit"}, {"limit", limit}, {"offset", offset}, {"input", input->toJson()}};
+}
+
+json SortPlan::toJson() const {
+    json sortKeys = json::array();
+    for (const auto& key : keys) {
+        sortKeys.push_back({{"column", key.column}, {"order", key.ascending ? "ASC" : "DESC"}});
+    }
+    return {{"type", "Sort"}, {"keys", sortKeys}, {"input", input->toJson()}};
+}
+
+json AggregatePlan::toJson() const {
+    json calls = json::array();
+    for (const auto& call : aggregates) {
+        calls.push_back({{"func", call.func}, {"column", call.column}});
+    }
+    return {{"type", "Aggregate"}, {"groupBy", groupBy}, {"aggregates", calls}, {"input", input->toJson()}};
+}
+
+json JoinPlan::toJson() const {
+    json plan = {{"type", "Join"},
+                 {"algorithm", algorithmName(algorithm)},
+                 {"leftTable", leftTable},
+                 {"rightTable", rightTable},
+                 {"leftKeys", leftKeys},
+                 {"rightKeys", rightKeys},
+                 {"left", left->toJson()}};
+    if (algorithm == Algorithm::IndexNestedLoop) {
+        plan["indexName"] = indexName;
+        plan["indexKey"] = indexKey;
+    } else {
+        plan["right"] = right->toJson();
+    }
+    return plan;
+}
+
+// ==================== planFromJson ====================
+
+PlanNodePtr planFromJson(const json& plan) {
+    std::string type = plan.at("type").get<std::string>();
+
+    if (type == "CreateTable") {
+        auto node = std::make_unique<CreateTablePlan>();
+        node->tableName = plan.at("tableName").get<std::string>();
+        for (const auto& col : plan.at("columns")) {
+            node->columns.push_back({col.at("name").get<std::string>(), col.at("type").get<std::string>()});
+        }
+        return node;
+    }
+    if (type == "CreateIndex") {
+        auto node = std::make_unique<CreateIndexPlan>();
+        node->indexName = plan.at("indexName").get<std::string>();
+        node->tableName = plan.at("tableName").get<std::string>();
+        node->columns = plan.value("columns", std::vector<std::string>{});
+        node->unique = plan.value("unique", false);
+        return node;
+    }
+    if (type == "Insert") {
+        auto node = std::make_unique<InsertPlan>();
+        node->tableName = plan.at("tableName").get<std::string>();
+        auto readRow = [](const json& values) {
+            std::vector<std::string> row;
+            for (const auto& value : values) {
+                row.push_back(textOf(value));
+            }
+            return row;
+        };
+        if (plan.contains("rows")) {
+            for (const auto& values : plan["rows"]) {
+                node->rows.push_back(readRow(values));
+            }
+        } else {
+            node->rows.push_back(readRow(plan.at("values")));
+        }
+        return node;
+    }
+    if (type == "Copy") {
+        auto node = std::make_unique<CopyPlan>();
+        node->tableName = plan.at("tableName").get<std::string>();
+        node->filePath = plan.at("filePath").get<std::string>();
+        node->header = plan.value("header", false);
+        return node;
+    }
+    if (type == "Delete") {
+        auto node = std::make_unique<DeletePlan>();
+        node->tableName = plan.at("tableName").get<std::string>();
+        node->input = plan.contains("input") ? planFromJson(plan["input"]) : scanWithCondition(plan);
+        return node;
+    }
+    if (type == "Update") {
+        auto node = std::make_unique<UpdatePlan>();
+        node->tableName = plan.at("tableName").get<std::string>();
+        for (const auto& update : plan.at("updates")) {
+            node->updates.push_back({update.at("column").get<std::string>(), textOf(update.at("value"))});
+        }
+        node->input = plan.contains("input") ? planFromJson(plan["input"]) : scanWithCondition(plan);
+        return node;
+    }
+    if (type == "SeqScan" || type == "Select") {
+        return scanWithCondition(plan);
+    }
+    if (type == "IndexScan") {
+        auto node = std::make_unique<IndexScanPlan>();
+        node->tableName = plan.at("tableName").get<std::string>();
+        node->indexName = plan.at("indexName").get<std::string>();
+        if (plan.contains("condition")) {
+            // 旧格式：单个首列条件
+            PlanCondition cond = conditionFromJson(plan["condition"]);
+            (cond.op == "=" ? node->prefix : node->range).push_back(std::move(cond));
+        }
+        for (const auto& cond : plan.value("prefix", json::array())) node->prefix.push_back(conditionFromJson(cond));
+        for (const auto& cond : plan.value("range", json::array())) node->range.push_back(conditionFromJson(cond));
+        return node;
+    }
+    if (type == "Filter") {
+        auto node = std::make_unique<FilterPlan>();
+        if (plan.contains("expr")) {
+            node->expr = exprFromJson(plan["expr"]);
+        } else {
+            node->condition = conditionFromJson(plan.at("condition"));
+        }
+        node->input = inputFromJson(plan);
+        return node;
+    }
+    if (type == "Project") {
+        auto node = std::make_unique<ProjectPlan>();
+        node->columns = plan.value("columns", std::vector<std::string>{});
+        node->input = inputFromJson(plan);
+        return node;
+    }
+    if (type == "Limit") {
+        auto node = std::make_unique<LimitPlan>();
+        node->limit = plan.at("limit").get<size_t>();
+        node->offset = plan.value("offset", static_cast<size_t>(0));
+        node->input = inputFromJson(plan);
+        return node;
+    }
+    if (type == "Sort") {
+        auto node = std::make_unique<SortPlan>();
+        for (const auto& key : plan.at("keys")) {
+            std::string order = key.value("order", std::string("ASC"));
+            std::transform(order.begin(), order.end(), order.begin(), ::toupper);
+            node->keys.push_back({key.at("column").get<std::string>(), order != "DESC"});
+        }
+        node->input = inputFromJson(plan);
+        return node;
+    }
+    if (type == "Aggregate") {
+        auto node = std::make_unique<AggregatePlan>();
+        node->groupBy = plan.value("groupBy", std::vector<std::string>{});
+        for (const auto& call : plan.at("aggregates")) {
+            node->aggregates.push_back({call.at("func").get<std::string>(), call.value("column", std::string("*"))});
+        }
+        node->input = inputFromJson(plan);
+        return node;
+    }
+    if (type == "Join") {
+        auto node = std::make_unique<JoinPlan>();
+        std::string algorithm = plan.value("algorithm", std::string("hash"));
+        if (algorithm == "merge") {
+            node->algorithm = JoinPlan::Algorithm::Merge;
+        } else if (algorithm == "indexNestedLoop") {
+            node->algorithm = JoinPlan::Algorithm::IndexNestedLoop;
+        } else if (algorithm != "hash") {
+            throw std::runtime_error("Unsupported join algorithm: " + algorithm);
+        }
+        node->leftTable = plan.value("leftTable", std::string());
+        node->rightTable = plan.value("rightTable", std::string());
+        node->leftKeys = plan.at("leftKeys").get<std::vector<std::string>>();
+        node->rightKeys = plan.at("rightKeys").get<std::vector<std::string>>();
+        node->left = planFromJson(plan.at("left"));
+        if (node->algorithm == JoinPlan::Algorithm::IndexNestedLoop) {
+            node->indexName = plan.at("indexName").get<std::string>();
+            node->indexKey = plan.value("indexKey", static_cast<size_t>(0));
+        } else {
+            node->right = planFromJson(plan.at("right"));
+        }
+        return node;
+    }
+
+    throw std::runtime_error("Unsupported operator type: " + type);
+}
+
+} // namespace minidb
@@ -0,0 +1,243 @@
+//
+// PreparedStatement.cpp
+// 预编译语句的参数绑定
+//
+
+#include "compiler/PreparedStatement.h"
+#include "compiler/AST.h"
+#include "compiler/SQLCompiler.h"
+#include "common/Exception.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+namespace minidb {
+
+namespace {
+
+// 绑定值转换为计划中的常量文本：字符串总是加引号，求值时去掉一层引号即为原值
+std::string toLiteral(const Value& value) {
+    switch (value.getType()) {
+        case TypeId::INTEGER:
+            return std::to_string(value.getAsInt());
+        case TypeId::BOOLEAN:
+            return value.getAsBool() ? "true" : "false";
+        case TypeId::VARCHAR:
+            return "'" + value.getAsString() + "'";
+        case TypeId::INVALID:
+            throw TypeMismatchException("NULL parameters are not supported");
+        default:
+            throw TypeMismatchException("Unsupported parameter type: " + std::string(getTypeName(value.getType())));
+    }
+}
+
+void collectSlot(std::string& text, std::vector<std::vector<std::string*>>& slots) {
+    size_t index = parameterIndex(text);
+    if (index != 0 && index <= slots.size()) {
+        slots[index - 1].push_back(&text);
+    }
+}
+
+void collectExprSlots(const PlanExpr& expr, std::vector<std::vector<std::string*>>& slots) {
+    if (expr.kind == PlanExpr::Kind::Literal) {
+        // 表达式节点在计划中以常量指针共享，绑定时需要改写其中的常量
+        collectSlot(const_cast<PlanExpr&>(expr).value, slots);
+    }
+    if (expr.left) collectExprSlots(*expr.left, slots);
+    if (expr.right) collectExprSlots(*expr.right, slots);
+}
+
+void collectSlots(PlanNode& plan, std::vector<std::vector<std::string*>>& slots) {
+    switch (plan.type) {
+        case PlanNodeType::Insert:
+            for (auto& row : static_cast<InsertPlan&>(plan).rows) {
+                for (auto& value : row) collectSlot(value, slots);
+            }
+            break;
+        case PlanNodeType::Delete:
+            collectSlots(*static_cast<DeletePlan&>(plan).input, slots);
+            break;
+        case PlanNodeType::Update: {
+            auto& update = static_cast<UpdatePlan&>(plan);
+            for (auto& assignment : update.updates) collectSlot(assignment.value, slots);
+            collectSlots(*update.input, slots);
+            break;
+        }
+        case PlanNodeType::IndexScan:
+            for (auto& cond : static_cast<IndexScanPlan&>(plan).prefix) collectSlot(cond.value, slots);
+            for (auto& cond : static_cast<IndexScanPlan&>(plan).range) collectSlot(cond.value, slots);
+            break;
+        case PlanNodeType::Filter: {
+            auto& filter = static_cast<FilterPlan&>(plan);
+            if (filter.expr) {
+                collectExprSlots(*filter.expr, slots);
+            } else {
+                collectSlot(filter.condition.value, slots);
+            }
+            collectSlots(*filter.input, slots);
+            break;
+        }
+        case PlanNodeType::Project:
+            collectSlots(*static_cast<ProjectPlan&>(plan).input, slots);
+            break;
+        case PlanNodeType::Limit:
+            collectSlots(*static_cast<LimitPlan&>(plan).input, slots);
+            break;
+        case PlanNodeType::Sort:
+            collectSlots(*static_cast<SortPlan&>(plan).input, slots);
+            break;
+        case PlanNodeType::Aggregate:
+            collectSlots(*static_cast<AggregatePlan&>(plan).input, slots);
+            break;
+        case PlanNodeType::Join: {
+            auto& join = static_cast<JoinPlan&>(plan);
+            collectSlots(*join.left, slots);
+            if (join.right) collectSlots(*join.right, slots);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+Value parseParameterValue(const std::string& item) {
+    if (item.size() >= 2 && (item.front() == '\'' || item.front() == '"') && item.back() == item.front()) {
+        // 与词法分析一致：反斜杠转义下一个字符
+        std::string text;
+        for (size_t i = 1; i + 1 < item.size(); ++i) {
+            if (item[i] == '\\' && i + 2 < item.size()) ++i;
+            text += item[i];
+        }
+        return Value(text);
+    }
+
+    std::string lower = item;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "true" || lower == "false") {
+        return Value(lower == "true");
+    }
+
+    size_t digits = (!item.empty() && (item[0] == '-' || item[0] == '+')) ? 1 : 0;
+    if (digits < item.size() && std::all_of(item.begin() + digits, item.end(), ::isdigit)) {
+        try {
+            long long number = std::stoll(item);
+            if (number >= std::numeric_limits<int32_t>::min() && number <= std::numeric_limits<int32_t>::max()) {
+                return Value(static_cast<int32_t>(number));
+            }
+        } catch (const std::out_of_range&) {
+        }
+        throw OutOfRangeException("parameter value " + item);
+    }
+    throw TypeMismatchException("Invalid parameter value: " + item);
+}
+
+} // namespace
+
+std::vector<std::vector<std::string*>> collectParameterSlots(PlanNode& plan, size_t parameterCount) {
+    std::vector<std::vector<std::string*>> slots(parameterCount);
+    collectSlots(plan, slots);
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (slots[i].empty()) {
+            throw DatabaseException("Parameter " + parameterMarker(i + 1) + " cannot be used in this position");
+        }
+    }
+    return slots;
+}
+
+std::vector<Value> parseParameterValues(const std::string& text) {
+    std::vector<Value> values;
+    if (trim(text).empty()) return values;
+
+    // 按引号外的逗号切分
+    std::string item;
+    char quote = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (quote) {
+            item += c;
+            if (c == '\\' && i + 1 < text.size()) {
+                item += text[++i];
+            } else if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == ',') {
+            values.push_back(parseParameterValue(trim(item)));
+            item.clear();
+        } else {
+            if (c == '\'' || c == '"') quote = c;
+            item += c;
+        }
+    }
+    values.push_back(parseParameterValue(trim(item)));
+    return values;
+}
+
+PreparedStatement::PreparedStatement(SQLCompiler* compiler, std::shared_ptr<CachedPlan> cached)
+    : compiler_(compiler), cached_(std::move(cached)), bindings_(cached_->parameterCount) {}
+
+const std::string& PreparedStatement::sql() const {
+    static const std::string empty;
+    return cached_ ? cached_->sql : empty;
+}
+
+PreparedStatement& PreparedStatement::bind(size_t index, const Value& value) {
+    if (index == 0 || index > bindings_.size()) {
+        throw OutOfRangeException("parameter index " + std::to_string(index) + " (statement has " +
+                                  std::to_string(bindings_.size()) + " parameters)");
+    }
+    bindings_[index - 1] = toLiteral(value);
+    return *this;
+}
+
+PreparedStatement& PreparedStatement::bind(const std::vector<Value>& values) {
+    if (values.size() != bindings_.size()) {
+        throw DatabaseException("Expected " + std::to_string(bindings_.size()) + " parameters, got " +
+                                std::to_string(values.size()));
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        bind(i + 1, values[i]);
+    }
+    return *this;
+}
+
+void PreparedStatement::clearBindings() {
+    std::fill(bindings_.begin(), bindings_.end(), std::nullopt);
+}
+
+const PlanNode& PreparedStatement::plan() {
+    if (!cached_) {
+        throw DatabaseException("Statement is not prepared");
+    }
+    // 目录变化后计划可能引用已删除的表，或错过新建的索引
+    if (cached_->catalogVersion != compiler_->catalogVersion()) {
+        cached_ = compiler_->lookupPlan(cached_->sql);
+        plan_.reset();
+    }
+
+    for (size_t i = 0; i < bindings_.size(); ++i) {
+        if (!bindings_[i]) {
+            throw DatabaseException("Parameter " + parameterMarker(i + 1) + " is not bound");
+        }
+    }
+    // 共享的缓存计划保持不变，参数只写入本语句的副本
+    if (!plan_) {
+        plan_ = planFromJson(cached_->plan->toJson());
+        slots_ = collectParameterSlots(*plan_, bindings_.size());
+    }
+    for (size_t i = 0; i < bindings_.size(); ++i) {
+        for (std::string* slot : slots_[i]) {
+            *slot = *bindings_[i];
+        }
+    }
+    return *plan_;
+}
+
+} // namespace minidb
@@ -6,9 +6,11 @@
 #include "compiler/QueryPlanner.h"
 
 #include "compiler/AST.h"
-#include <sstream>
-#include <iomanip>
-#include "../../include/compiler/PlanNode.h"
+#include "engine/catalog/catalog_manager.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
 #include "json.hpp"
 
 using json = nlohmann::json;
@@ -16,7 +18,121 @@ using namespace std;
 
 namespace minidb {
 
-json QueryPlanner::generatePlan(ASTNode* ast) {
+namespace {
+
+// AST 表达式树转换为计划中的表达式
+PlanExprPtr toPlanExpr(const ExprPtr& expr) {
+    if (!expr) return nullptr;
+    auto node = make_shared<PlanExpr>();
+    switch (expr->kind) {
+        case Expr::Kind::Column: node->kind = PlanExpr::Kind::Column; break;
+        case Expr::Kind::Literal: node->kind = PlanExpr::Kind::Literal; break;
+        case Expr::Kind::Unary: node->kind = PlanExpr::Kind::Unary; break;
+        case Expr::Kind::Binary: node->kind = PlanExpr::Kind::Binary; break;
+    }
+    node->value = expr->value;
+    node->type = expr->type;
+    node->left = toPlanExpr(expr->left);
+    node->right = toPlanExpr(expr->right);
+    return node;
+}
+
+// 按 AND 拆分为合取项
+void splitConjuncts(const ExprPtr& expr, vector<ExprPtr>& conjuncts) {
+    if (expr->kind == Expr::Kind::Binary && expr->value == "AND") {
+        splitConjuncts(expr->left, conjuncts);
+        splitConjuncts(expr->right, conjuncts);
+    } else {
+        conjuncts.push_back(expr);
+    }
+}
+
+// "列 运算符 常量" 形式的比较转换为简单条件
+optional<Condition> asCondition(const ExprPtr& expr) {
+    static const vector<string> comparisonOps = {"=", "!=", "<>", "<", "<=", ">", ">="};
+    if (expr->kind != Expr::Kind::Binary ||
+        find(comparisonOps.begin(), comparisonOps.end(), expr->value) == comparisonOps.end() ||
+        expr->left->kind != Expr::Kind::Column || expr->right->kind != Expr::Kind::Literal) {
+        return nullopt;
+    }
+    return Condition(expr->left->value, expr->value, expr->right->value);
+}
+
+PlanCondition toPlanCondition(const Condition& cond) {
+    return PlanCondition{cond.column, cond.op, cond.value};
+}
+
+// 列引用的表名限定（"orders.id" → "orders"），未限定时为空
+string qualifierOf(const string& column) {
+    size_t dot = column.find('.');
+    return dot == string::npos ? "" : column.substr(0, dot);
+}
+
+// 收集表达式中列引用的表名限定（未限定的列记为空串）
+void collectQualifiers(const ExprPtr& expr, set<string>& qualifiers) {
+    if (!expr) return;
+    if (expr->kind == Expr::Kind::Column) {
+        qualifiers.insert(qualifierOf(expr->value));
+    }
+    collectQualifiers(expr->left, qualifiers);
+    collectQualifiers(expr->right, qualifiers);
+}
+
+// 去掉列引用的表名限定，用于下推到单表扫描的条件
+ExprPtr stripQualifier(const ExprPtr& expr) {
+    if (!expr) return nullptr;
+    auto copy = make_shared<Expr>(*expr);
+    if (copy->kind == Expr::Kind::Column) {
+        copy->value = copy->value.substr(copy->value.find('.') + 1);
+    }
+    copy->left = stripQualifier(expr->left);
+    copy->right = stripQualifier(expr->right);
+    return copy;
+}
+
+// 去掉表名限定的列名（"orders.id" → "id"）
+string unqualified(const string& name) {
+    return name.substr(name.find('.') + 1);
+}
+
+// 子计划是否按该列升序输出：Filter 不改变顺序；IndexScan 的等值前缀列取值唯一，
+// 其后的区间列按索引顺序输出
+bool orderedBy(const PlanNode& plan, const string& column) {
+    const PlanNode* node = &plan;
+    while (node->type == PlanNodeType::Filter) {
+        node = static_cast<const FilterPlan*>(node)->input.get();
+    }
+    if (node->type != PlanNodeType::IndexScan) {
+        return false;
+    }
+    const auto* scan = static_cast<const IndexScanPlan*>(node);
+    for (const auto& cond : scan->prefix) {
+        if (cond.column == column) return true;
+    }
+    return !scan->range.empty() && scan->range.front().column == column;
+}
+
+// 合取项重新用 AND 连接，为空时返回空
+ExprPtr conjoin(const vector<ExprPtr>& conjuncts) {
+    ExprPtr expr;
+    for (const auto& conjunct : conjuncts) {
+        expr = expr ? Expr::binary("AND", expr, conjunct) : conjunct;
+        expr->type = "BOOLEAN";
+    }
+    return expr;
+}
+
+// 在 input 之上加一个表达式过滤节点
+PlanNodePtr filterOn(PlanNodePtr input, const ExprPtr& expr) {
+    auto filter = make_unique<FilterPlan>();
+    filter->expr = toPlanExpr(expr);
+    filter->input = std::move(input);
+    return filter;
+}
+
+} // namespace
+
+PlanNodePtr QueryPlanner::buildPlan(ASTNode* ast) {
     if (!ast) {
         throw std::runtime_error("AST is null");
     }
@@ -24,111 +140,314 @@ json QueryPlanner::generatePlan(ASTNode* ast) {
     // 根据 AST 类型分发处理逻辑
     if (auto createTableAst = dynamic_cast<CreateTableAST*>(ast)) {
         return handleCreateTable(createTableAst);
+    } else if (auto createIndexAst = dynamic_cast<CreateIndexAST*>(ast)) {
+        return handleCreateIndex(createIndexAst);
     } else if (auto insertAst = dynamic_cast<InsertAST*>(ast)) {
         return handleInsert(insertAst);
     } else if (auto selectAst = dynamic_cast<SelectAST*>(ast)) {
         return handleSelect(selectAst);
     } else if (auto deleteAst = dynamic_cast<DeleteAST*>(ast)) {
         return handleDelete(deleteAst);
+    } else if (auto copyAst = dynamic_cast<CopyAST*>(ast)) {
+        return handleCopy(copyAst);
     } else {
         throw std::runtime_error("Unsupported AST node type");
     }
 }
 
-json QueryPlanner::handleCreateTable(CreateTableAST* ast) {
-    json plan;
-    plan["type"] = "CreateTable";
-    plan["tableName"] = ast->tableName;
+json QueryPlanner::generatePlan(ASTNode* ast) {
+    return buildPlan(ast)->toJson();
+}
+
+PlanNodePtr QueryPlanner::handleCreateTable(CreateTableAST* ast) {
+    auto plan = make_unique<CreateTablePlan>();
+    plan->tableName = ast->tableName;
 
     // 处理列定义
-    json columns;
     for (const auto& col : ast->columns) {
-        json column;
-        column["name"] = col.name;
-        column["type"] = col.type;
-        columns.push_back(column);
+        plan->columns.push_back({col.name, col.type});
     }
-    plan["columns"] = columns;
+    return plan;
+}
 
+PlanNodePtr QueryPlanner::handleCreateIndex(CreateIndexAST* ast) {
+    auto plan = make_unique<CreateIndexPlan>();
+    plan->indexName = ast->indexName;
+    plan->tableName = ast->tableName;
+    plan->columns = ast->columns;
+    plan->unique = ast->isUnique;
     return plan;
 }
 
-json QueryPlanner::handleInsert(InsertAST* ast) {
-    json plan;
-    plan["type"] = "Insert";
-    plan["tableName"] = ast->tableName;
-    plan["values"] = ast->values;
+PlanNodePtr QueryPlanner::chooseIndexScan(const std::string& tableName, std::vector<Condition>& conds) const {
+    if (!catalog_) {
+        return nullptr;
+    }
+
+    vector<string> equalityColumns;
+    for (const auto& cond : conds) {
+        if (cond.op == "=") equalityColumns.push_back(cond.column);
+    }
+    // 该列上第一个运算符属于 ops 的条件下标，没有时返回 conds.size()
+    auto findCondition = [&](const string& column, std::initializer_list<const char*> ops) {
+        for (size_t i = 0; i < conds.size(); ++i) {
+            if (conds[i].column != column) continue;
+            for (const char* op : ops) {
+                if (conds[i].op == op) return i;
+            }
+        }
+        return conds.size();
+    };
+
+    // 每个索引取被等值条件覆盖的最长前导列前缀，再在下一列上取至多一个下界和一个上界；
+    // 前缀更长者优先，其次区间端点更多、唯一索引、列数少的索引
+    const catalog::IndexMeta* best = nullptr;
+    vector<size_t> bestUsed;
+    std::tuple<size_t, size_t, bool, size_t> bestScore{};
+    for (const auto* meta : catalog_->get_table_indexes(tableName)) {
+        const auto& columns = meta->get_column_names();
+        const size_t prefix = meta->match_equality_prefix(equalityColumns);
+        vector<size_t> used;
+        for (size_t i = 0; i < prefix; ++i) {
+            used.push_back(findCondition(columns[i], {"="}));
+        }
+        if (prefix < columns.size()) {
+            for (auto ops : {std::initializer_list<const char*>{">", ">="}, std::initializer_list<const char*>{"<", "<="}}) {
+                size_t bound = findCondition(columns[prefix], ops);
+                if (bound < conds.size()) used.push_back(bound);
+            }
+        }
+        if (used.empty()) continue;
 
+        std::tuple<size_t, size_t, bool, size_t> score{prefix, used.size() - prefix, meta->is_unique(),
+                                                       catalog::IndexMeta::MAX_INDEX_COLUMNS - columns.size()};
+        if (!best || score > bestScore) {
+            best = meta;
+            bestUsed = std::move(used);
+            bestScore = score;
+        }
+    }
+    if (!best) {
+        return nullptr;
+    }
+
+    auto indexScan = make_unique<IndexScanPlan>();
+    indexScan->tableName = tableName;
+    indexScan->indexName = best->get_index_name();
+    const size_t prefix = std::get<0>(bestScore);
+    for (size_t i = 0; i < bestUsed.size(); ++i) {
+        (i < prefix ? indexScan->prefix : indexScan->range).push_back(toPlanCondition(conds[bestUsed[i]]));
+    }
+    // 被索引保证的条件不再需要 Filter
+    std::sort(bestUsed.rbegin(), bestUsed.rend());
+    for (size_t i : bestUsed) {
+        conds.erase(conds.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    return indexScan;
+}
+
+PlanNodePtr QueryPlanner::handleInsert(InsertAST* ast) {
+    auto plan = make_unique<InsertPlan>();
+    plan->tableName = ast->tableName;
+    plan->rows = ast->rows;
     return plan;
 }
 
-    json QueryPlanner::handleSelect(SelectAST* ast) {
-    json plan;
+PlanNodePtr QueryPlanner::handleCopy(CopyAST* ast) {
+    auto plan = make_unique<CopyPlan>();
+    plan->tableName = ast->tableName;
+    plan->filePath = ast->filePath;
+    plan->header = ast->header;
+    return plan;
+}
 
-    // 1. 生成 SeqScan 节点
-    json seqScan;
-    seqScan["type"] = "SeqScan";
-    seqScan["tableName"] = ast->tableName;
+PlanNodePtr QueryPlanner::planWhere(const std::string& tableName, const std::optional<Condition>& condition,
+                                    const ExprPtr& where, bool useIndex) const {
+    vector<Condition> simple;
+    vector<ExprPtr> complex;
+    if (condition) {
+        simple.push_back(*condition);
+    } else if (where) {
+        vector<ExprPtr> conjuncts;
+        splitConjuncts(where, conjuncts);
+        for (const auto& conjunct : conjuncts) {
+            if (auto cond = asCondition(conjunct)) {
+                simple.push_back(*cond);
+            } else {
+                complex.push_back(conjunct);
+            }
+        }
+    }
 
+    // 1. 扫描节点：简单条件能构成某个索引的等值前缀或区间时用 IndexScan，这些条件由索引保证
+    PlanNodePtr plan = useIndex ? chooseIndexScan(tableName, simple) : nullptr;
+    if (!plan) {
+        auto scan = make_unique<SeqScanPlan>();
+        scan->tableName = tableName;
+        plan = std::move(scan);
+    }
 
+    // 2. 简单条件紧贴扫描（执行时下推到扫描中），复杂条件在其上
+    for (const auto& cond : simple) {
+        auto filter = make_unique<FilterPlan>();
+        filter->condition = toPlanCondition(cond);
+        filter->input = std::move(plan);
+        plan = std::move(filter);
+    }
+    for (const auto& expr : complex) {
+        plan = filterOn(std::move(plan), expr);
+    }
+    return plan;
+}
 
-    // 2. 如果有 WHERE 条件，生成 Filter 节点
-    if (ast->condition) {
-        json filter;
-        filter["type"] = "Filter";
-        filter["condition"] = {
-            {"column", ast->condition->column},
-            {"op", ast->condition->op},
-            {"value", ast->condition->value}
-        };
-        filter["input"] = seqScan;
-        plan = filter;
-    } else {
-        plan = seqScan;
+PlanNodePtr QueryPlanner::planJoin(SelectAST* ast) const {
+    // 1. WHERE 合取项按引用的表分组
+    vector<ExprPtr> conjuncts;
+    if (ast->where) {
+        splitConjuncts(ast->where, conjuncts);
+    }
+    map<string, vector<ExprPtr>> local;
+    vector<ExprPtr> residual;
+    for (const auto& conjunct : conjuncts) {
+        set<string> qualifiers;
+        collectQualifiers(conjunct, qualifiers);
+        if (qualifiers.size() == 1 && !qualifiers.begin()->empty()) {
+            local[*qualifiers.begin()].push_back(conjunct);
+        } else {
+            residual.push_back(conjunct);
+        }
     }
+    auto scan = [&](const string& tableName) {
+        vector<ExprPtr> stripped;
+        for (const auto& conjunct : local[tableName]) {
+            stripped.push_back(stripQualifier(conjunct));
+        }
+        return planWhere(tableName, nullopt, conjoin(stripped), true);
+    };
+
+    // 2. 左深连接树：每个 JOIN 把已有结果（左）与新表（右）连接
+    PlanNodePtr plan = scan(ast->tableName);
+    string leftTable = ast->tableName;
+    for (const auto& join : ast->joins) {
+        vector<string> leftKeys;
+        vector<string> rightKeys;
+        vector<ExprPtr> onFilters;
+        vector<ExprPtr> onConjuncts;
+        splitConjuncts(join.on, onConjuncts);
+        for (const auto& conjunct : onConjuncts) {
+            if (conjunct->kind == Expr::Kind::Binary && conjunct->value == "=" &&
+                conjunct->left->kind == Expr::Kind::Column && conjunct->right->kind == Expr::Kind::Column) {
+                bool leftNew = qualifierOf(conjunct->left->value) == join.tableName;
+                bool rightNew = qualifierOf(conjunct->right->value) == join.tableName;
+                if (leftNew != rightNew) {
+                    leftKeys.push_back(leftNew ? conjunct->right->value : conjunct->left->value);
+                    rightKeys.push_back(leftNew ? conjunct->left->value : conjunct->right->value);
+                    continue;
+                }
+            }
+            onFilters.push_back(conjunct);
+        }
+        if (leftKeys.empty()) {
+            throw std::runtime_error("JOIN " + join.tableName + " requires an equality between both sides");
+        }
+
+        // 连接算法：两侧都已按连接键有序时归并；右表连接键上有索引时逐行查索引；否则哈希
+        PlanNodePtr right = scan(join.tableName);
+        const catalog::IndexMeta* index = nullptr;
+        size_t indexKey = 0;
+        for (size_t k = 0; catalog_ && !index && k < rightKeys.size(); ++k) {
+            index = catalog_->find_index(join.tableName, unqualified(rightKeys[k]));
+            indexKey = k;
+        }
 
-    // 3. 生成 Project 节点（处理查询列）
-    json project;
-    project["type"] = "Project";
-    project["columns"] = ast->columns;
-    project["input"] = plan;
-    plan = project;
+        auto joinNode = make_unique<JoinPlan>();
+        joinNode->leftTable = leftTable;
+        joinNode->rightTable = join.tableName;
+        joinNode->leftKeys = leftKeys;
+        joinNode->rightKeys = rightKeys;
+        if (leftKeys.size() == 1 && !leftTable.empty() &&
+            orderedBy(*plan, unqualified(leftKeys[0])) && orderedBy(*right, unqualified(rightKeys[0]))) {
+            joinNode->algorithm = JoinPlan::Algorithm::Merge;
+            joinNode->right = std::move(right);
+        } else if (index) {
+            // 右表不再扫描，其单表条件在连接结果上过滤
+            joinNode->algorithm = JoinPlan::Algorithm::IndexNestedLoop;
+            joinNode->indexName = index->get_index_name();
+            joinNode->indexKey = indexKey;
+            for (const auto& expr : local[join.tableName]) {
+                onFilters.push_back(expr);
+            }
+        } else {
+            joinNode->algorithm = JoinPlan::Algorithm::Hash;
+            joinNode->right = std::move(right);
+        }
+        joinNode->left = std::move(plan);
+        plan = std::move(joinNode);
+        for (const auto& expr : onFilters) {
+            plan = filterOn(std::move(plan), expr);
+        }
+        leftTable.clear();  // 之后的左输入已是连接结果，列名均已限定
+    }
 
+    // 3. 跨表条件在全部连接之上
+    for (const auto& expr : residual) {
+        plan = filterOn(std::move(plan), expr);
+    }
     return plan;
 }
 
-    json QueryPlanner::handleDelete(DeleteAST* ast) {
-    json plan;
-
-    // 1. 生成 SeqScan 节点
-    json seqScan;
-    seqScan["type"] = "SeqScan";
-    seqScan["tableName"] = ast->tableName;
-
-    // 2. 如果有 WHERE 条件，生成 Filter 节点
-    if (ast->condition) {
-        json filter;
-        filter["type"] = "Filter";
-        filter["condition"] = {
-            {"column", ast->condition->column},
-            {"op", ast->condition->op},
-            {"value", ast->condition->value}
-        };
-        filter["input"] = seqScan;
-        plan = filter;
-    } else {
-        throw std::runtime_error("DELETE without WHERE is not supported");
+PlanNodePtr QueryPlanner::handleSelect(SelectAST* ast) {
+    // 1. 扫描 + WHERE 过滤（有 JOIN 时为连接树）
+    PlanNodePtr plan = ast->joins.empty() ? planWhere(ast->tableName, ast->condition, ast->where, true)
+                                          : planJoin(ast);
+
+    // 2. 有聚合函数或 GROUP BY 时生成 Aggregate 节点，其输出列名与查询列一致
+    if (!ast->aggregates.empty() || !ast->groupBy.empty()) {
+        auto aggregate = make_unique<AggregatePlan>();
+        aggregate->groupBy = ast->groupBy;
+        for (const auto& call : ast->aggregates) {
+            aggregate->aggregates.push_back({call.func, call.column});
+        }
+        aggregate->input = std::move(plan);
+        plan = std::move(aggregate);
     }
 
-    // 3. 生成 Delete 节点
-    json deleteNode;
-    deleteNode["type"] = "Delete";
-    deleteNode["tableName"] = ast->tableName;
-    deleteNode["input"] = plan;
-    plan = deleteNode;
+    // 3. ORDER BY 生成 Sort 节点；放在投影之下，排序列可以不在查询列中
+    if (!ast->orderBy.empty()) {
+        auto sort = make_unique<SortPlan>();
+        for (const auto& item : ast->orderBy) {
+            sort->keys.push_back({item.column, item.ascending});
+        }
+        sort->input = std::move(plan);
+        plan = std::move(sort);
+    }
 
-    return plan;
+    // 4. LIMIT 生成 Limit 节点：直接位于 Sort 之上时执行引擎只保留前 limit + offset 行
+    if (ast->limit.has_value()) {
+        auto limit = make_unique<LimitPlan>();
+        limit->limit = ast->limit.value();
+        limit->offset = ast->offset;
+        limit->input = std::move(plan);
+        plan = std::move(limit);
+    }
+
+    // 5. 生成 Project 节点（处理查询列）
+    auto project = make_unique<ProjectPlan>();
+    project->columns = ast->columns;
+    project->input = std::move(plan);
+    return project;
 }
-} // namespace minidb
 
+PlanNodePtr QueryPlanner::handleDelete(DeleteAST* ast) {
+    // 1. 扫描 + WHERE 过滤
+    if (!ast->condition && !ast->where) {
+        throw std::runtime_error("DELETE without WHERE is not supported");
+    }
 
+    // 2. 生成 Delete 节点
+    auto deleteNode = make_unique<DeletePlan>();
+    deleteNode->tableName = ast->tableName;
+    deleteNode->input = planWhere(ast->tableName, ast->condition, ast->where, false);
+    return deleteNode;
+}
+} // namespace minidb
@@ -4,6 +4,7 @@
 
 #include "../../include/compiler/SQLCompiler.h"
 
+#include <cctype>
 #include <iostream>
 #include "json.hpp"
 
@@ -16,6 +17,14 @@ namespace minidb {
     SQLCompiler::SQLCompiler(CatalogManager& catalog) : catalogManager(catalog) {}
 
     json SQLCompiler::compile(const std::string& sql) {
+    PlanNodePtr node = compilePlan(sql);
+    json plan = node->toJson();
+    // SELECT 计划的根节点是 Project
+    plan["astType"] = node->type == PlanNodeType::Project ? "Select" : planNodeTypeName(node->type);
+    return plan;
+}
+
+    ASTNodePtr SQLCompiler::parse(const std::string& sql, size_t& parameterCount) {
 
     // 1. 词法分析
     Lexer lexer(sql);
@@ -36,24 +45,36 @@ namespace minidb {
     if (!ast) {
         throw std::runtime_error("Parser error: Failed to generate AST.");
     }
+    parameterCount = parser.getParameterCount();
+    return ast;
+}
+
+    PlanNodePtr SQLCompiler::compilePlan(const std::string& sql) {
+
+    size_t parameterCount = 0;
+    ASTNodePtr ast = parse(sql, parameterCount);
+    if (parameterCount > 0) {
+        throw std::runtime_error("Statement has parameters; use PREPARE/EXECUTE to run it.");
+    }
 
     // 3. 语义分析
     SemanticAnalyzer analyzer(catalogManager);
     analyzer.analyze(ast.get());
 
-    // 4. 执行计划生成
-    QueryPlanner planner;
-    json plan = planner.generatePlan(ast.get());
+    // 4. 执行计划生成（传入目录以便选择索引扫描）
+    QueryPlanner planner(&catalogManager);
+    PlanNodePtr plan = planner.buildPlan(ast.get());
 
-    // 根据AST类型补充元信息并执行相应操作
+    // 根据AST类型执行相应操作
     if (dynamic_cast<CreateTableAST*>(ast.get())) {
-        plan["astType"] = "CreateTable";
         // 调用CatalogManager创建表
         auto createAst = static_cast<CreateTableAST*>(ast.get());
         catalogManager.create_table_from_ast(*createAst);
     }
+    else if (dynamic_cast<CreateIndexAST*>(ast.get())) {
+        // 索引元数据已在语义分析阶段登记，B+树由执行引擎构建
+    }
     else if (dynamic_cast<InsertAST*>(ast.get())) {
-        plan["astType"] = "Insert";
         // 验证表是否存在
         auto insertAst = static_cast<InsertAST*>(ast.get());
         if (!catalogManager.table_exists(insertAst->tableName)) {
@@ -61,7 +82,6 @@ namespace minidb {
         }
     }
     else if (dynamic_cast<SelectAST*>(ast.get())) {
-        plan["astType"] = "Select";
         // 验证表是否存在
         auto selectAst = static_cast<SelectAST*>(ast.get());
         if (!catalogManager.table_exists(selectAst->tableName)) {
@@ -69,7 +89,6 @@ namespace minidb {
         }
     }
     else if (dynamic_cast<DeleteAST*>(ast.get())) {
-        plan["astType"] = "Delete";
         // 验证表是否存在
         auto deleteAst = static_cast<DeleteAST*>(ast.get());
         if (!catalogManager.table_exists(deleteAst->tableName)) {
@@ -80,4 +99,95 @@ namespace minidb {
     return plan;
 }
 
+    PreparedStatement SQLCompiler::prepare(const std::string& sql) {
+    return PreparedStatement(this, lookupPlan(normalizeSql(sql)));
+}
+
+    std::shared_ptr<CachedPlan> SQLCompiler::lookupPlan(const std::string& normalizedSql) {
+    auto it = planCache.find(normalizedSql);
+    if (it != planCache.end() && it->second->catalogVersion == catalogManager.get_version()) {
+        return it->second;
+    }
+
+    size_t parameterCount = 0;
+    ASTNodePtr ast = parse(normalizedSql, parameterCount);
+    // 建表/建索引在编译时就修改目录，不能重复执行
+    if (!dynamic_cast<SelectAST*>(ast.get()) && !dynamic_cast<InsertAST*>(ast.get()) &&
+        !dynamic_cast<DeleteAST*>(ast.get())) {
+        throw std::runtime_error("Only SELECT, INSERT and DELETE statements can be prepared.");
+    }
+
+    SemanticAnalyzer analyzer(catalogManager);
+    analyzer.analyze(ast.get());
+    QueryPlanner planner(&catalogManager);
+
+    auto cached = std::make_shared<CachedPlan>();
+    cached->sql = normalizedSql;
+    cached->plan = planner.buildPlan(ast.get());
+    // 编译时就检查每个参数都出现在可绑定的位置
+    collectParameterSlots(*cached->plan, parameterCount);
+    cached->parameterCount = parameterCount;
+    cached->catalogVersion = catalogManager.get_version();
+
+    if (it != planCache.end()) {
+        it->second = cached;
+    } else if (planCacheCapacity > 0) {
+        if (planCache.size() >= planCacheCapacity) {
+            // 先淘汰已失效的计划，仍然满时任意淘汰一项（已取出的语句持有自己的计划，不受影响）
+            for (auto stale = planCache.begin(); stale != planCache.end();) {
+                if (stale->second->catalogVersion != cached->catalogVersion) {
+                    stale = planCache.erase(stale);
+                } else {
+                    ++stale;
+                }
+            }
+            if (planCache.size() >= planCacheCapacity) {
+                planCache.erase(planCache.begin());
+            }
+        }
+        planCache.emplace(normalizedSql, cached);
+    }
+    return cached;
+}
+
+    void SQLCompiler::setPlanCacheCapacity(size_t capacity) {
+    planCacheCapacity = capacity;
+    while (planCache.size() > planCacheCapacity) {
+        planCache.erase(planCache.begin());
+    }
+}
+
+    std::string SQLCompiler::normalizeSql(const std::string& sql) {
+    std::string normalized;
+    normalized.reserve(sql.size() + 1);
+    char quote = 0;
+    bool pendingSpace = false;
+    for (size_t i = 0; i < sql.size(); ++i) {
+        char c = sql[i];
+        if (quote) {
+            normalized += c;
+            if (c == '\\' && i + 1 < sql.size()) {
+                normalized += sql[++i];
+            } else if (c == quote) {
+                quote = 0;
+            }
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pendingSpace = !normalized.empty();
+            continue;
+        }
+        // 分号前的空白不保留
+        if (pendingSpace && c != ';') normalized += ' ';
+        pendingSpace = false;
+        if (c == '\'' || c == '"') quote = c;
+        normalized += c;
+    }
+    while (!normalized.empty() && normalized.back() == ';') {
+        normalized.pop_back();
+        while (!normalized.empty() && normalized.back() == ' ') normalized.pop_back();
+    }
+    return normalized + ";";
+}
+
 } // namespace minidb
\ No newline at end of file
@@ -8,6 +8,17 @@ using namespace minidb;
 using namespace std;
 
 
+//TypeIdתΪͼʹõַ
+static string typeIdToString(TypeId type) {
+    switch (type) {
+        case TypeId::INTEGER: return "INT";
+        case TypeId::VARCHAR: return "STRING";
+        case TypeId::FLOAT: return "FLOAT";
+        case TypeId::BOOLEAN: return "BOOLEAN";
+        default: return "UNKNOWN";
+    }
+}
+
 //ַתΪTypeIdö٣ֶ֧ͱʹСдʽ
 static TypeId stringToTypeId(const string& type_str) {
     // תΪСдʵִСдƥ
@@ -27,6 +38,14 @@ static TypeId stringToTypeId(const string& type_str) {
     }
 }
 
+//ѯǷĳۺϺ "COUNT(*)"
+static bool isAggregateColumn(const SelectAST* ast, const string& col_name) {
+    for (const auto& call : ast->aggregates) {
+        if (call.name() == col_name) return true;
+    }
+    return false;
+}
+
 
 //ںASTڵͷַӦķ
 void SemanticAnalyzer::analyze(ASTNode* ast) {
@@ -37,12 +56,16 @@ void SemanticAnalyzer::analyze(ASTNode* ast) {
     // ASTڵͽзַ
     if (auto create_table_ast = dynamic_cast<CreateTableAST*>(ast)) {
         analyzeCreateTable(create_table_ast);
+    } else if (auto create_index_ast = dynamic_cast<CreateIndexAST*>(ast)) {
+        analyzeCreateIndex(create_index_ast);
     } else if (auto insert_ast = dynamic_cast<InsertAST*>(ast)) {
         analyzeInsert(insert_ast);
     } else if (auto select_ast = dynamic_cast<SelectAST*>(ast)) {
         analyzeSelect(select_ast);
     } else if (auto delete_ast = dynamic_cast<DeleteAST*>(ast)) {
         analyzeDelete(delete_ast);
+    } else if (auto copy_ast = dynamic_cast<CopyAST*>(ast)) {
+        analyzeCopy(copy_ast);
     } else {
         throw SemanticError("ֵ֧ASTڵ");
     }
@@ -103,10 +126,47 @@ void SemanticAnalyzer::analyzeCreateTable(CreateTableAST* ast) {
     }
 }
 
+//CREATE INDEX䣬ǷڡǷظ
+void SemanticAnalyzer::analyzeCreateIndex(CreateIndexAST* ast) {
+    const string& index_name = ast->indexName;
+    const string& table_name = ast->tableName;
+
+    // ǷѴ
+    if (catalog_manager_.index_exists(index_name)) {
+        throw SemanticError(" '" + index_name + "' Ѵڣ޷ظ");
+    }
+
+    // Ƿ
+    const TableInfo* table_info = catalog_manager_.get_table(table_name);
+    if (!table_info) {
+        throw SemanticError("ʧܣ '" + table_name + "' ");
+    }
+    const Schema& schema = table_info->get_schema();
+
+    // ǷڡǷظ
+    if (ast->columns.empty() || ast->columns.size() > catalog::IndexMeta::MAX_INDEX_COLUMNS) {
+        throw SemanticError("ʧܣи1" +
+                            to_string(catalog::IndexMeta::MAX_INDEX_COLUMNS) + "֮");
+    }
+    unordered_set<string> seen;
+    for (const string& col_name : ast->columns) {
+        if (!schema.has_column(col_name)) {
+            throw SemanticError("ʧܣ '" + table_name + "' в '" + col_name + "'");
+        }
+        if (!seen.insert(col_name).second) {
+            throw SemanticError("ʧܣ '" + col_name + "' ظ");
+        }
+    }
+
+    // ǼԪݣB+ִ湹
+    if (!catalog_manager_.create_index_from_ast(*ast)) {
+        throw SemanticError(" '" + index_name + "' ʧ");
+    }
+}
+
 //INSERT
 void SemanticAnalyzer::analyzeInsert(InsertAST* ast) {
     const string& table_name = ast->tableName;
-    const vector<string>& values = ast->values;
 
     // Ƿ
     if (!catalog_manager_.table_exists(table_name)) {
@@ -120,47 +180,69 @@ void SemanticAnalyzer::analyzeInsert(InsertAST* ast) {
     }
     const Schema& schema = table_info->get_schema();
 
-    // ֵǷƥ
-    if (values.size() != schema.get_column_count()) {
-        throw SemanticError("ʧܣ '" + table_name + "'  " +
-                            to_string(schema.get_column_count()) + " У " +
-                            to_string(values.size()) + " ֵ");
-    }
-
-    // ÿֵǷӦеƥ
-    for (size_t i = 0; i < values.size(); ++i) {
-        const MyColumn& col = schema.get_column(static_cast<uint32_t>(i));
-        const string& value = values[i];
+    // вʱм飬Ϣк
+    for (size_t row = 0; row < ast->rows.size(); ++row) {
+        const vector<string>& values = ast->rows[row];
+        const string row_label = ast->rows.size() > 1 ? " " + to_string(row + 1) + " " : "";
 
-        // TypeIdתΪַͼ
-        string type_str;
-        switch (col.type) {
-            case TypeId::INTEGER:
-                type_str = "INT";
-                break;
-            case TypeId::VARCHAR:
-                type_str = "STRING";
-                break;
-            case TypeId::FLOAT:
-                type_str = "FLOAT";
-                break;
-            case TypeId::BOOLEAN:
-                type_str = "BOOLEAN";
-                break;
-            default:
-                type_str = "UNKNOWN";
-                break;
+        // ֵǷƥ
+        if (values.size() != schema.get_column_count()) {
+            throw SemanticError("ʧܣ '" + table_name + "'  " +
+                                to_string(schema.get_column_count()) + " У" + row_label + " " +
+                                to_string(values.size()) + " ֵ");
         }
 
-        if (!checkValueMatchType(value, type_str)) {
-            throw SemanticError("ʧܣ '" + table_name + "'  '" + col.name +
-                                "' Ͳƥ䣬 " + type_str + "ֵΪ '" + value + "'");
+        // ÿֵǷӦеƥ
+        for (size_t i = 0; i < values.size(); ++i) {
+            const MyColumn& col = schema.get_column(static_cast<uint32_t>(i));
+            const string& value = values[i];
+
+            // TypeIdתΪַͼ
+            string type_str;
+            switch (col.type) {
+                case TypeId::INTEGER:
+                    type_str = "INT";
+                    break;
+                case TypeId::VARCHAR:
+                    type_str = "STRING";
+                    break;
+                case TypeId::FLOAT:
+                    type_str = "FLOAT";
+                    break;
+                case TypeId::BOOLEAN:
+                    type_str = "BOOLEAN";
+                    break;
+                default:
+                    type_str = "UNKNOWN";
+                    break;
+            }
+
+            // ռλִʱ󶨣ɰ󶨵ֵ
+            if (parameterIndex(value) == 0 && !checkValueMatchType(value, type_str)) {
+                throw SemanticError("ʧܣ '" + table_name + "'  '" + col.name +
+                                    "' Ͳƥ䣬 " + type_str + "" + row_label + "ֵΪ '" + value + "'");
+            }
         }
     }
 }
 
+//COPY䣺Ŀڣļ·Ϊ
+void SemanticAnalyzer::analyzeCopy(CopyAST* ast) {
+    if (!catalog_manager_.table_exists(ast->tableName)) {
+        throw SemanticError("ʧܣ '" + ast->tableName + "' ");
+    }
+    if (ast->filePath.empty()) {
+        throw SemanticError("ʧܣļ·Ϊ");
+    }
+}
+
 //SELECT
 void SemanticAnalyzer::analyzeSelect(SelectAST* ast) {
+    if (!ast->joins.empty()) {
+        analyzeJoinSelect(ast);
+        return;
+    }
+
     const string& table_name = ast->tableName;
     const vector<string>& columns = ast->columns;
 
@@ -176,9 +258,9 @@ void SemanticAnalyzer::analyzeSelect(SelectAST* ast) {
     }
     const Schema& schema = table_info->get_schema();
 
-    // ѯǷڣͨ*⣩
+    // ѯǷڣͨ*;ۺϺ⣩
     for (const string& col_name : columns) {
-        if (col_name == "*") continue;
+        if (col_name == "*" || isAggregateColumn(ast, col_name)) continue;
 
         try {
             schema.get_column_index(col_name);
@@ -189,9 +271,131 @@ void SemanticAnalyzer::analyzeSelect(SelectAST* ast) {
         }
     }
 
-    // WHEREڣ
+    // WHEREڣȽü飬ʽ
     if (ast->condition.has_value()) {
         analyzeCondition(ast->condition.value(), schema, table_name);
+    } else if (ast->where) {
+        analyzeWhere(ast->where, {{table_name, &schema}});
+    }
+
+    analyzeAggregates(ast, {{table_name, &schema}});
+    analyzeOrderBy(ast, {{table_name, &schema}});
+}
+
+//JOINѯ
+void SemanticAnalyzer::analyzeJoinSelect(SelectAST* ast) {
+    vector<TableScope> tables;
+    auto addTable = [&](const string& table_name) {
+        const TableInfo* table_info = catalog_manager_.get_table(table_name);
+        if (!table_info) {
+            throw SemanticError("ѯʧܣ '" + table_name + "' ");
+        }
+        for (const auto& scope : tables) {
+            if (scope.name == table_name) {
+                throw SemanticError("ѯʧܣ '" + table_name + "'  JOIN ظ");
+            }
+        }
+        tables.push_back({table_name, &table_info->get_schema()});
+    };
+    addTable(ast->tableName);
+
+    // ON ֻõǰӵıٰһ " = " ֵȽ
+    for (auto& join : ast->joins) {
+        addTable(join.tableName);
+        analyzeWhere(join.on, tables);
+
+        bool hasEquiKey = false;
+        vector<ExprPtr> pending = {join.on};
+        while (!pending.empty()) {
+            ExprPtr expr = pending.back();
+            pending.pop_back();
+            if (expr->kind == Expr::Kind::Binary && expr->value == "AND") {
+                pending.push_back(expr->left);
+                pending.push_back(expr->right);
+            } else if (expr->kind == Expr::Kind::Binary && expr->value == "=" &&
+                       expr->left->kind == Expr::Kind::Column && expr->right->kind == Expr::Kind::Column) {
+                string prefix = join.tableName + ".";
+                bool leftNew = expr->left->value.rfind(prefix, 0) == 0;
+                bool rightNew = expr->right->value.rfind(prefix, 0) == 0;
+                hasEquiKey = hasEquiKey || leftNew != rightNew;
+            }
+        }
+        if (!hasEquiKey) {
+            throw SemanticError("ѯʧܣJOIN " + join.tableName + "  ON ȱеĵֵȽ");
+        }
+    }
+
+    // ѯУֻ飬дԭ
+    for (const string& col_name : ast->columns) {
+        if (col_name == "*" || isAggregateColumn(ast, col_name)) continue;
+        string name = col_name;
+        resolveColumn(name, tables);
+    }
+
+    if (ast->where) {
+        analyzeWhere(ast->where, tables);
+    }
+
+    analyzeAggregates(ast, tables);
+    analyzeOrderBy(ast, tables);
+}
+
+//ORDER BYڣۺϲѯֻܰGROUP BY
+void SemanticAnalyzer::analyzeOrderBy(SelectAST* ast, const vector<TableScope>& tables) {
+    unordered_set<string> group_columns;
+    for (const string& col_name : ast->groupBy) {
+        string name = col_name;
+        resolveColumn(name, tables);
+        group_columns.insert(name);
+    }
+    bool aggregated = !ast->aggregates.empty() || !ast->groupBy.empty();
+
+    for (const auto& item : ast->orderBy) {
+        string name = item.column;
+        resolveColumn(name, tables);
+        if (aggregated && !group_columns.count(name)) {
+            throw SemanticError("ѯʧܣ '" + item.column + "'  GROUP BY ");
+        }
+    }
+}
+
+//ۺϺGROUP BYдͺϷǾۺϵĲѯбGROUP BY
+void SemanticAnalyzer::analyzeAggregates(SelectAST* ast, const vector<TableScope>& tables) {
+    for (const auto& call : ast->aggregates) {
+        if (call.column == "*") {
+            if (call.func != "COUNT") {
+                throw SemanticError("ѯʧܣֻ COUNT ʹ *" + call.name() + " Ϸ");
+            }
+            continue;
+        }
+        string name = call.column;
+        const MyColumn& column = resolveColumn(name, tables);
+        if ((call.func == "SUM" || call.func == "AVG") && column.type != TypeId::INTEGER) {
+            throw SemanticError("ѯʧܣ" + call.name() + " Ĳб INT ");
+        }
+    }
+
+    // аֱȽϣʱΪ "."
+    unordered_set<string> group_columns;
+    for (const string& col_name : ast->groupBy) {
+        string name = col_name;
+        resolveColumn(name, tables);
+        group_columns.insert(name);
+    }
+
+    if (ast->aggregates.empty() && ast->groupBy.empty()) {
+        return;
+    }
+    for (const string& col_name : ast->columns) {
+        if (isAggregateColumn(ast, col_name)) continue;
+        if (col_name == "*") {
+            throw SemanticError("ѯʧܣۺϲѯвʹ *");
+        }
+        string name = col_name;
+        resolveColumn(name, tables);
+        if (!group_columns.count(name)) {
+            throw SemanticError("ѯʧܣ '" + col_name + "' ȲǾۺϺҲ GROUP BY ");
+        }
     }
 }
 
@@ -214,6 +418,8 @@ void SemanticAnalyzer::analyzeDelete(DeleteAST* ast) {
     // WHEREڣ
     if (ast->condition.has_value()) {
         analyzeCondition(ast->condition.value(), schema, table_name);
+    } else if (ast->where) {
+        analyzeWhere(ast->where, {{table_name, &schema}});
     } else {
         // 棺WHEREDELETEɾм¼
         // ԸҪǷֲ
@@ -234,27 +440,10 @@ void SemanticAnalyzer::analyzeCondition(const Condition& cond, const Schema& sch
         }
 
         // TypeIdתΪַͼ
-        string type_str;
-        switch (cond_col.type) {
-            case TypeId::INTEGER:
-                type_str = "INT";
-                break;
-            case TypeId::VARCHAR:
-                type_str = "STRING";
-                break;
-            case TypeId::FLOAT:
-                type_str = "FLOAT";
-                break;
-            case TypeId::BOOLEAN:
-                type_str = "BOOLEAN";
-                break;
-            default:
-                type_str = "UNKNOWN";
-                break;
-        }
+        string type_str = typeIdToString(cond_col.type);
 
         // ֵǷƥ
-        if (!checkValueMatchType(cond.value, type_str)) {
+        if (parameterIndex(cond.value) == 0 && !checkValueMatchType(cond.value, type_str)) {
             throw SemanticError("ʧܣ '" + cond.column + "' Ͳƥ䣬 " +
                                 type_str + "ֵΪ '" + cond.value + "'");
         }
@@ -272,6 +461,124 @@ void SemanticAnalyzer::analyzeCondition(const Condition& cond, const Schema& sch
 }
 
 
+//WHEREʽ
+void SemanticAnalyzer::analyzeWhere(const ExprPtr& where, const vector<TableScope>& tables) {
+    if (analyzeExpression(where, tables) != "BOOLEAN") {
+        throw SemanticError("ʧܣWHEREǲʽ");
+    }
+}
+
+//ݹʽбڣһ£AND/OR/NOT ĲΪ
+string SemanticAnalyzer::analyzeExpression(const ExprPtr& expr, const vector<TableScope>& tables) {
+    switch (expr->kind) {
+        case Expr::Kind::Column: {
+            expr->type = typeIdToString(resolveColumn(expr->value, tables).type);
+            break;
+        }
+        case Expr::Kind::Literal: {
+            // δȷʱʽƶϣռλֻȷ
+            if (expr->type.empty() && parameterIndex(expr->value) == 0) {
+                expr->type = checkValueMatchType(expr->value, "INT") ? "INT" : "STRING";
+            }
+            break;
+        }
+        case Expr::Kind::Unary: {
+            if (analyzeExpression(expr->left, tables) != "BOOLEAN") {
+                throw SemanticError("ʧܣ" + expr->value + " Ĳǲʽ");
+            }
+            expr->type = "BOOLEAN";
+            break;
+        }
+        case Expr::Kind::Binary: {
+            const string& op = expr->value;
+            string left_type = analyzeExpression(expr->left, tables);
+            string right_type = analyzeExpression(expr->right, tables);
+
+            if (op == "AND" || op == "OR") {
+                if (left_type != "BOOLEAN" || right_type != "BOOLEAN") {
+                    throw SemanticError("ʧܣ" + op + " Ĳǲʽ");
+                }
+                expr->type = "BOOLEAN";
+            } else if (op == "+" || op == "-") {
+                coerceLiteral(expr->left, "INT");
+                coerceLiteral(expr->right, "INT");
+                if (expr->left->type != "INT" || expr->right->type != "INT") {
+                    throw SemanticError("ʧܣ '" + op + "' ֻ INT ");
+                }
+                expr->type = "INT";
+            } else {
+                if (!isValidOperator(op)) {
+                    throw SemanticError("ʧܣֵ֧ '" + op + "'");
+                }
+                // һͽ
+                coerceLiteral(expr->left, right_type);
+                coerceLiteral(expr->right, left_type);
+                if (expr->left->type != expr->right->type) {
+                    throw SemanticError("ʧܣ '" + op + "' Ͳһ£" +
+                                        expr->left->type + "  " + expr->right->type + "");
+                }
+                if (!isOperatorCompatibleWithType(op, stringToTypeId(expr->left->type))) {
+                    throw SemanticError("ʧܣ '" + op + "'  " + expr->left->type);
+                }
+                expr->type = "BOOLEAN";
+            }
+            break;
+        }
+    }
+    return expr->type;
+}
+
+//
+const MyColumn& SemanticAnalyzer::resolveColumn(string& name, const vector<TableScope>& tables) {
+    size_t dot = name.find('.');
+    if (dot != string::npos) {
+        string table_name = name.substr(0, dot);
+        string col_name = name.substr(dot + 1);
+        for (const auto& scope : tables) {
+            if (scope.name == table_name) {
+                if (!scope.schema->has_column(col_name)) {
+                    throw SemanticError("ʧܣ '" + table_name + "' в '" + col_name + "'");
+                }
+                return scope.schema->get_column(col_name);
+            }
+        }
+        throw SemanticError("ʧܣ '" + name + "' õı '" + table_name + "' ڲѯ");
+    }
+
+    const TableScope* found = nullptr;
+    for (const auto& scope : tables) {
+        if (scope.schema->has_column(name)) {
+            if (found) {
+                throw SemanticError("ʧܣ '" + name + "' ͬʱڱ '" + found->name +
+                                    "'  '" + scope.name + "' У . ָ");
+            }
+            found = &scope;
+        }
+    }
+    if (!found && tables.size() == 1) {
+        throw SemanticError("ʧܣ '" + tables.front().name + "' в '" + name + "'");
+    }
+    if (!found) {
+        throw SemanticError("ʧܣӵıж '" + name + "'");
+    }
+    const MyColumn& column = found->schema->get_column(name);
+    if (tables.size() > 1) {
+        name = found->name + "." + name;
+    }
+    return column;
+}
+
+//ָͽ
+void SemanticAnalyzer::coerceLiteral(const ExprPtr& expr, const string& type) {
+    if (expr->kind != Expr::Kind::Literal || expr->type == type) {
+        return;
+    }
+    if (parameterIndex(expr->value) == 0 && !checkValueMatchType(expr->value, type)) {
+        throw SemanticError("ʧܣͲƥ䣬 " + type + "ֵΪ '" + expr->value + "'");
+    }
+    expr->type = type;
+}
+
 //ǷϷ
 bool SemanticAnalyzer::isValidOperator(const string& op) {
     static const unordered_set<string> valid_operators = {
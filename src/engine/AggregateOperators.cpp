@@ -0,0 +1,336 @@
+#include "../../include/engine/AggregateOperators.h"
+#include "common/Exception.h"
+#include "engine/bPlusTree/key_codec.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace minidb {
+
+namespace {
+
+// 聚合结果列是 INTEGER，64 位累加值超出 int32 范围时报错而不是回绕
+Value integerResult(int64_t value, const std::string &column) {
+    if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) {
+        throw OutOfRangeException(column + " = " + std::to_string(value) + " does not fit in INTEGER");
+    }
+    return Value(static_cast<int32_t>(value));
+}
+
+} // namespace
+
+AggregateType parseAggregateType(const std::string &func) {
+    std::string name = func;
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    if (name == "COUNT") return AggregateType::COUNT;
+    if (name == "SUM") return AggregateType::SUM;
+    if (name == "MIN") return AggregateType::MIN;
+    if (name == "MAX") return AggregateType::MAX;
+    if (name == "AVG") return AggregateType::AVG;
+    throw std::runtime_error("Unsupported aggregate function: " + func);
+}
+
+// ==================== GroupHashTable ====================
+
+void GroupHashTable::reset(const std::vector<TypeId> &keyTypes) {
+    integerKeys_ = keyTypes.size() == 1 &&
+                   (keyTypes[0] == TypeId::INTEGER || keyTypes[0] == TypeId::BOOLEAN);
+    intKeys_.clear();
+    encodedKeys_.clear();
+    encodedBytes_ = 0;
+    groupCount_ = 0;
+    slotHashes_.assign(64, 0);
+    slotGroups_.assign(64, NONE);
+    mask_ = 63;
+}
+
+bool GroupHashTable::keyEquals(uint32_t group, int64_t intKey) const {
+    return integerKeys_ ? intKeys_[group] == intKey : encodedKeys_[group] == scratch_;
+}
+
+uint32_t GroupHashTable::find(const Tuple &tuple, const std::vector<size_t> &columns, bool insert, uint64_t &hash) {
+    int64_t intKey = 0;
+    if (integerKeys_) {
+        const Value &value = tuple.getValue(columns[0]);
+        intKey = value.isNull() ? std::numeric_limits<int64_t>::min()
+                 : value.getType() == TypeId::BOOLEAN ? value.getAsBool() : value.getAsInt();
+        hash = mixHash(static_cast<uint64_t>(intKey));
+    } else {
+        scratch_.clear();
+        for (size_t col : columns) {
+            engine::KeyCodec::encode_value(tuple.getValue(col), &scratch_);
+        }
+        hash = mixHash(std::hash<std::string>()(scratch_));
+    }
+
+    uint64_t slot = hash & mask_;
+    for (; slotGroups_[slot] != NONE; slot = (slot + 1) & mask_) {
+        if (slotHashes_[slot] == hash && keyEquals(slotGroups_[slot], intKey)) return slotGroups_[slot];
+    }
+    if (!insert) return NONE;
+
+    uint32_t group = static_cast<uint32_t>(groupCount_++);
+    if (integerKeys_) {
+        intKeys_.push_back(intKey);
+    } else {
+        encodedBytes_ += scratch_.size();
+        encodedKeys_.push_back(scratch_);
+    }
+    slotHashes_[slot] = hash;
+    slotGroups_[slot] = group;
+    // 负载因子保持在 1/2 以下
+    if (groupCount_ * 2 > slotGroups_.size()) grow();
+    return group;
+}
+
+void GroupHashTable::grow() {
+    std::vector<uint64_t> oldHashes = std::move(slotHashes_);
+    std::vector<uint32_t> oldGroups = std::move(slotGroups_);
+    slotHashes_.assign(oldHashes.size() * 2, 0);
+    slotGroups_.assign(oldGroups.size() * 2, NONE);
+    mask_ = slotGroups_.size() - 1;
+    for (size_t i = 0; i < oldGroups.size(); ++i) {
+        if (oldGroups[i] == NONE) continue;
+        uint64_t slot = oldHashes[i] & mask_;
+        while (slotGroups_[slot] != NONE) slot = (slot + 1) & mask_;
+        slotHashes_[slot] = oldHashes[i];
+        slotGroups_[slot] = oldGroups[i];
+    }
+}
+
+size_t GroupHashTable::memoryUsage() const {
+    size_t slots = slotGroups_.size() * (sizeof(uint64_t) + sizeof(uint32_t));
+    size_t keys = integerKeys_ ? intKeys_.size() * sizeof(int64_t)
+                               : encodedKeys_.size() * sizeof(std::string) + encodedBytes_;
+    return slots + keys;
+}
+
+// ==================== Aggregate ====================
+
+AggregateOperator::AggregateOperator(OperatorPtr child, std::vector<size_t> groupColumns,
+                                     std::vector<AggregateSpec> aggregates,
+                                     std::shared_ptr<storage::BufferManager> bufferManager, size_t memoryBudget)
+    : child_(std::move(child)), groupColumns_(std::move(groupColumns)), aggregates_(std::move(aggregates)),
+      bufferManager_(std::move(bufferManager)), memoryBudget_(memoryBudget) {
+    for (size_t col : groupColumns_) {
+        columnNames_.push_back(child_->getColumnNames().at(col));
+        columnTypes_.push_back(child_->getColumnTypes().at(col));
+    }
+    for (const auto &agg : aggregates_) {
+        bool keepsType = agg.type == AggregateType::MIN || agg.type == AggregateType::MAX;
+        if (agg.column == AggregateSpec::NO_COLUMN && agg.type != AggregateType::COUNT) {
+            throw std::runtime_error("Only COUNT accepts '*'");
+        }
+        if ((agg.type == AggregateType::SUM || agg.type == AggregateType::AVG) &&
+            child_->getColumnTypes().at(agg.column) != TypeId::INTEGER) {
+            throw TypeMismatchException(agg.name + " requires an INTEGER column");
+        }
+        columnNames_.push_back(agg.name);
+        columnTypes_.push_back(keepsType ? child_->getColumnTypes().at(agg.column) : TypeId::INTEGER);
+    }
+}
+
+void AggregateOperator::resetGroups() {
+    std::vector<TypeId> keyTypes;
+    for (size_t col : groupColumns_) {
+        keyTypes.push_back(child_->getColumnTypes()[col]);
+    }
+    table_.reset(keyTypes);
+    groupKeys_.clear();
+    states_.clear();
+    groupBytes_ = 0;
+    cursor_ = 0;
+
+    // 没有分组列时只有一个分组，且输入为空也要输出
+    if (groupColumns_.empty()) {
+        states_.resize(aggregates_.size());
+    }
+}
+
+void AggregateOperator::open() {
+    resetGroups();
+    spilled_ = false;
+    partitions_.clear();
+    partition_ = 0;
+
+    child_->open();
+    Tuple tuple;
+    while (child_->next(tuple)) {
+        consume(tuple, bufferManager_ != nullptr);
+    }
+    child_->close();
+}
+
+void AggregateOperator::consume(const Tuple &tuple, bool allowSpill) {
+    if (groupColumns_.empty()) {
+        accumulate(states_.data(), tuple);
+        return;
+    }
+
+    bool full = allowSpill && table_.memoryUsage() + groupBytes_ > memoryBudget_;
+    uint64_t hash;
+    uint32_t group = table_.find(tuple, groupColumns_, !full, hash);
+    if (group == GroupHashTable::NONE) {
+        if (!spilled_) {
+            spilled_ = true;
+            for (size_t p = 0; p < PARTITION_COUNT; ++p) {
+                partitions_.push_back(std::make_unique<SpillFile>(bufferManager_));
+            }
+        }
+        partitions_[hash >> (64 - PARTITION_BITS)]->append(tuple);
+        return;
+    }
+
+    if (group * groupColumns_.size() == groupKeys_.size()) {
+        // 新分组：记录分组列值并追加一组初始状态
+        for (size_t col : groupColumns_) {
+            const Value &key = tuple.getValue(col);
+            groupBytes_ += sizeof(Value);
+            if (!key.isNull() && key.getType() == TypeId::VARCHAR) groupBytes_ += key.getAsString().size();
+            groupKeys_.push_back(key);
+        }
+        states_.resize(states_.size() + aggregates_.size());
+        groupBytes_ += aggregates_.size() * sizeof(AggState);
+    }
+    accumulate(states_.data() + group * aggregates_.size(), tuple);
+}
+
+void AggregateOperator::accumulate(AggState *states, const Tuple &tuple) {
+    for (size_t i = 0; i < aggregates_.size(); ++i) {
+        const auto &agg = aggregates_[i];
+        AggState &state = states[i];
+        if (agg.column == AggregateSpec::NO_COLUMN) {
+            ++state.count;
+            continue;
+        }
+
+        const Value &v = tuple.getValue(agg.column);
+        if (v.isNull()) continue;
+        switch (agg.type) {
+            case AggregateType::COUNT:
+                ++state.count;
+                break;
+            case AggregateType::SUM:
+            case AggregateType::AVG:
+                ++state.count;
+                state.sum += v.getAsInt();
+                break;
+            case AggregateType::MIN:
+                if (state.extreme.isNull() || v.lessThan(state.extreme)) state.extreme = v;
+                break;
+            case AggregateType::MAX:
+                if (state.extreme.isNull() || v.greaterThan(state.extreme)) state.extreme = v;
+                break;
+        }
+    }
+}
+
+Tuple AggregateOperator::result(size_t group) const {
+    std::vector<Value> values;
+    values.reserve(columnNames_.size());
+    auto keys = groupKeys_.begin() + static_cast<std::ptrdiff_t>(group * groupColumns_.size());
+    values.insert(values.end(), keys, keys + static_cast<std::ptrdiff_t>(groupColumns_.size()));
+
+    const AggState *states = states_.data() + group * aggregates_.size();
+    for (size_t i = 0; i < aggregates_.size(); ++i) {
+        const AggState &state = states[i];
+        const std::string &column = columnNames_[groupColumns_.size() + i];
+        switch (aggregates_[i].type) {
+            case AggregateType::COUNT:
+                values.push_back(integerResult(state.count, column));
+                break;
+            case AggregateType::SUM:
+                values.push_back(state.count ? integerResult(state.sum, column) : Value());
+                break;
+            case AggregateType::AVG:
+                values.push_back(state.count ? integerResult(state.sum / state.count, column) : Value());
+                break;
+            case AggregateType::MIN:
+            case AggregateType::MAX:
+                values.push_back(state.extreme);
+                break;
+        }
+    }
+    return Tuple(std::move(values));
+}
+
+bool AggregateOperator::next(Tuple &tuple) {
+    size_t group;
+    if (!advance(group)) return false;
+    tuple = result(group);
+    return true;
+}
+
+bool AggregateOperator::nextGroup(Tuple &keys, std::vector<AggState> &states) {
+    size_t group;
+    if (!advance(group)) return false;
+    auto key = groupKeys_.begin() + static_cast<std::ptrdiff_t>(group * groupColumns_.size());
+    keys = Tuple(std::vector<Value>(key, key + static_cast<std::ptrdiff_t>(groupColumns_.size())));
+    auto state = states_.begin() + static_cast<std::ptrdiff_t>(group * aggregates_.size());
+    states.assign(state, state + static_cast<std::ptrdiff_t>(aggregates_.size()));
+    return true;
+}
+
+void AggregateOperator::beginMerge() {
+    resetGroups();
+    spilled_ = false;
+    partitions_.clear();
+    partition_ = 0;
+}
+
+void AggregateOperator::mergeGroup(const Tuple &keys, const std::vector<AggState> &states) {
+    AggState *target = states_.data();
+    if (!groupColumns_.empty()) {
+        std::vector<size_t> keyColumns(groupColumns_.size());
+        for (size_t i = 0; i < keyColumns.size(); ++i) keyColumns[i] = i;
+        uint64_t hash;
+        uint32_t group = table_.find(keys, keyColumns, true, hash);
+        if (group * groupColumns_.size() == groupKeys_.size()) {
+            groupKeys_.insert(groupKeys_.end(), keys.getValues().begin(), keys.getValues().end());
+            states_.resize(states_.size() + aggregates_.size());
+        }
+        target = states_.data() + group * aggregates_.size();
+    }
+
+    for (size_t i = 0; i < aggregates_.size(); ++i) {
+        const AggState &state = states[i];
+        target[i].count += state.count;
+        target[i].sum += state.sum;
+        if (state.extreme.isNull()) continue;
+        bool replace = target[i].extreme.isNull() ||
+                       (aggregates_[i].type == AggregateType::MIN ? state.extreme.lessThan(target[i].extreme)
+                                                                  : state.extreme.greaterThan(target[i].extreme));
+        if (replace) target[i].extreme = state.extreme;
+    }
+}
+
+bool AggregateOperator::advance(size_t &group) {
+    while (true) {
+        size_t groupCount = groupColumns_.empty() ? 1 : table_.size();
+        if (cursor_ < groupCount) {
+            group = cursor_++;
+            return true;
+        }
+        if (!spilled_ || partition_ >= PARTITION_COUNT) return false;
+
+        // 内存中的分组已输出，清空后单独聚合下一个溢出分区（分区内不再溢出）
+        resetGroups();
+        SpillFile &file = *partitions_[partition_];
+        file.rewind();
+        Tuple row;
+        while (file.next(row)) {
+            consume(row, false);
+        }
+        partitions_[partition_++].reset();   // 读完即归还临时页
+    }
+}
+
+void AggregateOperator::close() {
+    groupKeys_.clear();
+    states_.clear();
+    partitions_.clear();
+    cursor_ = 0;
+}
+
+} // namespace minidb
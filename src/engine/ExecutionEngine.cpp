@@ -1,45 +1,165 @@
 #include "../include/engine/ExecutionEngine.h"
+#include "common/CsvReader.h"
 #include "common/Exception.h"
+#include "engine/bPlusTree/key_codec.h"
+#include <charconv>
 #include <cstring>
+#include <iostream>
 #include <algorithm>
+#include <unordered_set>
 
 namespace minidb {
 
-void ExecutionEngine::scanTablePages(const TableInfo *table_info,
-                                     const std::function<void(storage::Page *, RID &)> &callback) {
-    PageID pid = table_info->getFirstPageID();
-    while (pid != INVALID_PAGE_ID) {
-        storage::Page *page = bufferManager_->fetchPage(pid);
-        if (!page) {
-            throw std::runtime_error("Failed to fetch page: " + std::to_string(pid));
+namespace {
+
+// 单输入节点的子计划，扫描、连接等节点返回 nullptr
+const PlanNode *inputOf(const PlanNode &plan) {
+    switch (plan.type) {
+        case PlanNodeType::Delete: return static_cast<const DeletePlan &>(plan).input.get();
+        case PlanNodeType::Update: return static_cast<const UpdatePlan &>(plan).input.get();
+        case PlanNodeType::Filter: return static_cast<const FilterPlan &>(plan).input.get();
+        case PlanNodeType::Project: return static_cast<const ProjectPlan &>(plan).input.get();
+        case PlanNodeType::Limit: return static_cast<const LimitPlan &>(plan).input.get();
+        case PlanNodeType::Sort: return static_cast<const SortPlan &>(plan).input.get();
+        case PlanNodeType::Aggregate: return static_cast<const AggregatePlan &>(plan).input.get();
+        default: return nullptr;
+    }
+}
+
+// 按聚合计划解析分组列和聚合项，列名在 input（逐行或批量算子）的输出列中查找
+template <typename Input>
+void aggregateColumns(const AggregatePlan &aggregate, const Input &input, std::vector<size_t> &groupColumns,
+                      std::vector<AggregateSpec> &aggregates) {
+    for (const auto &column : aggregate.groupBy) {
+        groupColumns.push_back(input.getColumnIndex(column));
+    }
+    for (const auto &call : aggregate.aggregates) {
+        std::string func = call.func;
+        std::transform(func.begin(), func.end(), func.begin(), ::toupper);
+
+        AggregateSpec spec;
+        spec.type = parseAggregateType(func);
+        spec.column = call.column == "*" ? AggregateSpec::NO_COLUMN : input.getColumnIndex(call.column);
+        spec.name = func + "(" + call.column + ")";
+        aggregates.push_back(spec);
+    }
+}
+
+// 把一行常量文本按列类型编码为定长记录
+void encodeLiteralRow(const RowCodec &codec, const std::vector<std::string> &values, char *record) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        codec.encodeValue(record, i, parseLiteral(values[i], codec.field(i).type));
+    }
+}
+
+// 按列类型检查 CSV 一行：INTEGER/BOOLEAN 解析到 numbers，VARCHAR 字段写入时直接拷贝
+void parseCsvRow(const Schema &schema, const std::vector<std::string_view> &fields, std::vector<int32_t> &numbers,
+                 size_t line) {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        const MyColumn &column = schema.get_column(static_cast<uint32_t>(i));
+        std::string_view field = fields[i];
+        if (column.type == TypeId::INTEGER) {
+            if (!field.empty() && field.front() == '+') field.remove_prefix(1);
+            auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), numbers[i]);
+            if (field.empty() || ec != std::errc() || end != field.data() + field.size()) {
+                throw TypeMismatchException("CSV line " + std::to_string(line) + ", column '" + column.name +
+                                            "': invalid INTEGER '" + std::string(fields[i]) + "'");
+            }
+        } else if (column.type == TypeId::BOOLEAN) {
+            if (field == "true" || field == "1") {
+                numbers[i] = 1;
+            } else if (field == "false" || field == "0") {
+                numbers[i] = 0;
+            } else {
+                throw TypeMismatchException("CSV line " + std::to_string(line) + ", column '" + column.name +
+                                            "': invalid BOOLEAN '" + std::string(field) + "'");
+            }
+        } else if (column.type != TypeId::VARCHAR) {
+            throw TypeMismatchException("Unsupported column type for COPY: " + std::string(getTypeName(column.type)));
         }
-        RID rid{pid, static_cast<uint16_t>(-1)}; // 初始化为 -1 才能取到第0条
-        while (page->getNextRecord(rid)) {
-            callback(page, rid);
+    }
+}
+
+// 把 parseCsvRow 检查过的一行写入页内记录，VARCHAR 超长时截断，不足时补 '\0'
+void writeCsvRecord(const RowCodec &codec, const std::vector<std::string_view> &fields,
+                    const std::vector<int32_t> &numbers, char *record) {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        switch (codec.field(i).type) {
+            case TypeId::INTEGER: codec.writeInt(record, i, numbers[i]); break;
+            case TypeId::BOOLEAN: codec.writeBool(record, i, numbers[i] != 0); break;
+            default: codec.writeString(record, i, fields[i]); break;
         }
-        pid = page->getNextPageId();
     }
 }
 
-PageID ExecutionEngine::appendNewPageToTable(TableInfo *table_info) {
-    PageID new_pid = bufferManager_->allocatePage();
-    storage::Page *new_page = bufferManager_->fetchPage(new_pid);
-    new_page->initAsDataPage();
-    new_page->setNextPageId(INVALID_PAGE_ID);
+} // namespace
 
-    PageID last_pid = table_info->getFirstPageID();
-    storage::Page *last_page = bufferManager_->fetchPage(last_pid);
-    while (last_page->getNextPageId() != INVALID_PAGE_ID) {
-        last_pid = last_page->getNextPageId();
-        last_page = bufferManager_->fetchPage(last_pid);
+PageID ExecutionEngine::appendNewPageToTable(storage::TablePageDirectory &directory,
+                                             storage::WritePageGuard &last_page) {
+    PageID new_pid = bufferManager_->allocatePage();
+    uint16_t free_space;
+    {
+        storage::WritePageGuard new_page = bufferManager_->fetchPageWrite(new_pid);
+        new_page->initAsDataPage();
+        new_page->setNextPageId(INVALID_PAGE_ID);
+        new_page->setDirty(true);
+        free_space = new_page->getFreeSpace();
     }
+
     last_page->setNextPageId(new_pid);
     last_page->setDirty(true);
-
-    new_page->setDirty(true);
+    directory.append(new_pid, free_space);
     return new_pid;
 }
 
+RID ExecutionEngine::relocateRecord(storage::TablePageDirectory &directory, const char *record, uint16_t size) {
+    while (true) {
+        PageID pid = directory.findPageWithSpace(size);
+        if (pid == INVALID_PAGE_ID) {
+            storage::WritePageGuard last_page = bufferManager_->fetchPageWrite(directory.getLastPage());
+            pid = appendNewPageToTable(directory, last_page);
+        }
+        storage::WritePageGuard page = bufferManager_->fetchPageWrite(pid);
+        RID rid;
+        bool inserted = page->insertRecord(record, size, &rid);
+        directory.setFreeSpace(pid, page->getFreeSpace());
+        if (inserted) {
+            page->setDirty(true);
+            return rid;
+        }
+    }
+}
+
+storage::TablePageDirectory *ExecutionEngine::findPageDirectory(const TableInfo *table) {
+    auto it = directories_.find(table->get_table_id());
+    if (it != directories_.end()) return it->second.get();
+
+    PageID root = table->getDirectoryPageID();
+    if (root == INVALID_PAGE_ID) return nullptr;
+    auto directory = std::make_unique<storage::TablePageDirectory>(bufferManager_, root);
+    return directories_.emplace(table->get_table_id(), std::move(directory)).first->second.get();
+}
+
+storage::TablePageDirectory &ExecutionEngine::pageDirectory(const TableInfo *table) {
+    if (storage::TablePageDirectory *directory = findPageDirectory(table)) return *directory;
+
+    PageID root = storage::TablePageDirectory::create(bufferManager_, table->getFirstPageID());
+    catalog_->get_table(table->get_table_name())->setDirectoryPageID(root);
+    auto directory = std::make_unique<storage::TablePageDirectory>(bufferManager_, root);
+    return *directories_.emplace(table->get_table_id(), std::move(directory)).first->second;
+}
+
+std::vector<PageID> ExecutionEngine::tablePages(const TableInfo *table) {
+    if (const storage::TablePageDirectory *directory = findPageDirectory(table)) return directory->getPages();
+
+    std::vector<PageID> pages;
+    for (PageID pid = table->getFirstPageID(); pid != INVALID_PAGE_ID;) {
+        pages.push_back(pid);
+        pid = bufferManager_->fetchPageRead(pid)->getNextPageId();
+    }
+    return pages;
+}
+
 // QueryResult ExecutionEngine::executeCreateTable(const nlohmann::json &plan) {
 //     std::string tableName = plan["tableName"];
 //     Schema schema;
@@ -73,13 +193,13 @@ PageID ExecutionEngine::appendNewPageToTable(TableInfo *table_info) {
 // }
 
 
-    QueryResult ExecutionEngine::executeCreateTable(const nlohmann::json &plan) {
-    std::string tableName = plan["tableName"];
+    QueryResult ExecutionEngine::executeCreateTable(const CreateTablePlan &plan) {
+    const std::string &tableName = plan.tableName;
     try {
         Schema schema;
-        for (auto &col : plan["columns"]) {
-            std::string name = col["name"];
-            std::string typeStr = col["type"];
+        for (const auto &col : plan.columns) {
+            const std::string &name = col.name;
+            std::string typeStr = col.type;
 
             // 转大写，兼容大小写和 INT
             std::transform(typeStr.begin(), typeStr.end(), typeStr.begin(), ::toupper);
@@ -95,6 +215,20 @@ PageID ExecutionEngine::appendNewPageToTable(TableInfo *table_info) {
 
         catalog_->create_table(tableName, schema);
 
+        // 目录登记表时首页为 0（磁盘头页），在这里分配真正的首个数据页
+        TableInfo *table_info = catalog_->get_table(tableName);
+        if (table_info && table_info->getFirstPageID() == 0) {
+            PageID first_pid = bufferManager_->allocatePage();
+            {
+                storage::WritePageGuard first_page = bufferManager_->fetchPageWrite(first_pid);
+                first_page->initAsDataPage();
+                first_page->setNextPageId(INVALID_PAGE_ID);
+                first_page->setDirty(true);
+            }
+            table_info->setFirstPageID(first_pid);
+            table_info->setDirectoryPageID(storage::TablePageDirectory::create(bufferManager_, first_pid));
+        }
+
         QueryResult res;
         std::cout << "[OK] Table created: " << tableName << "\n";
         return res;
@@ -104,160 +238,250 @@ PageID ExecutionEngine::appendNewPageToTable(TableInfo *table_info) {
     }
 }
 
-QueryResult ExecutionEngine::executeInsert(const nlohmann::json &plan) {
-    std::string tableName = plan["tableName"];
-    std::vector<std::string> values = plan["values"];
+QueryResult ExecutionEngine::executeInsert(const InsertPlan &plan) {
+    const std::string &tableName = plan.tableName;
 
     TableInfo *table_info = catalog_->get_table(tableName);
     if (!table_info) handleError("Table does not exist: " + tableName);
 
     const Schema &schema = table_info->get_schema();
-    size_t record_size = 0;
-    for (uint32_t i = 0; i < schema.get_column_count(); ++i) {
-        const MyColumn &column = schema.get_column(i);
-        record_size += (column.type == TypeId::VARCHAR) ? column.length :
-                       (column.type == TypeId::BOOLEAN ? sizeof(bool) : sizeof(int32_t));
+    const RowCodec &codec = table_info->get_codec();
+    const uint16_t record_size = static_cast<uint16_t>(schema.get_length());
+    const std::vector<catalog::IndexMeta *> indexes = catalog_->get_table_indexes(tableName);
+    if (static_cast<size_t>(record_size) + storage::Page::SLOT_SIZE > PAGE_SIZE - sizeof(storage::PageHeader)) {
+        handleError("Record of " + std::to_string(record_size) + " bytes does not fit in a page");
     }
 
-    std::vector<char> record_data(record_size, 0);
-    size_t current_offset = 0;
-    for (size_t i = 0; i < values.size(); ++i) {
-        const MyColumn &column = schema.get_column(static_cast<uint32_t>(i));
-        if (column.type == TypeId::INTEGER) {
-            int32_t v = std::stoi(values[i]);
-            std::memcpy(record_data.data() + current_offset, &v, sizeof(int32_t));
-            current_offset += sizeof(int32_t);
-        } else if (column.type == TypeId::BOOLEAN) {
-            bool v = (values[i] == "true" || values[i] == "1");
-            std::memcpy(record_data.data() + current_offset, &v, sizeof(bool));
-            current_offset += sizeof(bool);
-        } else if (column.type == TypeId::VARCHAR) {
-            size_t copy_size = std::min(values[i].size(), static_cast<size_t>(column.length));
-            std::memcpy(record_data.data() + current_offset, values[i].c_str(), copy_size);
-            current_offset += column.length;
-        }
-    }
-
-    PageID pid = table_info->getFirstPageID();
-    storage::Page *page = bufferManager_->fetchPage(pid);
-    RID rid;
-    while (!page->insertRecord(record_data.data(), record_size, &rid)) {
-        if (page->getNextPageId() == INVALID_PAGE_ID) {
-            pid = appendNewPageToTable(table_info);
-            page = bufferManager_->fetchPage(pid);
-        } else {
-            pid = page->getNextPageId();
-            page = bufferManager_->fetchPage(pid);
+    // 第一遍：编码并校验所有行（列数、类型、唯一键与已有数据及本批其他行的冲突），
+    // 任何一行出错都在写入前抛出，多行 INSERT 要么全部写入要么都不写入
+    std::vector<char> records(plan.rows.size() * record_size, 0);
+    std::vector<Tuple> tuples;
+    std::vector<std::unordered_set<std::string>> batchKeys(indexes.size());
+    for (size_t r = 0; r < plan.rows.size(); ++r) {
+        const auto &values = plan.rows[r];
+        if (values.size() != schema.get_column_count()) {
+            handleError("Expected " + std::to_string(schema.get_column_count()) + " values, got " +
+                        std::to_string(values.size()));
+        }
+        char *record_data = records.data() + r * record_size;
+        encodeLiteralRow(codec, values, record_data);
+
+        if (indexes.empty()) continue;
+        tuples.push_back(codec.decode(record_data));
+        checkUniqueIndexes(indexes, schema, tuples.back());
+        for (size_t i = 0; i < indexes.size(); ++i) {
+            if (indexes[i]->is_unique() &&
+                !batchKeys[i].insert(engine::KeyCodec::encode(extractIndexKey(*indexes[i], schema, tuples.back())))
+                     .second) {
+                handleError("Duplicate key for unique index '" + indexes[i]->get_index_name() + "'");
+            }
         }
     }
-    page->setDirty(true);
+
+    // 第二遍：写入。各行共用写入位置：当前页写满后按目录的空闲空间提示找下一页，都满时追加到表尾
+    storage::TablePageDirectory &directory = pageDirectory(table_info);
+    storage::WritePageGuard page;
+    for (size_t r = 0; r < plan.rows.size(); ++r) {
+        const char *record_data = records.data() + r * record_size;
+        RID rid;
+        while (!page.isValid() || !page->insertRecord(record_data, record_size, &rid)) {
+            if (page.isValid()) {
+                directory.setFreeSpace(page.getPageId(), page->getFreeSpace());
+                page.release();
+            }
+            PageID pid = directory.findPageWithSpace(record_size);
+            if (pid == INVALID_PAGE_ID) {
+                storage::WritePageGuard last_page = bufferManager_->fetchPageWrite(directory.getLastPage());
+                pid = appendNewPageToTable(directory, last_page);
+            }
+            page = bufferManager_->fetchPageWrite(pid);
+        }
+        page->setDirty(true);
+
+        if (!indexes.empty()) {
+            tuples[r].setRid(rid);
+            insertIndexEntries(table_info, tuples[r]);
+        }
+    }
+    if (page.isValid()) {
+        directory.setFreeSpace(page.getPageId(), page->getFreeSpace());
+        page.release();
+    }
+    directory.flush();
+
     cout<<"insert ok"<<endl;
     return QueryResult();
 }
 
+QueryResult ExecutionEngine::executeCopy(const CopyPlan &plan) {
+    const std::string &tableName = plan.tableName;
 
+    TableInfo *table_info = catalog_->get_table(tableName);
+    if (!table_info) handleError("Table does not exist: " + tableName);
 
-    // SELECT 执行
-    QueryResult ExecutionEngine::executeSelect(const nlohmann::json &plan) {
-    std::string tableName = plan["tableName"];
-    TableInfo *tableInfo = catalog_->get_table(tableName);
-    if (!tableInfo) {
-        throw std::runtime_error("Table not found: " + tableName);
-    }
+    const Schema &schema = table_info->get_schema();
+    const RowCodec &codec = table_info->get_codec();
+    const uint16_t record_size = static_cast<uint16_t>(schema.get_length());
+    const std::vector<catalog::IndexMeta *> indexes = catalog_->get_table_indexes(tableName);
+    // 有索引时先编码到这里，解码出的元组与页内记录完全一致（VARCHAR 已截断）
+    std::vector<char> scratch(indexes.empty() ? 0 : record_size);
 
-    QueryResult result;
+    CsvReader reader(plan.filePath);
+    std::vector<std::string_view> fields;
+    if (plan.header) reader.next(fields);
 
-    // 设置列名
-    std::vector<std::string> colNames;
-    for (auto &col : tableInfo->get_schema().get_columns()) {
-        colNames.push_back(col.get_name());
-    }
-    result.setColumnNames(colNames);
+    // 只向尾页及其后追加，前面页中删除留下的空位留给 INSERT
+    storage::TablePageDirectory &directory = pageDirectory(table_info);
+    storage::WritePageGuard page = bufferManager_->fetchPageWrite(directory.getLastPage());
+
+    std::vector<int32_t> numbers(schema.get_column_count());
+    size_t rows = 0;
+    while (reader.next(fields)) {
+        if (fields.size() != schema.get_column_count()) {
+            handleError("CSV line " + std::to_string(reader.lineNumber()) + ": expected " +
+                        std::to_string(schema.get_column_count()) + " fields, got " + std::to_string(fields.size()));
+        }
+        // 先转换整行并检查唯一索引，出错时不会留下写了一半的记录
+        parseCsvRow(schema, fields, numbers, reader.lineNumber());
+
+        Tuple tuple;
+        if (!indexes.empty()) {
+            writeCsvRecord(codec, fields, numbers, scratch.data());
+            tuple = codec.decode(scratch.data());
+            checkUniqueIndexes(indexes, schema, tuple);
+        }
+
+        RID rid;
+        char *record = page->reserveRecord(record_size, &rid);
+        if (record == nullptr) {
+            directory.setFreeSpace(page.getPageId(), page->getFreeSpace());
+            PageID new_pid = appendNewPageToTable(directory, page);
+            page = bufferManager_->fetchPageWrite(new_pid);
+            record = page->reserveRecord(record_size, &rid);
+            if (record == nullptr) handleError("Record of " + std::to_string(record_size) + " bytes does not fit in a page");
+        }
+        if (indexes.empty()) {
+            writeCsvRecord(codec, fields, numbers, record);
+        } else {
+            std::memcpy(record, scratch.data(), record_size);
+        }
 
-    // 仅扫描首个 page
-    PageID pid = tableInfo->getFirstPageID();
-    scanSinglePage(pid, tableInfo->get_schema(), result);
+        if (!indexes.empty()) {
+            tuple.setRid(rid);
+            insertIndexEntries(table_info, tuple);
+        }
+        ++rows;
+    }
+    page->setDirty(true);
+    directory.setFreeSpace(page.getPageId(), page->getFreeSpace());
+    page.release();
+    directory.flush();
 
+    QueryResult result;
+    result.setColumns({"rows"}, {TypeId::INTEGER});
+    result.appendInt(0, static_cast<int32_t>(rows));
     return result;
 }
 
-QueryResult ExecutionEngine::executeDelete(const nlohmann::json &plan) {
-    std::string tableName = plan["tableName"];
+void ExecutionEngine::checkUniqueIndexes(const std::vector<catalog::IndexMeta *> &indexes, const Schema &schema,
+                                         const Tuple &tuple, const std::set<RID> *updating) {
+    for (catalog::IndexMeta *meta : indexes) {
+        if (!meta->is_unique()) continue;
+        for (engine::IndexIterator it = openIndex(meta).scan(extractIndexKey(*meta, schema, tuple));
+             !it.is_end(); ++it) {
+            if (updating == nullptr || updating->count(it.rid()) == 0) {
+                handleError("Duplicate key for unique index '" + meta->get_index_name() + "'");
+            }
+        }
+    }
+}
+
+
+QueryResult ExecutionEngine::executeDelete(const DeletePlan &plan) {
+    const std::string &tableName = plan.tableName;
     TableInfo *table_info = catalog_->get_table(tableName);
     if (!table_info) handleError("Table does not exist: " + tableName);
 
-    if (plan.contains("condition")) {
-        auto condition = plan["condition"];
-        std::string column_name = condition["column"];
-        std::string condition_value = condition["value"];
-        std::string condition_op = condition["op"];
-        uint32_t colIndex = table_info->get_schema().get_column_index(column_name);
-
-        scanTablePages(table_info, [&](storage::Page *page, RID &rid) {
-            char buffer[PAGE_SIZE];
-            if (page->getRecord(rid, buffer)) {
-                const MyColumn &column = table_info->get_schema().get_column(colIndex);
-                Value col_val;
-                if (column.type == TypeId::INTEGER)
-                    col_val = Value(*reinterpret_cast<int32_t *>(buffer + column.offset));
-                else if (column.type == TypeId::BOOLEAN)
-                    col_val = Value(*reinterpret_cast<bool *>(buffer + column.offset));
-                else if (column.type == TypeId::VARCHAR)
-                    col_val = Value(std::string(buffer + column.offset));
-
-                bool match = false;
-                if (condition_op == "EQUALS") match = col_val.equals(Value(condition_value));
-                else if (condition_op == "NOT_EQUALS") match = !col_val.equals(Value(condition_value));
-                else if (condition_op == "GREATER_THAN") match = col_val.greaterThan(Value(condition_value));
-                else if (condition_op == "LESS_THAN") match = col_val.lessThan(Value(condition_value));
-                else if (condition_op == "GREATER_THAN_OR_EQUAL") match = col_val.greaterThanOrEquals(Value(condition_value));
-                else if (condition_op == "LESS_THAN_OR_EQUAL") match = col_val.lessThanOrEquals(Value(condition_value));
-
-                if (match) {
-                    page->deleteRecord(rid);
-                    page->setDirty(true);
-                }
-            }
-        });
-    } else {
-        scanTablePages(table_info, [&](storage::Page *page, RID &rid) {
-            page->deleteRecord(rid);
-            page->setDirty(true);
-        });
+    // 先收集待删除的元组再删除，避免边扫描边修改页面
+    storage::TablePageDirectory &directory = pageDirectory(table_info);
+    for (const Tuple &tuple : collectTargets(*plan.input)) {
+        deleteIndexEntries(table_info, tuple);
+        storage::WritePageGuard page = bufferManager_->fetchPageWrite(tuple.getRid().page_id);
+        page->deleteRecord(tuple.getRid());
+        page->setDirty(true);
+        directory.setFreeSpace(page.getPageId(), page->getFreeSpace());
     }
+    directory.flush();
     cout<<"delete ok"<<endl;
     return QueryResult();
 }
 
-QueryResult ExecutionEngine::executeUpdate(const nlohmann::json &plan) {
-    std::string tableName = plan["tableName"];
+QueryResult ExecutionEngine::executeUpdate(const UpdatePlan &plan) {
+    const std::string &tableName = plan.tableName;
     TableInfo *table_info = catalog_->get_table(tableName);
     if (!table_info) handleError("Table does not exist: " + tableName);
 
-    auto updates = plan["updates"];
-    scanTablePages(table_info, [&](storage::Page *page, RID &rid) {
+    const Schema &schema = table_info->get_schema();
+    const RowCodec &codec = table_info->get_codec();
+    const std::vector<catalog::IndexMeta *> indexes = catalog_->get_table_indexes(tableName);
+    storage::TablePageDirectory &directory = pageDirectory(table_info);
+    std::vector<Tuple> targets = collectTargets(*plan.input);
+
+    // 第一遍：编码所有新记录，并用新键检查唯一索引（与表中其他行及本批其他行的冲突），
+    // 任何一行冲突都在写入前抛出，多行 UPDATE 要么全部生效要么都不生效
+    std::set<RID> updating;
+    for (const Tuple &tuple : targets) updating.insert(tuple.getRid());
+    std::vector<std::string> records;
+    std::vector<Tuple> olds;
+    std::vector<std::unordered_set<std::string>> batchKeys(indexes.size());
+    for (const Tuple &tuple : targets) {
+        const RID &rid = tuple.getRid();
         char buffer[PAGE_SIZE];
         uint16_t size;
-        if (page->getRecord(rid, buffer, &size)) {
-            for (const auto &upd : updates) {
-                uint32_t colIndex = table_info->get_schema().get_column_index(upd["column"]);
-                const MyColumn &col = table_info->get_schema().get_column(colIndex);
-                if (col.type == TypeId::INTEGER) {
-                    int32_t v = std::stoi(upd["value"].get<std::string>());
-                    std::memcpy(buffer + col.offset, &v, sizeof(v));
-                } else if (col.type == TypeId::BOOLEAN) {
-                    bool v = (upd["value"] == "true" || upd["value"] == "1");
-                    std::memcpy(buffer + col.offset, &v, sizeof(v));
-                } else if (col.type == TypeId::VARCHAR) {
-                    std::string v = upd["value"];
-                    size_t copy_size = std::min(v.size(), (size_t)col.length);
-                    std::memcpy(buffer + col.offset, v.c_str(), copy_size);
-                }
+        if (!bufferManager_->fetchPageRead(rid.page_id)->getRecord(rid, buffer, &size)) continue;
+        for (const auto &upd : plan.updates) {
+            size_t colIndex = schema.get_column_index(upd.column);
+            codec.encodeValue(buffer, colIndex, parseLiteral(upd.value, codec.field(colIndex).type));
+        }
+        records.emplace_back(buffer, size);
+        olds.push_back(tuple);
+
+        if (indexes.empty()) continue;
+        Tuple updated = codec.decode(buffer, rid);
+        checkUniqueIndexes(indexes, schema, updated, &updating);
+        for (size_t i = 0; i < indexes.size(); ++i) {
+            if (indexes[i]->is_unique() &&
+                !batchKeys[i].insert(engine::KeyCodec::encode(extractIndexKey(*indexes[i], schema, updated))).second) {
+                handleError("Duplicate key for unique index '" + indexes[i]->get_index_name() + "'");
             }
-            page->updateRecord(rid, buffer, table_info->get_schema().get_length());
-            page->setDirty(true);
         }
-    });
+    }
+
+    // 第二遍：先删掉全部旧索引条目再写记录，最后插入新条目，
+    // 批内互换键（如 a=1→2、b=2→1）时不会在中途撞上尚未更新的行
+    for (const Tuple &tuple : olds) deleteIndexEntries(table_info, tuple);
+    std::vector<RID> rids(olds.size());
+    for (size_t r = 0; r < olds.size(); ++r) {
+        const RID &rid = olds[r].getRid();
+        const std::string &record = records[r];
+        const uint16_t size = static_cast<uint16_t>(record.size());
+        storage::WritePageGuard page = bufferManager_->fetchPageWrite(rid.page_id);
+        rids[r] = rid;
+        bool updated = page->updateRecord(rid, record.data(), size, &rids[r]);
+        page->setDirty(true);
+        directory.setFreeSpace(page.getPageId(), page->getFreeSpace());
+        page.release();
+        if (!updated) {
+            // 原页已放不下新记录（旧记录已被删除），移到其他有空间的页
+            rids[r] = relocateRecord(directory, record.data(), size);
+        }
+    }
+    if (!indexes.empty()) {
+        for (size_t r = 0; r < olds.size(); ++r) {
+            insertIndexEntries(table_info, codec.decode(records[r].data(), rids[r]));
+        }
+    }
+    directory.flush();
     return QueryResult();
 }
 
@@ -329,103 +553,585 @@ QueryResult ExecutionEngine::executeUpdate(const nlohmann::json &plan) {
 //     return executeSelect(selectPlan);
 // }
 
-    QueryResult ExecutionEngine::executeProject(const nlohmann::json &plan) {
-    // 从Project计划中提取输入（SeqScan）和要投影的列
-    auto input = plan["input"];
-    if (input["type"] != "SeqScan") {
-        throw std::runtime_error("Unsupported input type in Project operator");
-    }
+QueryResult ExecutionEngine::executeCreateIndex(const CreateIndexPlan &plan) {
+    const std::string &indexName = plan.indexName;
+    const std::string &tableName = plan.tableName;
+
+    TableInfo *table_info = catalog_->get_table(tableName);
+    if (!table_info) handleError("Table does not exist: " + tableName);
+    if (indexes_.count(indexName)) handleError("Index already exists: " + indexName);
 
-    // 构建一个Select计划
-    nlohmann::json selectPlan;
-    selectPlan["type"] = "Select";
-    selectPlan["tableName"] = input["tableName"];
-    selectPlan["columns"] = plan["columns"]; // 要投影的列
+    // 经 SQLCompiler 编译的计划已在语义分析时登记元数据，直接执行的计划在这里补登记
+    catalog::IndexMeta *meta = catalog_->get_index(indexName);
+    if (!meta) {
+        if (!catalog_->create_index(indexName, tableName, plan.columns, plan.unique)) {
+            handleError("Failed to create index: " + indexName);
+        }
+        meta = catalog_->get_index(indexName);
+    }
 
-    // 检查是否有条件
-    if (input.contains("condition")) {
-        selectPlan["condition"] = input["condition"];
+    // 扫描堆表，为已有记录建立索引项
+    const Schema &schema = table_info->get_schema();
+    engine::BPlusTreeIndex &index = openIndex(meta);
+    try {
+        SeqScanOperator scan(bufferManager_, table_info);
+        scan.open();
+        Tuple tuple;
+        while (scan.next(tuple)) {
+            if (!index.insert_entry(extractIndexKey(*meta, schema, tuple), tuple.getRid())) {
+                throw DatabaseException("Duplicate key for unique index '" + indexName + "'");
+            }
+        }
+        scan.close();
+    } catch (...) {
+        indexes_.erase(indexName);
+        catalog_->drop_index(indexName);
+        throw;
     }
 
-    // 调用现有的executeSelect方法
-    return executeSelect(selectPlan);
+    std::cout << "[OK] Index created: " << indexName << "\n";
+    return QueryResult();
 }
 
-    void ExecutionEngine::scanSinglePage(PageID pid, const Schema &schema, QueryResult &result) {
-    storage::Page* page = bufferManager_->fetchPage(pid);
-    uint16_t slot_count = page->getSlotCount();
-
-    std::cout << "[DEBUG scan] page_id=" << pid
-              << " slot_count=" << slot_count << std::endl;
+size_t ExecutionEngine::estimatePages(const PlanNode &plan) {
+    const std::string *tableName = nullptr;
+    switch (plan.type) {
+        case PlanNodeType::SeqScan:
+            tableName = &static_cast<const SeqScanPlan &>(plan).tableName;
+            break;
+        case PlanNodeType::IndexScan:
+            tableName = &static_cast<const IndexScanPlan &>(plan).tableName;
+            break;
+        case PlanNodeType::Join: {
+            const auto &join = static_cast<const JoinPlan &>(plan);
+            return estimatePages(*join.left) + (join.right ? estimatePages(*join.right) : 0);
+        }
+        default: {
+            const PlanNode *input = inputOf(plan);
+            return input ? estimatePages(*input) : 0;
+        }
+    }
 
-    char buf[PAGE_SIZE];
-    uint16_t size;
+    const TableInfo *tableInfo = catalog_->get_table(*tableName);
+    if (!tableInfo) return 0;
+    const storage::TablePageDirectory *directory = findPageDirectory(tableInfo);
+    return directory ? directory->getPageCount() : tablePages(tableInfo).size();
+}
 
-    for (uint16_t slot = 0; slot < slot_count; slot++) {
-        if (page->getSlotSize(slot) == 0) continue;
+OperatorPtr ExecutionEngine::buildJoinOperator(const JoinPlan &plan) {
+    // leftTable/rightTable 非空时该侧输出为单表的列，连接后加上表名限定
+    const std::string &leftTable = plan.leftTable;
+    const std::string &rightTable = plan.rightTable;
+    OperatorPtr left = buildOperator(*plan.left);
 
-        RID rid{pid, slot};
+    // 连接键写作 "表.列"，在单表输入上查找时去掉限定
+    auto stripTable = [](const std::string &table, const std::string &column) {
+        if (!table.empty() && column.rfind(table + ".", 0) == 0) {
+            return column.substr(table.size() + 1);
+        }
+        return column;
+    };
+    std::vector<size_t> leftKeys;
+    for (const auto &key : plan.leftKeys) {
+        leftKeys.push_back(left->getColumnIndex(stripTable(leftTable, key)));
+    }
 
-        if (!page->getRecord(rid, buf, &size)) {
-            std::cout << "[DEBUG] getRecord failed for slot " << slot << std::endl;
-            continue;
+    if (plan.algorithm == JoinPlan::Algorithm::IndexNestedLoop) {
+        // 右侧直接是内表，不构建子算子
+        const TableInfo *inner = catalog_->get_table(rightTable);
+        if (!inner) {
+            throw std::runtime_error("Table not found: " + rightTable);
         }
+        catalog::IndexMeta *meta = catalog_->get_index(plan.indexName);
+        if (!meta) {
+            throw std::runtime_error("Index not found: " + plan.indexName);
+        }
+        std::vector<size_t> innerKeys;
+        for (const auto &key : plan.rightKeys) {
+            innerKeys.push_back(inner->get_schema().get_column_index(stripTable(rightTable, key)));
+        }
+        return std::make_unique<IndexNestedLoopJoinOperator>(std::move(left), bufferManager_, inner, &openIndex(meta),
+                                                             std::move(leftKeys), std::move(innerKeys),
+                                                             plan.indexKey, leftTable, rightTable);
+    }
 
-        std::cout << "[DEBUG] Read slot=" << slot << " size=" << size << std::endl;
+    OperatorPtr right = buildOperator(*plan.right);
+    std::vector<size_t> rightKeys;
+    for (const auto &key : plan.rightKeys) {
+        rightKeys.push_back(right->getColumnIndex(stripTable(rightTable, key)));
+    }
 
-        QueryResult::Row row;
-        size_t offset = 0;
+    if (plan.algorithm == JoinPlan::Algorithm::Merge) {
+        return std::make_unique<MergeJoinOperator>(std::move(left), std::move(right), std::move(leftKeys),
+                                                   std::move(rightKeys), leftTable, rightTable);
+    }
+    // 用估算页数较少的一侧建哈希表
+    bool buildLeft = estimatePages(*plan.left) < estimatePages(*plan.right);
+    return std::make_unique<HashJoinOperator>(std::move(left), std::move(right), std::move(leftKeys),
+                                              std::move(rightKeys), buildLeft, bufferManager_,
+                                              operatorMemoryBudget_, leftTable, rightTable);
+}
 
-        for (uint32_t col_idx = 0; col_idx < schema.get_column_count(); col_idx++) {
-            const MyColumn &col = schema.get_column(static_cast<uint32_t>(col_idx));
+OperatorPtr ExecutionEngine::buildOperator(const PlanNode &plan) {
+    // [Project] -> Filter* -> SeqScan：条件下推到扫描中，只解码需要的列
+    ScanChain chain;
+    if (matchScanChain(plan, chain)) {
+        return buildScanOperator(chain);
+    }
 
-            if (col.type == TypeId::INTEGER) {
-                int32_t val;
-                std::memcpy(&val, buf + offset, sizeof(int32_t));
-                offset += sizeof(int32_t);
-                row.push_back(std::to_string(val));
+    switch (plan.type) {
+        case PlanNodeType::IndexScan: {
+            const auto &scan = static_cast<const IndexScanPlan &>(plan);
+            const TableInfo *tableInfo = catalog_->get_table(scan.tableName);
+            if (!tableInfo) {
+                throw std::runtime_error("Table not found: " + scan.tableName);
+            }
+            catalog::IndexMeta *meta = catalog_->get_index(scan.indexName);
+            if (!meta) {
+                throw std::runtime_error("Index not found: " + scan.indexName);
+            }
+            // 等值条件组成前缀键，下一列上的比较转换为区间端点
+            const std::vector<TypeId> &keyTypes = meta->get_key_types();
+            if (scan.prefix.size() + (scan.range.empty() ? 0 : 1) > keyTypes.size()) {
+                throw std::runtime_error("Index scan has more columns than index: " + scan.indexName);
+            }
+            std::vector<Value> prefix;
+            for (size_t i = 0; i < scan.prefix.size(); ++i) {
+                prefix.push_back(parseLiteral(scan.prefix[i].value, keyTypes[i]));
+            }
+            engine::KeyBound lower, upper;
+            for (const PlanCondition &cond : scan.range) {
+                Value key = parseLiteral(cond.value, keyTypes[scan.prefix.size()]);
+                if (cond.op == ">") {
+                    lower = engine::KeyBound::open(key);
+                } else if (cond.op == ">=") {
+                    lower = engine::KeyBound::closed(key);
+                } else if (cond.op == "<") {
+                    upper = engine::KeyBound::open(key);
+                } else if (cond.op == "<=") {
+                    upper = engine::KeyBound::closed(key);
+                } else {
+                    throw std::runtime_error("Unsupported operator for index scan: " + cond.op);
+                }
+            }
+            return std::make_unique<IndexScanOperator>(bufferManager_, tableInfo, &openIndex(meta),
+                                                       std::move(prefix), lower, upper);
+        }
+        case PlanNodeType::Join:
+            return buildJoinOperator(static_cast<const JoinPlan &>(plan));
+        case PlanNodeType::Filter: {
+            // condition：单个比较；expr：AND/OR/NOT/算术组成的表达式树
+            const auto &filter = static_cast<const FilterPlan &>(plan);
+            OperatorPtr child = buildOperator(*filter.input);
+            FilterOperator::Predicate predicate;
+            if (filter.expr) {
+                TupleExpression expr = compileExpression(*child, *filter.expr);
+                predicate = [expr](const Tuple &tuple) { return isTrue(expr(tuple)); };
+            } else {
+                predicate = makePredicate(*child, filter.condition);
             }
-            else if (col.type == TypeId::BOOLEAN) {
-                bool val;
-                std::memcpy(&val, buf + offset, sizeof(bool));
-                offset += sizeof(bool);
-                row.push_back(val ? "true" : "false");
+            return std::make_unique<FilterOperator>(std::move(child), std::move(predicate));
+        }
+        case PlanNodeType::Project: {
+            const auto &project = static_cast<const ProjectPlan &>(plan);
+            return std::make_unique<ProjectOperator>(buildOperator(*project.input), project.columns);
+        }
+        case PlanNodeType::Limit: {
+            const auto &limit = static_cast<const LimitPlan &>(plan);
+            OperatorPtr child;
+            // ORDER BY ... LIMIT：排序只需保留前 limit + offset 行
+            if (limit.input->type == PlanNodeType::Sort) {
+                const auto &sort = static_cast<const SortPlan &>(*limit.input);
+                size_t topN = limit.limit > SortOperator::NO_LIMIT - limit.offset ? SortOperator::NO_LIMIT
+                                                                                  : limit.limit + limit.offset;
+                child = buildSortOperator(sort, buildOperator(*sort.input), topN);
+            } else {
+                child = buildOperator(*limit.input);
+            }
+            return std::make_unique<LimitOperator>(std::move(child), limit.limit, limit.offset);
+        }
+        case PlanNodeType::Sort: {
+            const auto &sort = static_cast<const SortPlan &>(plan);
+            return buildSortOperator(sort, buildOperator(*sort.input), SortOperator::NO_LIMIT);
+        }
+        case PlanNodeType::Aggregate: {
+            const auto &aggregate = static_cast<const AggregatePlan &>(plan);
+            std::vector<size_t> groupColumns;
+            std::vector<AggregateSpec> aggregates;
+
+            // 直接聚合大表的扫描链：各线程扫描各自领取的 morsel 并做部分聚合
+            ScanChain chain;
+            std::vector<PageID> pages;
+            if (matchScanChain(*aggregate.input, chain) && parallelPages(chain.table, pages)) {
+                MorselPipelineFactory factory = makeMorselFactory(chain);
+                aggregateColumns(aggregate, *factory({}), groupColumns, aggregates);
+                return std::make_unique<ParallelAggregateOperator>(
+                    scheduler(), parallelism_, std::move(pages), std::move(factory), std::move(groupColumns),
+                    std::move(aggregates), bufferManager_, operatorMemoryBudget_);
             }
-            else if (col.type == TypeId::VARCHAR) {
-                // 直接定长读取
-                std::string str(buf + offset, col.length);
-                // 去掉填充的 '\0'
-                str.erase(str.find_first_of('\0'));
-                offset += col.length;
-                row.push_back(str);
+
+            OperatorPtr child = buildOperator(*aggregate.input);
+            aggregateColumns(aggregate, *child, groupColumns, aggregates);
+            return std::make_unique<AggregateOperator>(std::move(child), std::move(groupColumns),
+                                                       std::move(aggregates), bufferManager_, operatorMemoryBudget_);
+        }
+        default:
+            throw std::runtime_error(std::string("Unsupported operator type: ") + planNodeTypeName(plan.type));
+    }
+}
+
+OperatorPtr ExecutionEngine::buildOperator(const nlohmann::json &plan) {
+    return buildOperator(*planFromJson(plan));
+}
+
+OperatorPtr ExecutionEngine::buildSortOperator(const SortPlan &plan, OperatorPtr child, size_t limit) {
+    std::vector<SortKey> keys;
+    for (const auto &key : plan.keys) {
+        keys.push_back(SortKey{child->getColumnIndex(key.column), key.ascending});
+    }
+    return std::make_unique<SortOperator>(std::move(child), std::move(keys), bufferManager_,
+                                          operatorMemoryBudget_, limit);
+}
+
+QueryResult ExecutionEngine::collectResult(ResultCursor &cursor) {
+    QueryResult result;
+    result.setColumns(cursor.getColumnNames(), cursor.getColumnTypes());
+    cursor.fetchInto(result);
+    return result;
+}
+
+bool ExecutionEngine::matchScanChain(const PlanNode &plan, ScanChain &chain) const {
+    // 拆出投影列、过滤条件和表名，遇到其他节点即放弃
+    const PlanNode *node = &plan;
+    if (node->type == PlanNodeType::Project) {
+        const auto &project = static_cast<const ProjectPlan &>(*node);
+        chain.projection = project.columns;
+        if (chain.projection.size() == 1 && chain.projection[0] == "*") {
+            chain.projection.clear();
+        }
+        node = project.input.get();
+    }
+    std::vector<const PlanCondition *> conditions;
+    while (node->type == PlanNodeType::Filter) {
+        // 表达式条件不能下推，交给 FilterOperator
+        const auto &filter = static_cast<const FilterPlan &>(*node);
+        if (filter.expr) return false;
+        conditions.push_back(&filter.condition);
+        node = filter.input.get();
+    }
+    if (node->type != PlanNodeType::SeqScan) return false;
+    // 最内层的条件最先执行
+    chain.conditions.assign(conditions.rbegin(), conditions.rend());
+
+    const std::string &tableName = static_cast<const SeqScanPlan &>(*node).tableName;
+    chain.table = catalog_->get_table(tableName);
+    if (!chain.table) {
+        throw std::runtime_error("Table not found: " + tableName);
+    }
+    return true;
+}
+
+std::vector<size_t> ExecutionEngine::scanColumns(const ScanChain &chain) const {
+    // 有投影时只扫描投影列和过滤列（保持表内顺序），否则为全部列（返回空）
+    std::vector<size_t> columns;
+    if (chain.projection.empty()) return columns;
+
+    const Schema &schema = chain.table->get_schema();
+    std::vector<bool> used(schema.get_column_count(), false);
+    for (const auto &name : chain.projection) {
+        used[schema.get_column_index(name)] = true;
+    }
+    for (const auto *condition : chain.conditions) {
+        used[schema.get_column_index(condition->column)] = true;
+    }
+    for (size_t i = 0; i < used.size(); ++i) {
+        if (used[i]) columns.push_back(i);
+    }
+    return columns;
+}
+
+OperatorPtr ExecutionEngine::buildScanOperator(const ScanChain &chain) {
+    const Schema &schema = chain.table->get_schema();
+    const RowCodec &codec = chain.table->get_codec();
+    std::vector<RecordPredicate> predicates;
+    for (const auto *condition : chain.conditions) {
+        const RowCodec::Field &field = codec.field(schema.get_column_index(condition->column));
+        predicates.push_back(compilePredicate(field, parseCompareOp(condition->op),
+                                              parseLiteral(condition->value, field.type)));
+    }
+
+    OperatorPtr root = std::make_unique<SeqScanOperator>(bufferManager_, chain.table, scanColumns(chain),
+                                                         std::move(predicates));
+    if (!chain.projection.empty()) {
+        root = std::make_unique<ProjectOperator>(std::move(root), chain.projection);
+    }
+    return root;
+}
+
+VectorOperatorPtr ExecutionEngine::buildVectorOperator(const PlanNode &plan) {
+    ScanChain chain;
+    if (!matchScanChain(plan, chain)) return nullptr;
+
+    std::vector<PageID> pages;
+    if (parallelPages(chain.table, pages)) {
+        return std::make_unique<ParallelScanOperator>(scheduler(), parallelism_, std::move(pages),
+                                                      makeMorselFactory(chain));
+    }
+
+    VectorOperatorPtr root = std::make_unique<VectorSeqScanOperator>(bufferManager_, chain.table,
+                                                                     scanColumns(chain));
+    for (const auto *condition : chain.conditions) {
+        size_t column = root->getColumnIndex(condition->column);
+        Value literal = parseLiteral(condition->value, root->getColumnTypes()[column]);
+        root = std::make_unique<VectorFilterOperator>(std::move(root), column,
+                                                      parseCompareOp(condition->op), literal);
+    }
+    if (!chain.projection.empty()) {
+        root = std::make_unique<VectorProjectOperator>(std::move(root), chain.projection);
+    }
+    return root;
+}
+
+VectorOperatorPtr ExecutionEngine::buildVectorOperator(const nlohmann::json &plan) {
+    return buildVectorOperator(*planFromJson(plan));
+}
+
+void ExecutionEngine::setParallelism(size_t threads) {
+    parallelism_ = std::max<size_t>(threads, 1);
+    scheduler_.reset();
+}
+
+TaskScheduler &ExecutionEngine::scheduler() {
+    if (!scheduler_) {
+        // 调用线程也参与执行，只需另建 parallelism_ - 1 个工作线程
+        scheduler_ = std::make_unique<TaskScheduler>(parallelism_ - 1);
+    }
+    return *scheduler_;
+}
+
+bool ExecutionEngine::parallelPages(const TableInfo *table, std::vector<PageID> &pages) {
+    if (parallelism_ <= 1) return false;
+    pages = tablePages(table);
+    return pages.size() >= PARALLEL_SCAN_MIN_PAGES;
+}
+
+MorselPipelineFactory ExecutionEngine::makeMorselFactory(const ScanChain &chain) {
+    struct Condition {
+        size_t column;
+        CompareOp op;
+        Value literal;
+    };
+    std::vector<size_t> columns = scanColumns(chain);
+    VectorSeqScanOperator prototype(bufferManager_, chain.table, columns, std::vector<PageID>{});
+    std::vector<Condition> conditions;
+    for (const auto *condition : chain.conditions) {
+        size_t column = prototype.getColumnIndex(condition->column);
+        conditions.push_back({column, parseCompareOp(condition->op),
+                              parseLiteral(condition->value, prototype.getColumnTypes()[column])});
+    }
+
+    return [bufferManager = bufferManager_, table = chain.table, columns = std::move(columns),
+            conditions = std::move(conditions), projection = chain.projection](std::vector<PageID> pages) {
+        VectorOperatorPtr root = std::make_unique<VectorSeqScanOperator>(bufferManager, table, columns,
+                                                                         std::move(pages));
+        for (const auto &condition : conditions) {
+            root = std::make_unique<VectorFilterOperator>(std::move(root), condition.column, condition.op,
+                                                          condition.literal);
+        }
+        if (!projection.empty()) {
+            root = std::make_unique<VectorProjectOperator>(std::move(root), projection);
+        }
+        return root;
+    };
+}
+
+FilterOperator::Predicate ExecutionEngine::makePredicate(const Operator &input, const PlanCondition &condition) {
+    size_t column = input.getColumnIndex(condition.column);
+    CompareOp op = parseCompareOp(condition.op);
+    // 运算符和字面量在构建时解析/转换一次，而不是每行转换
+    Value literal = parseLiteral(condition.value, input.getColumnTypes()[column]);
+    return [column, op, literal](const Tuple &tuple) {
+        return compareValues(tuple.getValue(column), op, literal);
+    };
+}
+
+TupleExpression ExecutionEngine::compileExpression(const Operator &input, const PlanExpr &expr) {
+    switch (expr.kind) {
+        case PlanExpr::Kind::Column: {
+            // 列引用：构建时解析为列位置
+            size_t column = input.getColumnIndex(expr.value);
+            return [column](const Tuple &tuple) { return tuple.getValue(column); };
+        }
+        case PlanExpr::Kind::Literal: {
+            // 常量：按语义分析确定的类型转换一次
+            TypeId type = expr.type == "INT" ? TypeId::INTEGER
+                        : expr.type == "BOOLEAN" ? TypeId::BOOLEAN
+                        : TypeId::VARCHAR;
+            Value literal = parseLiteral(expr.value, type);
+            return [literal](const Tuple &) { return literal; };
+        }
+        case PlanExpr::Kind::Unary: {
+            if (expr.value != "NOT") {
+                throw std::runtime_error("Unsupported unary operator: " + expr.value);
             }
+            TupleExpression operand = compileExpression(input, *expr.left);
+            return [operand](const Tuple &tuple) {
+                Value v = operand(tuple);
+                return v.isNull() ? Value() : Value(!v.getAsBool());
+            };
+        }
+        case PlanExpr::Kind::Binary:
+            break;
+    }
+
+    const std::string &op = expr.value;
+    TupleExpression lhs = compileExpression(input, *expr.left);
+    TupleExpression rhs = compileExpression(input, *expr.right);
+    // AND/OR 短路求值：左侧已能决定结果时不再计算右侧
+    if (op == "AND") {
+        return [lhs, rhs](const Tuple &tuple) { return Value(isTrue(lhs(tuple)) && isTrue(rhs(tuple))); };
+    }
+    if (op == "OR") {
+        return [lhs, rhs](const Tuple &tuple) { return Value(isTrue(lhs(tuple)) || isTrue(rhs(tuple))); };
+    }
+    if (op == "+" || op == "-") {
+        bool add = op == "+";
+        return [lhs, rhs, add](const Tuple &tuple) {
+            Value l = lhs(tuple), r = rhs(tuple);
+            if (l.isNull() || r.isNull()) return Value();
+            return add ? l.add(r) : l.subtract(r);
+        };
+    }
+    CompareOp compare = parseCompareOp(op);
+    return [lhs, rhs, compare](const Tuple &tuple) {
+        return Value(compareValues(lhs(tuple), compare, rhs(tuple)));
+    };
+}
+
+std::vector<Tuple> ExecutionEngine::collectTargets(const PlanNode &input) {
+    OperatorPtr root = buildOperator(input);
+    std::vector<Tuple> targets;
+    root->open();
+    Tuple tuple;
+    while (root->next(tuple)) {
+        targets.push_back(tuple);
+    }
+    root->close();
+    return targets;
+}
+
+engine::BPlusTreeIndex &ExecutionEngine::openIndex(catalog::IndexMeta *meta) {
+    auto it = indexes_.find(meta->get_index_name());
+    if (it == indexes_.end()) {
+        it = indexes_.emplace(meta->get_index_name(),
+                              std::make_unique<engine::BPlusTreeIndex>(pager_, meta)).first;
+    }
+    return *it->second;
+}
+
+std::vector<Value> ExecutionEngine::extractIndexKey(const catalog::IndexMeta &meta, const Schema &schema,
+                                                    const Tuple &tuple) const {
+    std::vector<Value> key;
+    key.reserve(meta.get_column_count());
+    for (const auto &column_name : meta.get_column_names()) {
+        key.push_back(tuple.getValue(schema.get_column_index(column_name)));
+    }
+    return key;
+}
+
+void ExecutionEngine::insertIndexEntries(const TableInfo *table_info, const Tuple &tuple) {
+    for (catalog::IndexMeta *meta : catalog_->get_table_indexes(table_info->get_table_name())) {
+        if (!openIndex(meta).insert_entry(extractIndexKey(*meta, table_info->get_schema(), tuple), tuple.getRid())) {
+            handleError("Duplicate key for unique index '" + meta->get_index_name() + "'");
+        }
+    }
+}
+
+void ExecutionEngine::deleteIndexEntries(const TableInfo *table_info, const Tuple &tuple) {
+    for (catalog::IndexMeta *meta : catalog_->get_table_indexes(table_info->get_table_name())) {
+        openIndex(meta).delete_entry(extractIndexKey(*meta, table_info->get_schema(), tuple), tuple.getRid());
+    }
+}
+
+
+QueryResult ExecutionEngine::executePlan(const PlanNode &plan) {
+    switch (plan.type) {
+        case PlanNodeType::CreateTable:
+            return executeCreateTable(static_cast<const CreateTablePlan &>(plan));
+        case PlanNodeType::CreateIndex:
+            return executeCreateIndex(static_cast<const CreateIndexPlan &>(plan));
+        case PlanNodeType::Insert:
+            return executeInsert(static_cast<const InsertPlan &>(plan));
+        case PlanNodeType::Copy:
+            return executeCopy(static_cast<const CopyPlan &>(plan));
+        case PlanNodeType::Delete:
+            return executeDelete(static_cast<const DeletePlan &>(plan));
+        case PlanNodeType::Update:
+            return executeUpdate(static_cast<const UpdatePlan &>(plan));
+        default: {
+            ResultCursor cursor = openCursor(plan);
+            return collectResult(cursor);
         }
+    }
+}
+
+QueryResult ExecutionEngine::executePlan(const nlohmann::json &plan) {
+    return executePlan(*planFromJson(plan));
+}
 
-        result.addRow(row);
+bool ExecutionEngine::isQuery(const PlanNode &plan) {
+    switch (plan.type) {
+        case PlanNodeType::CreateTable:
+        case PlanNodeType::CreateIndex:
+        case PlanNodeType::Insert:
+        case PlanNodeType::Copy:
+        case PlanNodeType::Delete:
+        case PlanNodeType::Update:
+            return false;
+        default:
+            return true;
     }
 }
 
+bool ExecutionEngine::isQuery(const nlohmann::json &plan) {
+    static const std::vector<std::string> statements = {"CreateTable", "CreateIndex", "Insert", "Copy", "Delete",
+                                                        "Update"};
+    return std::find(statements.begin(), statements.end(), plan.value("type", std::string())) == statements.end();
+}
 
-    QueryResult ExecutionEngine::executePlan(const nlohmann::json &plan) {
-    std::string type = plan["type"];
+ResultCursor ExecutionEngine::openCursor(const PlanNode &plan) {
+    if (!isQuery(plan)) {
+        throw std::runtime_error(std::string("Plan does not produce rows: ") + planNodeTypeName(plan.type));
+    }
+    // 查询计划：能批量执行的走批量算子，否则组装逐行算子树
+    if (vectorized_) {
+        if (VectorOperatorPtr root = buildVectorOperator(plan)) {
+            return ResultCursor(std::move(root));
+        }
+    }
+    return ResultCursor(buildOperator(plan));
+}
 
-    // ==== 新增调试输出 ====
-    std::cout << "[DEBUG] executePlan type: " << type << "\n"
-              << "[DEBUG] JSON plan:\n" << plan.dump(2) << std::endl;
+ResultCursor ExecutionEngine::openCursor(const nlohmann::json &plan) {
+    if (!isQuery(plan)) {
+        throw std::runtime_error("Plan does not produce rows: " + plan.value("type", std::string()));
+    }
+    return openCursor(*planFromJson(plan));
+}
+
+size_t ExecutionEngine::exportQuery(const PlanNode &plan, OutputBuffer &out, ResultWriter::Format format) {
+    ResultCursor cursor = openCursor(plan);
+    ResultWriter writer(out, format);
+    writer.begin(cursor.getColumnNames());
+    Tuple tuple;
+    while (cursor.next(tuple)) {
+        writer.writeRow(tuple);
+    }
+    writer.end();
+    return writer.rowsWritten();
+}
 
-    if (type == "CreateTable")
-        return executeCreateTable(plan);
-    else if (type == "Insert")
-        return executeInsert(plan);
-    else if (type == "Select")
-        return executeSelect(plan);
-    else if (type == "Project")   // 新增
-        return executeProject(plan);
-    else if (type == "Delete")
-        return executeDelete(plan);
-    else if (type == "Update")
-        return executeUpdate(plan);
-    else
-        throw std::runtime_error("Unsupported execution plan type: " + type);
+size_t ExecutionEngine::exportQuery(const nlohmann::json &plan, OutputBuffer &out, ResultWriter::Format format) {
+    return exportQuery(*planFromJson(plan), out, format);
 }
-} // namespace minidb
\ No newline at end of file
+} // namespace minidb
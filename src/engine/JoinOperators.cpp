@@ -0,0 +1,414 @@
+#include "../../include/engine/JoinOperators.h"
+
+#include <functional>
+#include <string_view>
+
+namespace minidb {
+
+namespace {
+
+// 把一侧输入的列追加到连接输出，qualifier 非空时列名加上 "表." 前缀
+void appendColumns(std::vector<std::string> &names, std::vector<TypeId> &types, const Operator &input,
+                   const std::string &qualifier) {
+    for (const auto &name : input.getColumnNames()) {
+        names.push_back(qualifier.empty() ? name : qualifier + "." + name);
+    }
+    types.insert(types.end(), input.getColumnTypes().begin(), input.getColumnTypes().end());
+}
+
+void checkKeyTypes(const Operator &left, const std::vector<size_t> &leftKeys, const std::vector<TypeId> &rightTypes,
+                   const std::vector<size_t> &rightKeys) {
+    if (leftKeys.empty() || leftKeys.size() != rightKeys.size()) {
+        throw std::runtime_error("Join requires matching key columns on both sides");
+    }
+    for (size_t k = 0; k < leftKeys.size(); ++k) {
+        if (left.getColumnTypes().at(leftKeys[k]) != rightTypes.at(rightKeys[k])) {
+            throw TypeMismatchException("Join key types do not match: " + left.getColumnNames()[leftKeys[k]]);
+        }
+    }
+}
+
+Tuple concat(const Tuple &left, const Tuple &right) {
+    std::vector<Value> values;
+    values.reserve(left.getColumnCount() + right.getColumnCount());
+    values.insert(values.end(), left.getValues().begin(), left.getValues().end());
+    values.insert(values.end(), right.getValues().begin(), right.getValues().end());
+    return Tuple(std::move(values));
+}
+
+bool hasNullKey(const Tuple &tuple, const std::vector<size_t> &keys) {
+    for (size_t key : keys) {
+        if (tuple.getValue(key).isNull()) return true;
+    }
+    return false;
+}
+
+// 按连接键逐列比较两行：<0 / 0 / >0
+int compareKeys(const Tuple &lhs, const std::vector<size_t> &lhsKeys, const Tuple &rhs,
+                const std::vector<size_t> &rhsKeys) {
+    for (size_t k = 0; k < lhsKeys.size(); ++k) {
+        const Value &a = lhs.getValue(lhsKeys[k]);
+        const Value &b = rhs.getValue(rhsKeys[k]);
+        if (a.lessThan(b)) return -1;
+        if (b.lessThan(a)) return 1;
+    }
+    return 0;
+}
+
+bool keysEqual(const Tuple &lhs, const std::vector<size_t> &lhsKeys, const Tuple &rhs,
+               const std::vector<size_t> &rhsKeys) {
+    for (size_t k = 0; k < lhsKeys.size(); ++k) {
+        if (!lhs.getValue(lhsKeys[k]).equals(rhs.getValue(rhsKeys[k]))) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool hashKeys(const Tuple &tuple, const std::vector<size_t> &keys, uint64_t &hash) {
+    uint64_t h = 0x9e3779b97f4a7c15ULL;
+    for (size_t key : keys) {
+        const Value &value = tuple.getValue(key);
+        uint64_t v;
+        switch (value.getType()) {
+            case TypeId::INTEGER: v = static_cast<uint32_t>(value.getAsInt()); break;
+            case TypeId::BOOLEAN: v = value.getAsBool(); break;
+            case TypeId::VARCHAR: v = std::hash<std::string>()(value.getAsString()); break;
+            default: return false;
+        }
+        h = mixHash(h ^ v) + 0x9e3779b97f4a7c15ULL;
+    }
+    hash = mixHash(h);
+    return true;
+}
+
+// ==================== JoinHashTable ====================
+
+void JoinHashTable::build(std::vector<Tuple> rows, std::vector<size_t> keys) {
+    rows_ = std::move(rows);
+    keys_ = std::move(keys);
+
+    // 装载因子不超过 1/2
+    size_t capacity = 16;
+    while (capacity < rows_.size() * 2) capacity <<= 1;
+    mask_ = capacity - 1;
+    slotHashes_.assign(capacity, 0);
+    slotHeads_.assign(capacity, NONE);
+    next_.assign(rows_.size(), NONE);
+
+    // 逆序插入到链头，使每条链按行顺序排列
+    for (size_t i = rows_.size(); i-- > 0;) {
+        uint64_t hash;
+        if (!hashKeys(rows_[i], keys_, hash)) continue;
+        size_t slot = hash & mask_;
+        while (slotHeads_[slot] != NONE && slotHashes_[slot] != hash) {
+            slot = (slot + 1) & mask_;
+        }
+        slotHashes_[slot] = hash;
+        next_[i] = slotHeads_[slot];
+        slotHeads_[slot] = static_cast<uint32_t>(i);
+    }
+}
+
+uint32_t JoinHashTable::findFirst(const Tuple &probe, const std::vector<size_t> &probeKeys, uint64_t hash) const {
+    if (rows_.empty()) return NONE;
+    for (size_t slot = hash & mask_; slotHeads_[slot] != NONE; slot = (slot + 1) & mask_) {
+        if (slotHashes_[slot] != hash) continue;
+        uint32_t row = slotHeads_[slot];
+        while (row != NONE && !keysEqual(row, probe, probeKeys)) row = next_[row];
+        return row;
+    }
+    return NONE;
+}
+
+uint32_t JoinHashTable::findNext(uint32_t row, const Tuple &probe, const std::vector<size_t> &probeKeys) const {
+    row = next_[row];
+    while (row != NONE && !keysEqual(row, probe, probeKeys)) row = next_[row];
+    return row;
+}
+
+bool JoinHashTable::keysEqual(uint32_t row, const Tuple &probe, const std::vector<size_t> &probeKeys) const {
+    const Tuple &tuple = rows_[row];
+    for (size_t k = 0; k < keys_.size(); ++k) {
+        if (!tuple.getValue(keys_[k]).equals(probe.getValue(probeKeys[k]))) return false;
+    }
+    return true;
+}
+
+void JoinHashTable::clear() {
+    rows_.clear();
+    slotHashes_.clear();
+    slotHeads_.clear();
+    next_.clear();
+    mask_ = 0;
+}
+
+// ==================== HashJoin ====================
+
+HashJoinOperator::HashJoinOperator(OperatorPtr left, OperatorPtr right, std::vector<size_t> leftKeys,
+                                   std::vector<size_t> rightKeys, bool buildLeft,
+                                   std::shared_ptr<storage::BufferManager> bufferManager, size_t memoryBudget,
+                                   const std::string &leftQualifier, const std::string &rightQualifier)
+    : buildLeft_(buildLeft), bufferManager_(std::move(bufferManager)), memoryBudget_(memoryBudget) {
+    checkKeyTypes(*left, leftKeys, right->getColumnTypes(), rightKeys);
+    appendColumns(columnNames_, columnTypes_, *left, leftQualifier);
+    appendColumns(columnNames_, columnTypes_, *right, rightQualifier);
+
+    build_ = buildLeft_ ? std::move(left) : std::move(right);
+    probe_ = buildLeft_ ? std::move(right) : std::move(left);
+    buildKeys_ = buildLeft_ ? std::move(leftKeys) : std::move(rightKeys);
+    probeKeys_ = buildLeft_ ? std::move(rightKeys) : std::move(leftKeys);
+}
+
+void HashJoinOperator::open() {
+    build_->open();
+    probe_->open();
+    match_ = JoinHashTable::NONE;
+    spilled_ = false;
+    partition_ = 0;
+
+    // 读入建表侧，超出内存预算时转为分区溢出
+    std::vector<Tuple> rows;
+    size_t bytes = 0;
+    Tuple tuple;
+    while (build_->next(tuple)) {
+        bytes += sizeof(Tuple) + tuple.getEstimatedSize();
+        rows.push_back(std::move(tuple));
+        if (bytes > memoryBudget_) {
+            spill(rows);
+            return;
+        }
+    }
+    table_.build(std::move(rows), buildKeys_);
+}
+
+void HashJoinOperator::spill(std::vector<Tuple> &buffered) {
+    spilled_ = true;
+    buildPartitions_.clear();
+    probePartitions_.clear();
+    for (size_t p = 0; p < PARTITION_COUNT; ++p) {
+        buildPartitions_.push_back(std::make_unique<SpillFile>(bufferManager_));
+        probePartitions_.push_back(std::make_unique<SpillFile>(bufferManager_));
+    }
+
+    // 键为 NULL 的行不会匹配，分区时直接丢弃
+    auto partitionOf = [](uint64_t hash) { return static_cast<size_t>(hash >> (64 - PARTITION_BITS)); };
+    uint64_t hash;
+    for (const Tuple &row : buffered) {
+        if (hashKeys(row, buildKeys_, hash)) buildPartitions_[partitionOf(hash)]->append(row);
+    }
+    buffered.clear();
+    buffered.shrink_to_fit();
+
+    Tuple tuple;
+    while (build_->next(tuple)) {
+        if (hashKeys(tuple, buildKeys_, hash)) buildPartitions_[partitionOf(hash)]->append(tuple);
+    }
+    while (probe_->next(tuple)) {
+        if (hashKeys(tuple, probeKeys_, hash)) probePartitions_[partitionOf(hash)]->append(tuple);
+    }
+    loadPartition(0);
+}
+
+void HashJoinOperator::loadPartition(size_t p) {
+    // 单个分区仍按整体读入（键严重倾斜时可能超出预算）
+    std::vector<Tuple> rows;
+    rows.reserve(buildPartitions_[p]->size());
+    buildPartitions_[p]->rewind();
+    Tuple tuple;
+    while (buildPartitions_[p]->next(tuple)) {
+        rows.push_back(std::move(tuple));
+    }
+    buildPartitions_[p].reset();   // 读完即归还临时页
+    table_.build(std::move(rows), buildKeys_);
+    probePartitions_[p]->rewind();
+}
+
+bool HashJoinOperator::nextProbe() {
+    if (!spilled_) {
+        return probe_->next(probeTuple_);
+    }
+    while (partition_ < PARTITION_COUNT) {
+        if (probePartitions_[partition_]->next(probeTuple_)) return true;
+        probePartitions_[partition_].reset();
+        if (++partition_ < PARTITION_COUNT) loadPartition(partition_);
+    }
+    return false;
+}
+
+bool HashJoinOperator::next(Tuple &tuple) {
+    while (true) {
+        if (match_ != JoinHashTable::NONE) {
+            const Tuple &row = table_.row(match_);
+            match_ = table_.findNext(match_, probeTuple_, probeKeys_);
+
+            tuple = buildLeft_ ? concat(row, probeTuple_) : concat(probeTuple_, row);
+            return true;
+        }
+
+        if (!nextProbe()) return false;
+        uint64_t hash;
+        if (!table_.empty() && hashKeys(probeTuple_, probeKeys_, hash)) {
+            match_ = table_.findFirst(probeTuple_, probeKeys_, hash);
+        }
+    }
+}
+
+void HashJoinOperator::close() {
+    build_->close();
+    probe_->close();
+    table_.clear();
+    buildPartitions_.clear();
+    probePartitions_.clear();
+    match_ = JoinHashTable::NONE;
+}
+
+// ==================== MergeJoin ====================
+
+MergeJoinOperator::MergeJoinOperator(OperatorPtr left, OperatorPtr right, std::vector<size_t> leftKeys,
+                                     std::vector<size_t> rightKeys, const std::string &leftQualifier,
+                                     const std::string &rightQualifier)
+    : left_(std::move(left)), right_(std::move(right)), leftKeys_(std::move(leftKeys)),
+      rightKeys_(std::move(rightKeys)) {
+    checkKeyTypes(*left_, leftKeys_, right_->getColumnTypes(), rightKeys_);
+    appendColumns(columnNames_, columnTypes_, *left_, leftQualifier);
+    appendColumns(columnNames_, columnTypes_, *right_, rightQualifier);
+}
+
+void MergeJoinOperator::open() {
+    left_->open();
+    right_->open();
+    group_.clear();
+    groupPos_ = 0;
+    inGroup_ = false;
+    hasLeft_ = advance(*left_, leftKeys_, leftRow_);
+    hasRight_ = advance(*right_, rightKeys_, rightRow_);
+}
+
+bool MergeJoinOperator::advance(Operator &input, const std::vector<size_t> &keys, Tuple &row) {
+    Tuple next;
+    while (input.next(next)) {
+        if (hasNullKey(next, keys)) continue;
+        // 首次调用时 row 为空元组，不做比较
+        if (row.getColumnCount() > 0 && compareKeys(next, keys, row, keys) < 0) {
+            throw std::runtime_error("Merge join input is not sorted on the join key");
+        }
+        row = std::move(next);
+        return true;
+    }
+    return false;
+}
+
+bool MergeJoinOperator::next(Tuple &tuple) {
+    while (true) {
+        if (inGroup_) {
+            if (groupPos_ < group_.size()) {
+                tuple = concat(leftRow_, group_[groupPos_++]);
+                return true;
+            }
+            // 当前左行已与整组组合完，下一左行键相同时复用这一组
+            hasLeft_ = advance(*left_, leftKeys_, leftRow_);
+            if (hasLeft_ && compareKeys(leftRow_, leftKeys_, group_.front(), rightKeys_) == 0) {
+                groupPos_ = 0;
+                continue;
+            }
+            inGroup_ = false;
+            group_.clear();
+        }
+
+        if (!hasLeft_ || !hasRight_) return false;
+        int cmp = compareKeys(leftRow_, leftKeys_, rightRow_, rightKeys_);
+        if (cmp < 0) {
+            hasLeft_ = advance(*left_, leftKeys_, leftRow_);
+        } else if (cmp > 0) {
+            hasRight_ = advance(*right_, rightKeys_, rightRow_);
+        } else {
+            // 收集右侧键相同的一组行
+            group_.push_back(rightRow_);
+            while ((hasRight_ = advance(*right_, rightKeys_, rightRow_)) &&
+                   compareKeys(rightRow_, rightKeys_, group_.front(), rightKeys_) == 0) {
+                group_.push_back(rightRow_);
+            }
+            groupPos_ = 0;
+            inGroup_ = true;
+        }
+    }
+}
+
+void MergeJoinOperator::close() {
+    left_->close();
+    right_->close();
+    group_.clear();
+    leftRow_ = Tuple();
+    rightRow_ = Tuple();
+}
+
+// ==================== IndexNestedLoopJoin ====================
+
+IndexNestedLoopJoinOperator::IndexNestedLoopJoinOperator(
+    OperatorPtr outer, std::shared_ptr<storage::BufferManager> bufferManager, const TableInfo *inner,
+    const engine::BPlusTreeIndex *index, std::vector<size_t> outerKeys, std::vector<size_t> innerKeys,
+    size_t indexKey, const std::string &outerQualifier, const std::string &innerQualifier)
+    : outer_(std::move(outer)), bufferManager_(std::move(bufferManager)), inner_(inner), index_(index),
+      outerKeys_(std::move(outerKeys)), innerKeys_(std::move(innerKeys)), indexKey_(indexKey) {
+    std::vector<TypeId> innerTypes;
+    for (const auto &col : inner_->get_schema().get_columns()) {
+        innerTypes.push_back(col.type);
+    }
+    checkKeyTypes(*outer_, outerKeys_, innerTypes, innerKeys_);
+
+    appendColumns(columnNames_, columnTypes_, *outer_, outerQualifier);
+    for (const auto &col : inner_->get_schema().get_columns()) {
+        columnNames_.push_back(innerQualifier.empty() ? col.get_name() : innerQualifier + "." + col.get_name());
+        columnTypes_.push_back(col.type);
+    }
+}
+
+void IndexNestedLoopJoinOperator::open() {
+    outer_->open();
+    matches_.clear();
+    matchPos_ = 0;
+}
+
+void IndexNestedLoopJoinOperator::probe() {
+    matches_.clear();
+    matchPos_ = 0;
+    const Value &key = outerRow_.getValue(outerKeys_[indexKey_]);
+    if (key.isNull()) return;
+
+    // 单列唯一索引直接点查；组合/非唯一索引的键带编码后缀，按首列前缀扫描
+    if (!index_->uses_encoded_keys()) {
+        RID rid = index_->get_tree().search(key);
+        if (rid.isValid()) matches_.push_back(rid);
+        return;
+    }
+    for (engine::IndexIterator it = index_->scan({key}); !it.is_end(); ++it) {
+        matches_.push_back(it.rid());
+    }
+}
+
+bool IndexNestedLoopJoinOperator::next(Tuple &tuple) {
+    const RowCodec &codec = inner_->get_codec();
+    while (true) {
+        while (matchPos_ < matches_.size()) {
+            RID rid = matches_[matchPos_++];
+            storage::ReadPageGuard page = bufferManager_->fetchPageRead(rid.page_id);
+            const char *record = page->getRecordData(rid.slot_num);
+            if (!record) continue;
+            Tuple innerRow = codec.decode(record, rid);
+            // 索引只保证索引列相等，其余连接键回表后再比较
+            if (!keysEqual(outerRow_, outerKeys_, innerRow, innerKeys_)) continue;
+            tuple = concat(outerRow_, innerRow);
+            return true;
+        }
+        if (!outer_->next(outerRow_)) return false;
+        probe();
+    }
+}
+
+void IndexNestedLoopJoinOperator::close() {
+    outer_->close();
+    matches_.clear();
+}
+
+} // namespace minidb
@@ -2,4 +2,359 @@
 // Created by tang_ on 2025/9/9.
 //
 
-#include "../../include/engine/Operators.h"
\ No newline at end of file
+#include "../../include/engine/Operators.h"
+#include "common/Exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+namespace minidb {
+
+namespace {
+
+// 去掉字符串常量两端的引号（解析器会给非数字常量加上引号）
+std::string unquote(const std::string &text) {
+    if (text.size() >= 2 && (text.front() == '\'' || text.front() == '"') && text.back() == text.front()) {
+        return text.substr(1, text.size() - 2);
+    }
+    return text;
+}
+
+} // namespace
+
+size_t Operator::getColumnIndex(const std::string &name) const {
+    auto it = std::find(columnNames_.begin(), columnNames_.end(), name);
+    if (it != columnNames_.end()) {
+        return static_cast<size_t>(it - columnNames_.begin());
+    }
+
+    // 连接结果的列名带表名限定（"orders.id"），未限定的列名按唯一的 ".列名" 后缀匹配
+    const std::string suffix = "." + name;
+    size_t found = columnNames_.size();
+    for (size_t i = 0; i < columnNames_.size(); ++i) {
+        const std::string &column = columnNames_[i];
+        if (column.size() > suffix.size() &&
+            column.compare(column.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            if (found != columnNames_.size()) {
+                throw std::runtime_error("Ambiguous column: " + name);
+            }
+            found = i;
+        }
+    }
+    if (found == columnNames_.size()) {
+        throw std::runtime_error("Unknown column: " + name);
+    }
+    return found;
+}
+
+// ==================== SeqScan ====================
+
+SeqScanOperator::SeqScanOperator(std::shared_ptr<storage::BufferManager> bufferManager,
+                                 const TableInfo *tableInfo, std::vector<size_t> columns,
+                                 std::vector<RecordPredicate> predicates)
+    : bufferManager_(std::move(bufferManager)), tableInfo_(tableInfo), columns_(std::move(columns)),
+      predicates_(std::move(predicates)) {
+    const Schema &schema = tableInfo_->get_schema();
+    if (columns_.empty()) {
+        columnNames_ = schema.get_column_names();
+        for (const auto &col : schema.get_columns()) {
+            columnTypes_.push_back(col.type);
+        }
+    }
+    for (size_t i : columns_) {
+        const MyColumn &col = schema.get_column(static_cast<uint32_t>(i));
+        columnNames_.push_back(col.get_name());
+        columnTypes_.push_back(col.type);
+    }
+}
+
+void SeqScanOperator::open() {
+    pageId_ = tableInfo_->getFirstPageID();
+    slot_ = 0;
+    page_ = pageId_ == INVALID_PAGE_ID ? storage::ReadPageGuard() : bufferManager_->fetchPageRead(pageId_);
+}
+
+bool SeqScanOperator::next(Tuple &tuple) {
+    while (pageId_ != INVALID_PAGE_ID) {
+        // 已删除（大小为0）的槽返回 nullptr
+        while (slot_ < page_->getSlotCount()) {
+            uint16_t slot = slot_++;
+            const char *record = page_->getRecordData(slot);
+            if (!record) continue;
+
+            bool matched = true;
+            for (const auto &predicate : predicates_) {
+                if (!predicate(record)) {
+                    matched = false;
+                    break;
+                }
+            }
+            if (!matched) continue;
+
+            const RowCodec &codec = tableInfo_->get_codec();
+            RID rid{pageId_, slot};
+            tuple = columns_.empty() ? codec.decode(record, rid) : codec.decode(record, columns_, rid);
+            return true;
+        }
+
+        // 当前页读完，先释放再移动到下一页
+        PageID next = page_->getNextPageId();
+        page_.release();
+        pageId_ = next;
+        slot_ = 0;
+        if (pageId_ != INVALID_PAGE_ID) {
+            page_ = bufferManager_->fetchPageRead(pageId_);
+        }
+    }
+    return false;
+}
+
+void SeqScanOperator::close() {
+    page_.release();
+    pageId_ = INVALID_PAGE_ID;
+}
+
+// ==================== IndexScan ====================
+
+IndexScanOperator::IndexScanOperator(std::shared_ptr<storage::BufferManager> bufferManager,
+                                     const TableInfo *tableInfo, const engine::BPlusTreeIndex *index,
+                                     std::vector<Value> prefix, engine::KeyBound lower, engine::KeyBound upper)
+    : bufferManager_(std::move(bufferManager)), tableInfo_(tableInfo), index_(index),
+      prefix_(std::move(prefix)), lower_(std::move(lower)), upper_(std::move(upper)) {
+    for (const auto &col : tableInfo_->get_schema().get_columns()) {
+        columnNames_.push_back(col.get_name());
+        columnTypes_.push_back(col.type);
+    }
+}
+
+void IndexScanOperator::open() {
+    iterator_ = index_->scan(prefix_, lower_, upper_);
+}
+
+bool IndexScanOperator::next(Tuple &tuple) {
+    while (!iterator_.is_end()) {
+        RID rid = iterator_.rid();
+        ++iterator_;
+
+        // 直接在页内解码，不先拷贝记录
+        storage::ReadPageGuard page = bufferManager_->fetchPageRead(rid.page_id);
+        const char *record = page->getRecordData(rid.slot_num);
+        if (record) {
+            tuple = tableInfo_->get_codec().decode(record, rid);
+            return true;
+        }
+    }
+    return false;
+}
+
+void IndexScanOperator::close() {
+    iterator_ = engine::IndexIterator();
+}
+
+// ==================== Filter ====================
+
+FilterOperator::FilterOperator(OperatorPtr child, Predicate predicate)
+    : child_(std::move(child)), predicate_(std::move(predicate)) {
+    columnNames_ = child_->getColumnNames();
+    columnTypes_ = child_->getColumnTypes();
+}
+
+void FilterOperator::open() { child_->open(); }
+
+bool FilterOperator::next(Tuple &tuple) {
+    while (child_->next(tuple)) {
+        if (predicate_(tuple)) return true;
+    }
+    return false;
+}
+
+void FilterOperator::close() { child_->close(); }
+
+// ==================== Project ====================
+
+ProjectOperator::ProjectOperator(OperatorPtr child, const std::vector<std::string> &columns)
+    : child_(std::move(child)) {
+    bool all = columns.empty() || (columns.size() == 1 && columns[0] == "*");
+    size_t count = all ? child_->getColumnNames().size() : columns.size();
+    for (size_t i = 0; i < count; ++i) {
+        size_t pos = all ? i : child_->getColumnIndex(columns[i]);
+        positions_.push_back(pos);
+        columnNames_.push_back(all ? child_->getColumnNames()[pos] : columns[i]);
+        columnTypes_.push_back(child_->getColumnTypes()[pos]);
+    }
+}
+
+void ProjectOperator::open() { child_->open(); }
+
+bool ProjectOperator::next(Tuple &tuple) {
+    Tuple input;
+    if (!child_->next(input)) return false;
+
+    std::vector<Value> values;
+    values.reserve(positions_.size());
+    for (size_t pos : positions_) {
+        values.push_back(input.getValue(pos));
+    }
+    tuple = Tuple(std::move(values));
+    tuple.setRid(input.getRid());
+    return true;
+}
+
+void ProjectOperator::close() { child_->close(); }
+
+// ==================== Limit ====================
+
+LimitOperator::LimitOperator(OperatorPtr child, size_t limit, size_t offset)
+    : child_(std::move(child)), limit_(limit), offset_(offset) {
+    columnNames_ = child_->getColumnNames();
+    columnTypes_ = child_->getColumnTypes();
+}
+
+void LimitOperator::open() {
+    produced_ = 0;
+    skipped_ = 0;
+    childOpen_ = limit_ > 0;
+    if (childOpen_) child_->open();
+}
+
+bool LimitOperator::next(Tuple &tuple) {
+    if (!childOpen_) return false;
+
+    for (; skipped_ < offset_; ++skipped_) {
+        if (!child_->next(tuple)) {
+            closeChild();
+            return false;
+        }
+    }
+    if (!child_->next(tuple)) {
+        closeChild();
+        return false;
+    }
+    // 取够后马上关闭子算子，不等上层调用 close()
+    if (++produced_ >= limit_) closeChild();
+    return true;
+}
+
+void LimitOperator::closeChild() {
+    if (childOpen_) {
+        child_->close();
+        childOpen_ = false;
+    }
+}
+
+void LimitOperator::close() { closeChild(); }
+
+// ==================== 工具函数 ====================
+
+Value decodeColumn(const char *record, const MyColumn &column) {
+    RowCodec::Field field = RowCodec::fieldOf(column);
+    return field.decode(record, field);
+}
+
+namespace {
+
+// 为一种比较函数对象生成按列类型特化的记录谓词
+template <typename Cmp>
+RecordPredicate compileComparison(const RowCodec::Field &field, const Value &literal, Cmp cmp) {
+    uint32_t offset = field.offset;
+    switch (field.type) {
+        case TypeId::INTEGER: {
+            int32_t constant = literal.getAsInt();
+            return [offset, constant, cmp](const char *record) {
+                int32_t v;
+                std::memcpy(&v, record + offset, sizeof(int32_t));
+                return cmp(v, constant);
+            };
+        }
+        case TypeId::BOOLEAN: {
+            bool constant = literal.getAsBool();
+            return [offset, constant, cmp](const char *record) {
+                return cmp(record[offset] != 0, constant);
+            };
+        }
+        case TypeId::VARCHAR: {
+            uint32_t length = field.width;
+            return [offset, length, constant = literal.getAsString(), cmp](const char *record) {
+                const char *field = record + offset;
+                return cmp(std::string_view(field, strnlen(field, length)), std::string_view(constant));
+            };
+        }
+        default:
+            throw TypeMismatchException("Unsupported column type: " + std::string(getTypeName(field.type)));
+    }
+}
+
+} // namespace
+
+CompareOp parseCompareOp(const std::string &op) {
+    if (op == "=" || op == "EQUALS") return CompareOp::EQ;
+    if (op == "!=" || op == "<>" || op == "NOT_EQUALS") return CompareOp::NE;
+    if (op == "<" || op == "LESS_THAN") return CompareOp::LT;
+    if (op == "<=" || op == "LESS_THAN_OR_EQUAL") return CompareOp::LE;
+    if (op == ">" || op == "GREATER_THAN") return CompareOp::GT;
+    if (op == ">=" || op == "GREATER_THAN_OR_EQUAL") return CompareOp::GE;
+    throw std::runtime_error("Unsupported comparison operator: " + op);
+}
+
+RecordPredicate compilePredicate(const MyColumn &column, CompareOp op, const Value &literal) {
+    return compilePredicate(RowCodec::fieldOf(column), op, literal);
+}
+
+RecordPredicate compilePredicate(const RowCodec::Field &field, CompareOp op, const Value &literal) {
+    // 与 NULL 比较恒为 false
+    if (literal.isNull()) {
+        return [](const char *) { return false; };
+    }
+    switch (op) {
+        case CompareOp::EQ: return compileComparison(field, literal, std::equal_to<>());
+        case CompareOp::NE: return compileComparison(field, literal, std::not_equal_to<>());
+        case CompareOp::LT: return compileComparison(field, literal, std::less<>());
+        case CompareOp::LE: return compileComparison(field, literal, std::less_equal<>());
+        case CompareOp::GT: return compileComparison(field, literal, std::greater<>());
+        case CompareOp::GE: return compileComparison(field, literal, std::greater_equal<>());
+    }
+    throw std::runtime_error("Unsupported comparison operator");
+}
+
+Value parseLiteral(const std::string &text, TypeId type) {
+    std::string v = unquote(text);
+    switch (type) {
+        case TypeId::INTEGER:
+            try {
+                return Value(static_cast<int32_t>(std::stoi(v)));
+            } catch (const std::exception &) {
+                throw TypeMismatchException("Invalid INTEGER literal: " + text);
+            }
+        case TypeId::BOOLEAN:
+            return Value(v == "true" || v == "1");
+        case TypeId::VARCHAR:
+            return Value(v);
+        default:
+            throw TypeMismatchException("Unsupported literal type: " + std::string(getTypeName(type)));
+    }
+}
+
+bool compareValues(const Value &lhs, CompareOp op, const Value &rhs) {
+    if (lhs.isNull() || rhs.isNull()) return false;
+
+    switch (op) {
+        case CompareOp::EQ: return lhs.equals(rhs);
+        case CompareOp::NE: return !lhs.equals(rhs);
+        case CompareOp::LT: return lhs.lessThan(rhs);
+        case CompareOp::LE: return lhs.lessThanOrEquals(rhs);
+        case CompareOp::GT: return lhs.greaterThan(rhs);
+        case CompareOp::GE: return lhs.greaterThanOrEquals(rhs);
+    }
+    return false;
+}
+
+bool compareValues(const Value &lhs, const std::string &op, const Value &rhs) {
+    return compareValues(lhs, parseCompareOp(op), rhs);
+}
+
+std::string valueToString(const Value &value) {
+    return value.getType() == TypeId::VARCHAR ? value.getAsString() : value.toString();
+}
+
+} // namespace minidb
@@ -0,0 +1,403 @@
+#include "../../include/engine/ParallelOperators.h"
+#include "common/Exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace minidb {
+
+namespace {
+
+// 工作线程内的行来源：逐个领取 morsel，执行其扫描流水线，把批次拆成元组交给部分聚合
+class MorselSourceOperator : public Operator {
+public:
+    MorselSourceOperator(MorselQueue &queue, const MorselPipelineFactory &factory,
+                         const std::vector<std::string> &names, const std::vector<TypeId> &types)
+        : queue_(queue), factory_(factory) {
+        columnNames_ = names;
+        columnTypes_ = types;
+    }
+
+    void open() override {}
+
+    bool next(Tuple &tuple) override {
+        while (true) {
+            if (pipeline_) {
+                if (pos_ < chunk_.activeCount()) {
+                    size_t row = chunk_.rowAt(pos_++);
+                    std::vector<Value> values;
+                    values.reserve(chunk_.columns.size());
+                    for (const auto &column : chunk_.columns) {
+                        values.push_back(column.getValue(row));
+                    }
+                    tuple = Tuple(std::move(values));
+                    return true;
+                }
+                if (pipeline_->nextBatch(chunk_)) {
+                    pos_ = 0;
+                    continue;
+                }
+                pipeline_->close();
+                pipeline_.reset();
+            }
+
+            size_t index;
+            if (!queue_.pop(index)) return false;
+            pipeline_ = factory_(queue_.morsel(index));
+            pipeline_->open();
+            chunk_ = DataChunk();
+            pos_ = 0;
+        }
+    }
+
+    void close() override {
+        if (pipeline_) {
+            pipeline_->close();
+            pipeline_.reset();
+        }
+    }
+
+private:
+    MorselQueue &queue_;
+    const MorselPipelineFactory &factory_;
+    VectorOperatorPtr pipeline_;
+    DataChunk chunk_;
+    size_t pos_ = 0;
+};
+
+/**
+ * 部分分组记录：2 字节分组键长度 + 分组键元组，每个聚合项的 count、sum（各 8 字节），
+ * 最后是各聚合项 extreme 组成的元组
+ */
+void encodePartial(const Tuple &keys, const std::vector<AggregateOperator::AggState> &states, std::string &out) {
+    out.assign(sizeof(uint16_t), '\0');
+    serializeTuple(keys, out);
+    auto keyBytes = static_cast<uint16_t>(out.size() - sizeof(uint16_t));
+    std::memcpy(out.data(), &keyBytes, sizeof(keyBytes));
+
+    std::vector<Value> extremes;
+    for (const auto &state : states) {
+        out.append(reinterpret_cast<const char *>(&state.count), sizeof(state.count));
+        out.append(reinterpret_cast<const char *>(&state.sum), sizeof(state.sum));
+        extremes.push_back(state.extreme);
+    }
+    serializeTuple(Tuple(std::move(extremes)), out);
+}
+
+std::string_view partialKey(std::string_view record) {
+    uint16_t keyBytes;
+    std::memcpy(&keyBytes, record.data(), sizeof(keyBytes));
+    return record.substr(sizeof(keyBytes), keyBytes);
+}
+
+void decodePartial(std::string_view record, size_t aggregateCount, Tuple &keys,
+                   std::vector<AggregateOperator::AggState> &states) {
+    std::string_view key = partialKey(record);
+    keys = deserializeTuple(key.data(), key.size());
+
+    const char *data = key.data() + key.size();
+    states.assign(aggregateCount, {});
+    for (auto &state : states) {
+        std::memcpy(&state.count, data, sizeof(state.count));
+        std::memcpy(&state.sum, data + sizeof(state.count), sizeof(state.sum));
+        data += sizeof(state.count) + sizeof(state.sum);
+    }
+    Tuple extremes = deserializeTuple(data, static_cast<size_t>(record.data() + record.size() - data));
+    for (size_t i = 0; i < aggregateCount; ++i) {
+        states[i].extreme = extremes.getValue(i);
+    }
+}
+
+// 已物化的元组序列
+class TupleListOperator : public Operator {
+public:
+    TupleListOperator(const std::vector<std::string> &names, const std::vector<TypeId> &types,
+                      std::vector<Tuple> rows = {})
+        : rows_(std::move(rows)) {
+        columnNames_ = names;
+        columnTypes_ = types;
+    }
+
+    void open() override { pos_ = 0; }
+
+    bool next(Tuple &tuple) override {
+        if (pos_ >= rows_.size()) return false;
+        tuple = std::move(rows_[pos_++]);
+        return true;
+    }
+
+    void close() override { rows_.clear(); }
+
+private:
+    std::vector<Tuple> rows_;
+    size_t pos_ = 0;
+};
+
+} // namespace
+
+// ==================== MorselQueue ====================
+
+MorselQueue::MorselQueue(const std::vector<PageID> &pages, size_t morselPages) {
+    if (morselPages == 0) morselPages = MORSEL_PAGES;
+    for (size_t begin = 0; begin < pages.size(); begin += morselPages) {
+        size_t end = std::min(pages.size(), begin + morselPages);
+        morsels_.emplace_back(pages.begin() + static_cast<std::ptrdiff_t>(begin),
+                              pages.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+}
+
+bool MorselQueue::pop(size_t &index) {
+    index = next_.fetch_add(1, std::memory_order_relaxed);
+    return index < morsels_.size();
+}
+
+// ==================== ParallelScan ====================
+
+ParallelScanOperator::ParallelScanOperator(TaskScheduler &scheduler, size_t workers, std::vector<PageID> pages,
+                                           MorselPipelineFactory factory, size_t morselPages)
+    : scheduler_(scheduler), workers_(std::max<size_t>(workers, 1)), window_(2 * workers_),
+      pages_(std::move(pages)), factory_(std::move(factory)), morselPages_(morselPages) {
+    VectorOperatorPtr prototype = factory_({});
+    columnNames_ = prototype->getColumnNames();
+    columnTypes_ = prototype->getColumnTypes();
+}
+
+ParallelScanOperator::~ParallelScanOperator() {
+    close();
+}
+
+void ParallelScanOperator::open() {
+    close();
+    queue_ = std::make_unique<MorselQueue>(pages_, morselPages_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        states_.assign(queue_->size(), MorselState::Pending);
+        results_.assign(queue_->size(), {});
+        error_ = nullptr;
+        cancelled_ = false;
+    }
+    submitted_ = 0;
+    morsel_ = 0;
+    batch_ = 0;
+    fillWindow();
+}
+
+void ParallelScanOperator::fillWindow() {
+    while (submitted_ < queue_->size() && submitted_ < morsel_ + window_) {
+        size_t index = submitted_++;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++outstanding_;
+        }
+        scheduler_.submit([this, index] {
+            runMorsel(index);
+            // 持锁通知：close() 看到 outstanding_ 归零前本任务不会再访问成员
+            std::lock_guard<std::mutex> lock(mutex_);
+            --outstanding_;
+            ready_.notify_all();
+        });
+    }
+}
+
+void ParallelScanOperator::runMorsel(size_t index) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cancelled_ || states_[index] != MorselState::Pending) return;
+        states_[index] = MorselState::Running;
+    }
+
+    std::vector<DataChunk> batches;
+    std::exception_ptr error;
+    try {
+        VectorOperatorPtr pipeline = factory_(queue_->morsel(index));
+        pipeline->open();
+        DataChunk chunk;
+        while (pipeline->nextBatch(chunk)) {
+            if (chunk.activeCount() == 0) continue;
+            batches.push_back(std::move(chunk));
+            chunk = DataChunk();
+        }
+        pipeline->close();
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    results_[index] = std::move(batches);
+    states_[index] = MorselState::Ready;
+    if (error && !error_) error_ = error;
+    ready_.notify_all();
+}
+
+bool ParallelScanOperator::nextBatch(DataChunk &chunk) {
+    while (morsel_ < results_.size()) {
+        if (batch_ == 0) {
+            // 等待的 morsel 还在队列里时自己执行，不空等工作线程
+            runMorsel(morsel_);
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return states_[morsel_] == MorselState::Ready; });
+            if (error_) std::rethrow_exception(error_);
+        }
+
+        std::vector<DataChunk> &batches = results_[morsel_];
+        if (batch_ < batches.size()) {
+            chunk = std::move(batches[batch_++]);
+            return true;
+        }
+        std::vector<DataChunk>().swap(batches);
+        ++morsel_;
+        batch_ = 0;
+        fillWindow();
+    }
+    return false;
+}
+
+void ParallelScanOperator::close() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cancelled_ = true;
+        ready_.wait(lock, [this] { return outstanding_ == 0; });
+        states_.clear();
+        results_.clear();
+    }
+    queue_.reset();
+    submitted_ = 0;
+    morsel_ = 0;
+    batch_ = 0;
+}
+
+// ==================== ParallelAggregate ====================
+
+ParallelAggregateOperator::ParallelAggregateOperator(TaskScheduler &scheduler, size_t workers,
+                                                     std::vector<PageID> pages, MorselPipelineFactory factory,
+                                                     std::vector<size_t> groupColumns,
+                                                     std::vector<AggregateSpec> aggregates,
+                                                     std::shared_ptr<storage::BufferManager> bufferManager,
+                                                     size_t memoryBudget, size_t morselPages)
+    : scheduler_(scheduler), workers_(std::max<size_t>(workers, 1)), pages_(std::move(pages)),
+      factory_(std::move(factory)), groupColumns_(std::move(groupColumns)), aggregates_(std::move(aggregates)),
+      bufferManager_(std::move(bufferManager)), memoryBudget_(memoryBudget), morselPages_(morselPages) {
+    VectorOperatorPtr prototype = factory_({});
+    inputNames_ = prototype->getColumnNames();
+    inputTypes_ = prototype->getColumnTypes();
+
+    // 输出列与串行聚合相同（同时检查聚合项是否合法）
+    AggregateOperator output(std::make_unique<TupleListOperator>(inputNames_, inputTypes_), groupColumns_,
+                             aggregates_);
+    columnNames_ = output.getColumnNames();
+    columnTypes_ = output.getColumnTypes();
+}
+
+void ParallelAggregateOperator::open() {
+    close();
+    MorselQueue queue(pages_, morselPages_);
+    size_t taskCount = std::max<size_t>(1, std::min(workers_, queue.size()));
+    size_t budget = memoryBudget_ / taskCount;
+    partials_.clear();
+    partials_.resize(taskCount);
+    std::vector<char> partialSpilled(taskCount, false);
+
+    std::vector<TaskScheduler::Task> tasks;
+    for (size_t w = 0; w < taskCount; ++w) {
+        tasks.emplace_back([this, &queue, &partialSpilled, w, budget] {
+            AggregateOperator partial(
+                std::make_unique<MorselSourceOperator>(queue, factory_, inputNames_, inputTypes_), groupColumns_,
+                aggregates_, bufferManager_, budget);
+            partial.open();
+            partialSpilled[w] = partial.spilled();
+            PartialBuffer &buffer = partials_[w];
+            buffer.memory.resize(PARTITION_COUNT);
+            Tuple keys;
+            std::vector<AggregateOperator::AggState> states;
+            while (partial.nextGroup(keys, states)) {
+                addPartial(buffer, keys, states, budget);
+            }
+            partial.close();
+        });
+    }
+    scheduler_.run(std::move(tasks));
+
+    spilled_ = false;
+    for (size_t w = 0; w < taskCount; ++w) {
+        spilled_ = spilled_ || partialSpilled[w] || !partials_[w].files.empty();
+    }
+    final_ = std::make_unique<AggregateOperator>(std::make_unique<TupleListOperator>(inputNames_, inputTypes_),
+                                                 groupColumns_, aggregates_);
+    partition_ = 0;
+    mergeNext();
+}
+
+void ParallelAggregateOperator::addPartial(PartialBuffer &buffer, const Tuple &keys,
+                                           const std::vector<AggregateOperator::AggState> &states, size_t budget) {
+    std::string record;
+    encodePartial(keys, states, record);
+    size_t partition = std::hash<std::string_view>{}(partialKey(record)) % PARTITION_COUNT;
+    if (!buffer.files.empty()) {
+        buffer.files[partition]->appendRecord(record);
+        return;
+    }
+
+    buffer.bytes += record.size() + sizeof(std::string);
+    buffer.memory[partition].push_back(std::move(record));
+    // 没有分组列时每个任务只有一条部分结果，不必溢出
+    if (buffer.bytes <= budget || !bufferManager_ || groupColumns_.empty()) return;
+
+    for (size_t p = 0; p < PARTITION_COUNT; ++p) {
+        buffer.files.push_back(std::make_unique<SpillFile>(bufferManager_));
+        for (const std::string &held : buffer.memory[p]) {
+            buffer.files[p]->appendRecord(held);
+        }
+        std::vector<std::string>().swap(buffer.memory[p]);
+    }
+    buffer.bytes = 0;
+}
+
+bool ParallelAggregateOperator::mergeNext() {
+    if (partition_ >= PARTITION_COUNT) return false;
+    // 没有溢出时部分结果都在内存中，一次合并全部分区
+    size_t end = spilled_ ? partition_ + 1 : PARTITION_COUNT;
+
+    final_->beginMerge();
+    Tuple keys;
+    std::vector<AggregateOperator::AggState> states;
+    for (; partition_ < end; ++partition_) {
+        for (PartialBuffer &buffer : partials_) {
+            for (const std::string &record : buffer.memory[partition_]) {
+                decodePartial(record, aggregates_.size(), keys, states);
+                final_->mergeGroup(keys, states);
+            }
+            std::vector<std::string>().swap(buffer.memory[partition_]);
+
+            if (buffer.files.empty()) continue;
+            SpillFile &file = *buffer.files[partition_];
+            file.rewind();
+            std::string_view record;
+            while (file.nextRecord(record)) {
+                decodePartial(record, aggregates_.size(), keys, states);
+                final_->mergeGroup(keys, states);
+            }
+            buffer.files[partition_].reset();   // 读完即归还临时页
+        }
+    }
+    return true;
+}
+
+bool ParallelAggregateOperator::next(Tuple &tuple) {
+    while (final_) {
+        if (final_->next(tuple)) return true;
+        if (!mergeNext()) return false;
+    }
+    return false;
+}
+
+void ParallelAggregateOperator::close() {
+    if (final_) {
+        final_->close();
+        final_.reset();
+    }
+    partials_.clear();
+}
+
+} // namespace minidb
@@ -0,0 +1,138 @@
+#include "../../include/engine/ResultCursor.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace minidb {
+
+ResultCursor::ResultCursor(OperatorPtr root) : root_(std::move(root)) {
+    columnNames_ = root_->getColumnNames();
+    columnTypes_ = root_->getColumnTypes();
+    root_->open();
+    open_ = true;
+}
+
+ResultCursor::ResultCursor(VectorOperatorPtr root) : vectorRoot_(std::move(root)) {
+    columnNames_ = vectorRoot_->getColumnNames();
+    columnTypes_ = vectorRoot_->getColumnTypes();
+    vectorRoot_->open();
+    open_ = true;
+}
+
+ResultCursor::~ResultCursor() {
+    close();
+}
+
+ResultCursor::ResultCursor(ResultCursor &&other) noexcept
+    : root_(std::move(other.root_)), vectorRoot_(std::move(other.vectorRoot_)),
+      columnNames_(std::move(other.columnNames_)), columnTypes_(std::move(other.columnTypes_)),
+      open_(std::exchange(other.open_, false)), produced_(other.produced_),
+      chunk_(std::move(other.chunk_)), chunkPos_(other.chunkPos_) {}
+
+ResultCursor &ResultCursor::operator=(ResultCursor &&other) noexcept {
+    if (this != &other) {
+        close();
+        root_ = std::move(other.root_);
+        vectorRoot_ = std::move(other.vectorRoot_);
+        columnNames_ = std::move(other.columnNames_);
+        columnTypes_ = std::move(other.columnTypes_);
+        open_ = std::exchange(other.open_, false);
+        produced_ = other.produced_;
+        chunk_ = std::move(other.chunk_);
+        chunkPos_ = other.chunkPos_;
+    }
+    return *this;
+}
+
+bool ResultCursor::next(Tuple &tuple) {
+    if (!open_) return false;
+
+    if (root_) {
+        if (!root_->next(tuple)) {
+            close();
+            return false;
+        }
+        ++produced_;
+        return true;
+    }
+
+    // 当前批次的有效行交付完再拉下一批（批次可能没有有效行）
+    while (chunkPos_ >= chunk_.activeCount()) {
+        chunkPos_ = 0;
+        if (!vectorRoot_->nextBatch(chunk_)) {
+            close();
+            return false;
+        }
+    }
+    size_t row = chunk_.rowAt(chunkPos_++);
+    std::vector<Value> values;
+    values.reserve(chunk_.columns.size());
+    for (const auto &column : chunk_.columns) {
+        values.push_back(column.getValue(row));
+    }
+    tuple = Tuple(std::move(values));
+    ++produced_;
+    return true;
+}
+
+size_t ResultCursor::nextBatch(std::vector<Tuple> &rows, size_t maxRows) {
+    size_t count = 0;
+    Tuple tuple;
+    while (count < maxRows && next(tuple)) {
+        rows.push_back(std::move(tuple));
+        ++count;
+    }
+    return count;
+}
+
+size_t ResultCursor::fetchInto(QueryResult &result, size_t maxRows) {
+    size_t count = 0;
+    if (root_) {
+        Tuple tuple;
+        while (count < maxRows && next(tuple)) {
+            result.appendTuple(tuple);
+            ++count;
+        }
+        return count;
+    }
+
+    while (open_ && count < maxRows) {
+        if (chunkPos_ >= chunk_.activeCount()) {
+            chunkPos_ = 0;
+            if (!vectorRoot_->nextBatch(chunk_)) {
+                close();
+                break;
+            }
+            continue;
+        }
+        // 逐列拷贝当前批次中的有效行：整数直接追加，字符串只拷贝字节
+        size_t take = std::min(maxRows - count, chunk_.activeCount() - chunkPos_);
+        for (size_t c = 0; c < chunk_.columns.size(); ++c) {
+            const ColumnVector &column = chunk_.columns[c];
+            for (size_t i = chunkPos_; i < chunkPos_ + take; ++i) {
+                size_t row = chunk_.rowAt(i);
+                if (column.type == TypeId::VARCHAR) {
+                    result.appendString(c, column.strings[row]);
+                } else {
+                    result.appendInt(c, column.ints[row]);
+                }
+            }
+        }
+        chunkPos_ += take;
+        count += take;
+    }
+    produced_ += count;
+    return count;
+}
+
+void ResultCursor::close() {
+    if (!open_) return;
+    open_ = false;
+    chunkPos_ = 0;
+    chunk_.size = 0;
+    chunk_.selectedCount = 0;
+    if (root_) root_->close();
+    if (vectorRoot_) vectorRoot_->close();
+}
+
+} // namespace minidb
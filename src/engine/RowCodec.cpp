@@ -0,0 +1,139 @@
+#include "../../include/engine/RowCodec.h"
+#include "common/Exception.h"
+
+#include <algorithm>
+
+namespace minidb {
+
+namespace {
+
+using Field = RowCodec::Field;
+
+// 每种列类型一组编解码例程，构造 RowCodec 时按类型取对应的实例
+template <TypeId T>
+Value decodeField(const char *record, const Field &field) {
+    const char *data = record + field.offset;
+    if constexpr (T == TypeId::INTEGER) {
+        int32_t v;
+        std::memcpy(&v, data, sizeof(int32_t));
+        return Value(v);
+    } else if constexpr (T == TypeId::BOOLEAN) {
+        return Value(*data != 0);
+    } else {
+        return Value(std::string(data, strnlen(data, field.width)));
+    }
+}
+
+template <TypeId T>
+void encodeField(char *record, const Field &field, const Value &value) {
+    char *data = record + field.offset;
+    if constexpr (T == TypeId::INTEGER) {
+        int32_t v = value.isNull() ? 0 : value.getAsInt();
+        std::memcpy(data, &v, sizeof(int32_t));
+    } else if constexpr (T == TypeId::BOOLEAN) {
+        bool v = !value.isNull() && value.getAsBool();
+        std::memcpy(data, &v, sizeof(bool));
+    } else {
+        std::string_view text = value.isNull() ? std::string_view() : value.getStringView();
+        size_t size = std::min(text.size(), static_cast<size_t>(field.width));
+        std::memcpy(data, text.data(), size);
+        std::memset(data + size, 0, field.width - size);
+    }
+}
+
+Value decodeUnsupported(const char *, const Field &field) {
+    throw TypeMismatchException("Unsupported column type: " + std::string(getTypeName(field.type)));
+}
+
+void encodeUnsupported(char *, const Field &field, const Value &) {
+    throw TypeMismatchException("Unsupported column type: " + std::string(getTypeName(field.type)));
+}
+
+} // namespace
+
+RowCodec::Field RowCodec::fieldOf(const MyColumn &column) {
+    Field field;
+    field.offset = column.offset;
+    field.width = column.length;
+    field.type = column.type;
+    switch (column.type) {
+        case TypeId::INTEGER:
+            field.decode = decodeField<TypeId::INTEGER>;
+            field.encode = encodeField<TypeId::INTEGER>;
+            break;
+        case TypeId::BOOLEAN:
+            field.decode = decodeField<TypeId::BOOLEAN>;
+            field.encode = encodeField<TypeId::BOOLEAN>;
+            break;
+        case TypeId::VARCHAR:
+            field.decode = decodeField<TypeId::VARCHAR>;
+            field.encode = encodeField<TypeId::VARCHAR>;
+            break;
+        default:
+            field.decode = decodeUnsupported;
+            field.encode = encodeUnsupported;
+            break;
+    }
+    return field;
+}
+
+RowCodec::RowCodec(const Schema &schema) {
+    fields_.reserve(schema.get_column_count());
+    for (const MyColumn &column : schema.get_columns()) {
+        fields_.push_back(fieldOf(column));
+        rowSize_ = std::max(rowSize_, column.offset + column.length);
+    }
+    allIntegers_ = !fields_.empty() && std::all_of(fields_.begin(), fields_.end(), [](const Field &f) {
+        return f.type == TypeId::INTEGER;
+    });
+}
+
+void RowCodec::writeString(char *record, size_t column, std::string_view value) const {
+    const Field &f = fields_[column];
+    size_t size = std::min(value.size(), static_cast<size_t>(f.width));
+    std::memcpy(record + f.offset, value.data(), size);
+    std::memset(record + f.offset + size, 0, f.width - size);
+}
+
+Tuple RowCodec::decode(const char *record, const RID &rid) const {
+    std::vector<Value> values;
+    values.reserve(fields_.size());
+    if (allIntegers_) {
+        for (const Field &f : fields_) {
+            int32_t v;
+            std::memcpy(&v, record + f.offset, sizeof(int32_t));
+            values.emplace_back(v);
+        }
+    } else {
+        for (const Field &f : fields_) {
+            values.push_back(f.decode(record, f));
+        }
+    }
+    Tuple tuple(std::move(values));
+    tuple.setRid(rid);
+    return tuple;
+}
+
+Tuple RowCodec::decode(const char *record, const std::vector<size_t> &columns, const RID &rid) const {
+    std::vector<Value> values;
+    values.reserve(columns.size());
+    for (size_t column : columns) {
+        const Field &f = fields_[column];
+        values.push_back(f.decode(record, f));
+    }
+    Tuple tuple(std::move(values));
+    tuple.setRid(rid);
+    return tuple;
+}
+
+void RowCodec::encode(const std::vector<Value> &values, char *record) const {
+    if (values.size() != fields_.size()) {
+        throw DatabaseException("Expected " + std::to_string(fields_.size()) + " values, got " +
+                                std::to_string(values.size()));
+    }
+    for (size_t i = 0; i < fields_.size(); ++i) {
+        fields_[i].encode(record, fields_[i], values[i]);
+    }
+}
+
+} // namespace minidb
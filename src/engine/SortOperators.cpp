@@ -0,0 +1,232 @@
+#include "../../include/engine/SortOperators.h"
+#include "engine/bPlusTree/key_codec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace minidb {
+
+namespace {
+
+// 记录开头的 2 字节键长之后是可比较字节串键
+std::string_view keyOf(std::string_view record) {
+    uint16_t length;
+    std::memcpy(&length, record.data(), sizeof(length));
+    return record.substr(sizeof(length), length);
+}
+
+// 键的前 8 字节按大端组成整数，不足补 0
+uint64_t prefixOf(std::string_view key) {
+    uint64_t prefix = 0;
+    for (size_t i = 0; i < sizeof(prefix); ++i) {
+        prefix <<= 8;
+        if (i < key.size()) prefix |= static_cast<unsigned char>(key[i]);
+    }
+    return prefix;
+}
+
+} // namespace
+
+SortOperator::SortOperator(OperatorPtr child, std::vector<SortKey> keys,
+                           std::shared_ptr<storage::BufferManager> bufferManager, size_t memoryBudget, size_t limit)
+    : child_(std::move(child)), keys_(std::move(keys)), bufferManager_(std::move(bufferManager)),
+      memoryBudget_(memoryBudget), limit_(limit) {
+    columnNames_ = child_->getColumnNames();
+    columnTypes_ = child_->getColumnTypes();
+}
+
+void SortOperator::encodeRecord(const Tuple &tuple, std::string &out) {
+    out.assign(sizeof(uint16_t), '\0');
+    for (const auto &key : keys_) {
+        size_t start = out.size();
+        engine::KeyCodec::encode_value(tuple.getValue(key.column), &out);
+        if (!key.ascending) {
+            // 编码无前缀歧义（VARCHAR 以 0x00 0x00 结尾），逐字节取反即得到逆序
+            for (size_t i = start; i < out.size(); ++i) out[i] = static_cast<char>(~out[i]);
+        }
+    }
+    // 输入序号（大端）使键唯一，相同排序键按输入顺序输出
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>(sequence_ >> shift));
+    }
+    ++sequence_;
+
+    auto keyLength = static_cast<uint16_t>(out.size() - sizeof(uint16_t));
+    std::memcpy(out.data(), &keyLength, sizeof(keyLength));
+    serializeTuple(tuple, out);
+}
+
+void SortOperator::addEntry(std::string_view record) {
+    std::string_view key = keyOf(record);
+    entries_.push_back({prefixOf(key), static_cast<uint32_t>(arena_.size()), static_cast<uint32_t>(key.size()),
+                        static_cast<uint32_t>(record.size())});
+    arena_.append(record);
+}
+
+void SortOperator::sortEntries() {
+    const char *arena = arena_.data();
+    std::sort(entries_.begin(), entries_.end(), [arena](const SortEntry &a, const SortEntry &b) {
+        if (a.prefix != b.prefix) return a.prefix < b.prefix;
+        std::string_view x(arena + a.offset + sizeof(uint16_t), a.keyLength);
+        std::string_view y(arena + b.offset + sizeof(uint16_t), b.keyLength);
+        return x < y;
+    });
+}
+
+void SortOperator::spillRun() {
+    sortEntries();
+    auto run = std::make_unique<SpillFile>(bufferManager_);
+    for (const auto &entry : entries_) {
+        run->appendRecord(std::string_view(arena_.data() + entry.offset, entry.length));
+    }
+    runs_.push_back(std::move(run));
+    arena_.clear();
+    entries_.clear();
+}
+
+void SortOperator::pushTopN() {
+    if (limit_ == 0) return;
+    auto keyLess = [](const std::string &a, const std::string &b) { return keyOf(a) < keyOf(b); };
+
+    if (heap_.size() < limit_) {
+        heapBytes_ += sizeof(std::string) + record_.size();
+        heap_.push_back(record_);
+        std::push_heap(heap_.begin(), heap_.end(), keyLess);
+    } else if (keyLess(record_, heap_.front())) {
+        std::pop_heap(heap_.begin(), heap_.end(), keyLess);
+        heapBytes_ = heapBytes_ - heap_.back().size() + record_.size();
+        heap_.back() = record_;
+        std::push_heap(heap_.begin(), heap_.end(), keyLess);
+    }
+
+    // limit 太大、堆放不进内存预算时改走外部排序，输出时仍只取前 limit 行
+    if (bufferManager_ && heapBytes_ > memoryBudget_) {
+        topN_ = false;
+        for (const auto &record : heap_) addEntry(record);
+        heap_.clear();
+        heapBytes_ = 0;
+    }
+}
+
+void SortOperator::open() {
+    arena_.clear();
+    entries_.clear();
+    heap_.clear();
+    heapBytes_ = 0;
+    runs_.clear();
+    heads_.clear();
+    exhausted_.clear();
+    tree_.clear();
+    cursor_ = 0;
+    produced_ = 0;
+    sequence_ = 0;
+    topN_ = limit_ != NO_LIMIT;
+
+    child_->open();
+    Tuple tuple;
+    while (child_->next(tuple)) {
+        encodeRecord(tuple, record_);
+        if (topN_) {
+            pushTopN();
+            continue;
+        }
+        addEntry(record_);
+        if (bufferManager_ && arena_.size() + entries_.size() * sizeof(SortEntry) > memoryBudget_) {
+            spillRun();
+        }
+    }
+    child_->close();
+
+    if (topN_) {
+        for (const auto &record : heap_) addEntry(record);
+        heap_.clear();
+    }
+    if (runs_.empty()) {
+        sortEntries();
+        return;
+    }
+
+    // 最后一段也写出，然后对所有有序段建败者树
+    if (!entries_.empty()) spillRun();
+    heads_.resize(runs_.size());
+    exhausted_.assign(runs_.size(), false);
+    for (size_t r = 0; r < runs_.size(); ++r) {
+        runs_[r]->rewind();
+        advanceRun(r);
+    }
+    tree_.assign(runs_.size(), 0);
+    tree_[0] = buildTree(1);
+}
+
+void SortOperator::advanceRun(size_t run) {
+    if (!runs_[run]->nextRecord(heads_[run])) {
+        exhausted_[run] = true;
+        runs_[run].reset();   // 读完即归还临时页
+    }
+}
+
+bool SortOperator::runLess(size_t a, size_t b) const {
+    if (exhausted_[a]) return false;
+    if (exhausted_[b]) return true;
+    return keyOf(heads_[a]) < keyOf(heads_[b]);
+}
+
+size_t SortOperator::buildTree(size_t node) {
+    // 结点 node 的孩子为 2node 和 2node+1，编号不小于段数 k 的结点是叶子 node - k
+    size_t k = runs_.size();
+    if (node >= k) return node - k;
+    size_t a = buildTree(2 * node);
+    size_t b = buildTree(2 * node + 1);
+    if (runLess(a, b)) {
+        tree_[node] = b;
+        return a;
+    }
+    tree_[node] = a;
+    return b;
+}
+
+void SortOperator::replay(size_t run) {
+    // 从叶子走到根，每个结点与保存的败者比较，败者留下、胜者继续向上
+    size_t winner = run;
+    for (size_t node = (run + runs_.size()) / 2; node > 0; node /= 2) {
+        if (runLess(tree_[node], winner)) std::swap(tree_[node], winner);
+    }
+    tree_[0] = winner;
+}
+
+bool SortOperator::next(Tuple &tuple) {
+    if (produced_ >= limit_) return false;
+
+    std::string_view record;
+    size_t winner = 0;
+    if (runs_.empty()) {
+        if (cursor_ >= entries_.size()) return false;
+        const SortEntry &entry = entries_[cursor_++];
+        record = std::string_view(arena_.data() + entry.offset, entry.length);
+    } else {
+        winner = tree_[0];
+        if (exhausted_[winner]) return false;
+        record = heads_[winner];
+    }
+
+    size_t tupleOffset = sizeof(uint16_t) + keyOf(record).size();
+    tuple = deserializeTuple(record.data() + tupleOffset, record.size() - tupleOffset);
+    if (!runs_.empty()) {
+        advanceRun(winner);
+        replay(winner);
+    }
+    ++produced_;
+    return true;
+}
+
+void SortOperator::close() {
+    arena_.clear();
+    entries_.clear();
+    heads_.clear();
+    exhausted_.clear();
+    tree_.clear();
+    runs_.clear();
+    cursor_ = 0;
+}
+
+} // namespace minidb
@@ -0,0 +1,173 @@
+#include "../../include/engine/SpillFile.h"
+#include "common/Exception.h"
+
+#include <cstring>
+
+namespace minidb {
+
+namespace {
+
+// 数据页中可用于记录和槽位的字节数（每条记录另占 4 字节槽位）
+constexpr size_t PAGE_CAPACITY = PAGE_SIZE - sizeof(storage::PageHeader);
+constexpr size_t SLOT_SIZE = 4;
+
+} // namespace
+
+void serializeTuple(const Tuple &tuple, std::string &out) {
+    for (const Value &value : tuple.getValues()) {
+        out.push_back(static_cast<char>(value.getType()));
+        switch (value.getType()) {
+            case TypeId::INTEGER: {
+                int32_t v = value.getAsInt();
+                out.append(reinterpret_cast<const char *>(&v), sizeof(v));
+                break;
+            }
+            case TypeId::BOOLEAN:
+                out.push_back(static_cast<char>(value.getAsBool()));
+                break;
+            case TypeId::VARCHAR: {
+                const std::string s = value.getAsString();
+                auto length = static_cast<uint16_t>(s.size());
+                out.append(reinterpret_cast<const char *>(&length), sizeof(length));
+                out.append(s);
+                break;
+            }
+            case TypeId::INVALID:
+                break;
+            default:
+                throw TypeMismatchException("Unsupported spill value type: " + std::string(getTypeName(value.getType())));
+        }
+    }
+}
+
+Tuple deserializeTuple(const char *data, size_t size) {
+    std::vector<Value> values;
+    const char *end = data + size;
+    while (data < end) {
+        auto type = static_cast<TypeId>(*data++);
+        switch (type) {
+            case TypeId::INTEGER: {
+                int32_t v;
+                std::memcpy(&v, data, sizeof(v));
+                data += sizeof(v);
+                values.emplace_back(v);
+                break;
+            }
+            case TypeId::BOOLEAN:
+                values.emplace_back(*data++ != 0);
+                break;
+            case TypeId::VARCHAR: {
+                uint16_t length;
+                std::memcpy(&length, data, sizeof(length));
+                data += sizeof(length);
+                values.emplace_back(std::string(data, length));
+                data += length;
+                break;
+            }
+            default:
+                values.emplace_back();
+                break;
+        }
+    }
+    return Tuple(std::move(values));
+}
+
+SpillFile::SpillFile(std::shared_ptr<storage::BufferManager> bufferManager)
+    : bufferManager_(std::move(bufferManager)) {}
+
+SpillFile::~SpillFile() {
+    // 临时页不再需要写回，直接丢弃缓存帧（不刷盘）后归还给磁盘空闲链表
+    for (PageID pid : pages_) {
+        try {
+            bufferManager_->discardPage(pid);
+            bufferManager_->getDiskManager()->deallocatePage(pid);
+        } catch (const std::exception &) {
+            // 析构中不抛出异常
+        }
+    }
+}
+
+void SpillFile::append(const Tuple &tuple) {
+    std::string record;
+    serializeTuple(tuple, record);
+    appendRecord(record);
+}
+
+void SpillFile::appendRecord(std::string_view record) {
+    if (record.size() + SLOT_SIZE > PAGE_CAPACITY) {
+        throw std::runtime_error("Record too large to spill: " + std::to_string(record.size()) + " bytes");
+    }
+
+    // 当前页放不下时先落盘
+    size_t used = staged_.size() + (stagedSizes_.size() + 1) * SLOT_SIZE;
+    if (used + record.size() > PAGE_CAPACITY) {
+        flush();
+    }
+    staged_ += record;
+    stagedSizes_.push_back(static_cast<uint16_t>(record.size()));
+    ++recordCount_;
+}
+
+void SpillFile::flush() {
+    if (stagedSizes_.empty()) return;
+
+    PageID pid = bufferManager_->allocatePage();
+    pages_.push_back(pid);
+    storage::WritePageGuard page = bufferManager_->fetchPageWrite(pid);
+    page->initAsDataPage();
+    page->setNextPageId(INVALID_PAGE_ID);
+
+    const char *data = staged_.data();
+    for (uint16_t size : stagedSizes_) {
+        if (!page->insertRecord(data, size)) {
+            throw std::runtime_error("Spill page overflow");
+        }
+        data += size;
+    }
+    page->setDirty(true);
+
+    staged_.clear();
+    stagedSizes_.clear();
+}
+
+void SpillFile::rewind() {
+    flush();
+    readPage_ = 0;
+    readBuffer_.clear();
+    readSizes_.clear();
+    readPos_ = 0;
+    readOffset_ = 0;
+}
+
+bool SpillFile::next(Tuple &tuple) {
+    std::string_view record;
+    if (!nextRecord(record)) return false;
+    tuple = deserializeTuple(record.data(), record.size());
+    return true;
+}
+
+bool SpillFile::nextRecord(std::string_view &record) {
+    while (readPos_ >= readSizes_.size()) {
+        if (readPage_ >= pages_.size()) {
+            return false;
+        }
+        // 整页拷出后立即释放，读取期间不长期 pin 页
+        readBuffer_.clear();
+        readSizes_.clear();
+        readPos_ = 0;
+        readOffset_ = 0;
+        storage::ReadPageGuard page = bufferManager_->fetchPageRead(pages_[readPage_++]);
+        for (uint16_t slot = 0; slot < page->getSlotCount(); ++slot) {
+            uint16_t size = 0;
+            const char *data = page->getRecordData(slot, &size);
+            if (!data) continue;
+            readBuffer_.append(data, size);
+            readSizes_.push_back(size);
+        }
+    }
+    record = std::string_view(readBuffer_.data() + readOffset_, readSizes_[readPos_]);
+    readOffset_ += readSizes_[readPos_++];
+    return true;
+}
+
+} // namespace minidb
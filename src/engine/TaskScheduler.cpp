@@ -0,0 +1,148 @@
+#include "../../include/engine/TaskScheduler.h"
+
+#include <exception>
+
+namespace minidb {
+
+TaskScheduler::TaskScheduler(size_t workers) {
+    for (size_t i = 0; i < workers; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+bool TaskScheduler::pop(size_t self, Task &task) {
+    if (self < queues_.size()) {
+        Queue &own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+    for (size_t k = 1; k <= queues_.size(); ++k) {
+        Queue &victim = *queues_[(self + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::workerLoop(size_t self) {
+    Task task;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+            if (stop_) return;
+        }
+        // 被唤醒后任务可能已被别的线程取走，取不到就回去等待
+        if (pop(self, task)) {
+            task();
+            task = nullptr;
+        }
+    }
+}
+
+void TaskScheduler::run(std::vector<Task> tasks) {
+    if (tasks.empty()) return;
+
+    // 同一批任务的完成计数和第一个异常
+    struct Batch {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining;
+        std::exception_ptr error;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->remaining = tasks.size();
+
+    auto wrap = [batch](Task task) {
+        return [batch, task = std::move(task)] {
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            if (error && !batch->error) batch->error = error;
+            if (--batch->remaining == 0) batch->done.notify_all();
+        };
+    };
+
+    if (queues_.empty()) {
+        for (auto &task : tasks) wrap(std::move(task))();
+    } else {
+        // 轮流放入各线程的队列，空闲线程会从别的队列窃取
+        size_t start = nextQueue_.fetch_add(1);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            Queue &queue = *queues_[(start + i) % queues_.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(wrap(std::move(tasks[i])));
+            ++queued_;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        wake_.notify_all();
+
+        // 调用线程也取任务执行（可能是别的批次的任务），取不到时等本批次剩余的任务完成
+        Task task;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                if (batch->remaining == 0) break;
+            }
+            if (pop(queues_.size(), task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(batch->mutex);
+            batch->done.wait(lock, [&] { return batch->remaining == 0; });
+            break;
+        }
+    }
+
+    if (batch->error) std::rethrow_exception(batch->error);
+}
+
+void TaskScheduler::submit(Task task) {
+    if (queues_.empty()) {
+        task();
+        return;
+    }
+    {
+        Queue &queue = *queues_[nextQueue_.fetch_add(1) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+        ++queued_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    wake_.notify_one();
+}
+
+} // namespace minidb
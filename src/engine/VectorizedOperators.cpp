@@ -0,0 +1,273 @@
+#include "../../include/engine/VectorizedOperators.h"
+#include "common/Exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace minidb {
+
+namespace {
+
+/**
+ * 在 int32_t 列上按比较结果生成选择向量
+ * 无论是否命中都写 out[n]，只用比较结果推进 n，循环体没有分支，编译器可以自动向量化。
+ * sel 为空表示输入全部有效；out 可以与 sel 指向同一数组（n 不会超过读位置）。
+ */
+template <typename Cmp>
+size_t selectInts(const int32_t *data, size_t count, const uint16_t *sel, int32_t literal,
+                  uint16_t *out, Cmp cmp) {
+    size_t n = 0;
+    if (sel == nullptr) {
+        for (size_t i = 0; i < count; ++i) {
+            out[n] = static_cast<uint16_t>(i);
+            n += cmp(data[i], literal);
+        }
+    } else {
+        for (size_t k = 0; k < count; ++k) {
+            uint16_t i = sel[k];
+            out[n] = i;
+            n += cmp(data[i], literal);
+        }
+    }
+    return n;
+}
+
+template <typename Cmp>
+size_t selectStrings(const std::vector<std::string> &data, size_t count, const uint16_t *sel,
+                     const std::string &literal, uint16_t *out, Cmp cmp) {
+    size_t n = 0;
+    for (size_t k = 0; k < count; ++k) {
+        uint16_t i = sel ? sel[k] : static_cast<uint16_t>(k);
+        out[n] = i;
+        n += cmp(data[i], literal);
+    }
+    return n;
+}
+
+} // namespace
+
+// ==================== ColumnVector / DataChunk ====================
+
+void ColumnVector::reset(TypeId columnType) {
+    type = columnType;
+    if (type == TypeId::VARCHAR) {
+        strings.resize(VECTOR_SIZE);
+    } else {
+        ints.resize(VECTOR_SIZE);
+    }
+}
+
+Value ColumnVector::getValue(size_t row) const {
+    switch (type) {
+        case TypeId::INTEGER: return Value(ints[row]);
+        case TypeId::BOOLEAN: return Value(ints[row] != 0);
+        case TypeId::VARCHAR: return Value(strings[row]);
+        default:
+            throw TypeMismatchException("Unsupported column vector type: " + std::string(getTypeName(type)));
+    }
+}
+
+void DataChunk::reset(const std::vector<TypeId> &types) {
+    columns.resize(types.size());
+    for (size_t i = 0; i < types.size(); ++i) {
+        columns[i].reset(types[i]);
+    }
+    selection.resize(VECTOR_SIZE);
+    size = 0;
+    selectedCount = 0;
+    hasSelection = false;
+}
+
+size_t VectorOperator::getColumnIndex(const std::string &name) const {
+    auto it = std::find(columnNames_.begin(), columnNames_.end(), name);
+    if (it == columnNames_.end()) {
+        throw std::runtime_error("Unknown column: " + name);
+    }
+    return static_cast<size_t>(it - columnNames_.begin());
+}
+
+// ==================== VectorSeqScan ====================
+
+VectorSeqScanOperator::VectorSeqScanOperator(std::shared_ptr<storage::BufferManager> bufferManager,
+                                             const TableInfo *tableInfo, std::vector<size_t> columns)
+    : bufferManager_(std::move(bufferManager)), tableInfo_(tableInfo) {
+    const Schema &schema = tableInfo_->get_schema();
+    const RowCodec &codec = tableInfo_->get_codec();
+    if (columns.empty()) {
+        for (uint32_t i = 0; i < schema.get_column_count(); ++i) {
+            columns.push_back(i);
+        }
+    }
+    for (size_t i : columns) {
+        fields_.push_back(codec.field(i));
+        columnNames_.push_back(schema.get_column(static_cast<uint32_t>(i)).get_name());
+        columnTypes_.push_back(codec.field(i).type);
+    }
+}
+
+VectorSeqScanOperator::VectorSeqScanOperator(std::shared_ptr<storage::BufferManager> bufferManager,
+                                             const TableInfo *tableInfo, std::vector<size_t> columns,
+                                             std::vector<PageID> pages)
+    : VectorSeqScanOperator(std::move(bufferManager), tableInfo, std::move(columns)) {
+    usePages_ = true;
+    pages_ = std::move(pages);
+}
+
+PageID VectorSeqScanOperator::nextPageId() const {
+    if (!usePages_) return page_->getNextPageId();
+    return pagePos_ < pages_.size() ? pages_[pagePos_] : INVALID_PAGE_ID;
+}
+
+void VectorSeqScanOperator::open() {
+    if (usePages_) {
+        pagePos_ = 0;
+        pageId_ = pages_.empty() ? INVALID_PAGE_ID : pages_[pagePos_++];
+    } else {
+        pageId_ = tableInfo_->getFirstPageID();
+    }
+    slot_ = 0;
+    page_ = pageId_ == INVALID_PAGE_ID ? storage::ReadPageGuard() : bufferManager_->fetchPageRead(pageId_);
+}
+
+bool VectorSeqScanOperator::nextBatch(DataChunk &chunk) {
+    chunk.reset(columnTypes_);
+    const char *records[VECTOR_SIZE];
+
+    while (chunk.size < VECTOR_SIZE && pageId_ != INVALID_PAGE_ID) {
+        // 先收集本页内的记录地址，再按列逐个解码（列内循环连续、无虚调用）
+        size_t base = chunk.size;
+        size_t n = 0;
+        uint16_t slotCount = page_->getSlotCount();
+        while (slot_ < slotCount && base + n < VECTOR_SIZE) {
+            const char *record = page_->getRecordData(slot_++);
+            if (record) records[n++] = record;
+        }
+
+        for (size_t c = 0; c < fields_.size(); ++c) {
+            const RowCodec::Field &field = fields_[c];
+            ColumnVector &vec = chunk.columns[c];
+            if (field.type == TypeId::INTEGER) {
+                int32_t *out = vec.ints.data() + base;
+                for (size_t r = 0; r < n; ++r) {
+                    std::memcpy(&out[r], records[r] + field.offset, sizeof(int32_t));
+                }
+            } else if (field.type == TypeId::BOOLEAN) {
+                for (size_t r = 0; r < n; ++r) {
+                    vec.ints[base + r] = records[r][field.offset] != 0;
+                }
+            } else {
+                for (size_t r = 0; r < n; ++r) {
+                    const char *data = records[r] + field.offset;
+                    vec.strings[base + r].assign(data, strnlen(data, field.width));
+                }
+            }
+        }
+        chunk.size += n;
+
+        // 当前页读完，先释放再移动到下一页
+        if (slot_ >= slotCount) {
+            PageID next = nextPageId();
+            if (usePages_ && next != INVALID_PAGE_ID) ++pagePos_;
+            page_.release();
+            pageId_ = next;
+            slot_ = 0;
+            if (pageId_ != INVALID_PAGE_ID) {
+                page_ = bufferManager_->fetchPageRead(pageId_);
+            }
+        }
+    }
+    return chunk.size > 0;
+}
+
+void VectorSeqScanOperator::close() {
+    page_.release();
+    pageId_ = INVALID_PAGE_ID;
+}
+
+// ==================== VectorFilter ====================
+
+VectorFilterOperator::VectorFilterOperator(VectorOperatorPtr child, size_t column, CompareOp op, Value literal)
+    : child_(std::move(child)), column_(column), op_(op), literal_(std::move(literal)) {
+    columnNames_ = child_->getColumnNames();
+    columnTypes_ = child_->getColumnTypes();
+
+    if (literal_.getType() != columnTypes_.at(column_)) {
+        throw TypeMismatchException("Filter literal type does not match column '" + columnNames_[column_] + "'");
+    }
+}
+
+void VectorFilterOperator::open() { child_->open(); }
+
+bool VectorFilterOperator::nextBatch(DataChunk &chunk) {
+    if (!child_->nextBatch(chunk)) return false;
+
+    const ColumnVector &vec = chunk.columns[column_];
+    const uint16_t *sel = chunk.hasSelection ? chunk.selection.data() : nullptr;
+    size_t count = chunk.activeCount();
+    uint16_t *out = chunk.selection.data();
+
+    auto run = [&](auto cmp) {
+        if (vec.type == TypeId::VARCHAR) {
+            return selectStrings(vec.strings, count, sel, literal_.getAsString(), out, cmp);
+        }
+        int32_t literal = vec.type == TypeId::BOOLEAN ? literal_.getAsBool() : literal_.getAsInt();
+        return selectInts(vec.ints.data(), count, sel, literal, out, cmp);
+    };
+
+    switch (op_) {
+        case CompareOp::EQ: chunk.selectedCount = run(std::equal_to<>()); break;
+        case CompareOp::NE: chunk.selectedCount = run(std::not_equal_to<>()); break;
+        case CompareOp::LT: chunk.selectedCount = run(std::less<>()); break;
+        case CompareOp::LE: chunk.selectedCount = run(std::less_equal<>()); break;
+        case CompareOp::GT: chunk.selectedCount = run(std::greater<>()); break;
+        case CompareOp::GE: chunk.selectedCount = run(std::greater_equal<>()); break;
+    }
+    chunk.hasSelection = true;
+    return true;
+}
+
+void VectorFilterOperator::close() { child_->close(); }
+
+// ==================== VectorProject ====================
+
+VectorProjectOperator::VectorProjectOperator(VectorOperatorPtr child, const std::vector<std::string> &columns)
+    : child_(std::move(child)) {
+    bool all = columns.empty() || (columns.size() == 1 && columns[0] == "*");
+    size_t count = all ? child_->getColumnNames().size() : columns.size();
+    for (size_t i = 0; i < count; ++i) {
+        size_t pos = all ? i : child_->getColumnIndex(columns[i]);
+        positions_.push_back(pos);
+        columnNames_.push_back(child_->getColumnNames()[pos]);
+        columnTypes_.push_back(child_->getColumnTypes()[pos]);
+    }
+}
+
+void VectorProjectOperator::open() { child_->open(); }
+
+bool VectorProjectOperator::nextBatch(DataChunk &chunk) {
+    if (!child_->nextBatch(input_)) return false;
+
+    // 每个输入列第一次被引用时交换过去，重复引用的列才拷贝
+    std::vector<bool> taken(input_.columns.size(), false);
+    chunk.columns.resize(positions_.size());
+    for (size_t i = 0; i < positions_.size(); ++i) {
+        size_t pos = positions_[i];
+        if (!taken[pos]) {
+            std::swap(chunk.columns[i], input_.columns[pos]);
+            taken[pos] = true;
+        } else {
+            auto first = std::find(positions_.begin(), positions_.end(), pos) - positions_.begin();
+            chunk.columns[i] = chunk.columns[first];
+        }
+    }
+    chunk.size = input_.size;
+    chunk.selectedCount = input_.selectedCount;
+    chunk.hasSelection = input_.hasSelection;
+    std::swap(chunk.selection, input_.selection);
+    return true;
+}
+
+void VectorProjectOperator::close() { child_->close(); }
+
+} // namespace minidb
@@ -3,6 +3,9 @@
 #include <functional>
 
 #include "engine/bPlusTree/bplus_tree_page.h"
+#include "common/Exception.h"
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <iostream>
 
@@ -11,71 +14,89 @@ namespace engine {
 
 BPlusTree::BPlusTree(std::shared_ptr<storage::Pager> pager,
                      PageID root_page_id,
-                     TypeId key_type)
-    : pager_(pager), root_page_id_(root_page_id), key_type_(key_type) {
+                     TypeId key_type,
+                     uint16_t leaf_max_size,
+                     uint16_t internal_max_size)
+    : pager_(pager), root_page_id_(root_page_id), key_type_(key_type),
+      leaf_max_size_(leaf_max_size), internal_max_size_(internal_max_size) {
+    // 空树不预先分配根节点，第一次插入时再创建
     if (!pager_->isValidPage(root_page_id_)) {
-        root_page_id_ = create_new_leaf_node();
+        root_page_id_ = INVALID_PAGE_ID;
     }
 }
 
 bool BPlusTree::insert(const Value& key, const RID& rid) {
     validate_key_type(key);
-    Value promoted_key;
-    PageID new_child_page_id;
-    bool need_split = false;
 
-    return insert_recursive(root_page_id_, key, rid, &promoted_key, &new_child_page_id, &need_split);
+    if (is_empty()) {
+        WriteNode root = create_new_leaf_node();
+        root_page_id_ = root.page_id();
+        return root->insert_leaf_pair(key, rid);
+    }
+
+    SplitResult result;
+    bool inserted = insert_recursive(root_page_id_, key, rid, &result);
+    if (result.split) {
+        create_new_root(root_page_id_, result.key, result.right_page_id);
+    }
+    return inserted;
 }
 
 RID BPlusTree::search(const Value& key) const {
-    PageID leaf_page_id = find_leaf_page(key);
-    auto leaf_page = get_node(leaf_page_id);
+    validate_key_type(key);
+    if (is_empty()) return RID::invalid();
 
-    int index = leaf_page->find_key_index(key);
-    if (index >= 0 && leaf_page->is_leaf()) {
-        return leaf_page->get_rid_at(index);
+    ReadNode leaf = read_node(find_leaf_page(key));
+    int index = leaf->find_key_index(key);
+    if (index >= 0) {
+        return leaf->get_rid_at(index);
     }
-
     return RID::invalid();
 }
 
 std::vector<RID> BPlusTree::range_search(const Value& begin, const Value& end) const {
     std::vector<RID> results;
-    PageID leaf_page_id = find_leaf_page(begin);
+    for (IndexIterator it = scan(KeyBound::closed(begin), KeyBound::closed(end)); !it.is_end(); ++it) {
+        results.push_back(it.rid());
+    }
+    return results;
+}
 
-    while (leaf_page_id != -1) {
-        auto leaf_page = get_node(leaf_page_id);
-        int start_index = std::max(0, leaf_page->find_key_index(begin));
-        for (int i = start_index; i < leaf_page->get_key_count(); ++i) {
-            Value key = leaf_page->get_key_at(i);
-            if (key > end) return results;
+IndexIterator BPlusTree::scan(const KeyBound& lower, const KeyBound& upper,
+                              ScanDirection direction) const {
+    if (lower.key) validate_key_type(*lower.key);
+    if (upper.key) validate_key_type(*upper.key);
+    if (is_empty()) return IndexIterator();
 
-            if (key >= begin) {
-                results.push_back(leaf_page->get_rid_at(i));
-            }
-        }
-
-        leaf_page_id = leaf_page->get_next_page_id();
+    PageID start_leaf;
+    if (direction == ScanDirection::FORWARD) {
+        start_leaf = lower.is_unbounded() ? find_first_leaf_page() : find_leaf_page(*lower.key);
+    } else {
+        start_leaf = upper.is_unbounded() ? find_last_leaf_page() : find_leaf_page(*upper.key);
     }
-    return results;
+    return IndexIterator(pager_, start_leaf, lower, upper, direction);
 }
 
 bool BPlusTree::remove(const Value& key) {
     validate_key_type(key);
-    bool need_merge = false;
+    if (is_empty()) return false;
 
-    return remove_recursive(root_page_id_, key, &need_merge);
+    bool removed = remove_recursive(root_page_id_, key);
+    if (removed) {
+        collapse_root();
+    }
+    return removed;
 }
 
 uint32_t BPlusTree::get_height() const {
     uint32_t height = 0;
     PageID page_id = root_page_id_;
 
-    while (page_id != -1) {
-        auto page = get_node(page_id);
+    while (page_id != INVALID_PAGE_ID) {
+        ReadNode node = read_node(page_id);
         ++height;
-        if (page->is_leaf()) break;
-        page_id = page->get_child_page_id_at(0);
+        if (node->is_leaf()) break;
+        page_id = node->get_child_page_id_at(0);
     }
     return height;
 }
@@ -91,33 +112,34 @@ uint32_t BPlusTree::get_node_count() const {
     std::function<void(PageID, int)> dfs = [&](PageID page_id, int depth) {
         if (page_id == INVALID_PAGE_ID) return;
 
-        auto page = get_node(page_id);
+        ReadNode node = read_node(page_id);
         std::string indent(depth * 4, ' '); // 每层4个空格
 
         std::cout << indent
                   << "|-- Node(PageID=" << page_id << ", "
-                  << (page->is_leaf() ? "Leaf" : "Internal")
-                  << ", Keys=" << page->get_key_count()
+                  << (node->is_leaf() ? "Leaf" : "Internal")
+                  << ", Keys=" << node->get_key_count()
                   << ")\n";
 
         // 打印 keys 和对应值
-        for (int i = 0; i < page->get_key_count(); i++) {
-            std::cout << indent << "    Key[" << i << "]: " << page->get_key_at(i).toString();
-            if (page->is_leaf()) {
-                std::cout << " -> RID: " << page->get_rid_at(i).toString();
+        for (int i = 0; i < node->get_key_count(); i++) {
+            std::cout << indent << "    Key[" << i << "]: " << node->get_key_at(i).toString();
+            if (node->is_leaf()) {
+                std::cout << " -> RID: " << node->get_rid_at(i).toString();
             } else {
-                std::cout << " -> ChildPage: " << page->get_child_page_id_at(i);
+                std::cout << " -> ChildPage: " << node->get_child_page_id_at(i + 1);
             }
             std::cout << "\n";
         }
 
-        if (!page->is_leaf()) {
-            // 递归打印最后一个子节点
-            PageID last_child = page->get_child_page_id_at(page->get_key_count());
-            for (int i = 0; i <= page->get_key_count(); i++) {
-                PageID child_id = (i == page->get_key_count())
-                                    ? last_child
-                                    : page->get_child_page_id_at(i);
+        if (!node->is_leaf()) {
+            // 先收集子节点再释放当前页，避免深度递归时持有整条路径的 pin
+            std::vector<PageID> children;
+            for (int i = 0; i <= node->get_key_count(); i++) {
+                children.push_back(node->get_child_page_id_at(i));
+            }
+            node.guard.release();
+            for (PageID child_id : children) {
                 dfs(child_id, depth + 1);
             }
         }
@@ -147,231 +169,391 @@ Value BPlusTree::get_min_value_for_type(TypeId type) const {
 
 void BPlusTree::validate_key_type(const Value& key) const {
     if (key.getType() != key_type_) {
-        throw std::invalid_argument("Key type mismatch");
+        throw TypeMismatchException("B+ tree key expects " + std::string(getTypeName(key_type_)) +
+                                    ", got " + std::string(getTypeName(key.getType())));
     }
 }
 
 
 
-    std::unique_ptr<BPlusTreePage> BPlusTree::get_node(PageID page_id) const {
+BPlusTree::ReadNode BPlusTree::read_node(PageID page_id) const {
     if (page_id == INVALID_PAGE_ID) {
         throw std::runtime_error("B+Tree tried to access INVALID_PAGE_ID (-1)!");
     }
-    auto page = pager_->getPage(page_id);
-    return std::make_unique<BPlusTreePage>(page);
+    return ReadNode(pager_->fetchPageRead(page_id));
 }
 
+BPlusTree::WriteNode BPlusTree::write_node(PageID page_id) {
+    if (page_id == INVALID_PAGE_ID) {
+        throw std::runtime_error("B+Tree tried to access INVALID_PAGE_ID (-1)!");
+    }
+    return WriteNode(pager_->fetchPageWrite(page_id));
+}
 
-void BPlusTree::release_node(PageID page_id, bool is_dirty) const {
-    pager_->releasePage(page_id, is_dirty);
+int BPlusTree::child_index_for(const BPlusTreePage& node, const Value& key) {
+    // 分隔键 key[i] 是 child[i+1] 的最小键，相等时进入右侧子树
+    int index = node.find_key_index(key);
+    return index >= 0 ? index + 1 : -index - 1;
 }
 
 PageID BPlusTree::find_leaf_page(const Value& key) const {
     PageID page_id = root_page_id_;
     while (true) {
-        auto page = get_node(page_id);
-
-        if (page->is_leaf()) return page_id;
-        int index = page->find_key_index(key);
-
-        if (index < 0) index = -index - 1; // If key not found, select first greater key
-        page_id = page->get_child_page_id_at(index);
+        ReadNode node = read_node(page_id);
+        if (node->is_leaf()) return page_id;
+        page_id = node->get_child_page_id_at(child_index_for(node.page, key));
     }
 }
 
 PageID BPlusTree::find_first_leaf_page() const {
     PageID page_id = root_page_id_;
-    while (true) {
-        auto page = get_node(page_id);
-        if (page->is_leaf()) return page_id;
-        page_id = page->get_child_page_id_at(0);
+    while (page_id != INVALID_PAGE_ID) {
+        ReadNode node = read_node(page_id);
+        if (node->is_leaf()) return page_id;
+        page_id = node->get_child_page_id_at(0);
+    }
+    return INVALID_PAGE_ID;
+}
+
+PageID BPlusTree::find_last_leaf_page() const {
+    PageID page_id = root_page_id_;
+    while (page_id != INVALID_PAGE_ID) {
+        ReadNode node = read_node(page_id);
+        if (node->is_leaf()) return page_id;
+        page_id = node->get_child_page_id_at(node->get_key_count());
     }
+    return INVALID_PAGE_ID;
 }
 
 bool BPlusTree::insert_recursive(PageID current_page_id, const Value& key,
-                                 const RID& rid, Value* promoted_key,
-                                 PageID* new_child_page_id, bool* need_split) {
-    auto current_page = get_node(current_page_id);
-    if (current_page->is_leaf()) {
-        if (current_page->insert_leaf_pair(key, rid)) {
-            release_node(current_page_id, true);
-            return true;
+                                 const RID& rid, SplitResult* result) {
+    WriteNode node = write_node(current_page_id);
+
+    if (node->is_leaf()) {
+        int index = node->find_key_index(key);
+        if (index >= 0) {
+            // 键已存在：不覆盖，由调用方决定如何处理
+            return false;
         }
-        return split_leaf_node(current_page_id, key, rid, promoted_key, new_child_page_id);
-    } else {
-        int index = current_page->find_key_index(key);
-        if (index < 0) index = -index - 1;
+        if (node->has_room_for(key)) {
+            return node->insert_leaf_pair(key, rid);
+        }
+        split_leaf_node(node, key, rid, result);
+        return true;
+    }
 
-        PageID child_page_id = current_page->get_child_page_id_at(index);
-        bool result = insert_recursive(child_page_id, key, rid, promoted_key, new_child_page_id, need_split);
+    SplitResult child_result;
+    PageID child_page_id = node->get_child_page_id_at(child_index_for(node.page, key));
+    bool inserted = insert_recursive(child_page_id, key, rid, &child_result);
 
-        if (*need_split) {
-            *need_split = false;
-            if (current_page->insert_internal_pair(*promoted_key, *new_child_page_id)) {
-                release_node(current_page_id, true);
-            } else {
-                return split_internal_node(current_page_id, *promoted_key, *new_child_page_id, promoted_key, new_child_page_id);
-            }
+    if (child_result.split) {
+        if (node->has_room_for(child_result.key)) {
+            node->insert_internal_pair(child_result.key, child_result.right_page_id);
+        } else {
+            split_internal_node(node, child_result.key, child_result.right_page_id, result);
         }
-        return result;
     }
+    return inserted;
 }
 
-    bool BPlusTree::split_leaf_node(PageID leaf_page_id, const Value& new_key, const RID& new_rid,
-                                    Value* promoted_key, PageID* new_page_id) {
-    auto leaf_page = get_node(leaf_page_id);
-    *new_page_id = create_new_leaf_node();
-    auto new_leaf_page = get_node(*new_page_id);
+void BPlusTree::split_leaf_node(WriteNode& leaf, const Value& new_key, const RID& new_rid,
+                                SplitResult* result) {
+    // 收集原有键值对并按序放入新键
+    int total_keys = leaf->get_key_count();
+    std::vector<std::pair<Value, RID>> entries;
+    entries.reserve(total_keys + 1);
+    for (int i = 0; i < total_keys; ++i) {
+        entries.emplace_back(leaf->get_key_at(i), leaf->get_rid_at(i));
+    }
+    auto pos = std::lower_bound(entries.begin(), entries.end(), new_key,
+                                [](const std::pair<Value, RID>& e, const Value& k) { return e.first < k; });
+    entries.insert(pos, {new_key, new_rid});
+
+    std::vector<size_t> sizes;
+    sizes.reserve(entries.size());
+    for (const auto& entry : entries) {
+        sizes.push_back(leaf->get_entry_size(entry.first));
+    }
+    int left_count = choose_split_point(sizes, leaf->get_max_capacity(), 0);
+
+    WriteNode new_leaf = create_new_leaf_node();
+    leaf->assign_leaf_entries({entries.begin(), entries.begin() + left_count});
+    new_leaf->assign_leaf_entries({entries.begin() + left_count, entries.end()});
+
+    // 维护双向叶子链：leaf <-> new_leaf <-> old_next
+    PageID old_next = leaf->get_next_page_id();
+    new_leaf->set_next_page_id(old_next);
+    new_leaf->set_prev_page_id(leaf.page_id());
+    leaf->set_next_page_id(new_leaf.page_id());
+    if (old_next != INVALID_PAGE_ID) {
+        WriteNode next_leaf = write_node(old_next);
+        next_leaf->set_prev_page_id(new_leaf.page_id());
+    }
 
-    int total_keys = leaf_page->get_key_count();
-    int split_index = total_keys / 2;
+    result->split = true;
+    result->key = key_type_ == TypeId::VARCHAR
+                      ? shortest_separator(entries[left_count - 1].first, entries[left_count].first)
+                      : entries[left_count].first;
+    result->right_page_id = new_leaf.page_id();
+}
 
-    // 复制到新节点
-    for (int i = split_index; i < total_keys; ++i) {
-        Value key = leaf_page->get_key_at(i);
-        RID rid = leaf_page->get_rid_at(i);
-        new_leaf_page->insert_leaf_pair(key, rid);
+void BPlusTree::split_internal_node(WriteNode& internal, const Value& new_key, PageID new_child_id,
+                                    SplitResult* result) {
+    int total_keys = internal->get_key_count();
+    std::vector<Value> keys;
+    std::vector<PageID> children;
+    keys.reserve(total_keys + 1);
+    children.reserve(total_keys + 2);
+    for (int i = 0; i < total_keys; ++i) {
+        keys.push_back(internal->get_key_at(i));
     }
-
-    // 清理原节点多余部分
-    while (leaf_page->get_key_count() > split_index) {
-        leaf_page->remove_leaf_pair(split_index);
+    for (int i = 0; i <= total_keys; ++i) {
+        children.push_back(internal->get_child_page_id_at(i));
     }
 
-    new_leaf_page->set_next_page_id(leaf_page->get_next_page_id());
-    leaf_page->set_next_page_id(*new_page_id);
-
-    *promoted_key = new_leaf_page->get_key_at(0);
+    // 新键放在第一个更大的键之前，其右子节点紧随其后
+    int insert_pos = static_cast<int>(std::lower_bound(keys.begin(), keys.end(), new_key) - keys.begin());
+    keys.insert(keys.begin() + insert_pos, new_key);
+    children.insert(children.begin() + insert_pos + 1, new_child_id);
 
-    if (new_key < *promoted_key) {
-        leaf_page->insert_leaf_pair(new_key, new_rid);
-    } else {
-        new_leaf_page->insert_leaf_pair(new_key, new_rid);
+    // 中间键上推，不保留在任何一侧
+    std::vector<size_t> sizes;
+    sizes.reserve(keys.size());
+    for (const auto& key : keys) {
+        sizes.push_back(internal->get_entry_size(key));
     }
+    int mid = choose_split_point(sizes, internal->get_max_capacity(), 1);
 
-    release_node(leaf_page_id, true);
-    release_node(*new_page_id, true);
-    return true;
-}
+    WriteNode new_internal = create_new_internal_node();
+    internal->assign_internal_entries({keys.begin(), keys.begin() + mid},
+                                      {children.begin(), children.begin() + mid + 1});
+    new_internal->assign_internal_entries({keys.begin() + mid + 1, keys.end()},
+                                          {children.begin() + mid + 1, children.end()});
 
+    result->split = true;
+    result->key = keys[mid];
+    result->right_page_id = new_internal.page_id();
+}
 
-bool BPlusTree::split_internal_node(PageID internal_page_id, const Value& new_key, PageID new_child_id,
-                                    Value* promoted_key, PageID* new_page_id) {
-    auto internal_page = get_node(internal_page_id);
-    *new_page_id = create_new_internal_node();
-    auto new_internal_page = get_node(*new_page_id);
-
-    int total_keys = internal_page->get_key_count();
-    int split_index = (total_keys / 2);
+int BPlusTree::choose_split_point(const std::vector<size_t>& sizes, size_t max_count, size_t promoted) {
+    // 左侧取到累计字节数过半为止；再限制两侧键数都不超过节点上限
+    size_t total = 0;
+    for (size_t size : sizes) total += size;
 
-    // 移动一半的键到新页面
-    for (int i = split_index + 1; i < total_keys; ++i) {
-        Value key = internal_page->get_key_at(i);
-        PageID child_id = internal_page->get_child_page_id_at(i);
-        new_internal_page->insert_internal_pair(key, child_id);
+    size_t left = 0, left_bytes = 0;
+    while (left < sizes.size() && (left_bytes + sizes[left]) * 2 <= total) {
+        left_bytes += sizes[left++];
+    }
+    // 越过中线的那个条目放在更接近均分的一侧；叶子平局时归左
+    if (left < sizes.size()) {
+        size_t over = (left_bytes + sizes[left]) * 2 - total;
+        size_t under = total - left_bytes * 2;
+        if (over < under || (over == under && promoted == 0)) ++left;
     }
 
-    *promoted_key = internal_page->get_key_at(split_index);
-    new_internal_page->set_child_page_id_at(0, internal_page->get_child_page_id_at(split_index + 1));
+    size_t count = sizes.size();
+    size_t lowest = count - promoted > max_count ? count - promoted - max_count : 1;
+    size_t highest = std::min(max_count, count - promoted - 1);
+    left = std::clamp(left, std::max<size_t>(lowest, 1), std::max<size_t>(highest, 1));
+    return static_cast<int>(left);
+}
 
-    internal_page->set_key_count(split_index);
-    if (new_key < *promoted_key) {
-        internal_page->insert_internal_pair(new_key, new_child_id);
-    } else {
-        new_internal_page->insert_internal_pair(new_key, new_child_id);
+Value BPlusTree::shortest_separator(const Value& left_max, const Value& right_min) {
+    // 取 right_min 中第一个与 left_max 不同的字节为止的前缀，
+    // 满足 left_max < sep <= right_min，分隔键越短内部节点扇出越大
+    const std::string left = left_max.getAsString();
+    const std::string right = right_min.getAsString();
+    size_t common = 0;
+    while (common < left.size() && common < right.size() && left[common] == right[common]) {
+        ++common;
     }
+    return Value(right.substr(0, common + 1));
+}
 
-    release_node(internal_page_id, true);
-    release_node(*new_page_id, true);
-    return true;
+void BPlusTree::create_new_root(PageID left_child_id, const Value& key, PageID right_child_id) {
+    WriteNode root = create_new_internal_node();
+
+    root->set_child_page_id_at(0, left_child_id);
+    root->insert_internal_pair(key, right_child_id);
+    root_page_id_ = root.page_id();
 }
 
-bool BPlusTree::create_new_root(PageID left_child_id, const Value& key, PageID right_child_id) {
-    root_page_id_ = create_new_internal_node();
-    auto root_page = get_node(root_page_id_);
+bool BPlusTree::remove_recursive(PageID current_page_id, const Value& key) {
+    WriteNode node = write_node(current_page_id);
 
-    root_page->insert_internal_pair(key, right_child_id);
-    root_page->set_child_page_id_at(0, left_child_id);
+    if (node->is_leaf()) {
+        int index = node->find_key_index(key);
+        if (index < 0) return false;
+        return node->remove_leaf_pair(index);
+    }
 
-    release_node(root_page_id_, true);
-    return true;
+    int child_index = child_index_for(node.page, key);
+    bool removed = remove_recursive(node->get_child_page_id_at(child_index), key);
+    if (removed) {
+        handle_underflow(node, child_index);
+    }
+    return removed;
 }
 
-bool BPlusTree::remove_recursive(PageID current_page_id, const Value& key, bool* need_merge) {
-    auto current_page = get_node(current_page_id);
-    if (current_page->is_leaf()) {
-        if (current_page->remove_leaf_pair(current_page->find_key_index(key))) {
-            release_node(current_page_id, true);
-            *need_merge = current_page->is_underflow();
-            return true;
+void BPlusTree::handle_underflow(WriteNode& parent, int child_index) {
+    WriteNode child = write_node(parent->get_child_page_id_at(child_index));
+    if (!child->is_underflow() || parent->get_key_count() == 0) return;
+
+    // 优先与左兄弟配对，最左子节点与右兄弟配对；分隔键下标为左节点的下标
+    int separator_index = child_index > 0 ? child_index - 1 : child_index;
+    if (child_index > 0) {
+        WriteNode left = write_node(parent->get_child_page_id_at(child_index - 1));
+        if (child->is_leaf()) {
+            rebalance_leaves(parent, separator_index, left, child);
+        } else {
+            rebalance_internals(parent, separator_index, left, child);
         }
-        return false;
     } else {
-        int index = current_page->find_key_index(key);
-        if (index < 0) index = -index - 1;
+        WriteNode right = write_node(parent->get_child_page_id_at(child_index + 1));
+        if (child->is_leaf()) {
+            rebalance_leaves(parent, separator_index, child, right);
+        } else {
+            rebalance_internals(parent, separator_index, child, right);
+        }
+    }
+}
 
-        PageID child_page_id = current_page->get_child_page_id_at(index);
-        bool result = remove_recursive(child_page_id, key, need_merge);
+void BPlusTree::rebalance_leaves(WriteNode& parent, int separator_index, WriteNode& left, WriteNode& right) {
+    std::vector<std::pair<Value, RID>> entries;
+    entries.reserve(left->get_key_count() + right->get_key_count());
+    for (int i = 0; i < left->get_key_count(); ++i) {
+        entries.emplace_back(left->get_key_at(i), left->get_rid_at(i));
+    }
+    for (int i = 0; i < right->get_key_count(); ++i) {
+        entries.emplace_back(right->get_key_at(i), right->get_rid_at(i));
+    }
 
-        if (*need_merge) {
-            *need_merge = false;
-            handle_underflow(current_page_id, child_page_id, index);
+    if (left->fits_leaf_entries(entries)) {
+        // 合并：右节点并入左节点，从叶子链和父节点中摘除后释放
+        left->assign_leaf_entries(entries);
+        PageID next = right->get_next_page_id();
+        left->set_next_page_id(next);
+        if (next != INVALID_PAGE_ID) {
+            WriteNode next_leaf = write_node(next);
+            next_leaf->set_prev_page_id(left.page_id());
         }
-        return result;
+        parent->remove_internal_pair(separator_index);
+        free_node(std::move(right));
+        return;
+    }
+
+    // 重新分配：两侧按字节均分，并更新父节点中的分隔键
+    std::vector<size_t> sizes;
+    sizes.reserve(entries.size());
+    for (const auto& entry : entries) {
+        sizes.push_back(left->get_entry_size(entry.first));
     }
+    int left_count = choose_split_point(sizes, left->get_max_capacity(), 0);
+    Value separator = key_type_ == TypeId::VARCHAR
+                          ? shortest_separator(entries[left_count - 1].first, entries[left_count].first)
+                          : entries[left_count].first;
+    if (!separator_fits(parent.page, separator_index, separator)) return;
+
+    left->assign_leaf_entries({entries.begin(), entries.begin() + left_count});
+    right->assign_leaf_entries({entries.begin() + left_count, entries.end()});
+    parent->set_key_at(separator_index, separator);
 }
 
-bool BPlusTree::remove_from_leaf(PageID leaf_page_id, const Value& key) {
-    auto leaf_page = get_node(leaf_page_id);
-    if (leaf_page->remove_leaf_pair(leaf_page->find_key_index(key))) {
-        release_node(leaf_page_id, true);
-        return leaf_page->is_underflow();
+void BPlusTree::rebalance_internals(WriteNode& parent, int separator_index, WriteNode& left, WriteNode& right) {
+    // 父节点中的分隔键下沉到两节点之间
+    std::vector<Value> keys;
+    std::vector<PageID> children;
+    keys.reserve(left->get_key_count() + right->get_key_count() + 1);
+    children.reserve(left->get_key_count() + right->get_key_count() + 2);
+    for (int i = 0; i < left->get_key_count(); ++i) {
+        keys.push_back(left->get_key_at(i));
+    }
+    for (int i = 0; i <= left->get_key_count(); ++i) {
+        children.push_back(left->get_child_page_id_at(i));
+    }
+    keys.push_back(parent->get_key_at(separator_index));
+    for (int i = 0; i < right->get_key_count(); ++i) {
+        keys.push_back(right->get_key_at(i));
+    }
+    for (int i = 0; i <= right->get_key_count(); ++i) {
+        children.push_back(right->get_child_page_id_at(i));
+    }
+
+    if (left->fits_internal_entries(keys)) {
+        left->assign_internal_entries(keys, children);
+        parent->remove_internal_pair(separator_index);
+        free_node(std::move(right));
+        return;
+    }
+
+    std::vector<size_t> sizes;
+    sizes.reserve(keys.size());
+    for (const auto& key : keys) {
+        sizes.push_back(left->get_entry_size(key));
     }
-    return false;
+    int mid = choose_split_point(sizes, left->get_max_capacity(), 1);
+    if (!separator_fits(parent.page, separator_index, keys[mid])) return;
+
+    left->assign_internal_entries({keys.begin(), keys.begin() + mid},
+                                  {children.begin(), children.begin() + mid + 1});
+    right->assign_internal_entries({keys.begin() + mid + 1, keys.end()},
+                                   {children.begin() + mid + 1, children.end()});
+    parent->set_key_at(separator_index, keys[mid]);
 }
 
-bool BPlusTree::handle_underflow(PageID parent_page_id, PageID page_id, int index) {
-    // Simple implementation to handle underflow
-    // Note: Incomplete, as this often requires borrowing or merging of nodes
+bool BPlusTree::separator_fits(const BPlusTreePage& parent, int index, const Value& key) {
+    // 定长键原位覆盖；变长键只有变长部分需要额外空间
+    if (!parent.uses_slotted_layout()) return true;
+    size_t old_size = parent.get_key_at(index).getAsString().size();
+    size_t new_size = key.getAsString().size();
+    return new_size <= old_size || new_size - old_size <= parent.get_free_space();
+}
 
-    auto parent_page = get_node(parent_page_id);
-    auto current_page = get_node(page_id);
+void BPlusTree::collapse_root() {
+    while (root_page_id_ != INVALID_PAGE_ID) {
+        WriteNode root = write_node(root_page_id_);
+        if (root->get_key_count() > 0) return;
 
-    if (current_page->is_leaf()) {
-        // Handle leaf underflow (simplified)
-        // Just delete the leaf page if possible (unsafe in real implementation)
-        return pager_->isValidPage(page_id);
-    } else {
-        // Handle internal node underflow (simplified)
-        return false; // Returning false for now
+        if (root->is_leaf()) {
+            root_page_id_ = INVALID_PAGE_ID;
+        } else {
+            root_page_id_ = root->get_child_page_id_at(0);
+        }
+        free_node(std::move(root));
     }
 }
 
-PageID BPlusTree::create_new_leaf_node() {
+void BPlusTree::free_node(WriteNode&& node) {
+    PageID page_id = node.page_id();
+    // 缓冲池不能移除仍被 pin 的页面，先释放守卫
+    node.guard.release();
+    pager_->deallocatePage(page_id);
+    if (node_count_ > 0) node_count_--;
+}
+
+BPlusTree::WriteNode BPlusTree::create_new_leaf_node() {
     PageID page_id = pager_->allocatePage();
-    auto page = pager_->getPage(page_id);
+    WriteNode node = write_node(page_id);
 
-    BPlusTreePage bpt_page(page);
-    bpt_page.initialize_page();
-    bpt_page.set_leaf(true);
-    bpt_page.set_key_type(key_type_);
-    release_node(page_id, true);
+    node->initialize_page();
+    node->set_leaf(true);
+    node->set_key_type(key_type_);
+    node->set_max_size(leaf_max_size_);
     node_count_++;
-    return page_id;
+    return node;
 }
 
-PageID BPlusTree::create_new_internal_node() {
+BPlusTree::WriteNode BPlusTree::create_new_internal_node() {
     PageID page_id = pager_->allocatePage();
-    auto page = pager_->getPage(page_id);
+    WriteNode node = write_node(page_id);
 
-    BPlusTreePage bpt_page(page);
-    bpt_page.initialize_page();
-    bpt_page.set_leaf(false);
-    bpt_page.set_key_type(key_type_);
-    release_node(page_id, true);
+    node->initialize_page();
+    node->set_leaf(false);
+    node->set_key_type(key_type_);
+    node->set_max_size(internal_max_size_);
     node_count_++;
-    return page_id;
+    return node;
 }
 
 } // namespace engine
-} // namespace minidb
\ No newline at end of file
+} // namespace minidb
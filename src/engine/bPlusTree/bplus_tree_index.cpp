@@ -0,0 +1,138 @@
+#include "engine/bPlusTree/bplus_tree_index.h"
+#include "common/Exception.h"
+
+namespace minidb {
+namespace engine {
+
+namespace {
+
+bool needs_encoding(const catalog::IndexMeta& meta) {
+    return meta.is_composite() || !meta.is_unique();
+}
+
+} // namespace
+
+BPlusTreeIndex::BPlusTreeIndex(std::shared_ptr<storage::Pager> pager,
+                               catalog::IndexMeta* meta,
+                               uint16_t leaf_max_size,
+                               uint16_t internal_max_size)
+    : pager_(pager),
+      meta_(meta),
+      encoded_(needs_encoding(*meta)),
+      tree_(pager, meta->get_root_page_id(),
+            encoded_ ? TypeId::VARCHAR : meta->get_key_type(),
+            leaf_max_size, internal_max_size) {}
+
+bool BPlusTreeIndex::insert_entry(const std::vector<Value>& key_values, const RID& rid) {
+    check_key_values(key_values, meta_->get_column_count());
+    Value key = make_tree_key(key_values, rid);
+
+    // 唯一索引的键不含 RID，键已存在时树拒绝插入并返回 false
+    bool inserted = tree_.insert(key, rid);
+    sync_root();
+    return inserted;
+}
+
+bool BPlusTreeIndex::delete_entry(const std::vector<Value>& key_values, const RID& rid) {
+    check_key_values(key_values, meta_->get_column_count());
+    Value key = make_tree_key(key_values, rid);
+
+    // 唯一索引的键不含 RID，确认指向的是同一条记录再删除
+    if (meta_->is_unique() && !(tree_.search(key) == rid)) {
+        return false;
+    }
+
+    bool removed = tree_.remove(key);
+    sync_root();
+    return removed;
+}
+
+IndexIterator BPlusTreeIndex::scan(const std::vector<Value>& eq_prefix,
+                                   const KeyBound& lower,
+                                   const KeyBound& upper,
+                                   ScanDirection direction) const {
+    if (eq_prefix.size() > meta_->get_column_count()) {
+        throw DatabaseException("Index prefix has more columns than index '" +
+                                meta_->get_index_name() + "'");
+    }
+    check_key_values(eq_prefix, eq_prefix.size());
+
+    if (!encoded_) {
+        if (!eq_prefix.empty()) {
+            return tree_.scan(KeyBound::closed(eq_prefix[0]), KeyBound::closed(eq_prefix[0]), direction);
+        }
+        return tree_.scan(lower, upper, direction);
+    }
+
+    // 编码键：前缀 base 后接下一列的编码。列值相同的所有键都以 base + enc(v) 为前缀，
+    // 因此开/闭端点分别对应该前缀本身或其后继。
+    const bool bounds_apply = eq_prefix.size() < meta_->get_column_count();
+    std::string base = KeyCodec::encode(eq_prefix);
+
+    auto with_next = [&](const Value& v) {
+        std::string key = base;
+        KeyCodec::encode_value(v, &key);
+        return key;
+    };
+
+    KeyBound enc_lower = base.empty() ? KeyBound::unbounded() : KeyBound::closed(Value(base));
+    if (bounds_apply && !lower.is_unbounded()) {
+        std::string key = with_next(*lower.key);
+        if (!lower.inclusive) {
+            key = KeyCodec::prefix_successor(key);
+            if (key.empty()) return IndexIterator();
+        }
+        enc_lower = KeyBound::closed(Value(key));
+    }
+
+    KeyBound enc_upper = KeyBound::unbounded();
+    if (!base.empty()) {
+        std::string succ = KeyCodec::prefix_successor(base);
+        if (!succ.empty()) enc_upper = KeyBound::open(Value(succ));
+    }
+    if (bounds_apply && !upper.is_unbounded()) {
+        std::string key = with_next(*upper.key);
+        if (upper.inclusive) {
+            key = KeyCodec::prefix_successor(key);
+            enc_upper = key.empty() ? enc_upper : KeyBound::open(Value(key));
+        } else {
+            enc_upper = KeyBound::open(Value(key));
+        }
+    }
+
+    return tree_.scan(enc_lower, enc_upper, direction);
+}
+
+void BPlusTreeIndex::check_key_values(const std::vector<Value>& values, size_t expected) const {
+    if (values.size() != expected) {
+        throw DatabaseException("Index '" + meta_->get_index_name() + "' expects " +
+                                std::to_string(expected) + " key values, got " +
+                                std::to_string(values.size()));
+    }
+    const auto& types = meta_->get_key_types();
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!values[i].isNull() && values[i].getType() != types[i]) {
+            throw TypeMismatchException("Index column '" + meta_->get_column_names()[i] +
+                                        "' expects " + getTypeName(types[i]) +
+                                        ", got " + getTypeName(values[i].getType()));
+        }
+    }
+}
+
+Value BPlusTreeIndex::make_tree_key(const std::vector<Value>& key_values, const RID& rid) const {
+    if (!encoded_) {
+        return key_values[0];
+    }
+    std::string key = KeyCodec::encode(key_values);
+    if (!meta_->is_unique()) {
+        KeyCodec::append_rid(rid, &key);
+    }
+    return Value(key);
+}
+
+void BPlusTreeIndex::sync_root() {
+    meta_->set_root_page_id(tree_.get_root_page_id());
+}
+
+} // namespace engine
+} // namespace minidb
@@ -23,14 +23,14 @@ namespace minidb
             const char* data = page_->getData();
             std::memcpy(&header_, data, sizeof(BPlusNodeHeader));
 
-            bool invalid_type = static_cast<int>(header_.key_type) < 0 ||
+            // 全零的新页面 key_type 为 INVALID，同样视为未初始化
+            bool invalid_type = static_cast<int>(header_.key_type) <= static_cast<int>(TypeId::INVALID) ||
                                 static_cast<int>(header_.key_type) > static_cast<int>(TypeId::VARCHAR);
 
             if (header_.key_count == 0 && invalid_type) {
                 header_.key_type = TypeId::INTEGER;
                 header_.key_size = calculate_key_size(TypeId::INTEGER);
                 header_.is_leaf = false;
-                header_.next_page_id = INVALID_PAGE_ID;
                 save_header();
             }
 
@@ -38,16 +38,20 @@ namespace minidb
                 header_.key_size = calculate_key_size(header_.key_type);
                 save_header();
             }
+        }
 
-            if (!is_leaf() && header_.key_count == 0) {
-                set_child_page_id_at(0, INVALID_PAGE_ID);
-            }
+        BPlusTreePage::BPlusTreePage(const storage::Page* page)
+            : page_(const_cast<storage::Page*>(page)) {
+            std::memcpy(&header_, page_->getData(), sizeof(BPlusNodeHeader));
         }
 
         Value BPlusTreePage::get_key_at(int index) const {
             if (index < 0 || index >= header_.key_count) {
                 throw std::out_of_range("Key index out of range");
             }
+            if (uses_slotted_layout()) {
+                return Value(slot_key(key_slot(index)));
+            }
             return deserialize_key(get_data_start() + get_key_offset(index));
         }
 
@@ -55,6 +59,15 @@ namespace minidb
             if (index < 0 || index >= header_.key_count) { // 改为 >=，不允许 index == key_count
                 throw std::out_of_range("Key index out of range");
             }
+            if (uses_slotted_layout()) {
+                std::vector<std::string> keys, values;
+                collect_slots(&keys, &values);
+                keys[key_slot(index)] = varchar_key_bytes(key);
+                if (!rebuild_slots(keys, values)) {
+                    throw std::runtime_error("B+ tree node has no room for key");
+                }
+                return;
+            }
             serialize_key(key, get_data_start() + get_key_offset(index));
             mark_dirty();
         }
@@ -63,11 +76,13 @@ namespace minidb
             if (index < 0 || index >= header_.key_count) {
                 throw std::out_of_range("Key index out of range");
             }
-
-            if (index < header_.key_count - 1) {
-                shift_keys_left(index + 1);
+            if (uses_slotted_layout()) {
+                // 槽式布局中键和值同处一个槽，只能成对删除
+                throw std::logic_error("remove_key_at is not supported for VARCHAR nodes");
             }
 
+            shift_keys_left(index + 1);
+
             header_.key_count--;
             save_header(); // ✅ 写回
             mark_dirty();
@@ -78,6 +93,9 @@ namespace minidb
             if (index < 0 || index >= header_.key_count) {
                 throw std::out_of_range("RID index out of range");
             }
+            if (uses_slotted_layout()) {
+                return deserialize_rid(slot_at(index) + 2 * sizeof(uint16_t));
+            }
             return deserialize_rid(get_data_start() + get_value_offset(index));
         }
 
@@ -86,6 +104,11 @@ namespace minidb
             if (index < 0 || index >= header_.key_count) { // 同样改为 >=
                 throw std::out_of_range("RID index out of range");
             }
+            if (uses_slotted_layout()) {
+                serialize_rid(rid, slot_at(index) + 2 * sizeof(uint16_t));
+                mark_dirty();
+                return;
+            }
             serialize_rid(rid, get_data_start() + get_value_offset(index));
             mark_dirty();
         }
@@ -95,6 +118,9 @@ namespace minidb
             if (index < 0 || index > header_.key_count) {
                 throw std::out_of_range("Child index out of range");
             }
+            if (uses_slotted_layout()) {
+                return deserialize_page_id(slot_at(index) + 2 * sizeof(uint16_t));
+            }
             return deserialize_page_id(get_data_start() + get_value_offset(index));
         }
 
@@ -103,12 +129,24 @@ namespace minidb
             if (index < 0 || index > header_.key_count + 1) {
                 throw std::out_of_range("Child index out of range");
             }
+            if (uses_slotted_layout()) {
+                // 槽式布局中第 i 个子指针位于第 i 个槽，槽必须已存在
+                if (index > header_.key_count) {
+                    throw std::out_of_range("Child index out of range");
+                }
+                serialize_page_id(page_id, slot_at(index) + 2 * sizeof(uint16_t));
+                mark_dirty();
+                return;
+            }
             serialize_page_id(page_id, get_data_start() + get_value_offset(index));
             mark_dirty();
         }
 
         int BPlusTreePage::find_key_index(const Value& key) const {
             if (header_.key_count == 0) return -1;
+            if (uses_slotted_layout()) {
+                return find_varchar_key_index(varchar_key_bytes(key));
+            }
 
             int left = 0, right = header_.key_count - 1;
             while (left <= right) {
@@ -123,7 +161,16 @@ namespace minidb
         }
 
         bool BPlusTreePage::insert_leaf_pair(const Value& key, const RID& rid) {
-            if (!is_leaf() || is_full()) return false;
+            if (!is_leaf()) return false;
+            if (uses_slotted_layout()) {
+                if (header_.max_size > 0 && header_.key_count >= header_.max_size) return false;
+                int pos_hint = find_key_index(key);
+                if (pos_hint >= 0) return false;
+                char value[sizeof(RID)];
+                serialize_rid(rid, value);
+                return insert_slot(-pos_hint - 1, varchar_key_bytes(key), value);
+            }
+            if (is_full()) return false;
 
             int pos_hint = find_key_index(key);
             if (pos_hint >= 0) return false; // 已存在
@@ -131,11 +178,10 @@ namespace minidb
             int insert_pos = -pos_hint - 1;
             if (insert_pos < 0 || insert_pos > header_.key_count) return false;
 
-            header_.key_count++; // ✅ 先加
-            if (insert_pos < header_.key_count - 1) { // 末尾插不用挪
-                shift_keys_right(insert_pos);
-                shift_values_right(insert_pos);
-            }
+            // 先挪动 [insert_pos, key_count) 的键值对，再增加计数
+            shift_keys_right(insert_pos);
+            shift_values_right(insert_pos);
+            header_.key_count++;
             save_header();
 
             serialize_key(key, get_data_start() + get_key_offset(insert_pos));
@@ -146,17 +192,26 @@ namespace minidb
 
 
         bool BPlusTreePage::insert_internal_pair(const Value& key, PageID child_page_id) {
-            if (is_leaf() || is_full()) return false;
+            if (is_leaf()) return false;
+            if (uses_slotted_layout()) {
+                if (header_.max_size > 0 && header_.key_count >= header_.max_size) return false;
+                int pos_hint = find_key_index(key);
+                if (pos_hint >= 0) return false;
+                char value[sizeof(PageID)];
+                serialize_page_id(child_page_id, value);
+                // 第 i 个键位于第 i + 1 个槽
+                return insert_slot(-pos_hint, varchar_key_bytes(key), value);
+            }
+            if (is_full()) return false;
 
             int pos_hint = find_key_index(key);
             if (pos_hint >= 0) return false;
             int insert_pos = -pos_hint - 1;
 
-            header_.key_count++; // ✅ 先加
-            if (insert_pos < header_.key_count - 1) {
-                shift_keys_right(insert_pos);
-                shift_values_right(insert_pos + 1);
-            }
+            // 键从 insert_pos 开始右移，子指针从 insert_pos + 1 开始右移
+            shift_keys_right(insert_pos);
+            shift_values_right(insert_pos + 1);
+            header_.key_count++;
             save_header();
 
             serialize_key(key, get_data_start() + get_key_offset(insert_pos));
@@ -168,40 +223,212 @@ namespace minidb
 
         bool BPlusTreePage::remove_leaf_pair(int index) {
             if (!is_leaf() || index < 0 || index >= header_.key_count) return false;
-            remove_key_at(index);
+            if (uses_slotted_layout()) {
+                remove_slot(index);
+                return true;
+            }
 
-            // 移动RID
-            if (index < header_.key_count) {
-                shift_values_left(index + 1);
+            shift_keys_left(index + 1);
+            shift_values_left(index + 1);
+            header_.key_count--;
+            save_header();
+            return true;
+        }
+
+        bool BPlusTreePage::remove_internal_pair(int index) {
+            // 删除第 index 个键及其右侧子指针（child[index + 1]）
+            if (is_leaf() || index < 0 || index >= header_.key_count) return false;
+            if (uses_slotted_layout()) {
+                remove_slot(index + 1);
+                return true;
             }
-            mark_dirty();
+
+            shift_keys_left(index + 1);
+            shift_values_left(index + 2);
+            header_.key_count--;
+            save_header();
             return true;
         }
 
+        void BPlusTreePage::assign_leaf_entries(const std::vector<std::pair<Value, RID>>& entries) {
+            if (!is_leaf()) throw std::logic_error("Not a leaf node");
+
+            if (uses_slotted_layout()) {
+                if (header_.max_size > 0 && entries.size() > header_.max_size) {
+                    throw std::runtime_error("Too many entries for B+ tree leaf");
+                }
+                std::vector<std::string> keys, values;
+                keys.reserve(entries.size());
+                values.reserve(entries.size());
+                for (const auto& [key, rid] : entries) {
+                    keys.push_back(varchar_key_bytes(key));
+                    values.emplace_back(reinterpret_cast<const char*>(&rid), sizeof(RID));
+                }
+                if (!rebuild_slots(keys, values)) {
+                    throw std::runtime_error("Entries do not fit in B+ tree leaf");
+                }
+                return;
+            }
+
+            if (entries.size() > get_max_capacity()) {
+                throw std::runtime_error("Too many entries for B+ tree leaf");
+            }
+            set_key_count(static_cast<uint16_t>(entries.size()));
+            for (size_t i = 0; i < entries.size(); ++i) {
+                serialize_key(entries[i].first, get_data_start() + get_key_offset(static_cast<int>(i)));
+                serialize_rid(entries[i].second, get_data_start() + get_value_offset(static_cast<int>(i)));
+            }
+            mark_dirty();
+        }
+
+        void BPlusTreePage::assign_internal_entries(const std::vector<Value>& keys,
+                                                    const std::vector<PageID>& children) {
+            if (is_leaf()) throw std::logic_error("Leaf node");
+            if (children.size() != keys.size() + 1) {
+                throw std::invalid_argument("Internal node needs exactly one more child than keys");
+            }
+
+            if (uses_slotted_layout()) {
+                if (header_.max_size > 0 && keys.size() > header_.max_size) {
+                    throw std::runtime_error("Too many keys for B+ tree internal node");
+                }
+                std::vector<std::string> slot_keys(1), values;
+                values.reserve(children.size());
+                for (const auto& key : keys) {
+                    slot_keys.push_back(varchar_key_bytes(key));
+                }
+                for (PageID child : children) {
+                    values.emplace_back(reinterpret_cast<const char*>(&child), sizeof(PageID));
+                }
+                if (!rebuild_slots(slot_keys, values)) {
+                    throw std::runtime_error("Keys do not fit in B+ tree internal node");
+                }
+                return;
+            }
+
+            if (keys.size() > get_max_capacity()) {
+                throw std::runtime_error("Too many keys for B+ tree internal node");
+            }
+            set_key_count(static_cast<uint16_t>(keys.size()));
+            for (size_t i = 0; i < keys.size(); ++i) {
+                serialize_key(keys[i], get_data_start() + get_key_offset(static_cast<int>(i)));
+            }
+            for (size_t i = 0; i < children.size(); ++i) {
+                serialize_page_id(children[i], get_data_start() + get_value_offset(static_cast<int>(i)));
+            }
+            mark_dirty();
+        }
+
+        bool BPlusTreePage::fits_leaf_entries(const std::vector<std::pair<Value, RID>>& entries) const {
+            if (!uses_slotted_layout()) return entries.size() <= get_max_capacity();
+            if (header_.max_size > 0 && entries.size() > header_.max_size) return false;
+            if (entries.empty()) return true;
+
+            // 有序条目的公共前缀即首尾两键的公共前缀
+            const std::string first = entries.front().first.getAsString();
+            const std::string last = entries.back().first.getAsString();
+            size_t common = 0;
+            while (common < first.size() && common < last.size() && first[common] == last[common]) {
+                ++common;
+            }
+            size_t need = common + entries.size() * slot_size();
+            for (const auto& entry : entries) {
+                need += entry.first.getAsString().size() - common;
+            }
+            return need <= get_data_capacity();
+        }
+
+        bool BPlusTreePage::fits_internal_entries(const std::vector<Value>& keys) const {
+            if (!uses_slotted_layout()) return keys.size() <= get_max_capacity();
+            if (header_.max_size > 0 && keys.size() > header_.max_size) return false;
+
+            size_t need = (keys.size() + 1) * slot_size();
+            for (const auto& key : keys) {
+                need += key.getAsString().size();
+            }
+            return need <= get_data_capacity();
+        }
+
+        bool BPlusTreePage::has_room_for(const Value& key) const {
+            if (!uses_slotted_layout()) return !is_full();
+            if (header_.max_size > 0 && header_.key_count >= header_.max_size) return false;
+
+            std::string bytes = varchar_key_bytes(key);
+            if (!is_leaf() || header_.key_count == 0) {
+                return used_bytes() + slot_size() + bytes.size() <= get_data_capacity();
+            }
+
+            // 插入放不下时节点会整体重建并重新计算公共前缀。有序键集合的公共前缀
+            // 等于最小键与最大键的公共前缀，据此算出重建后的精确占用
+            std::string first = slot_key(0);
+            std::string last = slot_key(header_.key_count - 1);
+            size_t common = 0;
+            while (common < first.size() && common < last.size() && common < bytes.size() &&
+                   first[common] == last[common] && first[common] == bytes[common]) {
+                ++common;
+            }
+            size_t count = header_.key_count + 1;
+            size_t full_bytes = used_bytes() - header_.prefix_size - header_.key_count * slot_size() +
+                                header_.key_count * header_.prefix_size + bytes.size();
+            size_t need = common + count * slot_size() + full_bytes - count * common;
+            return need <= get_data_capacity();
+        }
+
+        size_t BPlusTreePage::get_entry_size(const Value& key) const {
+            if (!uses_slotted_layout()) return get_pair_size();
+            return slot_size() + key.getAsString().size();
+        }
+
+        size_t BPlusTreePage::get_data_capacity() const {
+            return BPLUS_PAGE_DATA_SIZE - sizeof(BPlusNodeHeader);
+        }
+
         bool BPlusTreePage::is_full() const {
+            if (uses_slotted_layout()) {
+                return !has_room_for(Value(std::string()));
+            }
             return header_.key_count >= get_max_capacity();
         }
         uint16_t BPlusTreePage::get_free_space() const {
+            if (uses_slotted_layout()) {
+                return static_cast<uint16_t>(get_data_capacity() - used_bytes());
+            }
             size_t used_space = header_.key_count * get_pair_size();
-            size_t total_space = PAGE_SIZE - sizeof(BPlusNodeHeader);
+            size_t total_space = BPLUS_PAGE_DATA_SIZE - sizeof(BPlusNodeHeader);
             return static_cast<uint16_t>(total_space - used_space);
         }
 
         bool BPlusTreePage::is_underflow() const {
             if (header_.key_count == 0) return true;
+            if (uses_slotted_layout() && header_.max_size == 0) {
+                // 变长键按字节占用判断，不足半页即为下溢
+                return used_bytes() < get_data_capacity() / 2;
+            }
 
             int min_keys = get_max_capacity() / 2; // 典型的 B+树最小度数
             return header_.key_count < min_keys;
         }
 
         uint16_t BPlusTreePage::get_max_capacity() const {
+            if (uses_slotted_layout()) {
+                // 变长键的实际容量取决于键长，这里给出空键时的上限
+                auto page_capacity = static_cast<uint16_t>(get_data_capacity() / slot_size() - (is_leaf() ? 0 : 1));
+                if (header_.max_size > 0 && header_.max_size < page_capacity) {
+                    return header_.max_size;
+                }
+                return page_capacity;
+            }
             size_t pair_size = get_pair_size();
             if (pair_size == 0) return 0;
 
-            size_t total_space = PAGE_SIZE - sizeof(BPlusNodeHeader);
+            size_t total_space = BPLUS_PAGE_DATA_SIZE - sizeof(BPlusNodeHeader);
             if (!is_leaf()) total_space -= get_value_size();
 
-            return static_cast<uint16_t>(total_space / pair_size);
+            auto page_capacity = static_cast<uint16_t>(total_space / pair_size);
+            if (header_.max_size > 0 && header_.max_size < page_capacity) {
+                return header_.max_size;
+            }
+            return page_capacity;
         }
 
         void BPlusTreePage::save_header() {
@@ -264,35 +491,14 @@ namespace minidb
             return get_key_size() + get_value_size();
         }
 
+        // VARCHAR 键按定长槽位（长度字段 + 最大长度）存放，所有类型的键值对步长一致，
+        // 这样插入/删除时的整体搬移不会与变长数据错位。
         size_t BPlusTreePage::get_key_offset(int index) const {
-            if (header_.key_type != TypeId::VARCHAR) {
-                // 固定长度类型：每个键值对的大小相同
-                return index * get_pair_size();
-            }
-
-            // 对于VARCHAR类型，需要遍历计算偏移量
-            size_t offset = 0;
-            for (int i = 0; i < index; ++i) {
-                const char* data = get_data_start() + offset;
-                uint16_t len;
-                std::memcpy(&len, data, sizeof(uint16_t));
-                offset += sizeof(uint16_t) + len + get_value_size();
-            }
-            return offset;
+            return index * get_pair_size();
         }
 
         size_t BPlusTreePage::get_value_offset(int index) const {
-            if (header_.key_type != TypeId::VARCHAR) {
-                // 固定长度类型：值在键之后
-                return index * get_pair_size() + get_key_size();
-            }
-
-            // 对于VARCHAR类型，需要计算当前键的偏移量
-            size_t key_offset = get_key_offset(index);
-            const char* data = get_data_start() + key_offset;
-            uint16_t len;
-            std::memcpy(&len, data, sizeof(uint16_t));
-            return key_offset + sizeof(uint16_t) + len;
+            return index * get_pair_size() + get_key_size();
         }
 
         void BPlusTreePage::serialize_key(const Value& key, char* buffer) const {
@@ -315,6 +521,10 @@ namespace minidb
                 }
                 case TypeId::VARCHAR: {
                     const std::string& str_value = key.getAsString();
+                    if (str_value.size() + sizeof(uint16_t) > get_key_size()) {
+                        throw std::runtime_error("VARCHAR key too long for B+ tree node: " +
+                                                 std::to_string(str_value.size()) + " bytes");
+                    }
                     uint16_t len = static_cast<uint16_t>(str_value.size());
                     // 先存储长度
                     std::memcpy(buffer, &len, sizeof(uint16_t));
@@ -372,13 +582,16 @@ namespace minidb
             return page_id;
         }
 
+        // 定长布局下第 i 个键位于 i * pair_size，逐个元素按步长搬移；
+        // 搬移方向决定遍历顺序，避免覆盖尚未搬移的数据。
         void BPlusTreePage::shift_keys_right(int start_index, int count) {
             if (start_index >= header_.key_count || count <= 0) return;
+
             char* data = get_data_start();
-            size_t move_bytes = (header_.key_count - start_index) * get_key_size(); // ✅ 用实际 key_size
-            std::memmove(data + get_key_offset(start_index + count),
-                         data + get_key_offset(start_index),
-                         move_bytes);
+            size_t key_size = get_key_size();
+            for (int i = header_.key_count - 1; i >= start_index; --i) {
+                std::memmove(data + get_key_offset(i + count), data + get_key_offset(i), key_size);
+            }
         }
 
         void BPlusTreePage::shift_keys_left(int start_index, int count) {
@@ -386,13 +599,9 @@ namespace minidb
 
             char* data = get_data_start();
             size_t key_size = get_key_size();
-            size_t pair_size = get_pair_size();
-
-            int move_count = header_.key_count - start_index;
-            char* src = data + get_key_offset(start_index);
-            char* dest = src - count * pair_size;
-
-            std::memmove(dest, src, move_count * key_size);
+            for (int i = start_index; i < header_.key_count; ++i) {
+                std::memmove(data + get_key_offset(i - count), data + get_key_offset(i), key_size);
+            }
         }
 
         void BPlusTreePage::shift_values_right(int start_index, int count) {
@@ -402,13 +611,9 @@ namespace minidb
 
             char* data = get_data_start();
             size_t value_size = get_value_size();
-            size_t pair_size = get_pair_size();
-
-            int move_count = total_values - start_index;
-            char* src = data + get_value_offset(start_index);
-            char* dest = src + count * pair_size;
-
-            std::memmove(dest, src, move_count * value_size);
+            for (int i = total_values - 1; i >= start_index; --i) {
+                std::memmove(data + get_value_offset(i + count), data + get_value_offset(i), value_size);
+            }
         }
 
         void BPlusTreePage::shift_values_left(int start_index, int count) {
@@ -417,30 +622,212 @@ namespace minidb
 
             char* data = get_data_start();
             size_t value_size = get_value_size();
-            size_t pair_size = get_pair_size();
-
-            int move_count = total_values - start_index;
-            char* src = data + get_value_offset(start_index);
-            char* dest = src - count * pair_size;
-
-            std::memmove(dest, src, move_count * value_size);
+            for (int i = start_index; i < total_values; ++i) {
+                std::memmove(data + get_value_offset(i - count), data + get_value_offset(i), value_size);
+            }
         }
 
         // 初始化页面数据
         void BPlusTreePage::initialize_page() {
             // 清空页面数据
             char* data = const_cast<char*>(page_->getData());
-            std::memset(data, 0, PAGE_SIZE);
+            std::memset(data, 0, BPLUS_PAGE_DATA_SIZE);
 
             // 初始化头信息
             header_.key_count = 0;
             header_.is_leaf = false;
-            header_.next_page_id = 0;
+            header_.next_page_id = INVALID_PAGE_ID;
+            header_.prev_page_id = INVALID_PAGE_ID;
             header_.key_type = TypeId::INTEGER;
             header_.key_size = calculate_key_size(TypeId::INTEGER);
+            header_.max_size = 0;
+            reset_key_heap();
 
             save_header();
             mark_dirty();
         }
+
+        // ---------------- VARCHAR 槽式布局 ----------------
+
+        void BPlusTreePage::reset_key_heap() {
+            header_.prefix_size = 0;
+            header_.heap_offset = static_cast<uint16_t>(get_data_capacity());
+        }
+
+        size_t BPlusTreePage::heap_top() const {
+            // 未初始化的旧页面 heap_offset 为 0，视为空堆
+            return header_.heap_offset == 0 ? get_data_capacity() - header_.prefix_size : header_.heap_offset;
+        }
+
+        const char* BPlusTreePage::prefix_data() const {
+            return get_data_start() + get_data_capacity() - header_.prefix_size;
+        }
+
+        std::string BPlusTreePage::slot_key(int slot) const {
+            const char* entry = slot_at(slot);
+            uint16_t offset, length;
+            std::memcpy(&offset, entry, sizeof(uint16_t));
+            std::memcpy(&length, entry + sizeof(uint16_t), sizeof(uint16_t));
+
+            std::string key;
+            if (is_leaf()) {
+                key.reserve(header_.prefix_size + length);
+                key.assign(prefix_data(), header_.prefix_size);
+            }
+            key.append(get_data_start() + offset, length);
+            return key;
+        }
+
+        std::string BPlusTreePage::varchar_key_bytes(const Value& key) const {
+            if (key.getType() != TypeId::VARCHAR) {
+                throw std::runtime_error("Key type mismatch: expected " +
+                                         std::to_string(static_cast<int>(TypeId::VARCHAR)) +
+                                         ", got " + std::to_string(static_cast<int>(key.getType())));
+            }
+            std::string bytes = key.getAsString();
+            if (bytes.size() > BPLUS_MAX_VARCHAR_KEY_SIZE) {
+                throw std::runtime_error("VARCHAR key too long for B+ tree node: " +
+                                         std::to_string(bytes.size()) + " bytes");
+            }
+            return bytes;
+        }
+
+        size_t BPlusTreePage::used_bytes() const {
+            size_t used = header_.prefix_size + slot_count() * slot_size();
+            for (int slot = 0; slot < slot_count(); ++slot) {
+                uint16_t length;
+                std::memcpy(&length, slot_at(slot) + sizeof(uint16_t), sizeof(uint16_t));
+                used += length;
+            }
+            return used;
+        }
+
+        int BPlusTreePage::compare_suffix(std::string_view suffix, int index) const {
+            const char* entry = slot_at(key_slot(index));
+            uint16_t offset, length;
+            std::memcpy(&offset, entry, sizeof(uint16_t));
+            std::memcpy(&length, entry + sizeof(uint16_t), sizeof(uint16_t));
+            return suffix.compare(std::string_view(get_data_start() + offset, length));
+        }
+
+        // 先与公共前缀比较一次，前缀相同再只对后缀二分，无需反序列化任何 Value
+        int BPlusTreePage::find_varchar_key_index(const std::string& key) const {
+            std::string_view probe(key);
+            if (is_leaf() && header_.prefix_size > 0) {
+                std::string_view prefix(prefix_data(), header_.prefix_size);
+                int cmp = probe.substr(0, prefix.size()).compare(prefix);
+                if (cmp < 0) return -1;
+                if (cmp > 0) return -header_.key_count - 1;
+                probe.remove_prefix(prefix.size());
+            }
+
+            int left = 0, right = header_.key_count - 1;
+            while (left <= right) {
+                int mid = left + (right - left) / 2;
+                int cmp = compare_suffix(probe, mid);
+                if (cmp == 0) return mid;
+                if (cmp > 0) left = mid + 1;
+                else right = mid - 1;
+            }
+            return -left - 1;
+        }
+
+        void BPlusTreePage::collect_slots(std::vector<std::string>* keys, std::vector<std::string>* values) const {
+            keys->clear();
+            values->clear();
+            keys->reserve(slot_count() + 1);
+            values->reserve(slot_count() + 1);
+            for (int slot = 0; slot < slot_count(); ++slot) {
+                keys->push_back(slot_key(slot));
+                values->emplace_back(slot_at(slot) + 2 * sizeof(uint16_t), get_value_size());
+            }
+        }
+
+        // 按给定的完整键重新排布整个节点：叶子重新计算公共前缀，键堆紧凑存放
+        bool BPlusTreePage::rebuild_slots(const std::vector<std::string>& keys,
+                                          const std::vector<std::string>& values) {
+            size_t count = keys.size();
+            std::string prefix;
+            if (is_leaf() && count > 0) {
+                prefix = keys[0];
+                for (size_t i = 1; i < count && !prefix.empty(); ++i) {
+                    size_t common = 0;
+                    while (common < prefix.size() && common < keys[i].size() && prefix[common] == keys[i][common]) {
+                        ++common;
+                    }
+                    prefix.resize(common);
+                }
+            }
+
+            size_t need = prefix.size() + count * slot_size();
+            for (const auto& key : keys) {
+                need += key.size() - prefix.size();
+            }
+            if (need > get_data_capacity()) return false;
+
+            char* data = get_data_start();
+            size_t top = get_data_capacity() - prefix.size();
+            std::memcpy(data + top, prefix.data(), prefix.size());
+            for (size_t i = 0; i < count; ++i) {
+                auto length = static_cast<uint16_t>(keys[i].size() - prefix.size());
+                top -= length;
+                std::memcpy(data + top, keys[i].data() + prefix.size(), length);
+
+                char* entry = slot_at(static_cast<int>(i));
+                auto offset = static_cast<uint16_t>(top);
+                std::memcpy(entry, &offset, sizeof(uint16_t));
+                std::memcpy(entry + sizeof(uint16_t), &length, sizeof(uint16_t));
+                std::memcpy(entry + 2 * sizeof(uint16_t), values[i].data(), get_value_size());
+            }
+
+            header_.key_count = static_cast<uint16_t>(is_leaf() ? count : count - 1);
+            header_.prefix_size = static_cast<uint16_t>(prefix.size());
+            header_.heap_offset = static_cast<uint16_t>(top);
+            save_header();
+            return true;
+        }
+
+        bool BPlusTreePage::insert_slot(int slot, const std::string& key, const char* value) {
+            size_t prefix = is_leaf() ? header_.prefix_size : 0;
+            bool shares_prefix = key.size() >= prefix && std::memcmp(key.data(), prefix_data(), prefix) == 0;
+
+            if (shares_prefix) {
+                auto length = static_cast<uint16_t>(key.size() - prefix);
+                size_t slots_end = (slot_count() + 1) * slot_size();
+                if (slots_end + length <= heap_top()) {
+                    char* entry = slot_at(slot);
+                    std::memmove(entry + slot_size(), entry, (slot_count() - slot) * slot_size());
+
+                    auto offset = static_cast<uint16_t>(heap_top() - length);
+                    std::memcpy(get_data_start() + offset, key.data() + prefix, length);
+                    std::memcpy(entry, &offset, sizeof(uint16_t));
+                    std::memcpy(entry + sizeof(uint16_t), &length, sizeof(uint16_t));
+                    std::memcpy(entry + 2 * sizeof(uint16_t), value, get_value_size());
+
+                    header_.heap_offset = offset;
+                    header_.key_count++;
+                    save_header();
+                    return true;
+                }
+            }
+
+            // 前缀变短或堆中碎片过多：整体重建
+            std::vector<std::string> keys, values;
+            collect_slots(&keys, &values);
+            keys.insert(keys.begin() + slot, key);
+            values.insert(values.begin() + slot, std::string(value, get_value_size()));
+            return rebuild_slots(keys, values);
+        }
+
+        // 删除槽位只搬移槽数组，键字节留作碎片，下次重建时回收
+        void BPlusTreePage::remove_slot(int slot) {
+            char* entry = slot_at(slot);
+            std::memmove(entry, entry + slot_size(), (slot_count() - slot - 1) * slot_size());
+            header_.key_count--;
+            if (is_leaf() && header_.key_count == 0) {
+                reset_key_heap();
+            }
+            save_header();
+        }
     }//namespace engine
 }//namespace minidb
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "engine/bPlusTree/index_iterator.h"
+
+#include <stdexcept>
+
+namespace minidb {
+namespace engine {
+
+IndexIterator::IndexIterator(std::shared_ptr<storage::Pager> pager,
+                             PageID leaf_page_id,
+                             KeyBound lower,
+                             KeyBound upper,
+                             ScanDirection direction)
+    : pager_(std::move(pager)), lower_(std::move(lower)), upper_(std::move(upper)),
+      direction_(direction) {
+    if (leaf_page_id == INVALID_PAGE_ID) return;
+    load_leaf(leaf_page_id);
+    seek_first();
+}
+
+RID IndexIterator::rid() const {
+    if (is_end()) {
+        throw std::out_of_range("IndexIterator dereferenced at end");
+    }
+    return leaf_->get_rid_at(index_);
+}
+
+IndexIterator& IndexIterator::operator++() {
+    if (is_end()) return *this;
+    index_ += (direction_ == ScanDirection::FORWARD) ? 1 : -1;
+    settle();
+    return *this;
+}
+
+void IndexIterator::load_leaf(PageID page_id) {
+    // 先换守卫再建视图：赋值时旧叶子的 pin 随之释放
+    leaf_.reset();
+    guard_ = pager_->fetchPageRead(page_id);
+    leaf_.emplace(guard_.getPage());
+}
+
+void IndexIterator::seek_first() {
+    if (direction_ == ScanDirection::FORWARD) {
+        if (lower_.is_unbounded()) {
+            index_ = 0;
+        } else {
+            int pos = leaf_->find_key_index(*lower_.key);
+            if (pos >= 0) {
+                index_ = lower_.inclusive ? pos : pos + 1;
+            } else {
+                index_ = -pos - 1;
+            }
+        }
+    } else {
+        if (upper_.is_unbounded()) {
+            index_ = leaf_->get_key_count() - 1;
+        } else {
+            int pos = leaf_->find_key_index(*upper_.key);
+            if (pos >= 0) {
+                index_ = upper_.inclusive ? pos : pos - 1;
+            } else {
+                index_ = (-pos - 1) - 1;
+            }
+        }
+    }
+    settle();
+}
+
+void IndexIterator::settle() {
+    if (direction_ == ScanDirection::FORWARD) {
+        while (index_ >= leaf_->get_key_count()) {
+            PageID next = leaf_->get_next_page_id();
+            if (next == INVALID_PAGE_ID) {
+                finish();
+                return;
+            }
+            load_leaf(next);
+            index_ = 0;
+        }
+        current_key_ = leaf_->get_key_at(index_);
+        if (after_upper(current_key_)) finish();
+    } else {
+        while (index_ < 0) {
+            PageID prev = leaf_->get_prev_page_id();
+            if (prev == INVALID_PAGE_ID) {
+                finish();
+                return;
+            }
+            load_leaf(prev);
+            index_ = leaf_->get_key_count() - 1;
+        }
+        current_key_ = leaf_->get_key_at(index_);
+        if (before_lower(current_key_)) finish();
+    }
+}
+
+void IndexIterator::finish() {
+    leaf_.reset();
+    guard_.release();
+    index_ = 0;
+}
+
+bool IndexIterator::before_lower(const Value& key) const {
+    if (lower_.is_unbounded()) return false;
+    return lower_.inclusive ? key < *lower_.key : key <= *lower_.key;
+}
+
+bool IndexIterator::after_upper(const Value& key) const {
+    if (upper_.is_unbounded()) return false;
+    return upper_.inclusive ? key > *upper_.key : key >= *upper_.key;
+}
+
+} // namespace engine
+} // namespace minidb
@@ -0,0 +1,152 @@
+#include "engine/bPlusTree/key_codec.h"
+#include "common/Exception.h"
+
+namespace minidb {
+namespace engine {
+
+namespace {
+
+constexpr char NULL_TAG = 0x00;
+constexpr char VALUE_TAG = 0x01;
+
+void put_uint32_be(uint32_t v, std::string* out) {
+    out->push_back(static_cast<char>(v >> 24));
+    out->push_back(static_cast<char>(v >> 16));
+    out->push_back(static_cast<char>(v >> 8));
+    out->push_back(static_cast<char>(v));
+}
+
+uint32_t get_uint32_be(const std::string& in, size_t pos) {
+    if (pos + 4 > in.size()) {
+        throw DatabaseException("Truncated index key");
+    }
+    auto b = [&](size_t i) { return static_cast<uint32_t>(static_cast<unsigned char>(in[pos + i])); };
+    return (b(0) << 24) | (b(1) << 16) | (b(2) << 8) | b(3);
+}
+
+// 有符号整数翻转符号位后按无符号大端写出，负数排在正数之前
+void put_int32(int32_t v, std::string* out) {
+    put_uint32_be(static_cast<uint32_t>(v) ^ 0x80000000u, out);
+}
+
+int32_t get_int32(const std::string& in, size_t pos) {
+    return static_cast<int32_t>(get_uint32_be(in, pos) ^ 0x80000000u);
+}
+
+} // namespace
+
+void KeyCodec::encode_value(const Value& value, std::string* out) {
+    if (value.isNull()) {
+        out->push_back(NULL_TAG);
+        return;
+    }
+    out->push_back(VALUE_TAG);
+
+    switch (value.getType()) {
+        case TypeId::BOOLEAN:
+            out->push_back(value.getAsBool() ? 1 : 0);
+            break;
+        case TypeId::INTEGER:
+            put_int32(value.getAsInt(), out);
+            break;
+        case TypeId::VARCHAR: {
+            const std::string s = value.getAsString();
+            for (char c : s) {
+                out->push_back(c);
+                if (c == 0) out->push_back(static_cast<char>(0xFF));
+            }
+            out->push_back(0);
+            out->push_back(0);
+            break;
+        }
+        default:
+            throw TypeMismatchException("Unsupported index key type: " +
+                                        std::string(getTypeName(value.getType())));
+    }
+}
+
+std::string KeyCodec::encode(const std::vector<Value>& values) {
+    std::string out;
+    for (const auto& v : values) {
+        encode_value(v, &out);
+    }
+    return out;
+}
+
+void KeyCodec::append_rid(const RID& rid, std::string* out) {
+    put_int32(rid.page_id, out);
+    put_int32(rid.slot_num, out);
+}
+
+RID KeyCodec::decode_rid_suffix(const std::string& key) {
+    if (key.size() < RID_SUFFIX_SIZE) {
+        throw DatabaseException("Index key too short for RID suffix");
+    }
+    size_t pos = key.size() - RID_SUFFIX_SIZE;
+    return RID{get_int32(key, pos), get_int32(key, pos + sizeof(int32_t))};
+}
+
+std::vector<Value> KeyCodec::decode(const std::string& key, const std::vector<TypeId>& types) {
+    std::vector<Value> values;
+    values.reserve(types.size());
+    size_t pos = 0;
+
+    for (TypeId type : types) {
+        if (pos >= key.size()) {
+            throw DatabaseException("Truncated index key");
+        }
+        if (key[pos++] == NULL_TAG) {
+            values.emplace_back();
+            continue;
+        }
+
+        switch (type) {
+            case TypeId::BOOLEAN:
+                values.emplace_back(key.at(pos) != 0);
+                pos += 1;
+                break;
+            case TypeId::INTEGER:
+                values.emplace_back(get_int32(key, pos));
+                pos += sizeof(int32_t);
+                break;
+            case TypeId::VARCHAR: {
+                std::string s;
+                while (true) {
+                    if (pos + 1 >= key.size()) {
+                        throw DatabaseException("Unterminated VARCHAR in index key");
+                    }
+                    char c = key[pos++];
+                    if (c != 0) {
+                        s.push_back(c);
+                        continue;
+                    }
+                    // 0x00 0x00 为结束符，0x00 0xFF 为转义的 0x00
+                    if (key[pos++] == 0) break;
+                    s.push_back(0);
+                }
+                values.emplace_back(s);
+                break;
+            }
+            default:
+                throw TypeMismatchException("Unsupported index key type: " +
+                                            std::string(getTypeName(type)));
+        }
+    }
+    return values;
+}
+
+std::string KeyCodec::prefix_successor(const std::string& prefix) {
+    std::string succ = prefix;
+    while (!succ.empty()) {
+        auto last = static_cast<unsigned char>(succ.back());
+        if (last != 0xFF) {
+            succ.back() = static_cast<char>(last + 1);
+            return succ;
+        }
+        succ.pop_back();
+    }
+    return succ;
+}
+
+} // namespace engine
+} // namespace minidb
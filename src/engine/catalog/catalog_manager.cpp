@@ -25,6 +25,7 @@ bool CatalogManager::create_table(const std::string& table_name, const Schema& s
 
         PageID first_page_id = 0; // 根据具体需求设置默认值，或者调用分配页面的逻辑
         auto result = tables_.emplace(table_name, std::make_unique<TableInfo>(table_name, schema, first_page_id));
+        if (result.second) ++version_;
 
         return result.second;
     }
@@ -35,9 +36,20 @@ bool CatalogManager::create_table(const std::string& table_name, const Schema& s
      * @details 从目录中移除表信息，智能指针会自动释放相关内存
      */
     bool CatalogManager::drop_table(const std::string& table_name) {
+        // 表上的索引随表一起删除
+        for (auto it = indexes_.begin(); it != indexes_.end();) {
+            if (it->second->get_table_name() == table_name) {
+                it = indexes_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
         // erase方法返回删除的元素数量（0或1），大于0表示删除成功
         // 这种方式比先find再erase更简洁高效
-        return tables_.erase(table_name) > 0;
+        if (tables_.erase(table_name) == 0) return false;
+        ++version_;
+        return true;
     }
 
     /**
@@ -100,6 +112,97 @@ bool CatalogManager::create_table(const std::string& table_name, const Schema& s
         return names;
     }
 
+    // ==================== 索引管理 ====================
+    /**
+     * @brief 登记新索引
+     * @param index_name 索引名（全局唯一）
+     * @param table_name 所属表名
+     * @param column_names 索引列（按索引键顺序）
+     * @param is_unique 是否唯一索引
+     * @return true-登记成功, false-索引已存在、表或列不存在
+     * @details 键类型取自表结构；索引的B+树根页面初始为INVALID_PAGE_ID，由执行引擎建树后回填
+     */
+    bool CatalogManager::create_index(const std::string& index_name, const std::string& table_name,
+                                      const std::vector<std::string>& column_names, bool is_unique) {
+        const TableInfo* table_info = get_table(table_name);
+        if (!table_info || index_exists(index_name) || column_names.empty() ||
+            column_names.size() > catalog::IndexMeta::MAX_INDEX_COLUMNS) {
+            return false;
+        }
+
+        const Schema& schema = table_info->get_schema();
+        std::vector<TypeId> key_types;
+        key_types.reserve(column_names.size());
+        for (const auto& column_name : column_names) {
+            if (!schema.has_column(column_name)) {
+                return false;
+            }
+            key_types.push_back(schema.get_column(column_name).type);
+        }
+
+        auto meta = std::make_unique<catalog::IndexMeta>(index_name, table_name, column_names,
+                                                         key_types, is_unique);
+        if (!indexes_.emplace(index_name, std::move(meta)).second) return false;
+        ++version_;
+        return true;
+    }
+
+    bool CatalogManager::drop_index(const std::string& index_name) {
+        if (indexes_.erase(index_name) == 0) return false;
+        ++version_;
+        return true;
+    }
+
+    bool CatalogManager::index_exists(const std::string& index_name) const {
+        return indexes_.find(index_name) != indexes_.end();
+    }
+
+    catalog::IndexMeta* CatalogManager::get_index(const std::string& index_name) {
+        auto it = indexes_.find(index_name);
+        return it != indexes_.end() ? it->second.get() : nullptr;
+    }
+
+    const catalog::IndexMeta* CatalogManager::get_index(const std::string& index_name) const {
+        auto it = indexes_.find(index_name);
+        return it != indexes_.end() ? it->second.get() : nullptr;
+    }
+
+    /**
+     * @brief 获取表上的全部索引（按索引名排序，保证维护顺序稳定）
+     */
+    std::vector<catalog::IndexMeta*> CatalogManager::get_table_indexes(const std::string& table_name) const {
+        std::vector<catalog::IndexMeta*> result;
+        for (const auto& [name, meta] : indexes_) {
+            if (meta->get_table_name() == table_name) {
+                result.push_back(meta.get());
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const auto* a, const auto* b) {
+            return a->get_index_name() < b->get_index_name();
+        });
+        return result;
+    }
+
+    /**
+     * @brief 查找首列为指定列的索引
+     * @details 多个候选时优先唯一索引，其次列数少的索引（键更短，扇出更大）
+     */
+    const catalog::IndexMeta* CatalogManager::find_index(const std::string& table_name,
+                                                         const std::string& column_name) const {
+        const catalog::IndexMeta* best = nullptr;
+        for (const auto* meta : get_table_indexes(table_name)) {
+            if (meta->get_column_name() != column_name) {
+                continue;
+            }
+            if (!best || (meta->is_unique() && !best->is_unique()) ||
+                (meta->is_unique() == best->is_unique() &&
+                 meta->get_column_count() < best->get_column_count())) {
+                best = meta;
+            }
+        }
+        return best;
+    }
+
         // ==================== 新增方法实现：AST集成 ====================
     /**
      * @brief 从AST创建新表
@@ -147,6 +250,15 @@ bool CatalogManager::create_table(const std::string& table_name, const Schema& s
         return create_table(create_ast.tableName, schema);
     }
 
+    /**
+     * @brief 从AST登记新索引
+     * @param index_ast CREATE INDEX语句的AST节点
+     * @return true-登记成功, false-索引已存在或表/列不存在
+     */
+    bool CatalogManager::create_index_from_ast(const CreateIndexAST& index_ast) {
+        return create_index(index_ast.indexName, index_ast.tableName, index_ast.columns, index_ast.isUnique);
+    }
+
     /**
      * @brief 验证INSERT语句的AST是否有效
      * @param insert_ast INSERT语句的AST节点
@@ -162,9 +274,11 @@ bool CatalogManager::create_table(const std::string& table_name, const Schema& s
         // 获取表的Schema
         const Schema& schema = table_info->get_schema();
 
-        // 检查值数量是否与列数量匹配
-        if (insert_ast.values.size() != schema.get_column_count()) {
-            return false;
+        // 检查每行的值数量是否与列数量匹配
+        for (const auto& values : insert_ast.rows) {
+            if (values.size() != schema.get_column_count()) {
+                return false;
+            }
         }
 
         // TODO: 可以添加更详细的类型验证
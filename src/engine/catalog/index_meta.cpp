@@ -14,10 +14,29 @@ IndexMeta::IndexMeta(std::string index_name,
                      PageID root_page_id)
     : index_name_(std::move(index_name)),
       table_name_(std::move(table_name)),
-      column_name_(std::move(column_name)),
-      key_type_(key_type),
+      column_names_{std::move(column_name)},
+      key_types_{key_type},
+      is_unique_(true),
       root_page_id_(root_page_id) {
+    validate();
+}
+
+IndexMeta::IndexMeta(std::string index_name,
+                     std::string table_name,
+                     std::vector<std::string> column_names,
+                     std::vector<TypeId> key_types,
+                     bool is_unique,
+                     PageID root_page_id)
+    : index_name_(std::move(index_name)),
+      table_name_(std::move(table_name)),
+      column_names_(std::move(column_names)),
+      key_types_(std::move(key_types)),
+      is_unique_(is_unique),
+      root_page_id_(root_page_id) {
+    validate();
+}
 
+void IndexMeta::validate() const {
     // 简单的有效性检查
     if (index_name_.empty()) {
         throw DatabaseException("Index name cannot be empty"); // 改为DatabaseException
@@ -25,12 +44,46 @@ IndexMeta::IndexMeta(std::string index_name,
     if (table_name_.empty()) {
         throw DatabaseException("Table name cannot be empty"); // 改为DatabaseException
     }
-    if (column_name_.empty()) {
-        throw DatabaseException("Column name cannot be empty"); // 改为DatabaseException
+    if (column_names_.empty() || column_names_.size() > MAX_INDEX_COLUMNS) {
+        throw DatabaseException("Index must have between 1 and " +
+                                std::to_string(MAX_INDEX_COLUMNS) + " columns");
     }
-    if (key_type == TypeId::INVALID) {
-        throw DatabaseException("Key type cannot be invalid"); // 改为DatabaseException
+    if (column_names_.size() != key_types_.size()) {
+        throw DatabaseException("Index column names and key types do not match");
     }
+    for (size_t i = 0; i < column_names_.size(); ++i) {
+        if (column_names_[i].empty()) {
+            throw DatabaseException("Column name cannot be empty"); // 改为DatabaseException
+        }
+        if (key_types_[i] == TypeId::INVALID) {
+            throw DatabaseException("Key type cannot be invalid"); // 改为DatabaseException
+        }
+    }
+}
+
+const std::string& IndexMeta::get_column_name() const {
+    static const std::string empty;
+    return column_names_.empty() ? empty : column_names_.front();
+}
+
+TypeId IndexMeta::get_key_type() const {
+    return key_types_.empty() ? TypeId::INVALID : key_types_.front();
+}
+
+size_t IndexMeta::match_equality_prefix(const std::vector<std::string>& equality_columns) const {
+    size_t matched = 0;
+    for (const auto& column : column_names_) {
+        bool covered = false;
+        for (const auto& eq : equality_columns) {
+            if (eq == column) {
+                covered = true;
+                break;
+            }
+        }
+        if (!covered) break;
+        ++matched;
+    }
+    return matched;
 }
 
 void IndexMeta::serialize(char* buffer) const {
@@ -50,18 +103,35 @@ void IndexMeta::serialize(char* buffer) const {
     ptr[NAME_LENGTH - 1] = '\0';
     ptr += NAME_LENGTH;
 
-    // 序列化 column_name_ (固定长度)
-    std::strncpy(ptr, column_name_.c_str(), NAME_LENGTH);
+    // 序列化首列列名 (固定长度)
+    std::strncpy(ptr, get_column_name().c_str(), NAME_LENGTH);
     ptr[NAME_LENGTH - 1] = '\0';
     ptr += NAME_LENGTH;
 
-    // 序列化 key_type_ (作为底层整型)
+    // 序列化首列 key_type (作为底层整型)
     *reinterpret_cast<std::underlying_type_t<TypeId>*>(ptr) =
-        static_cast<std::underlying_type_t<TypeId>>(key_type_);
+        static_cast<std::underlying_type_t<TypeId>>(get_key_type());
     ptr += sizeof(std::underlying_type_t<TypeId>);
 
     // 序列化 root_page_id_
     *reinterpret_cast<PageID*>(ptr) = root_page_id_;
+    ptr += sizeof(PageID);
+
+    // 列数与唯一性标记
+    *reinterpret_cast<uint8_t*>(ptr++) = static_cast<uint8_t>(column_names_.size());
+    *reinterpret_cast<uint8_t*>(ptr++) = is_unique_ ? 1 : 0;
+
+    // 其余列（固定占 MAX_INDEX_COLUMNS - 1 个位置，未使用的位置清零）
+    for (size_t i = 1; i < MAX_INDEX_COLUMNS; ++i) {
+        std::memset(ptr, 0, NAME_LENGTH + sizeof(std::underlying_type_t<TypeId>));
+        if (i < column_names_.size()) {
+            std::strncpy(ptr, column_names_[i].c_str(), NAME_LENGTH);
+            ptr[NAME_LENGTH - 1] = '\0';
+            *reinterpret_cast<std::underlying_type_t<TypeId>*>(ptr + NAME_LENGTH) =
+                static_cast<std::underlying_type_t<TypeId>>(key_types_[i]);
+        }
+        ptr += NAME_LENGTH + sizeof(std::underlying_type_t<TypeId>);
+    }
 }
 
 void IndexMeta::deserialize(const char* buffer) {
@@ -88,27 +158,51 @@ void IndexMeta::deserialize(const char* buffer) {
     }
     ptr += NAME_LENGTH;
 
-    // 反序列化 column_name_
-    column_name_ = std::string(ptr, NAME_LENGTH);
-    null_pos = column_name_.find('\0');
-    if (null_pos != std::string::npos) {
-        column_name_.resize(null_pos);
-    }
-    ptr += NAME_LENGTH;
-
-    // 反序列化 key_type_
-    key_type_ = static_cast<TypeId>(
-        *reinterpret_cast<const std::underlying_type_t<TypeId>*>(ptr));
-    ptr += sizeof(std::underlying_type_t<TypeId>);
+    auto read_name = [&ptr]() {
+        std::string name(ptr, NAME_LENGTH);
+        size_t pos = name.find('\0');
+        if (pos != std::string::npos) {
+            name.resize(pos);
+        }
+        ptr += NAME_LENGTH;
+        return name;
+    };
+    auto read_type = [&ptr]() {
+        auto type = static_cast<TypeId>(
+            *reinterpret_cast<const std::underlying_type_t<TypeId>*>(ptr));
+        ptr += sizeof(std::underlying_type_t<TypeId>);
+        return type;
+    };
+
+    // 反序列化首列
+    column_names_.clear();
+    key_types_.clear();
+    column_names_.push_back(read_name());
+    key_types_.push_back(read_type());
 
     // 反序列化 root_page_id_
     root_page_id_ = *reinterpret_cast<const PageID*>(ptr);
+    ptr += sizeof(PageID);
+
+    size_t column_count = *reinterpret_cast<const uint8_t*>(ptr++);
+    is_unique_ = *reinterpret_cast<const uint8_t*>(ptr++) != 0;
+
+    for (size_t i = 1; i < MAX_INDEX_COLUMNS; ++i) {
+        std::string name = read_name();
+        TypeId type = read_type();
+        if (i < column_count) {
+            column_names_.push_back(std::move(name));
+            key_types_.push_back(type);
+        }
+    }
 }
 
 size_t IndexMeta::get_serialized_size() {
     return NAME_LENGTH * 3 + // 三个名称字段
            sizeof(std::underlying_type_t<TypeId>) + // key_type
-           sizeof(PageID); // root_page_id
+           sizeof(PageID) + // root_page_id
+           2 * sizeof(uint8_t) + // 列数、唯一性
+           (MAX_INDEX_COLUMNS - 1) * (NAME_LENGTH + sizeof(std::underlying_type_t<TypeId>)); // 其余列
 }
 
 std::string IndexMeta::to_string() const {
@@ -116,8 +210,13 @@ std::string IndexMeta::to_string() const {
     oss << "IndexMeta{"
         << "name='" << index_name_ << "', "
         << "table='" << table_name_ << "', "
-        << "column='" << column_name_ << "', "
-        << "key_type=" << static_cast<int>(key_type_) << ", "
+        << "columns=(";
+    for (size_t i = 0; i < column_names_.size(); ++i) {
+        if (i > 0) oss << ", ";
+        oss << column_names_[i] << " " << getTypeName(key_types_[i]);
+    }
+    oss << "), "
+        << "unique=" << (is_unique_ ? "true" : "false") << ", "
         << "root_page_id=" << root_page_id_
         << "}";
     return oss.str();
@@ -125,10 +224,14 @@ std::string IndexMeta::to_string() const {
 
     // 元数据完整性验证（永远不需要修改）
     bool IndexMeta::is_valid() const {
-    return !index_name_.empty() &&
-           !table_name_.empty() &&
-           !column_name_.empty() &&
-           key_type_ != TypeId::INVALID;
+    if (index_name_.empty() || table_name_.empty() || column_names_.empty() ||
+        column_names_.size() != key_types_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < column_names_.size(); ++i) {
+        if (column_names_[i].empty() || key_types_[i] == TypeId::INVALID) return false;
+    }
+    return true;
 }
 
     // 运行时可用性验证（可能随存储系统变化）
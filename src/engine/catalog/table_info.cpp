@@ -12,6 +12,7 @@ namespace minidb {
                          uint32_t table_id)
         : table_name_(table_name),
           schema_(schema),
+          codec_(schema_),
           first_page_id_(first_page_id) {
 
         if (table_id == 0) {
@@ -616,9 +616,11 @@
 
 #include "engine/catalog/catalog_manager.h"
 
+#include <cctype>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include "engine/ExecutionEngine.h"   // ִ
 #include "compiler/SQLCompiler.h"     // SQL 
 #include "storage/FileManager.h"      // ļ
@@ -630,6 +632,28 @@
 using json = nlohmann::json;
 using namespace minidb;
 
+// ǷԹؼֿͷִСдؼֺǿհ
+static bool startsWithKeyword(const std::string &sql, const std::string &keyword) {
+    if (sql.size() <= keyword.size() || !std::isspace(static_cast<unsigned char>(sql[keyword.size()]))) {
+        return false;
+    }
+    for (size_t i = 0; i < keyword.size(); ++i) {
+        if (std::toupper(static_cast<unsigned char>(sql[i])) != keyword[i]) return false;
+    }
+    return true;
+}
+
+// ȡͷһʣհסŻֺΪֹ pos Ƶ
+static std::string nextWord(const std::string &text, size_t &pos) {
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+    size_t start = pos;
+    while (pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos])) &&
+           text[pos] != '(' && text[pos] != ';') {
+        ++pos;
+    }
+    return text.substr(start, pos - start);
+}
+
 int main() {
     // === ʼݿ ===
     auto fileManager   = std::make_shared<storage::FileManager>();
@@ -649,6 +673,27 @@ int main() {
     ExecutionEngine engine(catalog, bufferManager);
     SQLCompiler compiler(*catalog); // ﴫã캯Ҫ޸
 
+    // ѯִбߴӡвصѯ䣺ִмƻӡ
+    auto runPlan = [&engine](const PlanNode &plan) {
+        if (ExecutionEngine::isQuery(plan)) {
+            ResultCursor cursor = engine.openCursor(plan);
+            Tuple row;
+            while (cursor.next(row)) {
+                const auto &values = row.getValues();
+                for (size_t i = 0; i < values.size(); ++i) {
+                    std::cout << valueToString(values[i]) << (i + 1 < values.size() ? "\t" : "\n");
+                }
+            }
+            if (cursor.rowsProduced() == 0) std::cout << "(empty)" << std::endl;
+            return;
+        }
+        QueryResult result = engine.executePlan(plan);
+        result.print(); // ޲ print()
+    };
+
+    // PREPARE Ԥ䣺 -> 
+    std::unordered_map<std::string, PreparedStatement> prepared;
+
     std::cout << "MiniDB  SQL 䣬 exit/quit ˳\n";
 
     std::string sql;
@@ -667,14 +712,58 @@ int main() {
         }
 
         try {
-            // 1.  SQL ִмƻ
-            json plan = compiler.compile(sql);
+            // EXPLAIN <SQL>ֻ JSON ʽִмƻִ
+            if (startsWithKeyword(sql, "EXPLAIN")) {
+                std::cout << compiler.compile(sql.substr(8)).dump(2) << std::endl;
+                continue;
+            }
+
+            // PREPARE <> AS <SQL>Ԥ ? 
+            if (startsWithKeyword(sql, "PREPARE")) {
+                size_t pos = 7;
+                std::string name = nextWord(sql, pos);
+                std::string as = nextWord(sql, pos);
+                if (name.empty() || (as != "AS" && as != "as")) {
+                    throw std::runtime_error("Usage: PREPARE <name> AS <statement>;");
+                }
+                PreparedStatement stmt = compiler.prepare(sql.substr(pos));
+                std::cout << "[OK] Statement prepared: " << name << " (" << stmt.parameterCount()
+                          << " parameters)\n";
+                prepared.insert_or_assign(name, std::move(stmt));
+                continue;
+            }
+
+            // EXECUTE <>(, ...)ֻ󶨲±
+            if (startsWithKeyword(sql, "EXECUTE")) {
+                size_t pos = 7;
+                std::string name = nextWord(sql, pos);
+                auto it = prepared.find(name);
+                if (it == prepared.end()) {
+                    throw std::runtime_error("Prepared statement not found: " + name);
+                }
+                std::string arguments;
+                size_t open = sql.find('(', pos);
+                size_t close = sql.rfind(')');
+                if (open != std::string::npos && close != std::string::npos && close > open) {
+                    arguments = sql.substr(open + 1, close - open - 1);
+                }
+                it->second.bind(parseParameterValues(arguments));
+                runPlan(it->second.plan());
+                continue;
+            }
 
-            // 2. ִмƻ
-            QueryResult result = engine.executePlan(plan);
+            // DEALLOCATE <>ɾԤ
+            if (startsWithKeyword(sql, "DEALLOCATE")) {
+                size_t pos = 10;
+                std::string name = nextWord(sql, pos);
+                if (prepared.erase(name) == 0) {
+                    throw std::runtime_error("Prepared statement not found: " + name);
+                }
+                continue;
+            }
 
-            // 3. ӡ
-            result.print(); // ޲ print()
+            //  SQL ִмƻִ
+            runPlan(*compiler.compilePlan(sql));
 
         } catch (const std::runtime_error &e) {
             std::cerr << "[/ִд] " << e.what() << "\n";
@@ -145,6 +145,25 @@ void BufferManager::unpinPage(PageID page_id, bool is_dirty) {
     }
 }
 
+ReadPageGuard BufferManager::fetchPageRead(PageID page_id) {
+    Page* page = fetchPage(page_id);
+    return ReadPageGuard(this, page_id, page);
+}
+
+WritePageGuard BufferManager::fetchPageWrite(PageID page_id) {
+    Page* page = fetchPage(page_id);
+    return WritePageGuard(this, page_id, page);
+}
+
+uint16_t BufferManager::getPinCount(PageID page_id) const {
+    std::shared_lock<std::shared_mutex> lock(buffer_mutex_);
+    auto it = page_table_.find(page_id);
+    if (it == page_table_.end()) {
+        return 0;
+    }
+    return it->second.pin_count;
+}
+
 void BufferManager::flushPage(PageID page_id) {
     std::unique_lock<std::shared_mutex> lock(buffer_mutex_);
     auto it = page_table_.find(page_id);
@@ -205,6 +224,19 @@ void BufferManager::removePage(PageID page_id) {
     page_table_.erase(it);
 }
 
+void BufferManager::discardPage(PageID page_id) {
+    std::unique_lock<std::shared_mutex> lock(buffer_mutex_);
+    auto it = page_table_.find(page_id);
+    if (it == page_table_.end()) return;
+
+    if (it->second.pin_count > 0) {
+        throw PinnedPageException(page_id);
+    }
+
+    lru_list_.erase(it->second.iterator);
+    page_table_.erase(it);
+}
+
 // ====================== LRU淘汰策略 ======================
 bool BufferManager::evictPage() {
     auto list_it = lru_list_.rbegin();
@@ -41,14 +41,23 @@ void Page::deserialize(const char* src) {
 }
 
 bool Page::hasEnoughSpace(uint16_t required) const {
-    uint16_t total_needed = required + 4; // 记录数据 + 槽位元数据
+    uint16_t total_needed = required + SLOT_SIZE; // 记录数据 + 槽位元数据
     return header_.free_space >= total_needed;
 }
 
     bool Page::insertRecord(const char* record_data, uint16_t record_size, RID* rid) {
-        if (!hasEnoughSpace(record_size)) {
+        char* record = reserveRecord(record_size, rid);
+        if (record == nullptr) {
             return false;
         }
+        memcpy(record, record_data, record_size);
+        return true;
+    }
+
+    char* Page::reserveRecord(uint16_t record_size, RID* rid) {
+        if (!hasEnoughSpace(record_size)) {
+            return nullptr;
+        }
 
         // ✅ 从 data_ 顶部（free_space_offset）向下分配
         header_.free_space_offset -= record_size;
@@ -59,8 +68,6 @@ bool Page::hasEnoughSpace(uint16_t required) const {
             throw BufferPoolException("insertRecord 越界");
         }
 
-        memcpy(data_ + record_offset, record_data, record_size);
-
         uint16_t new_slot_num = header_.slot_count;
         uint16_t* slot_offset_ptr = reinterpret_cast<uint16_t*>(data_ + new_slot_num * 4);
         uint16_t* slot_size_ptr   = slot_offset_ptr + 1;
@@ -75,37 +82,20 @@ bool Page::hasEnoughSpace(uint16_t required) const {
             rid->page_id = header_.page_id;
             rid->slot_num = new_slot_num;
         }
-        std::cout << "[DEBUG insert] page_id=" << header_.page_id
-          << " slot_num=" << new_slot_num
-          << " offset=" << *slot_offset_ptr
-          << " size=" << *slot_size_ptr
-          << " slot_count=" << header_.slot_count
-          << std::endl;
-
-        return true;
+        return data_ + record_offset;
     }
 
 
     bool Page::getRecord(const RID& rid, char* buffer, uint16_t* size) const {
-        std::cout << "[DEBUG getRecord] call: rid.page_id=" << rid.page_id
-                  << " rid.slot_num=" << rid.slot_num
-                  << " header.page_id=" << header_.page_id
-                  << " slot_count=" << header_.slot_count
-                  << std::endl;
-
         if (!rid.isValid() || rid.page_id != header_.page_id || rid.slot_num >= header_.slot_count) {
-            std::cout << "[DEBUG getRecord] return false" << std::endl;
             return false;
         }
         uint16_t record_offset, record_size;
         if (!getSlotInfo(rid.slot_num, &record_offset, &record_size)) {
-            std::cout << "[DEBUG getRecord] invalid slot" << std::endl;
             return false;
         }
         std::memcpy(buffer, data_ + record_offset, record_size);
         if (size) *size = record_size;
-
-        std::cout << "[DEBUG getRecord] return true, size=" << record_size << std::endl;
         return true;
     }
 
@@ -201,6 +191,15 @@ bool Page::getSlotInfo(uint16_t slot_num, uint16_t* offset, uint16_t* size) cons
     return *size != 0;  // 大小为0表示已删除
 }
 
+const char* Page::getRecordData(uint16_t slot_num, uint16_t* size) const {
+    uint16_t record_offset, record_size;
+    if (!getSlotInfo(slot_num, &record_offset, &record_size)) {
+        return nullptr;
+    }
+    if (size) *size = record_size;
+    return data_ + record_offset;
+}
+
 // ====================== 获取下一条记录 ======================
 bool Page::getNextRecord(RID& rid) const {
         std::cout << "[DEBUG scan] page_id=" << header_.page_id
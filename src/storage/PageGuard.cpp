@@ -0,0 +1,51 @@
+#include "storage/PageGuard.h"
+#include "storage/BufferManager.h"
+#include <iostream>
+#include <utility>
+
+namespace minidb {
+namespace storage {
+
+BasicPageGuard::BasicPageGuard(BufferManager* buffer_manager, PageID page_id, Page* page)
+    : buffer_manager_(buffer_manager), page_(page), page_id_(page_id) {}
+
+BasicPageGuard::~BasicPageGuard() {
+    release();
+}
+
+BasicPageGuard::BasicPageGuard(BasicPageGuard&& other) noexcept
+    : buffer_manager_(std::exchange(other.buffer_manager_, nullptr)),
+      page_(std::exchange(other.page_, nullptr)),
+      page_id_(std::exchange(other.page_id_, INVALID_PAGE_ID)),
+      is_dirty_(std::exchange(other.is_dirty_, false)) {}
+
+BasicPageGuard& BasicPageGuard::operator=(BasicPageGuard&& other) noexcept {
+    if (this != &other) {
+        release();
+        buffer_manager_ = std::exchange(other.buffer_manager_, nullptr);
+        page_ = std::exchange(other.page_, nullptr);
+        page_id_ = std::exchange(other.page_id_, INVALID_PAGE_ID);
+        is_dirty_ = std::exchange(other.is_dirty_, false);
+    }
+    return *this;
+}
+
+void BasicPageGuard::release() {
+    if (buffer_manager_ == nullptr || page_ == nullptr) {
+        return;
+    }
+    // 析构路径上不能抛异常，unpin 失败只记录警告
+    try {
+        buffer_manager_->unpinPage(page_id_, is_dirty_);
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: failed to unpin page " << page_id_
+                  << " in page guard: " << e.what() << std::endl;
+    }
+    buffer_manager_ = nullptr;
+    page_ = nullptr;
+    page_id_ = INVALID_PAGE_ID;
+    is_dirty_ = false;
+}
+
+} // namespace storage
+} // namespace minidb
@@ -26,8 +26,10 @@ namespace minidb {
 
             std::lock_guard<std::mutex> lock(pager_mutex_);
 
-            // 检查页面是否真的被分配过
-            if (allocated_pages_.find(page_id) == allocated_pages_.end()) {
+            // 检查页面是否真的被分配过：本次会话分配的页面直接查集合，
+            // 之前会话分配的页面以磁盘空闲链表为准，避免重复释放
+            if (allocated_pages_.find(page_id) == allocated_pages_.end() &&
+                !disk_manager_->isPageAllocated(page_id)) {
                 return;
             }
 
@@ -57,6 +59,22 @@ namespace minidb {
             return buffer_manager_->fetchPage(page_id);
         }
 
+        ReadPageGuard Pager::fetchPageRead(PageID page_id) {
+            if (!isValidPage(page_id)) {
+                throw std::runtime_error("Invalid page ID");
+            }
+
+            return buffer_manager_->fetchPageRead(page_id);
+        }
+
+        WritePageGuard Pager::fetchPageWrite(PageID page_id) {
+            if (!isValidPage(page_id)) {
+                throw std::runtime_error("Invalid page ID");
+            }
+
+            return buffer_manager_->fetchPageWrite(page_id);
+        }
+
         void Pager::pinPage(PageID page_id) {
             if (!isValidPage(page_id)) {
                 throw std::runtime_error("Invalid page ID");
@@ -109,8 +127,6 @@ namespace minidb {
 
 
         bool Pager::isValidPage(PageID page_id) const {
-            std::cout << "[DEBUG] isValidPage(" << page_id
-                      << ") page_count=" << getPageCount() << std::endl;
             if (page_id == INVALID_PAGE_ID || page_id < 0) return false;
             return page_id < getPageCount();
         }
@@ -0,0 +1,119 @@
+#include "../include/storage/TablePageDirectory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace minidb {
+    namespace storage {
+
+        void TablePageDirectory::initDirectoryPage(Page& page) {
+            page.initAsDataPage();
+            page.setPageType(PageType::DIRECTORY_PAGE);
+            page.setNextPageId(INVALID_PAGE_ID);
+        }
+
+        PageID TablePageDirectory::create(const std::shared_ptr<BufferManager>& buffer_manager, PageID first_page) {
+            PageID root = buffer_manager->allocatePage();
+            {
+                WritePageGuard page = buffer_manager->fetchPageWrite(root);
+                initDirectoryPage(*page.getPage());
+            }
+
+            TablePageDirectory directory(buffer_manager, root);
+            for (PageID pid = first_page; pid != INVALID_PAGE_ID;) {
+                ReadPageGuard page = buffer_manager->fetchPageRead(pid);
+                directory.append(pid, page->getFreeSpace());
+                pid = page->getNextPageId();
+            }
+            directory.flush();
+            return root;
+        }
+
+        TablePageDirectory::TablePageDirectory(std::shared_ptr<BufferManager> buffer_manager, PageID root_page)
+            : buffer_manager_(std::move(buffer_manager)) {
+            for (PageID pid = root_page; pid != INVALID_PAGE_ID;) {
+                ReadPageGuard page = buffer_manager_->fetchPageRead(pid);
+                if (page->getPageType() != PageType::DIRECTORY_PAGE) {
+                    throw DatabaseException("Page " + std::to_string(pid) + " is not a table directory page");
+                }
+                directory_pages_.push_back(pid);
+                dirty_.push_back(false);
+
+                const char* data = page->getData();
+                for (uint16_t i = 0; i < page->getSlotCount(); ++i) {
+                    Entry entry;
+                    std::memcpy(&entry, data + i * sizeof(Entry), sizeof(Entry));
+                    positions_[entry.page_id] = pages_.size();
+                    pages_.push_back(entry.page_id);
+                    free_space_.push_back(entry.free_space);
+                }
+                pid = page->getNextPageId();
+            }
+        }
+
+        uint16_t TablePageDirectory::getFreeSpace(PageID page_id) const {
+            auto it = positions_.find(page_id);
+            if (it == positions_.end()) {
+                throw DatabaseException("Page " + std::to_string(page_id) + " is not in the table directory");
+            }
+            return free_space_[it->second];
+        }
+
+        PageID TablePageDirectory::findPageWithSpace(uint16_t record_size) {
+            // 与 Page::hasEnoughSpace 的判断一致，提示准确时选中的页一定能放下
+            uint32_t required = static_cast<uint32_t>(record_size) + Page::SLOT_SIZE;
+            if (free_space_.back() >= required) return pages_.back();
+
+            // 游标只对不小于 cursor_required_ 的请求成立，更小的记录从头找
+            if (required < cursor_required_) cursor_ = 0;
+            cursor_required_ = required;
+            while (cursor_ < pages_.size() && free_space_[cursor_] < required) ++cursor_;
+            return cursor_ < pages_.size() ? pages_[cursor_] : INVALID_PAGE_ID;
+        }
+
+        void TablePageDirectory::append(PageID page_id, uint16_t free_space) {
+            if (pages_.size() == directory_pages_.size() * ENTRIES_PER_PAGE) {
+                PageID new_pid = buffer_manager_->allocatePage();
+                {
+                    WritePageGuard page = buffer_manager_->fetchPageWrite(new_pid);
+                    initDirectoryPage(*page.getPage());
+                }
+                WritePageGuard last = buffer_manager_->fetchPageWrite(directory_pages_.back());
+                last->setNextPageId(new_pid);
+                directory_pages_.push_back(new_pid);
+                dirty_.push_back(false);
+            }
+            positions_[page_id] = pages_.size();
+            pages_.push_back(page_id);
+            free_space_.push_back(free_space);
+            dirty_[(pages_.size() - 1) / ENTRIES_PER_PAGE] = true;
+        }
+
+        void TablePageDirectory::setFreeSpace(PageID page_id, uint16_t free_space) {
+            auto it = positions_.find(page_id);
+            if (it == positions_.end() || free_space_[it->second] == free_space) return;
+            free_space_[it->second] = free_space;
+            dirty_[it->second / ENTRIES_PER_PAGE] = true;
+            // 删除腾出空间的页可能在游标之前
+            if (free_space >= cursor_required_ && it->second < cursor_) cursor_ = it->second;
+        }
+
+        void TablePageDirectory::flush() {
+            for (size_t d = 0; d < directory_pages_.size(); ++d) {
+                if (!dirty_[d]) continue;
+                size_t begin = d * ENTRIES_PER_PAGE;
+                size_t end = std::min(pages_.size(), begin + ENTRIES_PER_PAGE);
+
+                WritePageGuard page = buffer_manager_->fetchPageWrite(directory_pages_[d]);
+                char* data = page->getData();
+                for (size_t i = begin; i < end; ++i) {
+                    Entry entry{pages_[i], free_space_[i]};
+                    std::memcpy(data + (i - begin) * sizeof(Entry), &entry, sizeof(Entry));
+                }
+                page->getHeader().slot_count = static_cast<uint16_t>(end - begin);
+                page->setDirty(true);
+                dirty_[d] = false;
+            }
+        }
+
+    } // namespace storage
+} // namespace minidb
@@ -72,8 +72,9 @@ TEST_CASE("INSERT statement parsing", "[parser][insert]") {
         auto insertAst = dynamic_cast<InsertAST*>(ast.get());
         REQUIRE(insertAst != nullptr);
         REQUIRE(insertAst->tableName == "users");
-        REQUIRE(insertAst->values.size() == 1);
-        REQUIRE(insertAst->values[0] == "123");
+        REQUIRE(insertAst->rows.size() == 1);
+        REQUIRE(insertAst->rows[0].size() == 1);
+        REQUIRE(insertAst->rows[0][0] == "123");
     }
 
     SECTION("INSERT with multiple values and string constants") {
@@ -84,10 +85,10 @@ TEST_CASE("INSERT statement parsing", "[parser][insert]") {
         auto insertAst = dynamic_cast<InsertAST*>(ast.get());
         REQUIRE(insertAst != nullptr);
         REQUIRE(insertAst->tableName == "students");
-        REQUIRE(insertAst->values.size() == 3);
-        REQUIRE(insertAst->values[0] == "'Alice'");
-        REQUIRE(insertAst->values[1] == "20");
-        REQUIRE(insertAst->values[2] == "95.5");
+        REQUIRE(insertAst->rows[0].size() == 3);
+        REQUIRE(insertAst->rows[0][0] == "'Alice'");
+        REQUIRE(insertAst->rows[0][1] == "20");
+        REQUIRE(insertAst->rows[0][2] == "95.5");
     }
 
     SECTION("INSERT with double quotes") {
@@ -98,8 +99,34 @@ TEST_CASE("INSERT statement parsing", "[parser][insert]") {
         auto insertAst = dynamic_cast<InsertAST*>(ast.get());
         REQUIRE(insertAst != nullptr);
         REQUIRE(insertAst->tableName == "courses");
-        REQUIRE(insertAst->values.size() == 2);
-        REQUIRE(insertAst->values[0] == "\'Math\'");
+        REQUIRE(insertAst->rows[0].size() == 2);
+        REQUIRE(insertAst->rows[0][0] == "\'Math\'");
+    }
+
+    SECTION("INSERT with multiple rows") {
+        std::string sql = "INSERT INTO users VALUES (1, 'Alice'), (2, 'Bob'), (3, ?);";
+        auto ast = parseSQL(sql);
+
+        REQUIRE(ast != nullptr);
+        auto insertAst = dynamic_cast<InsertAST*>(ast.get());
+        REQUIRE(insertAst != nullptr);
+        REQUIRE(insertAst->rows.size() == 3);
+        REQUIRE(insertAst->rows[1] == std::vector<std::string>{"2", "'Bob'"});
+        REQUIRE(insertAst->rows[2] == std::vector<std::string>{"3", parameterMarker(1)});
+    }
+
+    SECTION("COPY with and without HEADER") {
+        auto ast = parseSQL("COPY users FROM 'data/users.csv' HEADER;");
+        auto copyAst = dynamic_cast<CopyAST*>(ast.get());
+        REQUIRE(copyAst != nullptr);
+        REQUIRE(copyAst->tableName == "users");
+        REQUIRE(copyAst->filePath == "data/users.csv");
+        REQUIRE(copyAst->header);
+
+        ast = parseSQL("COPY users FROM 'users.csv';");
+        copyAst = dynamic_cast<CopyAST*>(ast.get());
+        REQUIRE(copyAst != nullptr);
+        REQUIRE_FALSE(copyAst->header);
     }
 }
 
@@ -162,6 +189,110 @@ TEST_CASE("SELECT statement parsing", "[parser][select]") {
         REQUIRE(selectAst->condition.value().op == ">=");
         REQUIRE(selectAst->condition.value().value == "90");
     }
+
+    SECTION("SELECT with AND/OR/NOT and arithmetic") {
+        std::string sql = "SELECT * FROM students WHERE NOT age + 1 > 20 OR name = 'Bob' AND (score < 60 OR score >= -5);";
+        auto ast = parseSQL(sql);
+
+        auto selectAst = dynamic_cast<SelectAST*>(ast.get());
+        REQUIRE(selectAst != nullptr);
+        REQUIRE_FALSE(selectAst->condition.has_value());
+        REQUIRE(selectAst->where != nullptr);
+
+        // OR 优先级最低，AND 高于 OR，NOT 作用于整个比较
+        const ExprPtr& where = selectAst->where;
+        REQUIRE(where->value == "OR");
+        REQUIRE(where->left->kind == Expr::Kind::Unary);
+        REQUIRE(where->left->left->value == ">");
+        REQUIRE(where->left->left->left->value == "+");
+        REQUIRE(where->right->value == "AND");
+        REQUIRE(where->right->left->right->value == "Bob");
+        REQUIRE(where->right->right->value == "OR");
+        REQUIRE(where->right->right->right->right->value == "-5");
+    }
+
+    SECTION("SELECT with JOIN ... ON and qualified columns") {
+        std::string sql = "SELECT orders.id, name FROM orders JOIN customers ON orders.customer_id = customers.id "
+                          "INNER JOIN cities ON customers.city = cities.name AND cities.id > 0 WHERE amount > 10;";
+        auto ast = parseSQL(sql);
+
+        auto selectAst = dynamic_cast<SelectAST*>(ast.get());
+        REQUIRE(selectAst != nullptr);
+        REQUIRE(selectAst->columns == std::vector<std::string>{"orders.id", "name"});
+        REQUIRE(selectAst->tableName == "orders");
+        REQUIRE(selectAst->joins.size() == 2);
+        REQUIRE(selectAst->joins[0].tableName == "customers");
+        REQUIRE(selectAst->joins[0].on->left->value == "orders.customer_id");
+        REQUIRE(selectAst->joins[0].on->right->value == "customers.id");
+        REQUIRE(selectAst->joins[1].tableName == "cities");
+        REQUIRE(selectAst->joins[1].on->value == "AND");
+        REQUIRE(selectAst->condition.has_value());
+        REQUIRE(selectAst->condition.value().column == "amount");
+    }
+
+    SECTION("SELECT with aggregates and GROUP BY") {
+        std::string sql = "SELECT city, COUNT(*), sum(amount), AVG(amount) FROM orders WHERE amount > 0 GROUP BY city;";
+        auto ast = parseSQL(sql);
+
+        auto selectAst = dynamic_cast<SelectAST*>(ast.get());
+        REQUIRE(selectAst != nullptr);
+        REQUIRE(selectAst->columns == std::vector<std::string>{"city", "COUNT(*)", "SUM(amount)", "AVG(amount)"});
+        REQUIRE(selectAst->aggregates.size() == 3);
+        REQUIRE(selectAst->aggregates[0].func == "COUNT");
+        REQUIRE(selectAst->aggregates[0].column == "*");
+        REQUIRE(selectAst->aggregates[1].func == "SUM");
+        REQUIRE(selectAst->aggregates[1].column == "amount");
+        REQUIRE(selectAst->groupBy == std::vector<std::string>{"city"});
+        REQUIRE(selectAst->where != nullptr);
+
+        auto joined = parseSQL("SELECT customers.city, MAX(amount) FROM orders JOIN customers "
+                               "ON orders.customer_id = customers.id GROUP BY customers.city, orders.id;");
+        auto joinedAst = dynamic_cast<SelectAST*>(joined.get());
+        REQUIRE(joinedAst != nullptr);
+        REQUIRE(joinedAst->joins.size() == 1);
+        REQUIRE(joinedAst->groupBy == std::vector<std::string>{"customers.city", "orders.id"});
+
+        REQUIRE_THROWS(parseSQL("SELECT COUNT(*) FROM orders GROUP BY;"));
+        REQUIRE_THROWS(parseSQL("SELECT SUM() FROM orders;"));
+    }
+
+    SECTION("SELECT with ORDER BY") {
+        auto ast = parseSQL("SELECT name FROM users WHERE age > 18 ORDER BY age DESC, name, id ASC;");
+        auto selectAst = dynamic_cast<SelectAST*>(ast.get());
+        REQUIRE(selectAst != nullptr);
+        REQUIRE(selectAst->orderBy.size() == 3);
+        REQUIRE(selectAst->orderBy[0].column == "age");
+        REQUIRE_FALSE(selectAst->orderBy[0].ascending);
+        REQUIRE(selectAst->orderBy[1].column == "name");
+        REQUIRE(selectAst->orderBy[1].ascending);
+        REQUIRE(selectAst->orderBy[2].ascending);
+
+        auto grouped = parseSQL("SELECT age, COUNT(*) FROM users GROUP BY age ORDER BY age DESC;");
+        auto groupedAst = dynamic_cast<SelectAST*>(grouped.get());
+        REQUIRE(groupedAst->groupBy == std::vector<std::string>{"age"});
+        REQUIRE(groupedAst->orderBy.size() == 1);
+
+        REQUIRE_THROWS(parseSQL("SELECT name FROM users ORDER BY;"));
+        REQUIRE_THROWS(parseSQL("SELECT name FROM users ORDER age;"));
+    }
+
+    SECTION("SELECT with LIMIT and OFFSET") {
+        auto ast = parseSQL("SELECT * FROM users ORDER BY id DESC LIMIT 10 OFFSET 20;");
+        auto selectAst = dynamic_cast<SelectAST*>(ast.get());
+        REQUIRE(selectAst != nullptr);
+        REQUIRE(selectAst->limit == std::optional<size_t>(10));
+        REQUIRE(selectAst->offset == 20);
+
+        auto plain = parseSQL("SELECT name FROM users WHERE age > 18 LIMIT 0;");
+        auto plainAst = dynamic_cast<SelectAST*>(plain.get());
+        REQUIRE(plainAst->limit == std::optional<size_t>(0));
+        REQUIRE(plainAst->offset == 0);
+        REQUIRE_FALSE(dynamic_cast<SelectAST*>(parseSQL("SELECT * FROM users;").get())->limit.has_value());
+
+        REQUIRE_THROWS(parseSQL("SELECT * FROM users LIMIT;"));
+        REQUIRE_THROWS(parseSQL("SELECT * FROM users LIMIT 'ten';"));
+        REQUIRE_THROWS(parseSQL("SELECT * FROM users OFFSET 5;"));
+    }
 }
 
 // 测试DELETE语句解析
@@ -265,7 +396,7 @@ TEST_CASE("Complex SQL statement parsing", "[parser][complex]") {
         auto insertAst = dynamic_cast<InsertAST*>(ast.get());
         REQUIRE(insertAst != nullptr);
         REQUIRE(insertAst->tableName == "test");
-        REQUIRE(insertAst->values.size() == 3);
+        REQUIRE(insertAst->rows[0].size() == 3);
     }
 
     SECTION("Complex SELECT with multiple columns and WHERE clause") {
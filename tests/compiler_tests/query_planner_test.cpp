@@ -40,7 +40,7 @@ TEST_CASE("QueryPlanner - INSERT", "[query_planner][insert]") {
     SECTION("Simple INSERT") {
         InsertAST insertAst;
         insertAst.tableName = "students";
-        insertAst.values = {"1", "'Alice'"};
+        insertAst.rows = {{"1", "'Alice'"}};
 
         json plan = planner.generatePlan(&insertAst);
         printPlan(plan);
@@ -84,6 +84,160 @@ TEST_CASE("QueryPlanner - SELECT", "[query_planner][select]") {
         REQUIRE(plan["input"]["condition"]["op"] == "=");
         REQUIRE(plan["input"]["condition"]["value"] == "1");
     }
+
+    SECTION("SELECT with an expression WHERE") {
+        SelectAST selectAst;
+        selectAst.tableName = "students";
+        selectAst.columns = {"*"};
+        // id > 1 AND (age = 20 OR age = 21)
+        auto rhs = Expr::binary("OR", Expr::binary("=", Expr::column("age"), Expr::literal("20")),
+                                Expr::binary("=", Expr::column("age"), Expr::literal("21")));
+        selectAst.where = Expr::binary("AND", Expr::binary(">", Expr::column("id"), Expr::literal("1")), rhs);
+
+        json plan = planner.generatePlan(&selectAst);
+        printPlan(plan);
+
+        // 复杂合取项在上，简单比较紧贴扫描
+        const json& exprFilter = plan["input"];
+        REQUIRE(exprFilter["type"] == "Filter");
+        REQUIRE(exprFilter["expr"]["op"] == "OR");
+        REQUIRE(exprFilter["expr"]["left"]["left"]["column"] == "age");
+        REQUIRE(exprFilter["input"]["condition"]["column"] == "id");
+        REQUIRE(exprFilter["input"]["input"]["type"] == "SeqScan");
+    }
+
+    SECTION("SELECT with JOIN") {
+        SelectAST selectAst;
+        selectAst.tableName = "orders";
+        selectAst.columns = {"orders.id", "name"};
+        selectAst.joins.push_back({"customers", Expr::binary("=", Expr::column("customers.id"),
+                                                             Expr::column("orders.customer_id"))});
+        // customers.city = 'Paris' AND orders.amount > customers.id
+        selectAst.where = Expr::binary(
+            "AND", Expr::binary("=", Expr::column("customers.city"), Expr::literal("Paris")),
+            Expr::binary(">", Expr::column("orders.amount"), Expr::column("customers.id")));
+
+        json plan = planner.generatePlan(&selectAst);
+        printPlan(plan);
+
+        // 跨表条件在连接之上，单表条件下推到该表的扫描并去掉表名限定
+        const json& residual = plan["input"];
+        REQUIRE(residual["type"] == "Filter");
+        REQUIRE(residual["expr"]["left"]["column"] == "orders.amount");
+
+        const json& join = residual["input"];
+        REQUIRE(join["type"] == "Join");
+        REQUIRE(join["leftTable"] == "orders");
+        REQUIRE(join["rightTable"] == "customers");
+        REQUIRE(join["leftKeys"] == json::array({"orders.customer_id"}));
+        REQUIRE(join["rightKeys"] == json::array({"customers.id"}));
+        REQUIRE(join["left"]["type"] == "SeqScan");
+        REQUIRE(join["right"]["type"] == "Filter");
+        REQUIRE(join["right"]["condition"]["column"] == "city");
+        REQUIRE(join["right"]["input"]["tableName"] == "customers");
+    }
+
+    SECTION("SELECT with GROUP BY") {
+        SelectAST selectAst;
+        selectAst.tableName = "orders";
+        selectAst.columns = {"city", "COUNT(*)", "AVG(amount)"};
+        selectAst.aggregates = {{"COUNT", "*"}, {"AVG", "amount"}};
+        selectAst.groupBy = {"city"};
+
+        json plan = planner.generatePlan(&selectAst);
+        printPlan(plan);
+
+        // Aggregate 位于扫描之上、投影之下
+        REQUIRE(plan["type"] == "Project");
+        REQUIRE(plan["columns"] == json::array({"city", "COUNT(*)", "AVG(amount)"}));
+        const json& aggregate = plan["input"];
+        REQUIRE(aggregate["type"] == "Aggregate");
+        REQUIRE(aggregate["groupBy"] == json::array({"city"}));
+        REQUIRE(aggregate["aggregates"][0]["func"] == "COUNT");
+        REQUIRE(aggregate["aggregates"][1]["column"] == "amount");
+        REQUIRE(aggregate["input"]["type"] == "SeqScan");
+    }
+
+    SECTION("SELECT with ORDER BY") {
+        SelectAST selectAst;
+        selectAst.tableName = "users";
+        selectAst.columns = {"name"};
+        selectAst.orderBy = {{"age", false}, {"id", true}};
+
+        json plan = planner.generatePlan(&selectAst);
+        printPlan(plan);
+
+        // 排序在投影之下，排序列可以不在查询列中
+        const json& sort = plan["input"];
+        REQUIRE(sort["type"] == "Sort");
+        REQUIRE(sort["keys"][0]["column"] == "age");
+        REQUIRE(sort["keys"][0]["order"] == "DESC");
+        REQUIRE(sort["keys"][1]["order"] == "ASC");
+        REQUIRE(sort["input"]["type"] == "SeqScan");
+    }
+
+    SECTION("SELECT with ORDER BY and LIMIT") {
+        SelectAST selectAst;
+        selectAst.tableName = "users";
+        selectAst.columns = {"*"};
+        selectAst.orderBy = {{"id", false}};
+        selectAst.limit = 10;
+        selectAst.offset = 5;
+
+        json plan = planner.generatePlan(&selectAst);
+        printPlan(plan);
+
+        // Project -> Limit -> Sort：Limit 在排序之上、投影之下
+        const json& limit = plan["input"];
+        REQUIRE(limit["type"] == "Limit");
+        REQUIRE(limit["limit"] == 10);
+        REQUIRE(limit["offset"] == 5);
+        REQUIRE(limit["input"]["type"] == "Sort");
+    }
+}
+
+TEST_CASE("QueryPlanner - typed plan nodes", "[query_planner][plan_node]") {
+    QueryPlanner planner;
+
+    SECTION("buildPlan returns typed nodes") {
+        SelectAST selectAst;
+        selectAst.tableName = "students";
+        selectAst.columns = {"id"};
+        selectAst.condition = Condition{"id", ">", "1"};
+
+        PlanNodePtr plan = planner.buildPlan(&selectAst);
+        REQUIRE(plan->type == PlanNodeType::Project);
+        const auto& project = static_cast<const ProjectPlan&>(*plan);
+        REQUIRE(project.columns == std::vector<std::string>{"id"});
+        REQUIRE(project.input->type == PlanNodeType::Filter);
+        const auto& filter = static_cast<const FilterPlan&>(*project.input);
+        REQUIRE(filter.expr == nullptr);
+        REQUIRE(filter.condition.op == ">");
+        REQUIRE(filter.input->type == PlanNodeType::SeqScan);
+        REQUIRE(static_cast<const SeqScanPlan&>(*filter.input).tableName == "students");
+    }
+
+    SECTION("JSON plans round-trip through planFromJson") {
+        SelectAST selectAst;
+        selectAst.tableName = "students";
+        selectAst.columns = {"*"};
+        selectAst.where = Expr::binary("OR", Expr::binary("=", Expr::column("age"), Expr::literal("20")),
+                                       Expr::unary("NOT", Expr::binary("<", Expr::column("id"), Expr::literal("5"))));
+        selectAst.orderBy = {{"id", false}};
+        selectAst.limit = 3;
+
+        json plan = planner.generatePlan(&selectAst);
+        REQUIRE(planFromJson(plan)->toJson() == plan);
+    }
+
+    SECTION("Legacy Select plans become a scan with a filter") {
+        json legacy = {{"type", "Select"}, {"tableName", "students"},
+                       {"condition", {{"column", "id"}, {"op", "="}, {"value", 1}}}};
+        PlanNodePtr plan = planFromJson(legacy);
+        REQUIRE(plan->type == PlanNodeType::Filter);
+        REQUIRE(static_cast<const FilterPlan&>(*plan).condition.value == "1");
+        REQUIRE_THROWS_AS(planFromJson(json{{"type", "Nope"}}), std::runtime_error);
+    }
 }
 
 TEST_CASE("QueryPlanner - DELETE", "[query_planner][delete]") {
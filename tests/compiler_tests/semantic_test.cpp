@@ -104,7 +104,7 @@ TEST_CASE("INSERT analysis", "[semantic][insert]") {
     SECTION("Valid INSERT") {
         auto ast = std::make_unique<InsertAST>();
         ast->tableName = "test_table";
-        ast->values = {"1", "'Alice'", "25"};
+        ast->rows = {{"1", "'Alice'", "25"}};
 
         REQUIRE_NOTHROW(analyzer.analyze(ast.get()));
     }
@@ -112,7 +112,7 @@ TEST_CASE("INSERT analysis", "[semantic][insert]") {
     SECTION("Table not exists") {
         auto ast = std::make_unique<InsertAST>();
         ast->tableName = "nonexistent_table";
-        ast->values = {"1"};
+        ast->rows = {{"1"}};
 
         REQUIRE_THROWS_AS(analyzer.analyze(ast.get()), SemanticError);
     }
@@ -120,7 +120,7 @@ TEST_CASE("INSERT analysis", "[semantic][insert]") {
     SECTION("Value count mismatch") {
         auto ast = std::make_unique<InsertAST>();
         ast->tableName = "test_table";
-        ast->values = {"1", "'Alice'"}; // 缺少 age 值
+        ast->rows = {{"1", "'Alice'"}}; // 缺少 age 值
 
         REQUIRE_THROWS_AS(analyzer.analyze(ast.get()), SemanticError);
     }
@@ -128,7 +128,7 @@ TEST_CASE("INSERT analysis", "[semantic][insert]") {
     SECTION("Type mismatch") {
         auto ast = std::make_unique<InsertAST>();
         ast->tableName = "test_table";
-        ast->values = {"'not_a_number'", "'Alice'", "25"}; // id 应该是数字
+        ast->rows = {{"'not_a_number'", "'Alice'", "25"}}; // id 应该是数字
 
         REQUIRE_THROWS_AS(analyzer.analyze(ast.get()), SemanticError);
     }
@@ -180,6 +180,32 @@ TEST_CASE("SELECT analysis", "[semantic][select]") {
 
         REQUIRE_THROWS_AS(analyzer.analyze(ast.get()), SemanticError);
     }
+
+    SECTION("WHERE expression is type checked") {
+        auto ast = std::make_unique<SelectAST>();
+        ast->tableName = "test_table";
+        ast->columns = {"*"};
+
+        // age + 1 > 20 AND name = '42'：常量按另一侧列的类型解释
+        ast->where = Expr::binary("AND",
+            Expr::binary(">", Expr::binary("+", Expr::column("age"), Expr::literal("1")), Expr::literal("20")),
+            Expr::binary("=", Expr::column("name"), Expr::literal("42")));
+        REQUIRE_NOTHROW(analyzer.analyze(ast.get()));
+        REQUIRE(ast->where->type == "BOOLEAN");
+        REQUIRE(ast->where->right->right->type == "STRING");
+
+        // 算术只适用于 INT
+        ast->where = Expr::binary("=", Expr::binary("+", Expr::column("name"), Expr::literal("1")), Expr::literal("2"));
+        REQUIRE_THROWS_AS(analyzer.analyze(ast.get()), SemanticError);
+
+        // AND 的操作数必须是布尔表达式
+        ast->where = Expr::binary("AND", Expr::column("age"), Expr::binary("=", Expr::column("id"), Expr::literal("1")));
+        REQUIRE_THROWS_AS(analyzer.analyze(ast.get()), SemanticError);
+
+        // 不存在的列
+        ast->where = Expr::unary("NOT", Expr::binary("=", Expr::column("missing"), Expr::literal("1")));
+        REQUIRE_THROWS_AS(analyzer.analyze(ast.get()), SemanticError);
+    }
 }
 
 // 测试 DELETE 语句的语义分析
@@ -215,7 +215,7 @@ TEST_CASE("Catalog Manager Integration with Mock Storage", "[catalog][integratio
         // 测试INSERT验证
         InsertAST insert_ast;
         insert_ast.tableName = "users";
-        insert_ast.values = {"1", "'test'", "'test@example.com'"};
+        insert_ast.rows = {{"1", "'test'", "'test@example.com'"}};
         REQUIRE(catalog.validate_insert_ast(insert_ast));
 
         // 测试SELECT验证
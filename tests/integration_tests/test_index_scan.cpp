@@ -0,0 +1,171 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include "compiler/SQLCompiler.h"
+#include "engine/ExecutionEngine.h"
+#include "storage/BufferManager.h"
+#include "storage/DiskManager.h"
+#include "storage/FileManager.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+
+using namespace minidb;
+using json = nlohmann::json;
+
+namespace {
+
+    // SQL -> 计划 -> 执行的完整链路，数据库文件在析构时清理
+    struct SqlSession {
+        std::string db_name;
+        std::shared_ptr<CatalogManager> catalog;
+        std::unique_ptr<SQLCompiler> compiler;
+        std::unique_ptr<ExecutionEngine> engine;
+
+        explicit SqlSession(const std::string& name) : db_name(name) {
+            cleanup();
+            auto file_manager = std::make_shared<storage::FileManager>();
+            file_manager->createDatabase(db_name);
+            auto disk_manager = std::make_shared<storage::DiskManager>(file_manager);
+            auto buffer_manager = std::make_shared<storage::BufferManager>(disk_manager, 128);
+            catalog = std::make_shared<CatalogManager>();
+            compiler = std::make_unique<SQLCompiler>(*catalog);
+            engine = std::make_unique<ExecutionEngine>(catalog, buffer_manager);
+        }
+
+        ~SqlSession() { cleanup(); }
+
+        void cleanup() const {
+            std::error_code ec;
+            std::filesystem::remove(db_name + ".minidb", ec);
+        }
+
+        json plan(const std::string& sql) { return compiler->compile(sql); }
+        QueryResult run(const std::string& sql) { return engine->executePlan(plan(sql)); }
+    };
+
+} // namespace
+
+TEST_CASE("CREATE INDEX drives IndexScan plans", "[integration][index]") {
+    SqlSession session("test_index_scan");
+
+    session.run("CREATE TABLE users (id INT, name VARCHAR, age INT);");
+    for (int i = 0; i < 200; ++i) {
+        session.run("INSERT INTO users VALUES (" + std::to_string(i) + ", 'user" +
+                    std::to_string(i) + "', " + std::to_string(20 + i % 10) + ");");
+    }
+
+    SECTION("Planner keeps SeqScan without an index") {
+        json plan = session.plan("SELECT name FROM users WHERE id = 42;");
+        REQUIRE(plan["input"]["type"] == "Filter");
+        REQUIRE(plan["input"]["input"]["type"] == "SeqScan");
+    }
+
+    SECTION("Index on existing rows answers equality and range predicates") {
+        session.run("CREATE UNIQUE INDEX users_id ON users (id);");
+        session.run("CREATE INDEX users_age ON users (age);");
+        REQUIRE(session.catalog->get_table_indexes("users").size() == 2);
+
+        json plan = session.plan("SELECT name FROM users WHERE id = 42;");
+        REQUIRE(plan["type"] == "Project");
+        REQUIRE(plan["input"]["type"] == "IndexScan");
+        REQUIRE(plan["input"]["indexName"] == "users_id");
+
+        QueryResult point = session.engine->executePlan(plan);
+        REQUIRE(point.rowCount() == 1);
+        REQUIRE(point.getColumnNames() == std::vector<std::string>{"name"});
+        REQUIRE(point.getValue(0, 0) == "user42");
+
+        QueryResult range = session.run("SELECT id FROM users WHERE id >= 195;");
+        REQUIRE(range.rowCount() == 5);
+        REQUIRE(range.getValue(0, 0) == "195");
+        REQUIRE(range.getValue(4, 0) == "199");
+
+        // 非唯一索引返回全部重复键
+        QueryResult dup = session.run("SELECT * FROM users WHERE age = 23;");
+        REQUIRE(dup.rowCount() == 20);
+        for (size_t i = 0; i < dup.rowCount(); ++i) {
+            REQUIRE(dup.getValue(i, 2) == "23");
+        }
+    }
+
+    SECTION("Composite index takes the longest equality prefix and a trailing range") {
+        session.run("CREATE INDEX users_age_id ON users (age, id);");
+        session.run("CREATE INDEX users_age ON users (age);");
+
+        // age = 23 为等值前缀，id 上的两个比较组成区间，三个条件都由索引保证
+        json plan = session.plan("SELECT id FROM users WHERE id < 150 AND age = 23 AND id >= 100;");
+        REQUIRE(plan["input"]["type"] == "IndexScan");
+        REQUIRE(plan["input"]["indexName"] == "users_age_id");
+        REQUIRE(plan["input"]["prefix"].size() == 1);
+        REQUIRE(plan["input"]["range"].size() == 2);
+        QueryResult range = session.engine->executePlan(plan);
+        REQUIRE(range.rowCount() == 5);
+        REQUIRE(range.getValue(0, 0) == "103");
+        REQUIRE(range.getValue(4, 0) == "143");
+
+        json point = session.plan("SELECT name FROM users WHERE id = 42 AND age = 22;");
+        REQUIRE(point["input"]["indexName"] == "users_age_id");
+        REQUIRE(point["input"]["prefix"].size() == 2);
+        REQUIRE(session.engine->executePlan(point).getValue(0, 0) == "user42");
+
+        // 前缀一样长时选列数少的索引，其余条件留在 Filter 中
+        json partial = session.plan("SELECT id FROM users WHERE age = 25 AND name = 'user15';");
+        REQUIRE(partial["input"]["type"] == "Filter");
+        REQUIRE(partial["input"]["input"]["indexName"] == "users_age");
+        QueryResult filtered = session.engine->executePlan(partial);
+        REQUIRE(filtered.rowCount() == 1);
+        REQUIRE(filtered.getValue(0, 0) == "15");
+
+        // 首列没有条件时不能用组合索引
+        REQUIRE(session.plan("SELECT name FROM users WHERE id = 42;")["input"]["input"]["type"] == "SeqScan");
+    }
+
+    SECTION("Index is maintained by later inserts") {
+        session.run("CREATE INDEX users_name ON users (name);");
+        session.run("INSERT INTO users VALUES (500, 'late', 99);");
+
+        json plan = session.plan("SELECT id FROM users WHERE name = 'late';");
+        REQUIRE(plan["input"]["type"] == "IndexScan");
+        QueryResult result = session.engine->executePlan(plan);
+        REQUIRE(result.rowCount() == 1);
+        REQUIRE(result.getValue(0, 0) == "500");
+    }
+
+    SECTION("Unique index rejects duplicates") {
+        session.run("CREATE UNIQUE INDEX users_id ON users (id);");
+        REQUIRE_THROWS(session.run("INSERT INTO users VALUES (7, 'again', 30);"));
+
+        // UPDATE 到已有键时拒绝且原行不变；更新为自身的键不算冲突
+        auto update = [&](const json& updates, const std::string& where = "id = 7") {
+            json target = session.plan("SELECT * FROM users WHERE " + where + ";")["input"];
+            return session.engine->executePlan(
+                json{{"type", "Update"}, {"tableName", "users"}, {"updates", updates}, {"input", target}});
+        };
+        REQUIRE_THROWS(update(json::array({{{"column", "id"}, {"value", "8"}}})));
+        REQUIRE(session.run("SELECT name FROM users WHERE id = 7;").rowCount() == 1);
+        REQUIRE(session.run("SELECT name FROM users WHERE id = 8;").rowCount() == 1);
+        update(json::array({{{"column", "id"}, {"value", "7"}}, {{"column", "age"}, {"value", "99"}}}));
+        QueryResult updated = session.run("SELECT age FROM users WHERE id = 7;");
+        REQUIRE(updated.rowCount() == 1);
+        REQUIRE(updated.getValue(0, 0) == "99");
+        REQUIRE(session.run("SELECT id FROM users;").rowCount() == 200);
+
+        // 多行 UPDATE 在后面的行上冲突时整批拒绝，前面的行也保持原值
+        // 第一行改成 500 不与表中任何行冲突，第二行再改成 500 才冲突
+        REQUIRE_THROWS(update(json::array({{{"column", "id"}, {"value", "500"}}, {{"column", "age"}, {"value", "77"}}}),
+                              "id >= 198"));
+        REQUIRE(session.run("SELECT id FROM users WHERE id >= 198;").rowCount() == 2);
+        REQUIRE(session.run("SELECT id FROM users WHERE id = 500;").rowCount() == 0);
+        REQUIRE(session.run("SELECT id FROM users WHERE age = 77;").rowCount() == 0);
+        // 不改键的多行 UPDATE 不与本批其他行的旧条目冲突
+        update(json::array({{{"column", "age"}, {"value", "77"}}}), "id < 3");
+        REQUIRE(session.run("SELECT id FROM users WHERE age = 77;").rowCount() == 3);
+        REQUIRE(session.run("SELECT id FROM users WHERE id = 2;").getValue(0, 0) == "2");
+        REQUIRE_THROWS(session.run("CREATE UNIQUE INDEX users_age ON users (age);"));
+        REQUIRE_FALSE(session.catalog->index_exists("users_age"));
+    }
+
+    SECTION("Semantic errors") {
+        REQUIRE_THROWS(session.plan("CREATE INDEX bad ON users (missing);"));
+        REQUIRE_THROWS(session.plan("CREATE INDEX bad ON nowhere (id);"));
+    }
+}
@@ -0,0 +1,876 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include "compiler/SQLCompiler.h"
+#include "common/CsvReader.h"
+#include "engine/AggregateOperators.h"
+#include "engine/ExecutionEngine.h"
+#include "engine/JoinOperators.h"
+#include "engine/Operators.h"
+#include "engine/ParallelOperators.h"
+#include "engine/SortOperators.h"
+#include "storage/BufferManager.h"
+#include "storage/DiskManager.h"
+#include "storage/FileManager.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace minidb;
+using json = nlohmann::json;
+
+namespace {
+
+    // 建表并插入 n 行 (id, name, age)，age 在 20..29 间循环
+    struct OperatorFixture {
+        std::string db_name = "test_operators";
+        std::shared_ptr<CatalogManager> catalog;
+        std::unique_ptr<SQLCompiler> compiler;
+        std::shared_ptr<storage::BufferManager> buffer_manager;
+        std::unique_ptr<ExecutionEngine> engine;
+
+        explicit OperatorFixture(int rows) {
+            cleanup();
+            auto file_manager = std::make_shared<storage::FileManager>();
+            file_manager->createDatabase(db_name);
+            auto disk_manager = std::make_shared<storage::DiskManager>(file_manager);
+            buffer_manager = std::make_shared<storage::BufferManager>(disk_manager, 64);
+            catalog = std::make_shared<CatalogManager>();
+            compiler = std::make_unique<SQLCompiler>(*catalog);
+            engine = std::make_unique<ExecutionEngine>(catalog, buffer_manager);
+
+            run("CREATE TABLE users (id INT, name VARCHAR, age INT);");
+            for (int i = 0; i < rows; ++i) {
+                run("INSERT INTO users VALUES (" + std::to_string(i) + ", 'user" + std::to_string(i) +
+                    "', " + std::to_string(20 + i % 10) + ");");
+            }
+        }
+
+        ~OperatorFixture() { cleanup(); }
+
+        void cleanup() const {
+            std::error_code ec;
+            std::filesystem::remove(db_name + ".minidb", ec);
+        }
+
+        QueryResult run(const std::string& sql) { return engine->executePlan(compiler->compile(sql)); }
+    };
+
+    json seqScan() { return {{"type", "SeqScan"}, {"tableName", "users"}}; }
+
+    // 结果行排序后比较（连接、溢出后的聚合不保证输出顺序）
+    std::vector<std::string> rows(const QueryResult &result) {
+        std::vector<std::string> rows;
+        for (size_t r = 0; r < result.rowCount(); ++r) {
+            std::string row;
+            for (const auto &value : result.getRow(r)) row += value + "|";
+            rows.push_back(row);
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+} // namespace
+
+TEST_CASE("Volcano operators over a multi-page table", "[integration][operators]") {
+    OperatorFixture fx(300);
+
+    SECTION("SeqScan follows the page chain") {
+        QueryResult all = fx.run("SELECT * FROM users;");
+        REQUIRE(all.rowCount() == 300);
+        REQUIRE(all.getColumnNames() == std::vector<std::string>{"id", "name", "age"});
+        REQUIRE(all.getValue(299, 1) == "user299");
+    }
+
+    SECTION("Filter and Project") {
+        QueryResult result = fx.run("SELECT name FROM users WHERE age >= 28;");
+        REQUIRE(result.rowCount() == 60);
+        REQUIRE(result.getColumnNames() == std::vector<std::string>{"name"});
+        REQUIRE(result.getValue(0, 0) == "user8");
+    }
+
+    SECTION("Stacked filters are pushed into the scan") {
+        fx.engine->setVectorized(false);
+        json plan = {{"type", "Project"}, {"columns", {"name"}},
+                     {"input", {{"type", "Filter"},
+                                {"condition", {{"column", "id"}, {"op", "<"}, {"value", "100"}}},
+                                {"input", {{"type", "Filter"},
+                                           {"condition", {{"column", "age"}, {"op", "="}, {"value", "25"}}},
+                                           {"input", seqScan()}}}}}};
+        QueryResult result = fx.engine->executePlan(plan);
+        REQUIRE(result.rowCount() == 10);
+        REQUIRE(result.getColumnNames() == std::vector<std::string>{"name"});
+        REQUIRE(result.getValue(9, 0) == "user95");
+
+        QueryResult legacy = fx.engine->executePlan(
+            {{"type", "Select"}, {"tableName", "users"},
+             {"condition", {{"column", "name"}, {"op", "EQUALS"}, {"value", "'user7'"}}}});
+        REQUIRE(legacy.rowCount() == 1);
+        REQUIRE(legacy.getValue(0, 2) == "27");
+    }
+
+    SECTION("WHERE with AND/OR/NOT and arithmetic") {
+        // age 在 20..29 间循环
+        REQUIRE(fx.run("SELECT id FROM users WHERE age = 20 AND id < 100;").rowCount() == 10);
+        REQUIRE(fx.run("SELECT id FROM users WHERE age = 20 OR age = 21;").rowCount() == 60);
+        REQUIRE(fx.run("SELECT id FROM users WHERE NOT age < 28;").rowCount() == 60);
+        REQUIRE(fx.run("SELECT id FROM users WHERE age - 20 = id - 290;").rowCount() == 10);
+
+        QueryResult nested = fx.run(
+            "SELECT name FROM users WHERE (name = 'user5' OR name = 'user7') AND NOT (age + 1 = 26);");
+        REQUIRE(nested.rowCount() == 1);
+        REQUIRE(nested.getValue(0, 0) == "user7");
+
+        fx.run("DELETE FROM users WHERE age = 29 OR id < 10;");
+        REQUIRE(fx.run("SELECT * FROM users;").rowCount() == 300 - 30 - 9);
+    }
+
+    SECTION("Limit with offset") {
+        json plan = {{"type", "Limit"}, {"limit", 5}, {"offset", 10}, {"input", seqScan()}};
+        QueryResult result = fx.engine->executePlan(plan);
+        REQUIRE(result.rowCount() == 5);
+        REQUIRE(result.getValue(0, 0) == "10");
+        REQUIRE(result.getValue(4, 0) == "14");
+    }
+
+    SECTION("LIMIT stops the scan early and releases its pins") {
+        QueryResult page = fx.run("SELECT id, name FROM users LIMIT 3 OFFSET 5;");
+        REQUIRE(page.rowCount() == 3);
+        REQUIRE(page.getRow(0) == QueryResult::Row{"5", "user5"});
+        REQUIRE(fx.run("SELECT * FROM users LIMIT 0;").rowCount() == 0);
+        REQUIRE(fx.run("SELECT * FROM users LIMIT 10 OFFSET 295;").rowCount() == 5);
+        REQUIRE(fx.run("SELECT name FROM users WHERE age = 21 ORDER BY id DESC LIMIT 2;").getValue(1, 0) ==
+                "user281");
+
+        // 只读第一页：与扫描全表相比访问的页数是常数
+        size_t before = fx.buffer_manager->getHitCount() + fx.buffer_manager->getMissCount();
+        fx.run("SELECT * FROM users LIMIT 3;");
+        size_t fetched = fx.buffer_manager->getHitCount() + fx.buffer_manager->getMissCount() - before;
+        REQUIRE(fetched == 1);
+
+        // 取到第 limit 行时扫描已关闭，不必等到 close()
+        PageID first = fx.catalog->get_table("users")->getFirstPageID();
+        OperatorPtr root = fx.engine->buildOperator(fx.compiler->compile("SELECT id FROM users LIMIT 2;"));
+        root->open();
+        Tuple tuple;
+        REQUIRE(root->next(tuple));
+        REQUIRE(fx.buffer_manager->getPinCount(first) == 1);
+        REQUIRE(root->next(tuple));
+        REQUIRE(fx.buffer_manager->getPinCount(first) == 0);
+        REQUIRE_FALSE(root->next(tuple));
+        root->close();
+    }
+
+    SECTION("Sort descending then Limit") {
+        json sort = {{"type", "Sort"},
+                     {"keys", {{{"column", "age"}, {"order", "DESC"}}, {{"column", "id"}, {"order", "ASC"}}}},
+                     {"input", seqScan()}};
+        json plan = {{"type", "Limit"}, {"limit", 3}, {"input", sort}};
+        QueryResult result = fx.engine->executePlan(plan);
+        REQUIRE(result.rowCount() == 3);
+        REQUIRE(result.getValue(0, 0) == "9");
+        REQUIRE(result.getValue(1, 0) == "19");
+        REQUIRE(result.getValue(2, 2) == "29");
+    }
+
+    SECTION("Aggregate with and without GROUP BY") {
+        json grouped = {{"type", "Aggregate"},
+                        {"groupBy", {"age"}},
+                        {"aggregates", {{{"func", "COUNT"}, {"column", "*"}},
+                                        {{"func", "SUM"}, {"column", "id"}},
+                                        {{"func", "MAX"}, {"column", "name"}}}},
+                        {"input", seqScan()}};
+        QueryResult result = fx.engine->executePlan(grouped);
+        REQUIRE(result.rowCount() == 10);
+        REQUIRE(result.getColumnNames() ==
+                std::vector<std::string>{"age", "COUNT(*)", "SUM(id)", "MAX(name)"});
+        // age = 20 的组：id = 0, 10, ..., 290
+        REQUIRE(result.getValue(0, 0) == "20");
+        REQUIRE(result.getValue(0, 1) == "30");
+        REQUIRE(result.getValue(0, 2) == "4350");
+        REQUIRE(result.getValue(0, 3) == "user90");
+
+        json empty = {{"type", "Aggregate"},
+                      {"aggregates", {{{"func", "COUNT"}, {"column", "*"}}, {{"func", "MIN"}, {"column", "age"}}}},
+                      {"input", {{"type", "Filter"},
+                                 {"condition", {{"column", "age"}, {"op", ">"}, {"value", "99"}}},
+                                 {"input", seqScan()}}}};
+        QueryResult none = fx.engine->executePlan(empty);
+        REQUIRE(none.rowCount() == 1);
+        REQUIRE(none.getValue(0, 0) == "0");
+        REQUIRE(none.getValue(0, 1) == "NULL");
+    }
+
+    SECTION("Operators can be composed directly") {
+        OperatorPtr root = fx.engine->buildOperator(
+            {{"type", "Project"}, {"columns", {"id"}},
+             {"input", {{"type", "Filter"},
+                        {"condition", {{"column", "name"}, {"op", "="}, {"value", "'user42'"}}},
+                        {"input", seqScan()}}}});
+        root->open();
+        Tuple tuple;
+        REQUIRE(root->next(tuple));
+        REQUIRE(tuple.getValue(0).getAsInt() == 42);
+        REQUIRE(tuple.hasRid());
+        REQUIRE_FALSE(root->next(tuple));
+        root->close();
+    }
+
+    SECTION("DELETE only removes rows matching its filter") {
+        fx.run("DELETE FROM users WHERE age = 20;");
+        REQUIRE(fx.run("SELECT * FROM users;").rowCount() == 270);
+        REQUIRE(fx.run("SELECT id FROM users WHERE age = 20;").rowCount() == 0);
+    }
+}
+
+TEST_CASE("Vectorized execution matches row-at-a-time operators", "[integration][operators][vectorized]") {
+    // 超过一个批次（VECTOR_SIZE），覆盖跨批次、跨页的情况
+    OperatorFixture fx(1500);
+
+    auto compare = [&](const std::string &sql) {
+        json plan = fx.compiler->compile(sql);
+        REQUIRE(fx.engine->buildVectorOperator(plan) != nullptr);
+        fx.engine->setVectorized(true);
+        QueryResult batched = fx.engine->executePlan(plan);
+        fx.engine->setVectorized(false);
+        QueryResult rows = fx.engine->executePlan(plan);
+        fx.engine->setVectorized(true);
+
+        REQUIRE(batched.getColumnNames() == rows.getColumnNames());
+        REQUIRE(batched.rowCount() == rows.rowCount());
+        for (size_t r = 0; r < rows.rowCount(); ++r) {
+            for (size_t c = 0; c < rows.getColumnNames().size(); ++c) {
+                REQUIRE(batched.getValue(r, c) == rows.getValue(r, c));
+            }
+        }
+        return batched;
+    };
+
+    REQUIRE(compare("SELECT * FROM users;").rowCount() == 1500);
+    REQUIRE(compare("SELECT name, id FROM users WHERE age < 22;").rowCount() == 300);
+    REQUIRE(compare("SELECT id FROM users WHERE name = 'user1024';").rowCount() == 1);
+    REQUIRE(compare("SELECT age FROM users WHERE age != 25;").rowCount() == 1350);
+
+    // 不支持的计划回退到逐行算子
+    json limit = {{"type", "Limit"}, {"limit", 3}, {"input", seqScan()}};
+    REQUIRE(fx.engine->buildVectorOperator(limit) == nullptr);
+    REQUIRE(fx.engine->executePlan(limit).rowCount() == 3);
+}
+
+TEST_CASE("Hash join over orders and customers", "[integration][operators][join]") {
+    // users: id 0..49；customers: id 0..49，city 在 city0..city4 间循环；
+    // orders: id 0..399，customer_id = id % 60（50..59 没有对应的客户），amount = id
+    OperatorFixture fx(50);
+    fx.run("CREATE TABLE customers (id INT, name VARCHAR, city VARCHAR);");
+    fx.run("CREATE TABLE orders (id INT, customer_id INT, amount INT);");
+    for (int i = 0; i < 50; ++i) {
+        fx.run("INSERT INTO customers VALUES (" + std::to_string(i) + ", 'customer" + std::to_string(i) +
+               "', 'city" + std::to_string(i % 5) + "');");
+    }
+    for (int i = 0; i < 400; ++i) {
+        fx.run("INSERT INTO orders VALUES (" + std::to_string(i) + ", " + std::to_string(i % 60) + ", " +
+               std::to_string(i) + ");");
+    }
+
+    const std::string join = "SELECT orders.id, name FROM orders JOIN customers ON orders.customer_id = customers.id";
+
+    SECTION("Equi-join with pushed-down and cross-table filters") {
+        QueryResult result = fx.run(join + ";");
+        REQUIRE(result.getColumnNames() == std::vector<std::string>{"orders.id", "name"});
+        REQUIRE(result.rowCount() == 340);
+        REQUIRE(rows(result).front() == "0|customer0|");
+
+        REQUIRE(fx.run(join + " WHERE customers.city = 'city1' AND amount < 100;").rowCount() == 18);
+        REQUIRE(fx.run(join + " WHERE orders.amount = customers.id;").rowCount() == 50);
+        REQUIRE(fx.run("SELECT orders.id FROM orders JOIN customers ON orders.customer_id = customers.id "
+                       "JOIN users ON users.id = customers.id WHERE users.age = 20;").rowCount() == 34);
+    }
+
+    SECTION("Ambiguous and unknown columns are rejected") {
+        REQUIRE_THROWS(fx.run("SELECT id FROM orders JOIN customers ON orders.customer_id = customers.id;"));
+        REQUIRE_THROWS(fx.run("SELECT * FROM orders JOIN customers ON orders.amount > customers.id;"));
+        REQUIRE_THROWS(fx.run("SELECT * FROM orders JOIN customers ON orders.customer_id = users.id;"));
+    }
+
+    SECTION("Planner picks index nested-loop and merge joins") {
+        const std::string inlQuery = join + " WHERE customers.city = 'city1';";
+        const std::string mergeQuery = join + " WHERE orders.customer_id < 20 AND customers.id < 20;";
+        const std::string reverse = "SELECT customers.id FROM customers JOIN orders ON orders.customer_id = customers.id;";
+        auto hashInl = rows(fx.run(inlQuery));
+        auto hashMerge = rows(fx.run(mergeQuery));
+        auto hashReverse = rows(fx.run(reverse));
+        REQUIRE(hashInl.size() == 68);
+        REQUIRE(hashMerge.size() == 140);
+
+        // 内表连接键上有唯一索引：逐行点查索引
+        fx.run("CREATE UNIQUE INDEX customers_id ON customers (id);");
+        json plan = fx.compiler->compile(inlQuery);
+        REQUIRE(plan["input"]["input"]["algorithm"] == "indexNestedLoop");
+        REQUIRE(rows(fx.engine->executePlan(plan)) == hashInl);
+
+        // 两侧都是连接键上的索引扫描：归并
+        fx.run("CREATE INDEX orders_customer ON orders (customer_id);");
+        plan = fx.compiler->compile(mergeQuery);
+        REQUIRE(plan["input"]["algorithm"] == "merge");
+        REQUIRE(rows(fx.engine->executePlan(plan)) == hashMerge);
+
+        // 非唯一索引按前缀扫描
+        plan = fx.compiler->compile(reverse);
+        REQUIRE(plan["input"]["algorithm"] == "indexNestedLoop");
+        REQUIRE(rows(fx.engine->executePlan(plan)) == hashReverse);
+    }
+
+    SECTION("Build side larger than the memory budget spills to temp pages") {
+        QueryResult inMemory = fx.run(join + ";");
+
+        fx.engine->setOperatorMemoryBudget(1024);
+        QueryResult spilled = fx.run(join + ";");
+        REQUIRE(rows(spilled) == rows(inMemory));
+
+        json plan = fx.compiler->compile(join + ";");
+        OperatorPtr root = fx.engine->buildOperator(plan["input"]);
+        auto *hashJoin = dynamic_cast<HashJoinOperator *>(root.get());
+        REQUIRE(hashJoin != nullptr);
+        root->open();
+        REQUIRE(hashJoin->spilled());
+        size_t count = 0;
+        Tuple tuple;
+        while (root->next(tuple)) ++count;
+        root->close();
+        REQUIRE(count == 340);
+    }
+
+    SECTION("GROUP BY over a join") {
+        QueryResult result = fx.run("SELECT city, COUNT(*), MIN(orders.id) FROM orders JOIN customers "
+                                    "ON orders.customer_id = customers.id GROUP BY city;");
+        REQUIRE(result.getColumnNames() == std::vector<std::string>{"city", "COUNT(*)", "MIN(orders.id)"});
+        REQUIRE(rows(result) == std::vector<std::string>{"city0|68|0|", "city1|68|1|", "city2|68|2|",
+                                                         "city3|68|3|", "city4|68|4|"});
+    }
+}
+
+TEST_CASE("GROUP BY with hash aggregation", "[integration][operators][aggregate]") {
+    // age 在 20..29 间循环，每个 age 各 100 行
+    OperatorFixture fx(1000);
+    // 以下断言依赖串行 AggregateOperator 的首次出现顺序与类型；并行路径另见 [parallel] 测试
+    fx.engine->setParallelism(1);
+
+    SECTION("Aggregate functions with and without GROUP BY") {
+        QueryResult grouped = fx.run("SELECT age, COUNT(*), SUM(id), AVG(id), MIN(name) FROM users GROUP BY age;");
+        REQUIRE(grouped.rowCount() == 10);
+        REQUIRE(grouped.getColumnNames() ==
+                std::vector<std::string>{"age", "COUNT(*)", "SUM(id)", "AVG(id)", "MIN(name)"});
+        // 分组按首次出现的顺序输出；age = 20 的组：id = 0, 10, ..., 990
+        REQUIRE(grouped.getRow(0) == QueryResult::Row{"20", "100", "49500", "495", "user0"});
+
+        // 查询列顺序可以与分组列不同
+        QueryResult reordered = fx.run("SELECT MAX(id), age FROM users WHERE id < 500 GROUP BY age;");
+        REQUIRE(reordered.getRow(9) == QueryResult::Row{"499", "29"});
+
+        // 26..29 的平均值 27.5 向零截断
+        QueryResult total = fx.run("SELECT COUNT(*), AVG(age), COUNT(name) FROM users WHERE age > 25;");
+        REQUIRE(total.getRow(0) == QueryResult::Row{"400", "27", "400"});
+        REQUIRE(fx.run("SELECT COUNT(*), SUM(id) FROM users WHERE age > 99;").getRow(0) ==
+                QueryResult::Row{"0", "NULL"});
+    }
+
+    SECTION("Invalid aggregate queries are rejected") {
+        REQUIRE_THROWS(fx.run("SELECT name, COUNT(*) FROM users GROUP BY age;"));
+        REQUIRE_THROWS(fx.run("SELECT * FROM users GROUP BY age;"));
+        REQUIRE_THROWS(fx.run("SELECT SUM(name) FROM users;"));
+        REQUIRE_THROWS(fx.run("SELECT MAX(*) FROM users;"));
+        REQUIRE_THROWS(fx.run("SELECT COUNT(*) FROM users GROUP BY missing;"));
+    }
+
+    SECTION("Results outside the INTEGER range are rejected instead of wrapping") {
+        fx.run("INSERT INTO users VALUES (2000, 'big', 2000000000);");
+        fx.run("INSERT INTO users VALUES (2001, 'big', 2000000000);");
+        // 累加在 64 位上进行：平均值仍在范围内，总和超过 INT32_MAX
+        REQUIRE(fx.run("SELECT COUNT(*), AVG(age) FROM users WHERE name = 'big';").getRow(0) ==
+                QueryResult::Row{"2", "2000000000"});
+        REQUIRE_THROWS_AS(fx.run("SELECT SUM(age) FROM users WHERE name = 'big';"), DatabaseException);
+        REQUIRE_THROWS_AS(fx.run("SELECT name, SUM(age) FROM users GROUP BY name;"), DatabaseException);
+        REQUIRE_THROWS_AS(fx.run("SELECT SUM(age) FROM users;"), DatabaseException);
+    }
+
+    SECTION("More groups than the memory budget spill to temp pages") {
+        // 整数键走特化的哈希表，VARCHAR 键走编码后的通用哈希表
+        for (const std::string column : {"id", "name"}) {
+            const std::string sql = "SELECT " + column + ", COUNT(*), SUM(age) FROM users GROUP BY " + column + ";";
+            fx.engine->setOperatorMemoryBudget(DEFAULT_OPERATOR_MEMORY_BUDGET);
+            QueryResult inMemory = fx.run(sql);
+            REQUIRE(inMemory.rowCount() == 1000);
+
+            fx.engine->setOperatorMemoryBudget(4096);
+            REQUIRE(rows(fx.run(sql)) == rows(inMemory));
+
+            json plan = fx.compiler->compile(sql);
+            OperatorPtr root = fx.engine->buildOperator(plan["input"]);
+            auto *aggregate = dynamic_cast<AggregateOperator *>(root.get());
+            REQUIRE(aggregate != nullptr);
+            root->open();
+            REQUIRE(aggregate->spilled());
+            size_t count = 0;
+            Tuple tuple;
+            while (root->next(tuple)) ++count;
+            root->close();
+            REQUIRE(count == 1000);
+        }
+    }
+}
+
+TEST_CASE("ORDER BY with external merge sort", "[integration][operators][sort]") {
+    // age 在 20..29 间循环
+    OperatorFixture fx(1500);
+    const std::string query = "SELECT id, age FROM users ORDER BY age DESC, name;";
+
+    SECTION("Multi-key ORDER BY") {
+        QueryResult result = fx.run(query);
+        REQUIRE(result.rowCount() == 1500);
+        REQUIRE(result.getColumnNames() == std::vector<std::string>{"id", "age"});
+        // age = 29 的行按 name 的字典序：user1009, user1019, ..., user109, user1099, ...
+        REQUIRE(result.getRow(0) == QueryResult::Row{"1009", "29"});
+        REQUIRE(result.getRow(1) == QueryResult::Row{"1019", "29"});
+        REQUIRE(result.getValue(1499, 1) == "20");
+
+        // 排序列不在查询列中；聚合后按分组列排序
+        REQUIRE(fx.run("SELECT name FROM users WHERE id < 30 ORDER BY age, id DESC;").getValue(0, 0) == "user20");
+        QueryResult grouped = fx.run("SELECT age, COUNT(*) FROM users GROUP BY age ORDER BY age DESC;");
+        REQUIRE(grouped.getRow(0) == QueryResult::Row{"29", "150"});
+
+        REQUIRE_THROWS(fx.run("SELECT id FROM users ORDER BY missing;"));
+        REQUIRE_THROWS(fx.run("SELECT age, COUNT(*) FROM users GROUP BY age ORDER BY id;"));
+    }
+
+    SECTION("Runs larger than the memory budget are merged from temp pages") {
+        QueryResult inMemory = fx.run(query);
+
+        fx.engine->setOperatorMemoryBudget(4096);
+        QueryResult external = fx.run(query);
+        REQUIRE(external.rowCount() == inMemory.rowCount());
+        for (size_t r = 0; r < inMemory.rowCount(); ++r) {
+            REQUIRE(external.getRow(r) == inMemory.getRow(r));
+        }
+
+        json plan = fx.compiler->compile(query);
+        OperatorPtr root = fx.engine->buildOperator(plan["input"]);
+        auto *sort = dynamic_cast<SortOperator *>(root.get());
+        REQUIRE(sort != nullptr);
+        root->open();
+        REQUIRE(sort->runCount() > 2);
+        size_t count = 0;
+        Tuple tuple;
+        while (root->next(tuple)) ++count;
+        root->close();
+        REQUIRE(count == 1500);
+    }
+
+    SECTION("ORDER BY with LIMIT keeps only the top rows") {
+        json sortPlan = fx.compiler->compile(query)["input"];
+        QueryResult full = fx.engine->executePlan(sortPlan);
+
+        json limit = {{"type", "Limit"}, {"limit", 5}, {"offset", 3}, {"input", sortPlan}};
+        QueryResult top = fx.engine->executePlan(limit);
+        REQUIRE(top.rowCount() == 5);
+        for (size_t r = 0; r < 5; ++r) {
+            REQUIRE(top.getRow(r) == full.getRow(r + 3));
+        }
+
+        SortOperator topN(fx.engine->buildOperator(seqScan()), {{2, false}, {0, true}}, nullptr,
+                          DEFAULT_OPERATOR_MEMORY_BUDGET, 3);
+        topN.open();
+        REQUIRE(topN.usedTopN());
+        Tuple tuple;
+        std::vector<int32_t> ids;
+        while (topN.next(tuple)) ids.push_back(tuple.getValue(0).getAsInt());
+        topN.close();
+        REQUIRE(ids == std::vector<int32_t>{9, 19, 29});
+    }
+}
+
+TEST_CASE("Result cursor streams typed rows", "[integration][operators][cursor]") {
+    OperatorFixture fx(300);
+    PageID first = fx.catalog->get_table("users")->getFirstPageID();
+
+    for (bool vectorized : {true, false}) {
+        fx.engine->setVectorized(vectorized);
+
+        ResultCursor cursor = fx.engine->openCursor(fx.compiler->compile("SELECT id, name FROM users WHERE age = 25;"));
+        REQUIRE(cursor.getColumnNames() == std::vector<std::string>{"id", "name"});
+        REQUIRE(cursor.getColumnTypes() == std::vector<TypeId>{TypeId::INTEGER, TypeId::VARCHAR});
+
+        // 行以带类型的值交付，扫描仍停在第一页上
+        Tuple tuple;
+        REQUIRE(cursor.next(tuple));
+        REQUIRE(tuple.getValue(0).getType() == TypeId::INTEGER);
+        REQUIRE(tuple.getValue(0).getAsInt() == 5);
+        REQUIRE(tuple.getValue(1).getAsString() == "user5");
+
+        std::vector<Tuple> batch;
+        REQUIRE(cursor.nextBatch(batch, 4) == 4);
+        REQUIRE(batch.back().getValue(0).getAsInt() == 45);
+        REQUIRE(cursor.rowsProduced() == 5);
+
+        // 提前关闭立即释放 pin
+        cursor.close();
+        REQUIRE_FALSE(cursor.isOpen());
+        REQUIRE_FALSE(cursor.next(tuple));
+        REQUIRE(fx.buffer_manager->getPinCount(first) == 0);
+    }
+
+    SECTION("Draining the cursor matches executePlan") {
+        json plan = fx.compiler->compile("SELECT name FROM users ORDER BY age DESC, id;");
+        QueryResult result = fx.engine->executePlan(plan);
+        ResultCursor cursor = fx.engine->openCursor(plan);
+        std::vector<Tuple> all;
+        while (cursor.nextBatch(all, 64) > 0) {}
+        REQUIRE_FALSE(cursor.isOpen());
+        REQUIRE(all.size() == result.rowCount());
+        for (size_t r = 0; r < all.size(); ++r) {
+            REQUIRE(all[r].getValue(0).getAsString() == result.getRow(r)[0]);
+        }
+    }
+
+    SECTION("Exporting a query streams it through the writer") {
+        json plan = fx.compiler->compile("SELECT id, name FROM users WHERE id < 3;");
+        OutputBuffer csv;
+        REQUIRE(fx.engine->exportQuery(plan, csv, ResultWriter::Format::CSV) == 3);
+        REQUIRE(csv.str() == "id,name\n0,user0\n1,user1\n2,user2\n");
+
+        OutputBuffer jsonOut;
+        fx.engine->exportQuery(plan, jsonOut, ResultWriter::Format::JSON);
+        REQUIRE(jsonOut.str() == fx.engine->executePlan(plan).toJsonString());
+        REQUIRE(json::parse(jsonOut.str())[2]["name"] == "user2");
+    }
+
+    SECTION("Statements without rows cannot be opened as cursors") {
+        REQUIRE(ExecutionEngine::isQuery(fx.compiler->compile("SELECT * FROM users;")));
+        json insert = fx.compiler->compile("INSERT INTO users VALUES (1000, 'x', 1);");
+        REQUIRE_FALSE(ExecutionEngine::isQuery(insert));
+        REQUIRE_THROWS(fx.engine->openCursor(insert));
+    }
+}
+
+TEST_CASE("Prepared statements reuse cached plans", "[integration][operators][prepared]") {
+    OperatorFixture fx(50);
+
+    SECTION("Parameters are bound per execution") {
+        PreparedStatement insert = fx.compiler->prepare("INSERT INTO users VALUES (?, ?, ?);");
+        REQUIRE(insert.parameterCount() == 3);
+        for (int i = 100; i < 110; ++i) {
+            fx.engine->executePlan(insert.bind({Value(i), Value("p'" + std::to_string(i)), Value(7)}).plan());
+        }
+
+        PreparedStatement select = fx.compiler->prepare("SELECT id, name FROM users WHERE age = ? AND id >= ?;");
+        QueryResult result = fx.engine->executePlan(select.bind({Value(7), Value(105)}).plan());
+        REQUIRE(result.rowCount() == 5);
+        REQUIRE(result.getValue(0, 1) == "p'105");
+        result = fx.engine->executePlan(select.bind(2, Value(0)).plan());
+        REQUIRE(result.rowCount() == 10);
+
+        // 与占位符写法相同的字符串常量不是参数
+        PreparedStatement literal = fx.compiler->prepare("SELECT id FROM users WHERE name = '?1' OR id = ?;");
+        REQUIRE(literal.parameterCount() == 1);
+        REQUIRE(fx.engine->executePlan(literal.bind(1, Value(3)).plan()).rowCount() == 1);
+
+        PreparedStatement remove = fx.compiler->prepare("DELETE FROM users WHERE age = ?;");
+        fx.engine->executePlan(remove.bind(1, Value(7)).plan());
+        REQUIRE(fx.run("SELECT * FROM users;").rowCount() == 50);
+    }
+
+    SECTION("Plans are cached by normalized SQL and invalidated by catalog changes") {
+        REQUIRE(SQLCompiler::normalizeSql("  SELECT  *\n FROM users  WHERE name = 'a  b' ; ") ==
+                "SELECT * FROM users WHERE name = 'a  b';");
+
+        PreparedStatement first = fx.compiler->prepare("SELECT id FROM users WHERE id = ?;");
+        PreparedStatement second = fx.compiler->prepare("SELECT id   FROM users WHERE id = ?");
+        REQUIRE(fx.compiler->planCacheSize() == 1);
+        // 两个语句共享缓存计划，但交替绑定、执行时互不影响
+        const PlanNode &firstPlan = first.bind(1, Value(1)).plan();
+        const PlanNode &secondPlan = second.bind(1, Value(2)).plan();
+        REQUIRE(fx.engine->executePlan(firstPlan).getValue(0, 0) == "1");
+        REQUIRE(fx.engine->executePlan(secondPlan).getValue(0, 0) == "2");
+        REQUIRE(fx.engine->executePlan(first.bind(1, Value(3)).plan()).getValue(0, 0) == "3");
+        REQUIRE(fx.engine->executePlan(secondPlan).getValue(0, 0) == "2");
+        REQUIRE(fx.compiler->planCacheSize() == 1);
+        REQUIRE(first.plan().type == PlanNodeType::Project);
+        REQUIRE(static_cast<const ProjectPlan &>(first.plan()).input->type == PlanNodeType::Filter);
+
+        // 建索引后重新编译，改用索引扫描
+        fx.run("CREATE INDEX idx_id ON users (id);");
+        const PlanNode &plan = first.plan();
+        REQUIRE(static_cast<const ProjectPlan &>(plan).input->type == PlanNodeType::IndexScan);
+        QueryResult result = fx.engine->executePlan(first.bind(1, Value(42)).plan());
+        REQUIRE(result.rowCount() == 1);
+        REQUIRE(result.getValue(0, 0) == "42");
+    }
+
+    SECTION("Invalid statements and bindings are rejected") {
+        REQUIRE_THROWS(fx.compiler->prepare("CREATE TABLE t (id INT);"));
+        REQUIRE_THROWS(fx.compiler->compilePlan("SELECT * FROM users WHERE id = ?;"));
+        REQUIRE_FALSE(fx.catalog->table_exists("t"));
+
+        PreparedStatement select = fx.compiler->prepare("SELECT id FROM users WHERE id = ?;");
+        REQUIRE_THROWS_AS(select.plan(), DatabaseException);
+        REQUIRE_THROWS_AS(select.bind(2, Value(1)), OutOfRangeException);
+        REQUIRE_THROWS_AS(select.bind(1, Value()), TypeMismatchException);
+
+        std::vector<Value> values = parseParameterValues(" 12, 'a, \\'b', TRUE, -3 ");
+        REQUIRE(values.size() == 4);
+        REQUIRE(values[0].getAsInt() == 12);
+        REQUIRE(values[1].getAsString() == "a, 'b");
+        REQUIRE(values[2].getAsBool());
+        REQUIRE(values[3].getAsInt() == -3);
+        REQUIRE(parseParameterValues("").empty());
+        REQUIRE_THROWS(parseParameterValues("abc"));
+    }
+}
+
+TEST_CASE("Multi-row INSERT and COPY bulk load", "[integration][operators][copy]") {
+    OperatorFixture fx(10);
+    const std::string csv_path = "test_operators_copy.csv";
+    auto writeFile = [&](const std::string &text) {
+        std::ofstream(csv_path, std::ios::binary) << text;
+    };
+
+    SECTION("INSERT accepts several rows in one statement") {
+        fx.run("INSERT INTO users VALUES (100, 'a', 1), (101, 'b', 2), (102, 'c', 3);");
+        QueryResult result = fx.run("SELECT id, name FROM users WHERE id >= 100;");
+        REQUIRE(result.rowCount() == 3);
+        REQUIRE(result.getValue(2, 1) == "c");
+
+        json plan = fx.compiler->compile("INSERT INTO users VALUES (200, 'x', 1), (201, 'y', 2);");
+        REQUIRE(plan["rows"].size() == 2);
+        REQUIRE(planFromJson(plan)->toJson()["rows"] == plan["rows"]);
+
+        PreparedStatement insert = fx.compiler->prepare("INSERT INTO users VALUES (?, 'p', 5), (?, 'q', 5);");
+        REQUIRE(insert.parameterCount() == 2);
+        fx.engine->executePlan(insert.bind({Value(300), Value(301)}).plan());
+        REQUIRE(fx.run("SELECT id FROM users WHERE age = 5;").rowCount() == 2);
+
+        REQUIRE_THROWS(fx.compiler->compile("INSERT INTO users VALUES (1, 'a', 1), (2, 'b');"));
+
+        // 任何一行违反唯一索引时整条语句都不写入，包括本批内部的重复键
+        fx.run("CREATE UNIQUE INDEX idx_id ON users (id);");
+        REQUIRE_THROWS_WITH(fx.run("INSERT INTO users VALUES (400, 'a', 7), (401, 'b', 7), (400, 'c', 7);"),
+                            Catch::Matchers::ContainsSubstring("Duplicate"));
+        REQUIRE_THROWS_WITH(fx.run("INSERT INTO users VALUES (402, 'd', 7), (100, 'e', 7);"),
+                            Catch::Matchers::ContainsSubstring("Duplicate"));
+        REQUIRE(fx.run("SELECT id FROM users WHERE age = 7;").rowCount() == 0);
+        fx.run("INSERT INTO users VALUES (400, 'a', 7), (401, 'b', 7);");
+        REQUIRE(fx.run("SELECT id FROM users WHERE age = 7;").rowCount() == 2);
+    }
+
+    SECTION("COPY loads a multi-page CSV file") {
+        std::string text = "id,name,age\r\n";
+        for (int i = 1000; i < 4000; ++i) {
+            text += std::to_string(i) + ",copy" + std::to_string(i) + "," + std::to_string(i % 50) + "\r\n";
+        }
+        text += "4000,\"comma, \"\"quote\"\"\nnewline\",7\n\n4001,,+8";
+        writeFile(text);
+
+        QueryResult loaded = fx.run("COPY users FROM '" + csv_path + "' HEADER;");
+        REQUIRE(loaded.getValue(0, 0) == "3002");
+        REQUIRE(fx.run("SELECT * FROM users;").rowCount() == 3012);
+        REQUIRE(fx.run("SELECT id FROM users WHERE age = 49;").rowCount() == 60);
+
+        QueryResult special = fx.run("SELECT name, age FROM users WHERE id >= 4000;");
+        REQUIRE(special.rowCount() == 2);
+        REQUIRE(special.getValue(0, 0) == "comma, \"quote\"\nnewline");
+        REQUIRE(special.getValue(1, 0) == "");
+        REQUIRE(special.getValue(1, 1) == "8");
+
+        // 导出的 CSV 可以再导入
+        OutputBuffer out;
+        fx.engine->exportQuery(fx.compiler->compilePlan("SELECT * FROM users WHERE id >= 3990;")->toJson(), out,
+                               ResultWriter::Format::CSV);
+        writeFile(out.str());
+        fx.run("CREATE TABLE users_copy (id INT, name VARCHAR, age INT);");
+        REQUIRE(fx.run("COPY users_copy FROM '" + csv_path + "' HEADER;").getValue(0, 0) == "12");
+        REQUIRE(rows(fx.run("SELECT * FROM users_copy;")) == rows(fx.run("SELECT * FROM users WHERE id >= 3990;")));
+    }
+
+    SECTION("COPY maintains indexes and reports bad rows") {
+        fx.run("CREATE UNIQUE INDEX idx_id ON users (id);");
+        writeFile("20,a,1\n21,b,2\n");
+        fx.run("COPY users FROM '" + csv_path + "';");
+        QueryResult found = fx.run("SELECT name FROM users WHERE id = 21;");
+        REQUIRE(found.rowCount() == 1);
+        REQUIRE(found.getValue(0, 0) == "b");
+
+        // 出错前导入的行保留，出错的行不写入
+        writeFile("30,c,1\n20,dup,1\n");
+        REQUIRE_THROWS_WITH(fx.run("COPY users FROM '" + csv_path + "';"), Catch::Matchers::ContainsSubstring("Duplicate"));
+        writeFile("31,d,1\n32,e,x\n");
+        REQUIRE_THROWS_WITH(fx.run("COPY users FROM '" + csv_path + "';"), Catch::Matchers::ContainsSubstring("line 2"));
+        writeFile("33,f\n");
+        REQUIRE_THROWS(fx.run("COPY users FROM '" + csv_path + "';"));
+        REQUIRE(fx.run("SELECT * FROM users;").rowCount() == 14);
+
+        REQUIRE_THROWS_AS(fx.run("COPY users FROM 'missing_file.csv';"), FileNotFoundException);
+        REQUIRE_THROWS(fx.compiler->compile("COPY missing FROM 'a.csv';"));
+    }
+
+    SECTION("CsvReader handles records split across chunks") {
+        writeFile("a,\"b\"\"c\",d\r\n\"x\ny\",,\n,\n\"tail\"");
+        CsvReader reader(csv_path, 3);
+        std::vector<std::string_view> fields;
+        std::vector<std::vector<std::string>> records;
+        while (reader.next(fields)) {
+            records.emplace_back(fields.begin(), fields.end());
+        }
+        REQUIRE(records == std::vector<std::vector<std::string>>{
+                               {"a", "b\"c", "d"}, {"x\ny", "", ""}, {"", ""}, {"tail"}});
+        REQUIRE(reader.lineNumber() == 5);
+
+        writeFile("\"open,1\n");
+        CsvReader broken(csv_path);
+        REQUIRE_THROWS_AS(broken.next(fields), DatabaseException);
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(csv_path, ec);
+}
+
+TEST_CASE("Morsel-driven parallel scan and aggregation", "[integration][operators][parallel]") {
+    OperatorFixture fx(0);
+    const std::string csv_path = "test_operators_parallel.csv";
+    {
+        std::ofstream out(csv_path, std::ios::binary);
+        for (int i = 0; i < 20000; ++i) {
+            out << i << ",user" << i << "," << 20 + i % 10 << "\n";
+        }
+    }
+    fx.run("COPY users FROM '" + csv_path + "';");
+    fx.engine->setParallelism(4);
+
+    // 并行与串行（parallelism = 1）的结果一致；scan 为 true 时连行序也一致
+    auto compare = [&](const std::string &sql, bool scan) {
+        QueryResult parallel = fx.run(sql);
+        fx.engine->setParallelism(1);
+        QueryResult serial = fx.run(sql);
+        fx.engine->setParallelism(4);
+
+        REQUIRE(parallel.getColumnNames() == serial.getColumnNames());
+        for (size_t c = 0; c < serial.getColumnNames().size(); ++c) {
+            REQUIRE(parallel.getColumnType(c) == serial.getColumnType(c));
+        }
+        if (scan) {
+            REQUIRE(parallel.rowCount() == serial.rowCount());
+            for (size_t r = 0; r < serial.rowCount(); ++r) {
+                REQUIRE(parallel.getRow(r) == serial.getRow(r));
+            }
+        } else {
+            REQUIRE(rows(parallel) == rows(serial));
+        }
+        return parallel;
+    };
+
+    SECTION("Scans are split into morsels and keep the serial row order") {
+        json plan = fx.compiler->compile("SELECT name, id FROM users WHERE age < 22;");
+        VectorOperatorPtr scan = fx.engine->buildVectorOperator(plan);
+        REQUIRE(dynamic_cast<ParallelScanOperator *>(scan.get()) != nullptr);
+
+        // 只取一批就关闭：尚未开始的 morsel 被取消，close() 等已提交的任务结束
+        scan->open();
+        DataChunk chunk;
+        REQUIRE(scan->nextBatch(chunk));
+        REQUIRE(chunk.activeCount() > 0);
+        scan->close();
+
+        REQUIRE(compare("SELECT * FROM users;", true).rowCount() == 20000);
+        REQUIRE(compare("SELECT id FROM users LIMIT 5;", true).rowCount() == 5);
+        REQUIRE(compare("SELECT name, id FROM users WHERE age < 22;", true).rowCount() == 4000);
+        REQUIRE(compare("SELECT id FROM users WHERE name = 'user12345';", true).rowCount() == 1);
+    }
+
+    SECTION("Aggregates run partially in each worker and are merged") {
+        json plan = fx.compiler->compile("SELECT age, COUNT(*) FROM users GROUP BY age;");
+        REQUIRE(dynamic_cast<ParallelAggregateOperator *>(fx.engine->buildOperator(plan["input"]).get()) != nullptr);
+
+        QueryResult grouped = compare("SELECT age, COUNT(*), SUM(id), AVG(id), MIN(name), MAX(id) FROM users "
+                                      "WHERE id < 15000 GROUP BY age;", false);
+        REQUIRE(grouped.rowCount() == 10);
+        REQUIRE(compare("SELECT COUNT(*), AVG(age), COUNT(name) FROM users WHERE age > 25;", false).getRow(0) ==
+                QueryResult::Row{"8000", "27", "8000"});
+        REQUIRE(compare("SELECT COUNT(*), SUM(id) FROM users WHERE age > 99;", false).getRow(0) ==
+                QueryResult::Row{"0", "NULL"});
+        REQUIRE(compare("SELECT id, COUNT(*) FROM users GROUP BY id;", false).rowCount() == 20000);
+    }
+
+    SECTION("Partial results spill under a small memory budget") {
+        fx.engine->setOperatorMemoryBudget(4096);
+        for (const std::string column : {"id", "name"}) {
+            const std::string sql = "SELECT " + column + ", COUNT(*), SUM(age), MIN(name) FROM users GROUP BY " +
+                                    column + ";";
+            OperatorPtr root = fx.engine->buildOperator(fx.compiler->compile(sql)["input"]);
+            auto *aggregate = dynamic_cast<ParallelAggregateOperator *>(root.get());
+            REQUIRE(aggregate != nullptr);
+            root->open();
+            REQUIRE(aggregate->spilled());
+            size_t count = 0;
+            Tuple tuple;
+            while (root->next(tuple)) ++count;
+            root->close();
+            REQUIRE(count == 20000);
+
+            REQUIRE(compare(sql, false).rowCount() == 20000);
+        }
+        REQUIRE(compare("SELECT COUNT(*), SUM(id) FROM users;", false).getRow(0) ==
+                QueryResult::Row{"20000", "199990000"});
+    }
+
+    SECTION("Read paths fall back to the page chain for tables without a directory") {
+        // 模拟没有目录的旧表：新引擎上查询不建立目录，第一次写入时才建立
+        TableInfo *users = fx.catalog->get_table("users");
+        users->setDirectoryPageID(INVALID_PAGE_ID);
+        ExecutionEngine engine(fx.catalog, fx.buffer_manager);
+        engine.setParallelism(4);
+        json plan = fx.compiler->compile("SELECT id FROM users WHERE age = 21;");
+        REQUIRE(dynamic_cast<ParallelScanOperator *>(engine.buildVectorOperator(plan).get()) != nullptr);
+        REQUIRE(engine.executePlan(plan).rowCount() == 2000);
+        REQUIRE(users->getDirectoryPageID() == INVALID_PAGE_ID);
+
+        engine.executePlan(fx.compiler->compile("INSERT INTO users VALUES (20000, 'user20000', 21);"));
+        REQUIRE(users->getDirectoryPageID() != INVALID_PAGE_ID);
+        REQUIRE(engine.executePlan(plan).rowCount() == 2001);
+    }
+
+    SECTION("Partial sums are merged as 64-bit values") {
+        // 每个线程的部分和都远超 INT32_MAX，只有合并后的 AVG 落回 INTEGER 范围
+        {
+            std::ofstream out(csv_path, std::ios::binary);
+            for (int i = 0; i < 40000; ++i) {
+                out << i % 4 << "," << 2000000000 - i % 2 << "\n";
+            }
+        }
+        fx.run("CREATE TABLE wide (k INT, v INT);");
+        fx.run("COPY wide FROM '" + csv_path + "';");
+        REQUIRE(dynamic_cast<ParallelAggregateOperator *>(
+                    fx.engine->buildOperator(fx.compiler->compile("SELECT AVG(v) FROM wide;")["input"]).get()) !=
+                nullptr);
+
+        REQUIRE(compare("SELECT AVG(v), MIN(v), MAX(v) FROM wide;", false).getRow(0) ==
+                QueryResult::Row{"1999999999", "1999999999", "2000000000"});
+        QueryResult grouped = compare("SELECT k, AVG(v) FROM wide GROUP BY k;", false);
+        REQUIRE(rows(grouped) == std::vector<std::string>{"0|2000000000|", "1|1999999999|", "2|2000000000|",
+                                                          "3|1999999999|"});
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(csv_path, ec);
+}
+
+TEST_CASE("Vectorized vs row-at-a-time scan throughput", "[operators][!benchmark]") {
+    OperatorFixture fx(5000);
+    json plan = fx.compiler->compile("SELECT id FROM users WHERE age >= 25;");
+
+    BENCHMARK("row operators") {
+        fx.engine->setVectorized(false);
+        return fx.engine->executePlan(plan).rowCount();
+    };
+    BENCHMARK("vectorized operators") {
+        fx.engine->setVectorized(true);
+        return fx.engine->executePlan(plan).rowCount();
+    };
+}
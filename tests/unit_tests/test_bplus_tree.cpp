@@ -9,6 +9,7 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <numeric>
 #include <random>
 #include <iostream>
 #include <filesystem>
@@ -77,12 +78,15 @@ namespace test_utils {
         std::vector<std::pair<Value, RID>> data;
         data.reserve(count);
 
+        // 从 [0, 2 * count] 中不重复地随机取 count 个键（树拒绝重复键）
+        std::vector<int> keys(count * 2 + 1);
+        std::iota(keys.begin(), keys.end(), 0);
         std::random_device rd;
         std::mt19937 gen(rd());
-        std::uniform_int_distribution<> distrib(0, count * 2);
+        std::shuffle(keys.begin(), keys.end(), gen);
 
         for (int i = 0; i < count; ++i) {
-            int key = distrib(gen);
+            int key = keys[i];
             data.emplace_back(Value(key), RID{key % 10 + 1, key % 100 + 1});
         }
         return data;
@@ -292,9 +296,11 @@ TEST_CASE("BPlusTree Range Search - Enhanced", "[bplustree][range]") {
             REQUIRE(tree.insert(Value(i * 2), RID{i * 2, i})); // 只插入偶数
         }
 
-        // 查询奇数范围
+        // 边界本身不存在时，返回落在区间内的偶数键 2..38
         auto results = tree.range_search(Value(1), Value(39));
-        REQUIRE(results.size() == 0);
+        REQUIRE(results.size() == 19);
+        REQUIRE(results.front().page_id == 2);
+        REQUIRE(results.back().page_id == 38);
     }
 
     SECTION("Large range search across multiple leaves") {
@@ -343,12 +349,9 @@ TEST_CASE("BPlusTree Edge Cases and Error Handling", "[bplustree][edge]") {
 
         REQUIRE(tree.insert(Value(42), rid1));
 
-        // 重复键插入 - 行为取决于实现（可能覆盖或失败）
-        bool duplicate_result = tree.insert(Value(42), rid2);
-
-        // 至少应该有一个结果存在
-        RID result = tree.search(Value(42));
-        REQUIRE(result.isValid());
+        // 重复键插入失败，原有条目不被覆盖
+        REQUIRE_FALSE(tree.insert(Value(42), rid2));
+        REQUIRE(tree.search(Value(42)) == rid1);
     }
 
     SECTION("Type validation") {
@@ -552,3 +555,267 @@ TEST_CASE("BPlusTree Tree Structure Validation", "[bplustree][structure]") {
     }
 }
 
+
+TEST_CASE("BPlusTree Index Iterator", "[bplustree][iterator]") {
+    std::cout << "=== Starting Index Iterator Test ===" << std::endl;
+    test_utils::TestPager pager_wrapper("test_iterator_ops.db");
+    engine::BPlusTree tree(pager_wrapper, TEST_INVALID_PAGE_ID, TypeId::INTEGER);
+
+    SECTION("Empty tree yields end iterator") {
+        REQUIRE(tree.begin().is_end());
+        REQUIRE(tree.begin(engine::ScanDirection::BACKWARD).is_end());
+    }
+
+    // 只插入偶数 0..98，跨越多个叶子
+    for (int i = 0; i < 50; ++i) {
+        REQUIRE(tree.insert(Value(i * 2), RID{i * 2, i}));
+    }
+
+    SECTION("Full forward and backward scans") {
+        int expected = 0;
+        for (auto it = tree.begin(); !it.is_end(); ++it) {
+            REQUIRE(it.key().getAsInt() == expected);
+            REQUIRE(it.rid().page_id == expected);
+            expected += 2;
+        }
+        REQUIRE(expected == 100);
+
+        expected = 98;
+        for (auto it = tree.begin(engine::ScanDirection::BACKWARD); !it.is_end(); ++it) {
+            REQUIRE(it.key().getAsInt() == expected);
+            expected -= 2;
+        }
+        REQUIRE(expected == -2);
+    }
+
+    SECTION("Closed and open bounds") {
+        auto collect = [&](const engine::KeyBound& lo, const engine::KeyBound& hi,
+                           engine::ScanDirection dir) {
+            std::vector<int> keys;
+            for (auto it = tree.scan(lo, hi, dir); !it.is_end(); ++it) {
+                keys.push_back(it.key().getAsInt());
+            }
+            return keys;
+        };
+
+        auto closed = collect(engine::KeyBound::closed(Value(10)), engine::KeyBound::closed(Value(20)),
+                              engine::ScanDirection::FORWARD);
+        REQUIRE(closed == std::vector<int>{10, 12, 14, 16, 18, 20});
+
+        auto open = collect(engine::KeyBound::open(Value(10)), engine::KeyBound::open(Value(20)),
+                            engine::ScanDirection::FORWARD);
+        REQUIRE(open == std::vector<int>{12, 14, 16, 18});
+
+        auto open_back = collect(engine::KeyBound::open(Value(10)), engine::KeyBound::open(Value(20)),
+                                 engine::ScanDirection::BACKWARD);
+        REQUIRE(open_back == std::vector<int>{18, 16, 14, 12});
+
+        // 端点不存在于树中
+        auto odd = collect(engine::KeyBound::closed(Value(9)), engine::KeyBound::closed(Value(15)),
+                           engine::ScanDirection::BACKWARD);
+        REQUIRE(odd == std::vector<int>{14, 12, 10});
+
+        auto tail = collect(engine::KeyBound::open(Value(94)), engine::KeyBound::unbounded(),
+                            engine::ScanDirection::FORWARD);
+        REQUIRE(tail == std::vector<int>{96, 98});
+
+        auto head = collect(engine::KeyBound::unbounded(), engine::KeyBound::open(Value(4)),
+                            engine::ScanDirection::BACKWARD);
+        REQUIRE(head == std::vector<int>{2, 0});
+
+        auto none = collect(engine::KeyBound::open(Value(10)), engine::KeyBound::open(Value(12)),
+                            engine::ScanDirection::FORWARD);
+        REQUIRE(none.empty());
+    }
+
+    SECTION("Early termination leaves tree usable") {
+        int seen = 0;
+        for (auto it = tree.begin(); !it.is_end() && seen < 3; ++it) {
+            ++seen;
+        }
+        REQUIRE(seen == 3);
+        REQUIRE(tree.insert(Value(1), RID{1, 1}));
+        REQUIRE(tree.search(Value(1)).isValid());
+    }
+}
+
+TEST_CASE("BPlusTree VARCHAR keys use page-sized nodes", "[bplustree][varchar]") {
+    test_utils::TestPager test_pager("test_bplus_tree_varchar.db");
+    // 0 表示按页面字节容量分裂，而不是固定键数
+    engine::BPlusTree tree(test_pager.get(), INVALID_PAGE_ID, TypeId::VARCHAR, 0, 0);
+
+    const int count = 3000;
+    auto make_key = [](int i) { return "customer/" + std::to_string(100000 + i) + "/profile/settings"; };
+
+    std::mt19937 gen(42);
+    std::vector<int> order(count);
+    for (int i = 0; i < count; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), gen);
+    for (int i : order) {
+        REQUIRE(tree.insert(Value(make_key(i)), RID{i, i % 7}));
+    }
+
+    SECTION("All keys are found and scanned in order") {
+        for (int i = 0; i < count; i += 37) {
+            RID rid = tree.search(Value(make_key(i)));
+            REQUIRE(rid.page_id == i);
+        }
+        REQUIRE_FALSE(tree.search(Value(make_key(count))).isValid());
+
+        int expected = 0;
+        for (auto it = tree.begin(); !it.is_end(); ++it) {
+            REQUIRE(it.key().getAsString() == make_key(expected));
+            ++expected;
+        }
+        REQUIRE(expected == count);
+    }
+
+    SECTION("Separators are truncated and the tree stays shallow") {
+        REQUIRE(tree.get_height() <= 2);
+
+        auto root = test_pager.get()->fetchPageRead(tree.get_root_page_id());
+        engine::BPlusTreePage root_node(root.getPage());
+        REQUIRE_FALSE(root_node.is_leaf());
+        for (int i = 0; i < root_node.get_key_count(); ++i) {
+            REQUIRE(root_node.get_key_at(i).getAsString().size() < make_key(0).size());
+        }
+    }
+}
+
+namespace {
+
+    // 正反两个方向遍历叶子链，返回键序列
+    std::vector<int> collect_keys(const engine::BPlusTree& tree, engine::ScanDirection direction) {
+        std::vector<int> keys;
+        for (auto it = tree.begin(direction); !it.is_end(); ++it) {
+            keys.push_back(it.key().getAsInt());
+        }
+        return keys;
+    }
+
+} // namespace
+
+TEST_CASE("BPlusTree deletion with merge and redistribution", "[bplustree][delete]") {
+    test_utils::TestPager test_pager("test_bplus_tree_delete.db");
+    engine::BPlusTree tree(test_pager.get(), INVALID_PAGE_ID, TypeId::INTEGER);
+
+    const int count = 400;
+    std::vector<int> keys(count);
+    for (int i = 0; i < count; ++i) keys[i] = i;
+    std::mt19937 gen(7);
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (int k : keys) {
+        REQUIRE(tree.insert(Value(k), RID{k, 0}));
+    }
+    const uint32_t full_height = tree.get_height();
+    const uint32_t full_nodes = tree.get_node_count();
+
+    SECTION("Remaining keys stay reachable and ordered after every removal") {
+        std::shuffle(keys.begin(), keys.end(), gen);
+        std::vector<int> remaining(keys.begin(), keys.end());
+        std::sort(remaining.begin(), remaining.end());
+
+        for (int i = 0; i < count; ++i) {
+            int k = keys[i];
+            REQUIRE(tree.remove(Value(k)));
+            REQUIRE_FALSE(tree.remove(Value(k)));
+            remaining.erase(std::lower_bound(remaining.begin(), remaining.end(), k));
+
+            if (i % 25 == 0) {
+                REQUIRE(collect_keys(tree, engine::ScanDirection::FORWARD) == remaining);
+                std::vector<int> reversed(remaining.rbegin(), remaining.rend());
+                REQUIRE(collect_keys(tree, engine::ScanDirection::BACKWARD) == reversed);
+                for (int r : remaining) {
+                    REQUIRE(tree.search(Value(r)).page_id == r);
+                }
+            }
+        }
+
+        // 全部删除后根节点被回收
+        REQUIRE(tree.is_empty());
+        REQUIRE(tree.get_node_count() == 0);
+        REQUIRE(tree.begin().is_end());
+    }
+
+    SECTION("Deleting most keys shrinks the tree and frees pages") {
+        for (int k = 0; k < count; ++k) {
+            if (k % 10 != 0) REQUIRE(tree.remove(Value(k)));
+        }
+        REQUIRE(tree.get_height() < full_height);
+        REQUIRE(tree.get_node_count() < full_nodes / 4);
+
+        std::vector<int> expected;
+        for (int k = 0; k < count; k += 10) expected.push_back(k);
+        REQUIRE(collect_keys(tree, engine::ScanDirection::FORWARD) == expected);
+    }
+
+    SECTION("Freed pages are reused by later inserts") {
+        for (int k = 0; k < count; ++k) {
+            REQUIRE(tree.remove(Value(k)));
+        }
+        PageID pages_after_delete = test_pager.get()->getPageCount();
+        // 按原顺序重建得到同样形状的树，所需页面全部来自空闲链表
+        for (int k : keys) {
+            REQUIRE(tree.insert(Value(k), RID{k, 1}));
+        }
+        REQUIRE(test_pager.get()->getPageCount() == pages_after_delete);
+        REQUIRE(tree.search(Value(count - 1)).slot_num == 1);
+    }
+}
+
+TEST_CASE("BPlusTree VARCHAR deletion rebalances by bytes", "[bplustree][delete][varchar]") {
+    test_utils::TestPager test_pager("test_bplus_tree_varchar_delete.db");
+    engine::BPlusTree tree(test_pager.get(), INVALID_PAGE_ID, TypeId::VARCHAR, 0, 0);
+
+    auto make_key = [](int i) { return "item/" + std::to_string(100000 + i) + std::string(i % 40, 'x'); };
+    const int count = 2000;
+    for (int i = 0; i < count; ++i) {
+        REQUIRE(tree.insert(Value(make_key(i)), RID{i, 0}));
+    }
+    for (int i = 0; i < count; ++i) {
+        if (i % 7 != 0) REQUIRE(tree.remove(Value(make_key(i))));
+    }
+
+    int seen = 0;
+    for (auto it = tree.begin(); !it.is_end(); ++it) {
+        REQUIRE(it.key().getAsString() == make_key(seen * 7));
+        ++seen;
+    }
+    REQUIRE(seen == (count + 6) / 7);
+    REQUIRE(tree.get_height() <= 2);
+}
+
+TEST_CASE("BPlusTree churn keeps size and lookups stable", "[bplustree][!benchmark]") {
+    test_utils::TestPager test_pager("test_bplus_tree_churn.db");
+    engine::BPlusTree tree(test_pager.get(), INVALID_PAGE_ID, TypeId::INTEGER, 0, 0);
+
+    // 稳定工作集：每轮删除一半旧键、插入同样多新键
+    const int working_set = 20000;
+    const int rounds = 10;
+    std::mt19937 gen(1234);
+    std::vector<int> live(working_set);
+    for (int i = 0; i < working_set; ++i) {
+        live[i] = i;
+        tree.insert(Value(i), RID{i, 0});
+    }
+    int next_key = working_set;
+
+    for (int round = 0; round < rounds; ++round) {
+        std::shuffle(live.begin(), live.end(), gen);
+        for (int i = 0; i < working_set / 2; ++i) {
+            REQUIRE(tree.remove(Value(live[i])));
+            live[i] = next_key++;
+            tree.insert(Value(live[i]), RID{live[i], 0});
+        }
+
+        std::cout << "round " << round
+                  << ": nodes=" << tree.get_node_count()
+                  << " height=" << tree.get_height()
+                  << " file_pages=" << test_pager.get()->getPageCount() << std::endl;
+    }
+
+    std::uniform_int_distribution<size_t> pick(0, live.size() - 1);
+    BENCHMARK("point lookup after churn") {
+        return tree.search(Value(live[pick(gen)]));
+    };
+}
@@ -0,0 +1,185 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include "engine/bPlusTree/bplus_tree_index.h"
+#include "engine/bPlusTree/key_codec.h"
+#include "engine/catalog/index_meta.h"
+#include "storage/Pager.h"
+#include "storage/BufferManager.h"
+#include "storage/DiskManager.h"
+#include "storage/FileManager.h"
+#include "common/Exception.h"
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace minidb;
+
+namespace {
+
+    // 每个测试用例独立的数据库文件，析构时清理
+    struct IndexTestPager {
+        std::string db_filename;
+        std::shared_ptr<storage::Pager> pager;
+
+        explicit IndexTestPager(const std::string& filename) : db_filename(filename) {
+            cleanup();
+            auto file_manager = std::make_shared<storage::FileManager>();
+            file_manager->createDatabase(db_filename);
+            file_manager->openDatabase(db_filename);
+            auto disk_manager = std::make_shared<storage::DiskManager>(file_manager);
+            auto buffer_manager = std::make_shared<storage::BufferManager>(disk_manager, 256);
+            pager = std::make_shared<storage::Pager>(disk_manager, buffer_manager);
+        }
+
+        ~IndexTestPager() { cleanup(); }
+
+        void cleanup() const {
+            std::error_code ec;
+            std::filesystem::remove(db_filename, ec);
+            std::filesystem::remove(db_filename + ".minidb", ec);
+        }
+    };
+
+    std::vector<RID> collect_rids(engine::IndexIterator it) {
+        std::vector<RID> rids;
+        for (; !it.is_end(); ++it) {
+            rids.push_back(it.rid());
+        }
+        return rids;
+    }
+
+} // namespace
+
+TEST_CASE("KeyCodec memcomparable encoding", "[index][keycodec][unit]") {
+    using engine::KeyCodec;
+
+    SECTION("Integer order is preserved by byte order") {
+        std::vector<int32_t> ints = {INT32_MIN, -1000, -1, 0, 1, 255, 256, 70000, INT32_MAX};
+        for (size_t i = 1; i < ints.size(); ++i) {
+            REQUIRE(KeyCodec::encode({Value(ints[i - 1])}) < KeyCodec::encode({Value(ints[i])}));
+        }
+    }
+
+    SECTION("String order is preserved including embedded zero bytes") {
+        std::vector<std::string> strs = {"", std::string("a\0", 2), "a", "ab", "b"};
+        std::sort(strs.begin(), strs.end());
+        for (size_t i = 1; i < strs.size(); ++i) {
+            REQUIRE(KeyCodec::encode({Value(strs[i - 1])}) < KeyCodec::encode({Value(strs[i])}));
+        }
+    }
+
+    SECTION("Composite keys order column by column") {
+        auto k1 = KeyCodec::encode({Value("a"), Value(5)});
+        auto k2 = KeyCodec::encode({Value("a"), Value(7)});
+        auto k3 = KeyCodec::encode({Value("ab"), Value(-100)});
+        REQUIRE(k1 < k2);
+        REQUIRE(k2 < k3);
+
+        // 前缀的编码是完整编码的字节前缀
+        auto prefix = KeyCodec::encode({Value("a")});
+        REQUIRE(k1.compare(0, prefix.size(), prefix) == 0);
+        REQUIRE(k3 >= KeyCodec::prefix_successor(prefix));
+    }
+
+    SECTION("Decode round trip and RID suffix") {
+        std::string key = KeyCodec::encode({Value(std::string("x\0y", 3)), Value(-42), Value(true)});
+        KeyCodec::append_rid(RID{12, 3}, &key);
+
+        auto values = KeyCodec::decode(key, {TypeId::VARCHAR, TypeId::INTEGER, TypeId::BOOLEAN});
+        REQUIRE(values[0].getAsString() == std::string("x\0y", 3));
+        REQUIRE(values[1].getAsInt() == -42);
+        REQUIRE(values[2].getAsBool());
+
+        RID rid = KeyCodec::decode_rid_suffix(key);
+        REQUIRE(rid.page_id == 12);
+        REQUIRE(rid.slot_num == 3);
+    }
+}
+
+TEST_CASE("BPlusTreeIndex non-unique and composite keys", "[index][bplustree][unit]") {
+    IndexTestPager test_pager("test_secondary_index.db");
+
+    SECTION("Non-unique index keeps every duplicate") {
+        catalog::IndexMeta meta("age_idx", "students", std::vector<std::string>{"age"},
+                                std::vector<TypeId>{TypeId::INTEGER}, false);
+        engine::BPlusTreeIndex index(test_pager.pager, &meta, 4, 4);
+        REQUIRE(index.uses_encoded_keys());
+
+        for (int i = 0; i < 40; ++i) {
+            REQUIRE(index.insert_entry({Value(i % 4)}, RID{i, i}));
+        }
+        REQUIRE(meta.get_root_page_id() != INVALID_PAGE_ID);
+
+        auto rids = collect_rids(index.scan({Value(2)}));
+        REQUIRE(rids.size() == 10);
+        for (const auto& rid : rids) {
+            REQUIRE(rid.page_id % 4 == 2);
+        }
+        // RID 后缀使重复键按 RID 排序
+        REQUIRE(std::is_sorted(rids.begin(), rids.end()));
+
+        REQUIRE(index.delete_entry({Value(2)}, RID{6, 6}));
+        REQUIRE_FALSE(index.delete_entry({Value(2)}, RID{6, 6}));
+        REQUIRE(collect_rids(index.scan({Value(2)})).size() == 9);
+    }
+
+    SECTION("Unique index rejects duplicate keys") {
+        catalog::IndexMeta meta("id_idx", "students", "id", TypeId::INTEGER);
+        engine::BPlusTreeIndex index(test_pager.pager, &meta);
+        REQUIRE_FALSE(index.uses_encoded_keys());
+
+        REQUIRE(index.insert_entry({Value(1)}, RID{1, 1}));
+        REQUIRE_FALSE(index.insert_entry({Value(1)}, RID{2, 2}));
+        REQUIRE(collect_rids(index.scan({Value(1)})) == std::vector<RID>{RID{1, 1}});
+        REQUIRE_THROWS_AS(index.insert_entry({Value("x")}, RID{3, 3}), TypeMismatchException);
+    }
+
+    SECTION("Composite prefix scans") {
+        catalog::IndexMeta meta("name_age_idx", "students", {"name", "age"},
+                                {TypeId::VARCHAR, TypeId::INTEGER}, false);
+        engine::BPlusTreeIndex index(test_pager.pager, &meta, 4, 4);
+
+        const char* names[] = {"alice", "bob", "carol"};
+        int slot = 0;
+        for (const char* name : names) {
+            for (int age = 18; age < 24; ++age) {
+                REQUIRE(index.insert_entry({Value(name), Value(age)}, RID{age, slot++}));
+            }
+        }
+
+        // 前导列等值
+        REQUIRE(collect_rids(index.scan({Value("bob")})).size() == 6);
+        // 两列等值
+        auto exact = collect_rids(index.scan({Value("bob"), Value(20)}));
+        REQUIRE(exact.size() == 1);
+        REQUIRE(exact[0].page_id == 20);
+
+        // 前导列等值 + 第二列范围 (19, 22]
+        auto range = collect_rids(index.scan({Value("carol")},
+                                             engine::KeyBound::open(Value(19)),
+                                             engine::KeyBound::closed(Value(22))));
+        REQUIRE(range.size() == 3);
+        REQUIRE(range.front().page_id == 20);
+        REQUIRE(range.back().page_id == 22);
+
+        // 反向扫描
+        auto backward = collect_rids(index.scan({Value("alice")}, engine::KeyBound::unbounded(),
+                                                engine::KeyBound::open(Value(20)),
+                                                engine::ScanDirection::BACKWARD));
+        REQUIRE(backward.size() == 2);
+        REQUIRE(backward.front().page_id == 19);
+
+        // 不存在的前缀
+        REQUIRE(collect_rids(index.scan({Value("dave")})).empty());
+    }
+
+    SECTION("Index meta reports usable equality prefix") {
+        catalog::IndexMeta meta("abc_idx", "t", {"a", "b", "c"},
+                                {TypeId::INTEGER, TypeId::INTEGER, TypeId::INTEGER}, false);
+        REQUIRE(meta.match_equality_prefix({"a", "b"}) == 2);
+        REQUIRE(meta.match_equality_prefix({"b", "a", "c"}) == 3);
+        REQUIRE(meta.match_equality_prefix({"b", "c"}) == 0);
+        REQUIRE(meta.match_equality_prefix({"a", "c"}) == 1);
+    }
+}
@@ -5,7 +5,9 @@
 #include <common/Types.h>
 #include <memory>
 #include <vector>
+#include <cstdio>
 #include <cstring>
+#include <string>
 
 TEST_CASE("BPlusTreePage basic functionality", "[bplustreepage][unit]")
 {
@@ -366,4 +368,87 @@ TEST_CASE("BPlusTreePage serialization integrity", "[bplustreepage][serializatio
         REQUIRE(bpage2.get_rid_at(0).slot_num == 10);
         REQUIRE(bpage2.get_rid_at(1).slot_num == 20);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("BPlusTreePage slotted VARCHAR layout", "[bplustreepage][varchar][unit]")
+{
+    auto page = std::make_unique<minidb::storage::Page>(1);
+    minidb::engine::BPlusTreePage bpage(page.get());
+    bpage.initialize_page();
+    bpage.set_leaf(true);
+    bpage.set_key_type(minidb::TypeId::VARCHAR);
+
+    SECTION("Shared prefix is stored once") {
+        for (int i = 9; i >= 0; --i) {
+            std::string key = "customer/0000" + std::to_string(i);
+            REQUIRE(bpage.insert_leaf_pair(minidb::Value(key), minidb::RID{i, i}));
+        }
+        bpage.assign_leaf_entries({{minidb::Value("customer/00003"), minidb::RID{3, 3}},
+                                   {minidb::Value("customer/00007"), minidb::RID{7, 7}}});
+        REQUIRE(bpage.get_prefix_size() == std::string("customer/0000").size());
+        REQUIRE(bpage.get_key_at(1).getAsString() == "customer/00007");
+        REQUIRE(bpage.find_key_index(minidb::Value("customer/00007")) == 1);
+        REQUIRE(bpage.find_key_index(minidb::Value("customer/00005")) == -2);
+        REQUIRE(bpage.find_key_index(minidb::Value("a")) == -1);
+        REQUIRE(bpage.find_key_index(minidb::Value("z")) == -3);
+
+        // 不共享前缀的新键使前缀收缩，已有键保持不变
+        REQUIRE(bpage.insert_leaf_pair(minidb::Value("cat"), minidb::RID{9, 9}));
+        REQUIRE(bpage.get_prefix_size() == 1);
+        REQUIRE(bpage.get_key_at(0).getAsString() == "cat");
+        REQUIRE(bpage.get_key_at(2).getAsString() == "customer/00007");
+        REQUIRE(bpage.get_rid_at(2).slot_num == 7);
+    }
+
+    SECTION("Fan-out is driven by key bytes, not a fixed slot width") {
+        auto make_key = [](int i) {
+            char buf[16];
+            std::snprintf(buf, sizeof(buf), "key%06d", i);
+            return minidb::Value(std::string(buf));
+        };
+
+        int inserted = 0;
+        while (bpage.has_room_for(make_key(inserted))) {
+            REQUIRE(bpage.insert_leaf_pair(make_key(inserted), minidb::RID{inserted, 0}));
+            ++inserted;
+        }
+        // 旧的定长槽位每页只能放 15 个 VARCHAR 键
+        REQUIRE(inserted > 200);
+        REQUIRE(bpage.get_key_at(inserted - 1).getAsString() == make_key(inserted - 1).getAsString());
+
+        // 删除留下的碎片在新键放不下时被整理回收
+        for (int i = inserted - 1; i >= 0; i -= 2) {
+            REQUIRE(bpage.remove_leaf_pair(i));
+        }
+        minidb::Value late("zzzz-after-compaction");
+        REQUIRE(bpage.has_room_for(late));
+        REQUIRE(bpage.insert_leaf_pair(late, minidb::RID{1, 1}));
+        REQUIRE(bpage.get_key_at(bpage.get_key_count() - 1).getAsString() == "zzzz-after-compaction");
+        REQUIRE(bpage.get_key_count() == inserted / 2 + 1);
+    }
+
+    SECTION("Internal nodes keep child pointers beside their keys") {
+        auto internal_page = std::make_unique<minidb::storage::Page>(2);
+        minidb::engine::BPlusTreePage internal(internal_page.get());
+        internal.initialize_page();
+        internal.set_leaf(false);
+        internal.set_key_type(minidb::TypeId::VARCHAR);
+
+        internal.set_child_page_id_at(0, 10);
+        REQUIRE(internal.insert_internal_pair(minidb::Value("m"), 30));
+        REQUIRE(internal.insert_internal_pair(minidb::Value("f"), 20));
+        REQUIRE(internal.get_child_page_id_at(0) == 10);
+        REQUIRE(internal.get_child_page_id_at(1) == 20);
+        REQUIRE(internal.get_child_page_id_at(2) == 30);
+
+        REQUIRE(internal.remove_internal_pair(0));
+        REQUIRE(internal.get_key_count() == 1);
+        REQUIRE(internal.get_key_at(0).getAsString() == "m");
+        REQUIRE(internal.get_child_page_id_at(1) == 30);
+    }
+
+    SECTION("Oversized keys are rejected") {
+        std::string huge(minidb::engine::BPLUS_MAX_VARCHAR_KEY_SIZE + 1, 'x');
+        REQUIRE_THROWS(bpage.insert_leaf_pair(minidb::Value(huge), minidb::RID{1, 1}));
+    }
+}
@@ -336,6 +336,28 @@ TEST_CASE("BufferManager edge cases", "[buffermanager][edge][unit]")
         REQUIRE(buffer_manager.getCurrentPages() == 0);
     }
 
+    SECTION("Discard page drops dirty frames without writing them back") {
+        file_manager->createDatabase(test_db);
+        auto disk_manager = std::make_shared<minidb::storage::DiskManager>(file_manager);
+        minidb::storage::BufferManager buffer_manager(disk_manager, 5);
+
+        minidb::PageID page_id = disk_manager->allocatePage();
+        char before[minidb::PAGE_SIZE];
+        disk_manager->readPage(page_id, before);
+
+        std::strcpy(buffer_manager.fetchPage(page_id)->getData(), "temporary data");
+        REQUIRE_THROWS_AS(buffer_manager.discardPage(page_id), minidb::PinnedPageException);
+        buffer_manager.unpinPage(page_id, true);
+
+        buffer_manager.discardPage(page_id);
+        REQUIRE(buffer_manager.getCurrentPages() == 0);
+        REQUIRE_NOTHROW(buffer_manager.discardPage(page_id));
+
+        char after[minidb::PAGE_SIZE];
+        disk_manager->readPage(page_id, after);
+        REQUIRE(std::memcmp(before, after, minidb::PAGE_SIZE) == 0);
+    }
+
     if (file_manager->databaseExists(test_db)) {
         file_manager->deleteDatabase(test_db);
     }
@@ -371,7 +371,7 @@ TEST_CASE("CatalogManager AST validation", "[catalog][ast][validation][unit]")
     SECTION("Validate INSERT AST - valid") {
         InsertAST insert_ast;
         insert_ast.tableName = "users";
-        insert_ast.values = {"1", "'John'", "25"};
+        insert_ast.rows = {{"1", "'John'", "25"}};
 
         REQUIRE(catalog.validate_insert_ast(insert_ast) == true);
     }
@@ -379,7 +379,7 @@ TEST_CASE("CatalogManager AST validation", "[catalog][ast][validation][unit]")
     SECTION("Validate INSERT AST - table not exists") {
         InsertAST insert_ast;
         insert_ast.tableName = "nonexistent";
-        insert_ast.values = {"1", "'John'"};
+        insert_ast.rows = {{"1", "'John'"}};
 
         REQUIRE(catalog.validate_insert_ast(insert_ast) == false);
     }
@@ -387,11 +387,11 @@ TEST_CASE("CatalogManager AST validation", "[catalog][ast][validation][unit]")
     SECTION("Validate INSERT AST - wrong value count") {
         InsertAST insert_ast;
         insert_ast.tableName = "users";
-        insert_ast.values = {"1", "'John'"}; // 缺少一个值
+        insert_ast.rows = {{"1", "'John'"}}; // 缺少一个值
 
         REQUIRE(catalog.validate_insert_ast(insert_ast) == false);
 
-        insert_ast.values = {"1", "'John'", "25", "extra"}; // 多一个值
+        insert_ast.rows = {{"1", "'John'", "25", "extra"}}; // 多一个值
         REQUIRE(catalog.validate_insert_ast(insert_ast) == false);
     }
 
@@ -2,6 +2,7 @@
 #include "engine/catalog/index_meta.h"
 #include "common/Exception.h"
 #include <cstring>
+#include <vector>
 
 TEST_CASE("IndexMeta Construction and Basic Properties", "[catalog][index_meta]") {
     SECTION("Default constructor creates invalid index") {
@@ -224,4 +225,51 @@ TEST_CASE("IndexMeta Validity Checking") {
         REQUIRE(meta.is_valid());        // ✅ 元数据有效
         REQUIRE(meta.is_ready_for_use()); // ✅ 准备好使用
     }
-}
\ No newline at end of file
+}
+TEST_CASE("IndexMeta Composite and Non-unique Indexes", "[catalog][index_meta][composite]") {
+    SECTION("Composite index keeps column order and uniqueness") {
+        minidb::catalog::IndexMeta meta("name_age_idx", "students", {"name", "age"},
+                                        {minidb::TypeId::VARCHAR, minidb::TypeId::INTEGER}, false, 7);
+
+        REQUIRE(meta.is_valid());
+        REQUIRE(meta.is_composite());
+        REQUIRE_FALSE(meta.is_unique());
+        REQUIRE(meta.get_column_count() == 2);
+        REQUIRE(meta.get_column_name() == "name");
+        REQUIRE(meta.get_key_type() == minidb::TypeId::VARCHAR);
+    }
+
+    SECTION("Composite serialization round-trip") {
+        minidb::catalog::IndexMeta original("abc_idx", "t", {"a", "b", "c"},
+                                            {minidb::TypeId::INTEGER, minidb::TypeId::VARCHAR,
+                                             minidb::TypeId::BOOLEAN}, false, 42);
+
+        std::vector<char> buffer(minidb::catalog::IndexMeta::get_serialized_size());
+        original.serialize(buffer.data());
+
+        minidb::catalog::IndexMeta restored;
+        restored.deserialize(buffer.data());
+
+        REQUIRE(restored.get_column_names() == original.get_column_names());
+        REQUIRE(restored.get_key_types() == original.get_key_types());
+        REQUIRE_FALSE(restored.is_unique());
+        REQUIRE(restored.get_root_page_id() == 42);
+    }
+
+    SECTION("Single-column constructor stays unique") {
+        minidb::catalog::IndexMeta meta("id_idx", "t", "id", minidb::TypeId::INTEGER);
+        REQUIRE(meta.is_unique());
+        REQUIRE_FALSE(meta.is_composite());
+    }
+
+    SECTION("Mismatched or oversized column lists are rejected") {
+        REQUIRE_THROWS_AS(
+            minidb::catalog::IndexMeta("idx", "t", std::vector<std::string>{"a", "b"},
+                                       std::vector<minidb::TypeId>{minidb::TypeId::INTEGER}, false),
+            minidb::DatabaseException);
+        REQUIRE_THROWS_AS(
+            minidb::catalog::IndexMeta("idx", "t", {"a", "b", "c", "d", "e"},
+                                       std::vector<minidb::TypeId>(5, minidb::TypeId::INTEGER), false),
+            minidb::DatabaseException);
+    }
+}
@@ -4,6 +4,7 @@
 #include <cstring>
 #include <vector>
 #include <iostream>
+#include <iomanip>
 
 using namespace minidb::storage;
 using namespace Catch::Matchers;
@@ -0,0 +1,100 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include <storage/BufferManager.h>
+#include <storage/DiskManager.h>
+#include <storage/FileManager.h>
+#include <storage/PageGuard.h>
+#include <common/Exception.h>
+#include <memory>
+#include <cstring>
+#include <vector>
+
+TEST_CASE("PageGuard RAII pin management", "[pageguard][storage][unit]")
+{
+    auto file_manager = std::make_shared<minidb::storage::FileManager>();
+    std::string test_db = "test_pageguard_db";
+
+    if (file_manager->databaseExists(test_db)) {
+        file_manager->deleteDatabase(test_db);
+    }
+    file_manager->createDatabase(test_db);
+    auto disk_manager = std::make_shared<minidb::storage::DiskManager>(file_manager);
+
+    SECTION("Guard unpins page on scope exit") {
+        minidb::storage::BufferManager buffer_manager(disk_manager, 3);
+        minidb::PageID page_id = disk_manager->allocatePage();
+
+        {
+            auto guard = buffer_manager.fetchPageRead(page_id);
+            REQUIRE(guard.isValid());
+            REQUIRE(guard.getPageId() == page_id);
+            REQUIRE(buffer_manager.getPinCount(page_id) == 1);
+
+            auto second = buffer_manager.fetchPageRead(page_id);
+            REQUIRE(buffer_manager.getPinCount(page_id) == 2);
+        }
+        REQUIRE(buffer_manager.getPinCount(page_id) == 0);
+    }
+
+    SECTION("Moved guard releases exactly once") {
+        minidb::storage::BufferManager buffer_manager(disk_manager, 3);
+        minidb::PageID page_id = disk_manager->allocatePage();
+
+        minidb::storage::WritePageGuard outer;
+        {
+            auto guard = buffer_manager.fetchPageWrite(page_id);
+            outer = std::move(guard);
+            REQUIRE_FALSE(guard.isValid());
+        }
+        REQUIRE(outer.isValid());
+        REQUIRE(buffer_manager.getPinCount(page_id) == 1);
+
+        outer.release();
+        REQUIRE_FALSE(outer.isValid());
+        REQUIRE(buffer_manager.getPinCount(page_id) == 0);
+
+        // 重复释放是安全的空操作
+        outer.release();
+        REQUIRE(buffer_manager.getPinCount(page_id) == 0);
+    }
+
+    SECTION("Write guard marks page dirty so changes survive eviction") {
+        minidb::storage::BufferManager buffer_manager(disk_manager, 2);
+        minidb::PageID page_id = disk_manager->allocatePage();
+        const char payload[] = "guarded";
+
+        {
+            auto guard = buffer_manager.fetchPageWrite(page_id);
+            std::memcpy(guard.getData() + 64, payload, sizeof(payload));
+        }
+
+        // 访问其他页面把目标页挤出缓冲池
+        for (int i = 0; i < 4; ++i) {
+            minidb::PageID other = disk_manager->allocatePage();
+            auto guard = buffer_manager.fetchPageRead(other);
+        }
+
+        auto guard = buffer_manager.fetchPageRead(page_id);
+        REQUIRE(std::memcmp(guard.getData() + 64, payload, sizeof(payload)) == 0);
+    }
+
+    SECTION("Scans with guards never exhaust a small pool") {
+        minidb::storage::BufferManager buffer_manager(disk_manager, 2);
+        std::vector<minidb::PageID> pages;
+        for (int i = 0; i < 8; ++i) {
+            pages.push_back(disk_manager->allocatePage());
+        }
+
+        for (int round = 0; round < 3; ++round) {
+            for (minidb::PageID page_id : pages) {
+                REQUIRE_NOTHROW(buffer_manager.fetchPageRead(page_id));
+            }
+        }
+        for (minidb::PageID page_id : pages) {
+            REQUIRE(buffer_manager.getPinCount(page_id) == 0);
+        }
+    }
+
+    if (file_manager->databaseExists(test_db)) {
+        file_manager->deleteDatabase(test_db);
+    }
+}
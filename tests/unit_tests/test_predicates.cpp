@@ -0,0 +1,121 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include "engine/Operators.h"
+#include "engine/catalog/schema.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace minidb;
+
+namespace {
+
+    // (id INT, name VARCHAR(16), active BOOLEAN) 的定长记录
+    Schema makeSchema() {
+        return Schema({MyColumn("id", TypeId::INTEGER, 4, 0),
+                       MyColumn("name", TypeId::VARCHAR, 16, 0),
+                       MyColumn("active", TypeId::BOOLEAN, 1, 0)});
+    }
+
+    std::vector<char> encodeRecord(const Schema &schema, int32_t id, const std::string &name, bool active) {
+        std::vector<char> record(schema.get_length(), 0);
+        std::memcpy(record.data() + schema.get_column(0u).offset, &id, sizeof(int32_t));
+        std::memcpy(record.data() + schema.get_column(1u).offset, name.data(), name.size());
+        record[schema.get_column(2u).offset] = active;
+        return record;
+    }
+
+    const std::vector<CompareOp> ALL_OPS = {CompareOp::EQ, CompareOp::NE, CompareOp::LT,
+                                            CompareOp::LE, CompareOp::GT, CompareOp::GE};
+
+} // namespace
+
+TEST_CASE("Compiled predicates agree with Value comparison", "[predicate][unit]") {
+    const Schema schema = makeSchema();
+
+    SECTION("operator names") {
+        REQUIRE(parseCompareOp("=") == CompareOp::EQ);
+        REQUIRE(parseCompareOp("<>") == CompareOp::NE);
+        REQUIRE(parseCompareOp("GREATER_THAN_OR_EQUAL") == CompareOp::GE);
+        REQUIRE_THROWS(parseCompareOp("LIKE"));
+    }
+
+    SECTION("INTEGER, VARCHAR and BOOLEAN columns") {
+        const std::vector<std::pair<int32_t, std::string>> rows = {
+            {-5, "alice"}, {0, "bob"}, {7, "bobby"}, {42, ""}, {100, "0123456789abcdef"}};
+        const std::vector<int32_t> ints = {-5, 0, 7, 50};
+        const std::vector<std::string> strings = {"bob", "", "b", "zzz", "0123456789abcdef"};
+
+        for (const auto &[id, name] : rows) {
+            bool active = id % 2 == 0;
+            std::vector<char> record = encodeRecord(schema, id, name, active);
+            for (CompareOp op : ALL_OPS) {
+                for (int32_t constant : ints) {
+                    auto predicate = compilePredicate(schema.get_column(0u), op, Value(constant));
+                    REQUIRE(predicate(record.data()) == compareValues(Value(id), op, Value(constant)));
+                }
+                for (const auto &constant : strings) {
+                    auto predicate = compilePredicate(schema.get_column(1u), op, Value(constant));
+                    REQUIRE(predicate(record.data()) == compareValues(Value(name), op, Value(constant)));
+                }
+                auto predicate = compilePredicate(schema.get_column(2u), op, Value(true));
+                REQUIRE(predicate(record.data()) == compareValues(Value(active), op, Value(true)));
+            }
+        }
+    }
+
+    SECTION("comparison with NULL never matches") {
+        std::vector<char> record = encodeRecord(schema, 1, "x", true);
+        REQUIRE_FALSE(compilePredicate(schema.get_column(0u), CompareOp::NE, Value())(record.data()));
+    }
+}
+
+TEST_CASE("Predicate throughput in rows/sec", "[predicate][!benchmark]") {
+    const Schema schema = makeSchema();
+    constexpr int ROWS = 200000;
+
+    std::vector<char> records;
+    records.reserve(static_cast<size_t>(ROWS) * schema.get_length());
+    for (int i = 0; i < ROWS; ++i) {
+        auto record = encodeRecord(schema, i, "user" + std::to_string(i % 1000), i % 2 == 0);
+        records.insert(records.end(), record.begin(), record.end());
+    }
+
+    // 每种谓词各跑若干轮，输出每秒过滤的行数
+    auto measure = [&](const std::string &label, const std::function<bool(const char *)> &predicate) {
+        constexpr int ROUNDS = 10;
+        size_t matched = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < ROUNDS; ++round) {
+            for (int i = 0; i < ROWS; ++i) {
+                matched += predicate(records.data() + static_cast<size_t>(i) * schema.get_length());
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << label << ": " << static_cast<long long>(ROWS * ROUNDS / elapsed.count())
+                  << " rows/sec" << std::endl;
+        return matched / ROUNDS;
+    };
+
+    // 对照组：逐行解码为 Value，并按字符串运算符分派
+    auto interpreted = [&](size_t column, std::string op, Value constant) {
+        const MyColumn &col = schema.get_column(static_cast<uint32_t>(column));
+        return [&col, op, constant](const char *record) {
+            return compareValues(decodeColumn(record, col), op, constant);
+        };
+    };
+
+    size_t intCompiled = measure("INT compiled       ",
+                                 compilePredicate(schema.get_column(0u), CompareOp::LT, Value(ROWS / 2)));
+    size_t intInterpreted = measure("INT interpreted    ", interpreted(0, "LESS_THAN", Value(ROWS / 2)));
+    REQUIRE(intCompiled == intInterpreted);
+    REQUIRE(intCompiled == ROWS / 2);
+
+    size_t strCompiled = measure("VARCHAR compiled   ",
+                                 compilePredicate(schema.get_column(1u), CompareOp::EQ, Value("user42")));
+    size_t strInterpreted = measure("VARCHAR interpreted", interpreted(1, "EQUALS", Value("user42")));
+    REQUIRE(strCompiled == strInterpreted);
+    REQUIRE(strCompiled == ROWS / 1000);
+}
@@ -0,0 +1,53 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include <common/QueryResult.h>
+#include <common/Tuple.h>
+#include <common/Value.h>
+
+#include <sstream>
+
+using namespace minidb;
+
+TEST_CASE("Columnar QueryResult", "[query_result][unit]")
+{
+    QueryResult result;
+    result.setColumns({"id", "name", "active"}, {TypeId::INTEGER, TypeId::VARCHAR, TypeId::BOOLEAN});
+    result.appendTuple(Tuple({Value(1), Value("alice"), Value(true)}));
+    result.appendTuple(Tuple({Value(-20), Value(), Value(false)}));
+    result.appendTuple(Tuple({Value(), Value(""), Value()}));
+
+    SECTION("Typed access without text conversion") {
+        REQUIRE(result.rowCount() == 3);
+        REQUIRE(result.columnCount() == 3);
+        REQUIRE(result.getColumnType(0) == TypeId::INTEGER);
+        REQUIRE(result.getInt(1, 0) == -20);
+        REQUIRE(result.getString(0, 1) == "alice");
+        REQUIRE(result.getString(2, 1).empty());
+        REQUIRE(result.isNull(1, 1));
+        REQUIRE(result.isNull(2, 0));
+        REQUIRE_FALSE(result.isNull(2, 1));
+        REQUIRE_THROWS_AS(result.getString(0, 0), TypeMismatchException);
+        REQUIRE_THROWS(result.getInt(3, 0));
+    }
+
+    SECTION("Text is produced at the presentation boundary") {
+        REQUIRE(result.getRow(0) == QueryResult::Row{"1", "alice", "true"});
+        REQUIRE(result.getRow(1) == QueryResult::Row{"-20", "NULL", "false"});
+        REQUIRE(result.getValue(2, 0) == std::optional<std::string>("NULL"));
+        REQUIRE_FALSE(result.getValue(0, 3).has_value());
+        REQUIRE_THROWS(result.getRow(3));
+
+        std::ostringstream out;
+        result.print(out);
+        REQUIRE(out.str() == "1\talice\ttrue\n-20\tNULL\tfalse\nNULL\t\tNULL\n");
+    }
+
+    SECTION("Text rows are kept in VARCHAR columns") {
+        QueryResult text;
+        text.setColumnNames({"a", "b"});
+        text.addRow({"x", "42"});
+        text.appendTuple(Tuple({Value(7), Value("y")}));
+        REQUIRE(text.getColumnType(1) == TypeId::VARCHAR);
+        REQUIRE(text.getRow(1) == QueryResult::Row{"7", "y"});
+        REQUIRE_THROWS(text.addRow({"only one"}));
+    }
+}
@@ -0,0 +1,78 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include <common/ResultWriter.h>
+
+#include <cstdio>
+#include <string>
+
+using namespace minidb;
+
+TEST_CASE("ResultWriter serializes JSON and CSV", "[result_writer][unit]")
+{
+    QueryResult result;
+    result.setColumns({"id", "na\"me", "ok"}, {TypeId::INTEGER, TypeId::VARCHAR, TypeId::BOOLEAN});
+    result.appendTuple(Tuple({Value(-7), Value("a,\"b\"\n"), Value(true)}));
+    result.appendTuple(Tuple({Value(2147483647), Value(), Value()}));
+    result.appendTuple(Tuple({Value(0), Value(""), Value(false)}));
+
+    SECTION("JSON uses column names, typed scalars and escaping") {
+        REQUIRE(result.toJsonString() ==
+                "[\n"
+                "  {\"id\":-7,\"na\\\"me\":\"a,\\\"b\\\"\\n\",\"ok\":true},\n"
+                "  {\"id\":2147483647,\"na\\\"me\":null,\"ok\":null},\n"
+                "  {\"id\":0,\"na\\\"me\":\"\",\"ok\":false}\n"
+                "]");
+        REQUIRE(QueryResult().toJsonString() == "[]");
+
+        OutputBuffer out;
+        appendJsonString(out, std::string("\\\t\x01", 3));
+        REQUIRE(out.str() == "\"\\\\\\t\\u0001\"");
+    }
+
+    SECTION("CSV quotes only fields that need it") {
+        REQUIRE(result.toCsvString() ==
+                "id,\"na\"\"me\",ok\n"
+                "-7,\"a,\"\"b\"\"\n\",true\n"
+                "2147483647,,\n"
+                "0,\"\",false\n");
+    }
+
+    SECTION("Tuples are streamed row by row") {
+        OutputBuffer out;
+        ResultWriter writer(out, ResultWriter::Format::CSV);
+        writer.begin({"a", "b"});
+        writer.writeRow(Tuple({Value(1), Value("x y")}));
+        writer.writeRow(Tuple({Value(), Value(true)}));
+        writer.end();
+        REQUIRE(writer.rowsWritten() == 2);
+        REQUIRE(out.str() == "a,b\n1,x y\n,true\n");
+    }
+
+    SECTION("Output is flushed incrementally to a file descriptor") {
+        std::FILE *file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        size_t expected = 0;
+        {
+            OutputBuffer out(fileno(file), 256);
+            ResultWriter writer(out, ResultWriter::Format::CSV);
+            writer.begin({"id"});
+            expected += 3;
+            for (int i = 0; i < 1000; ++i) {
+                writer.writeRow(Tuple({Value(i)}));
+                expected += std::to_string(i).size() + 1;
+                // 缓冲区不会超过阈值太多
+                REQUIRE(out.str().size() < 256);
+            }
+            writer.end();
+            REQUIRE(out.str().empty());
+            REQUIRE(out.bytesFlushed() == expected);
+        }
+
+        std::fseek(file, 0, SEEK_END);
+        REQUIRE(static_cast<size_t>(std::ftell(file)) == expected);
+        std::rewind(file);
+        char head[8] = {};
+        REQUIRE(std::fread(head, 1, 7, file) == 7);
+        REQUIRE(std::string(head) == "id\n0\n1\n");
+        std::fclose(file);
+    }
+}
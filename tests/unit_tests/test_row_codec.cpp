@@ -0,0 +1,59 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include "engine/RowCodec.h"
+#include "engine/catalog/schema.h"
+
+#include <string>
+#include <vector>
+
+using namespace minidb;
+
+TEST_CASE("RowCodec encodes and decodes fixed-length records", "[rowcodec][unit]") {
+    // (id INT, name VARCHAR(8), active BOOLEAN, score INT)
+    Schema schema({MyColumn("id", TypeId::INTEGER, 4, 0),
+                   MyColumn("name", TypeId::VARCHAR, 8, 0),
+                   MyColumn("active", TypeId::BOOLEAN, 1, 0),
+                   MyColumn("score", TypeId::INTEGER, 4, 0)});
+    RowCodec codec(schema);
+
+    SECTION("offsets and widths follow the schema") {
+        REQUIRE(codec.columnCount() == 4);
+        REQUIRE(codec.rowSize() == schema.get_length());
+        for (uint32_t i = 0; i < schema.get_column_count(); ++i) {
+            REQUIRE(codec.field(i).offset == schema.get_column(i).offset);
+            REQUIRE(codec.field(i).width == schema.get_column(i).length);
+            REQUIRE(codec.field(i).type == schema.get_column(i).type);
+        }
+    }
+
+    SECTION("round trip, VARCHAR truncated to its width") {
+        std::vector<char> record(codec.rowSize(), 'x');
+        codec.encode({Value(-7), Value(std::string("abcdefghij")), Value(true), Value(99)}, record.data());
+
+        Tuple tuple = codec.decode(record.data(), RID{3, 5});
+        REQUIRE(tuple.getValue(0).getAsInt() == -7);
+        REQUIRE(tuple.getValue(1).getAsString() == "abcdefgh");
+        REQUIRE(tuple.getValue(2).getAsBool());
+        REQUIRE(tuple.getValue(3).getAsInt() == 99);
+        REQUIRE(tuple.getRid() == RID{3, 5});
+
+        codec.writeString(record.data(), 1, "ab");
+        REQUIRE(codec.readString(record.data(), 1) == "ab");
+        REQUIRE(codec.readInt(record.data(), 3) == 99);
+
+        Tuple projected = codec.decode(record.data(), {3, 1}, RID{});
+        REQUIRE(projected.getValue(0).getAsInt() == 99);
+        REQUIRE(projected.getValue(1).getAsString() == "ab");
+    }
+
+    SECTION("all-INTEGER schema and value count check") {
+        Schema ints({MyColumn("a", TypeId::INTEGER, 4, 0), MyColumn("b", TypeId::INTEGER, 4, 0)});
+        RowCodec intCodec(ints);
+        std::vector<char> record(intCodec.rowSize());
+        intCodec.encode({Value(1), Value(2)}, record.data());
+        Tuple tuple = intCodec.decode(record.data());
+        REQUIRE(tuple.getValue(0).getAsInt() == 1);
+        REQUIRE(tuple.getValue(1).getAsInt() == 2);
+
+        REQUIRE_THROWS(intCodec.encode({Value(1)}, record.data()));
+    }
+}
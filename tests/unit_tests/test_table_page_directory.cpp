@@ -0,0 +1,91 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include "storage/TablePageDirectory.h"
+#include "storage/BufferManager.h"
+#include "storage/DiskManager.h"
+#include "storage/FileManager.h"
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace minidb;
+using namespace minidb::storage;
+
+namespace {
+
+    // 分配并链接 n 个数据页，返回页号（按链顺序）
+    std::vector<PageID> makeChain(BufferManager& buffer_manager, size_t n) {
+        std::vector<PageID> pages;
+        for (size_t i = 0; i < n; ++i) {
+            PageID pid = buffer_manager.allocatePage();
+            WritePageGuard page = buffer_manager.fetchPageWrite(pid);
+            page->initAsDataPage();
+            if (!pages.empty()) {
+                buffer_manager.fetchPageWrite(pages.back())->setNextPageId(pid);
+            }
+            pages.push_back(pid);
+        }
+        return pages;
+    }
+
+} // namespace
+
+TEST_CASE("Table page directory tracks data pages and free space", "[storage][directory]") {
+    std::filesystem::remove("test_db_directory.minidb");
+    auto file_manager = std::make_shared<FileManager>();
+    file_manager->createDatabase("test_db_directory");
+    auto disk_manager = std::make_shared<DiskManager>(file_manager);
+    auto buffer_manager = std::make_shared<BufferManager>(disk_manager, 32);
+
+    SECTION("existing page chains are migrated in chain order") {
+        std::vector<PageID> chain = makeChain(*buffer_manager, 5);
+        buffer_manager->fetchPageWrite(chain[2])->insertRecord("abcd", 4);
+
+        TablePageDirectory directory(buffer_manager, TablePageDirectory::create(buffer_manager, chain.front()));
+        REQUIRE(directory.getPages() == chain);
+        REQUIRE(directory.getLastPage() == chain.back());
+        REQUIRE(directory.getFreeSpace(chain[2]) == directory.getFreeSpace(chain[0]) - 4 - Page::SLOT_SIZE);
+        REQUIRE_THROWS_AS(TablePageDirectory(buffer_manager, chain.front()), DatabaseException);
+    }
+
+    SECTION("entries spill onto further directory pages and survive reopening") {
+        std::vector<PageID> chain = makeChain(*buffer_manager, 1);
+        PageID root = TablePageDirectory::create(buffer_manager, chain.front());
+
+        const size_t count = TablePageDirectory::ENTRIES_PER_PAGE + 10;
+        {
+            TablePageDirectory directory(buffer_manager, root);
+            // 只登记目录条目，不实际分配数据页
+            for (size_t i = 1; i < count; ++i) {
+                directory.append(static_cast<PageID>(100000 + i), static_cast<uint16_t>(i % 2 ? 0 : 500));
+            }
+            directory.setFreeSpace(chain.front(), 0);
+            directory.flush();
+            REQUIRE(directory.getDirectoryPages().size() == 2);
+        }
+
+        TablePageDirectory reopened(buffer_manager, root);
+        REQUIRE(reopened.getPageCount() == count);
+        REQUIRE(reopened.getRootPageId() == root);
+        REQUIRE(reopened.getLastPage() == static_cast<PageID>(100000 + count - 1));
+        PageID last = reopened.getLastPage();
+        reopened.setFreeSpace(last, 0);
+        REQUIRE(reopened.findPageWithSpace(100) == 100002);
+        REQUIRE(reopened.findPageWithSpace(500) == INVALID_PAGE_ID);
+
+        // 表尾页有空间时优先选它；游标之前的页腾出空间后重新可选
+        reopened.setFreeSpace(last, 500);
+        REQUIRE(reopened.findPageWithSpace(100) == last);
+        reopened.setFreeSpace(last, 0);
+        reopened.setFreeSpace(100002, 0);
+        REQUIRE(reopened.findPageWithSpace(100) == 100004);
+        reopened.setFreeSpace(100002, 200);
+        REQUIRE(reopened.findPageWithSpace(100) == 100002);
+        REQUIRE(reopened.findPageWithSpace(300) == 100004);
+        REQUIRE(reopened.findPageWithSpace(50) == 100002);
+    }
+
+    buffer_manager.reset();
+    disk_manager.reset();
+    file_manager.reset();
+    std::filesystem::remove("test_db_directory.minidb");
+}
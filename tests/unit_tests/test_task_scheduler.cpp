@@ -0,0 +1,77 @@
+#include <../tests/catch2/catch_amalgamated.hpp>
+#include "engine/TaskScheduler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace minidb;
+
+TEST_CASE("TaskScheduler runs batches of tasks to completion", "[scheduler][unit]") {
+    SECTION("every task runs exactly once") {
+        for (size_t workers : {0, 1, 4}) {
+            TaskScheduler scheduler(workers);
+            REQUIRE(scheduler.workerCount() == workers);
+            std::vector<std::atomic<int>> hits(1000);
+            std::vector<TaskScheduler::Task> tasks;
+            for (size_t i = 0; i < hits.size(); ++i) {
+                tasks.emplace_back([&hits, i] { ++hits[i]; });
+            }
+            scheduler.run(std::move(tasks));
+            for (const auto &hit : hits) {
+                REQUIRE(hit == 1);
+            }
+        }
+    }
+
+    SECTION("tasks may submit nested batches") {
+        TaskScheduler scheduler(2);
+        std::atomic<int> count{0};
+        std::vector<TaskScheduler::Task> outer;
+        for (int i = 0; i < 8; ++i) {
+            outer.emplace_back([&] {
+                std::vector<TaskScheduler::Task> inner;
+                for (int j = 0; j < 8; ++j) {
+                    inner.emplace_back([&] { ++count; });
+                }
+                scheduler.run(std::move(inner));
+            });
+        }
+        scheduler.run(std::move(outer));
+        REQUIRE(count == 64);
+    }
+
+    SECTION("submitted tasks run without blocking the caller") {
+        for (size_t workers : {0, 3}) {
+            std::mutex mutex;
+            std::condition_variable done;
+            int count = 0;
+            TaskScheduler scheduler(workers);
+            for (int i = 0; i < 100; ++i) {
+                scheduler.submit([&] {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (++count == 100) done.notify_all();
+                });
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&] { return count == 100; });
+            REQUIRE(count == 100);
+        }
+    }
+
+    SECTION("the first exception is rethrown after the batch finishes") {
+        TaskScheduler scheduler(3);
+        std::atomic<int> count{0};
+        std::vector<TaskScheduler::Task> tasks;
+        for (int i = 0; i < 16; ++i) {
+            tasks.emplace_back([&, i] {
+                ++count;
+                if (i == 5) throw std::runtime_error("task failed");
+            });
+        }
+        REQUIRE_THROWS_WITH(scheduler.run(std::move(tasks)), "task failed");
+        REQUIRE(count == 16);
+    }
+}